@@ -45,6 +45,10 @@ using KIGFX::COLOR4D;
 // Create only once, as seeding is *very* expensive
 static boost::uuids::random_generator randomGenerator;
 
+// The random generator is not thread-safe, and items can be created concurrently, for
+// instance when loading schematic sheets.
+static std::mutex randomGeneratorMutex;
+
 // These don't have the same performance penalty, but might as well be consistent
 static boost::uuids::string_generator stringGenerator;
 static boost::uuids::nil_generator nilGenerator;
@@ -54,7 +58,6 @@ KIID niluuid( 0 );
 
 
 KIID::KIID() :
-        m_uuid( randomGenerator() ),
         m_cached_timestamp( 0 )
 {
 #if defined(EESCHEMA)
@@ -62,12 +65,22 @@ KIID::KIID() :
     static timestamp_t oldTimeStamp;
     timestamp_t        newTimeStamp = time( NULL );
 
-    if( newTimeStamp <= oldTimeStamp )
-        newTimeStamp = oldTimeStamp + 1;
+    {
+        std::lock_guard<std::mutex> lock( randomGeneratorMutex );
+
+        m_uuid = randomGenerator();
+
+        if( newTimeStamp <= oldTimeStamp )
+            newTimeStamp = oldTimeStamp + 1;
 
-    oldTimeStamp = newTimeStamp;
+        oldTimeStamp = newTimeStamp;
+    }
 
     *this = KIID( wxString::Format( "%8.8X", newTimeStamp ) );
+#else
+    std::lock_guard<std::mutex> lock( randomGeneratorMutex );
+
+    m_uuid = randomGenerator();
 #endif
 }
 
@@ -110,6 +123,8 @@ KIID::KIID( const wxString& aString ) :
         {
             // Failed to parse string representation; best we can do is assign a new
             // random one.
+            std::lock_guard<std::mutex> lock( randomGeneratorMutex );
+
             m_uuid = randomGenerator();
         }
     }
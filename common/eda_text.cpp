@@ -180,12 +180,11 @@ bool EDA_TEXT::Replace( wxFindReplaceData& aSearchData )
 
 int EDA_TEXT::LenSize( const wxString& aLine, int aThickness ) const
 {
-    basic_gal.SetFontItalic( IsItalic() );
-    basic_gal.SetFontBold( IsBold() );
-    basic_gal.SetLineWidth( (float) aThickness );
-    basic_gal.SetGlyphSize( VECTOR2D( GetTextSize() ) );
-
-    VECTOR2D tsize = basic_gal.GetTextLineSize( aLine );
+    // Use the font directly rather than the basic_gal settings: texts can be measured
+    // concurrently, for instance when loading schematic sheets.
+    const auto& font = basic_gal.GetStrokeFont();
+    VECTOR2D    tsize = font.ComputeStringBoundaryLimits( aLine, VECTOR2D( GetTextSize() ),
+                                                          aThickness, IsItalic() );
 
     return KiROUND( tsize.x );
 }
@@ -251,7 +250,9 @@ EDA_RECT EDA_TEXT::GetTextBox( int aLine, bool aInvertY ) const
     const auto& font = basic_gal.GetStrokeFont();
     VECTOR2D    fontSize( GetTextSize() );
     double      penWidth( thickness );
-    int         dx = KiROUND( font.ComputeStringBoundaryLimits( text, fontSize, penWidth ).x );
+    bool        italic = IsItalic();
+    int         dx = KiROUND( font.ComputeStringBoundaryLimits( text, fontSize, penWidth,
+                                                                italic ).x );
     int         dy = GetInterline();
 
     // Creates bounding box (rectangle) for horizontal, left and top justified text. The
@@ -290,7 +291,8 @@ EDA_RECT EDA_TEXT::GetTextBox( int aLine, bool aInvertY ) const
         for( unsigned ii = 1; ii < strings.GetCount(); ii++ )
         {
             text = strings.Item( ii );
-            dx = KiROUND( font.ComputeStringBoundaryLimits( text, fontSize, penWidth ).x );
+            dx = KiROUND( font.ComputeStringBoundaryLimits( text, fontSize, penWidth,
+                                                            italic ).x );
             textsize.x = std::max( textsize.x, dx );
             textsize.y += dy;
         }
@@ -168,6 +168,21 @@ void CAIRO_COMPOSITOR::Present()
 {
 }
 
+
+void CAIRO_COMPOSITOR::DrawTile( cairo_surface_t* aSurface, int aX, int aY )
+{
+    cairo_t* context = m_buffers[m_current].context;
+
+    // Tiles are positioned in screen coordinates, whatever the buffer transformation is
+    cairo_save( context );
+    cairo_identity_matrix( context );
+    cairo_set_operator( context, CAIRO_OPERATOR_OVER );
+    cairo_set_source_surface( context, aSurface, aX, aY );
+    cairo_paint( context );
+    cairo_restore( context );
+}
+
+
 void CAIRO_COMPOSITOR::clean()
 {
     CAIRO_BUFFERS::const_iterator it;
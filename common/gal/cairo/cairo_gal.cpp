@@ -31,12 +31,14 @@
 
 #include <gal/cairo/cairo_gal.h>
 #include <gal/cairo/cairo_compositor.h>
+#include <gal/cairo/cairo_tile_gal.h>
 #include <gal/definitions.h>
 #include <geometry/shape_poly_set.h>
 #include <math/util.h>      // for KiROUND
 #include <bitmap_base.h>
 
 #include <limits>
+#include <thread>
 
 #include <pixman.h>
 
@@ -52,6 +54,7 @@ CAIRO_GAL_BASE::CAIRO_GAL_BASE( GAL_DISPLAY_OPTIONS& aDisplayOptions ) :
     isElementAdded      = false;
     groupCounter        = 0;
     currentGroup        = nullptr;
+    groupOwner          = this;
 
     lineWidth = 1.0;
     linePixelWidth = 1.0;
@@ -780,8 +783,12 @@ void CAIRO_GAL_BASE::DrawGroup( int aGroupNumber )
 
     storePath();
 
-    for( GROUP::iterator it = groups[aGroupNumber].begin();
-         it != groups[aGroupNumber].end(); ++it )
+    auto group = groupOwner->groups.find( aGroupNumber );
+
+    if( group == groupOwner->groups.end() )
+        return;
+
+    for( GROUP::const_iterator it = group->second.begin(); it != group->second.end(); ++it )
     {
         switch( it->command )
         {
@@ -1212,6 +1219,9 @@ CAIRO_GAL::CAIRO_GAL( GAL_DISPLAY_OPTIONS& aDisplayOptions,
     validCompositor     = false;
     SetTarget( TARGET_NONCACHED );
 
+    tiledRendering      = true;
+    tileCount           = 0;
+
     parentWindow  = aParent;
     mouseListener = aMouseListener;
     paintListener = aPaintListener;
@@ -1405,6 +1415,84 @@ void CAIRO_GAL::ClearTarget( RENDER_TARGET aTarget )
 }
 
 
+int CAIRO_GAL::BeginTiles()
+{
+    // Tiles smaller than this cost more in drawing the items crossing them than they save
+    const int minTileSize = 64;
+
+    int threadCount = std::thread::hardware_concurrency();
+
+    tileCount = 0;
+
+    if( !tiledRendering || !validCompositor || !isInitialized || threadCount < 2 )
+        return 0;
+
+    // A few tiles per thread balance the load, as some parts of the screen are denser
+    int columns = std::max( 1, KiROUND( sqrt( 2.0 * threadCount ) ) );
+    int rows = ( 2 * threadCount + columns - 1 ) / columns;
+    int tileWidth = ( screenSize.x + columns - 1 ) / columns;
+    int tileHeight = ( screenSize.y + rows - 1 ) / rows;
+
+    if( tileWidth < minTileSize || tileHeight < minTileSize )
+        return 0;
+
+    // Tiles use the antialiasing mode of the compositor buffers
+    cairo_antialias_t antialias = cairo_get_antialias( currentContext );
+
+    for( int row = 0; row < rows; ++row )
+    {
+        for( int col = 0; col < columns; ++col )
+        {
+            VECTOR2I origin( col * tileWidth, row * tileHeight );
+            VECTOR2I size( std::min( tileWidth, screenSize.x - origin.x ),
+                           std::min( tileHeight, screenSize.y - origin.y ) );
+
+            if( size.x <= 0 || size.y <= 0 )
+                continue;
+
+            if( tileCount == (int) tiles.size() )
+                tiles.emplace_back( new CAIRO_TILE_GAL( options, this ) );
+
+            tiles[tileCount++]->BeginTile( BOX2I( origin, size ), antialias );
+        }
+    }
+
+    return tileCount;
+}
+
+
+GAL* CAIRO_GAL::GetTile( int aIndex )
+{
+    wxASSERT( aIndex >= 0 && aIndex < tileCount );
+
+    return tiles[aIndex].get();
+}
+
+
+BOX2I CAIRO_GAL::GetTileRect( int aIndex ) const
+{
+    wxASSERT( aIndex >= 0 && aIndex < tileCount );
+
+    return tiles[aIndex]->GetRect();
+}
+
+
+void CAIRO_GAL::EndTiles()
+{
+    storePath();
+
+    for( int i = 0; i < tileCount; ++i )
+    {
+        const BOX2I& rect = tiles[i]->GetRect();
+
+        tiles[i]->EndTile();
+        compositor->DrawTile( tiles[i]->GetSurface(), rect.GetX(), rect.GetY() );
+    }
+
+    tileCount = 0;
+}
+
+
 void CAIRO_GAL::initSurface()
 {
     if( isInitialized )
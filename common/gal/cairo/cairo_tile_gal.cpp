@@ -0,0 +1,103 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <gal/cairo/cairo_tile_gal.h>
+
+using namespace KIGFX;
+
+
+CAIRO_TILE_GAL::CAIRO_TILE_GAL( GAL_DISPLAY_OPTIONS& aDisplayOptions, CAIRO_GAL_BASE* aParent ) :
+    CAIRO_GAL_BASE( aDisplayOptions ),
+    m_parent( aParent ),
+    m_groupDepth( 0 )
+{
+    if( m_parent )
+        groupOwner = m_parent;
+}
+
+
+void CAIRO_TILE_GAL::BeginTile( const BOX2I& aRect, cairo_antialias_t aAntialias )
+{
+    if( m_parent )
+        CopyViewParameters( *m_parent );
+
+    if( !surface || aRect.GetSize() != m_rect.GetSize() )
+    {
+        if( context )
+            cairo_destroy( context );
+
+        if( surface )
+            cairo_surface_destroy( surface );
+
+        surface = cairo_image_surface_create( GAL_FORMAT, aRect.GetWidth(), aRect.GetHeight() );
+        context = cairo_create( surface );
+    }
+
+    m_rect = aRect;
+    m_groupDepth = 0;
+    currentContext = context;
+
+    cairo_set_antialias( context, aAntialias );
+    cairo_set_operator( context, CAIRO_OPERATOR_OVER );
+
+    resetContext();
+
+    // Shift the screen, so the tile corner is the origin of the tile surface
+    cairo_matrix_t offset;
+    cairo_matrix_init_translate( &offset, -aRect.GetX(), -aRect.GetY() );
+    cairo_matrix_multiply( &cairoWorldScreenMatrix, &cairoWorldScreenMatrix, &offset );
+    updateWorldScreenMatrix();
+}
+
+
+void CAIRO_TILE_GAL::EndTile()
+{
+    Flush();
+    cairo_surface_flush( surface );
+}
+
+
+void CAIRO_TILE_GAL::ClearScreen()
+{
+    // Tiles are composited over the parent buffer, so the background stays transparent
+    cairo_save( currentContext );
+    cairo_set_operator( currentContext, CAIRO_OPERATOR_CLEAR );
+    cairo_paint( currentContext );
+    cairo_restore( currentContext );
+}
+
+
+void CAIRO_TILE_GAL::DrawGroup( int aGroupNumber )
+{
+    // Cached paths are stored in the screen coordinates of the parent GAL
+    if( m_groupDepth++ == 0 )
+    {
+        storePath();
+        cairo_translate( currentContext, -m_rect.GetX(), -m_rect.GetY() );
+    }
+
+    CAIRO_GAL_BASE::DrawGroup( aGroupNumber );
+
+    if( --m_groupDepth == 0 )
+        cairo_translate( currentContext, m_rect.GetX(), m_rect.GetY() );
+}
@@ -207,6 +207,23 @@ void GAL::ComputeWorldScreenMatrix()
 }
 
 
+void GAL::CopyViewParameters( const GAL& aGal )
+{
+    screenSize        = aGal.screenSize;
+    worldUnitLength   = aGal.worldUnitLength;
+    screenDPI         = aGal.screenDPI;
+    lookAtPoint       = aGal.lookAtPoint;
+    zoomFactor        = aGal.zoomFactor;
+    rotation          = aGal.rotation;
+    worldScreenMatrix = aGal.worldScreenMatrix;
+    screenWorldMatrix = aGal.screenWorldMatrix;
+    worldScale        = aGal.worldScale;
+    globalFlipX       = aGal.globalFlipX;
+    globalFlipY       = aGal.globalFlipY;
+    depthRange        = aGal.depthRange;
+}
+
+
 double GAL::computeMinGridSpacing() const
 {
     // just return the current value. This could be cleverer and take
@@ -34,6 +34,7 @@
 #include <gal/opengl/vertex_item.h>
 #include <gal/opengl/utils.h>
 
+#include <algorithm>
 #include <list>
 #include <cassert>
 
@@ -282,10 +283,9 @@ bool CACHED_CONTAINER::reallocate( unsigned int aSize )
 void CACHED_CONTAINER::defragment( VERTEX* aTarget )
 {
     // Defragmentation
-    ITEMS::iterator it, it_end;
     int newOffset = 0;
 
-    for( VERTEX_ITEM* item : m_items )
+    for( VERTEX_ITEM* item : itemsByOffset() )
     {
         int itemOffset    = item->GetOffset();
         int itemSize      = item->GetSize();
@@ -313,6 +313,20 @@ void CACHED_CONTAINER::defragment( VERTEX* aTarget )
 }
 
 
+std::vector<VERTEX_ITEM*> CACHED_CONTAINER::itemsByOffset() const
+{
+    std::vector<VERTEX_ITEM*> items( m_items.begin(), m_items.end() );
+
+    std::sort( items.begin(), items.end(),
+               []( const VERTEX_ITEM* aFirst, const VERTEX_ITEM* aSecond )
+               {
+                   return aFirst->GetOffset() < aSecond->GetOffset();
+               } );
+
+    return items;
+}
+
+
 void CACHED_CONTAINER::mergeFreeChunks()
 {
     if( m_freeChunks.size() <= 1 ) // There are no chunks that can be merged
@@ -132,13 +132,11 @@ bool CACHED_CONTAINER_GPU::defragmentResize( unsigned int aNewSize )
     glBufferData( GL_ELEMENT_ARRAY_BUFFER, aNewSize * VERTEX_SIZE, NULL, GL_DYNAMIC_DRAW );
     checkGlError( "creating buffer during defragmentation" );
 
-    ITEMS::iterator it, it_end;
     int newOffset = 0;
 
     // Defragmentation
-    for( it = m_items.begin(), it_end = m_items.end(); it != it_end; ++it )
+    for( VERTEX_ITEM* item : itemsByOffset() )
     {
-        VERTEX_ITEM* item = *it;
         int itemOffset    = item->GetOffset();
         int itemSize      = item->GetSize();
 
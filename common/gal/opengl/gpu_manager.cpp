@@ -39,6 +39,13 @@
 
 using namespace KIGFX;
 
+/**
+ * Minimal average size of the ranges of vertices drawn with a single glMultiDrawArrays() call.
+ * Drawing many tiny ranges is faster with an index buffer, as the drivers (especially software
+ * ones) process each range of a multi-draw call separately.
+ */
+static const unsigned int MULTI_DRAW_MIN_RANGE_SIZE = 64;
+
 GPU_MANAGER* GPU_MANAGER::MakeManager( VERTEX_CONTAINER* aContainer )
 {
     if( aContainer->IsCached() )
@@ -74,7 +81,7 @@ void GPU_MANAGER::SetShader( SHADER& aShader )
 // Cached manager
 GPU_CACHED_MANAGER::GPU_CACHED_MANAGER( VERTEX_CONTAINER* aContainer ) :
     GPU_MANAGER( aContainer ), m_buffersInitialized( false ), m_indicesPtr( NULL ),
-    m_indicesBuffer( 0 ), m_indicesSize( 0 ), m_indicesCapacity( 0 )
+    m_indicesBuffer( 0 ), m_indicesSize( 0 ), m_indicesCapacity( 0 ), m_itemCount( 0 )
 {
     // Allocate the biggest possible buffer for indices
     resizeIndices( aContainer->GetSize() );
@@ -107,8 +114,9 @@ void GPU_CACHED_MANAGER::BeginDrawing()
 
     // Number of vertices to be drawn in the EndDrawing()
     m_indicesSize = 0;
-    // Set the indices pointer to the beginning of the indices-to-draw buffer
-    m_indicesPtr = m_indices.get();
+    m_itemCount = 0;
+    m_rangeOffsets.clear();
+    m_rangeSizes.clear();
 
     m_isDrawing = true;
 }
@@ -118,8 +126,23 @@ void GPU_CACHED_MANAGER::DrawIndices( unsigned int aOffset, unsigned int aSize )
 {
     wxASSERT( m_isDrawing );
 
-    // Copy indices of items that should be drawn to GPU memory
-    for( unsigned int i = aOffset; i < aOffset + aSize; *m_indicesPtr++ = i++ );
+    m_itemCount++;
+
+    if( aSize == 0 )
+        return;
+
+    // Items cached one after another are usually drawn one after another too, so their
+    // vertices are drawn as a single range
+    if( !m_rangeOffsets.empty()
+            && (unsigned int) ( m_rangeOffsets.back() + m_rangeSizes.back() ) == aOffset )
+    {
+        m_rangeSizes.back() += aSize;
+    }
+    else
+    {
+        m_rangeOffsets.push_back( aOffset );
+        m_rangeSizes.push_back( aSize );
+    }
 
     m_indicesSize += aSize;
 }
@@ -129,7 +152,8 @@ void GPU_CACHED_MANAGER::DrawAll()
 {
     wxASSERT( m_isDrawing );
 
-    for( unsigned int i = 0; i < m_indicesSize; *m_indicesPtr++ = i++ );
+    m_rangeOffsets.assign( 1, 0 );
+    m_rangeSizes.assign( 1, m_container->GetSize() );
 
     m_indicesSize = m_container->GetSize();
 }
@@ -176,14 +200,26 @@ void GPU_CACHED_MANAGER::EndDrawing()
                                VERTEX_SIZE, (GLvoid*) SHADER_OFFSET );
     }
 
-    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_indicesBuffer );
-    glBufferData( GL_ELEMENT_ARRAY_BUFFER, m_indicesSize * sizeof(int),
-            (GLvoid*) m_indices.get(), GL_DYNAMIC_DRAW );
+    bool multiDraw = m_rangeOffsets.size() * MULTI_DRAW_MIN_RANGE_SIZE <= m_indicesSize;
+
+    if( multiDraw )
+    {
+        glMultiDrawArrays( GL_TRIANGLES, m_rangeOffsets.data(), m_rangeSizes.data(),
+                           m_rangeOffsets.size() );
+    }
+    else
+    {
+        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_indicesBuffer );
+        uploadIndices();
 
-    glDrawElements( GL_TRIANGLES, m_indicesSize, GL_UNSIGNED_INT, 0 );
+        glDrawElements( GL_TRIANGLES, m_indicesSize, GL_UNSIGNED_INT, 0 );
+    }
 
 #ifdef __WXDEBUG__
     wxLogTrace( "GAL_PROFILE", wxT( "Cached manager size: %d" ), m_indicesSize );
+    wxLogTrace( "GAL_PROFILE", wxT( "Cached manager: %u groups drawn as %u ranges with %s" ),
+                m_itemCount, (unsigned int) m_rangeOffsets.size(),
+                multiDraw ? wxT( "glMultiDrawArrays()" ) : wxT( "glDrawElements()" ) );
 #endif /* __WXDEBUG__ */
 
     glBindBuffer( GL_ARRAY_BUFFER, 0 );
@@ -210,6 +246,31 @@ void GPU_CACHED_MANAGER::EndDrawing()
 }
 
 
+void GPU_CACHED_MANAGER::uploadIndices()
+{
+    // The same items are drawn by most frames, so the buffer is filled only when they change
+    if( m_rangeOffsets == m_uploadedOffsets && m_rangeSizes == m_uploadedSizes )
+        return;
+
+    resizeIndices( m_indicesSize );
+    m_indicesPtr = m_indices.get();
+
+    for( size_t i = 0; i < m_rangeOffsets.size(); ++i )
+    {
+        GLuint offset = m_rangeOffsets[i];
+        GLuint end = offset + m_rangeSizes[i];
+
+        for( GLuint index = offset; index < end; *m_indicesPtr++ = index++ );
+    }
+
+    glBufferData( GL_ELEMENT_ARRAY_BUFFER, m_indicesSize * sizeof(int),
+            (GLvoid*) m_indices.get(), GL_DYNAMIC_DRAW );
+
+    m_uploadedOffsets = m_rangeOffsets;
+    m_uploadedSizes = m_rangeSizes;
+}
+
+
 void GPU_CACHED_MANAGER::resizeIndices( unsigned int aNewSize )
 {
     if( aNewSize > m_indicesCapacity )
@@ -0,0 +1,463 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <gal/recording_gal.h>
+
+using namespace KIGFX;
+
+// Flags of the text attributes recorded with CMD_BITMAP_TEXT
+static const int TEXT_BOLD = 1;
+static const int TEXT_ITALIC = 2;
+static const int TEXT_MIRRORED = 4;
+
+
+RECORDING_GAL::RECORDING_GAL( GAL_DISPLAY_OPTIONS& aDisplayOptions, GAL* aTarget ) :
+    GAL( aDisplayOptions )
+{
+    CopyViewParameters( *aTarget );
+
+    m_isOpenGl = aTarget->IsOpenGlEngine();
+    m_isCairo = aTarget->IsCairoEngine();
+}
+
+
+void RECORDING_GAL::Clear()
+{
+    m_commands.clear();
+    m_pointLists.clear();
+    m_lineChains.clear();
+    m_polySets.clear();
+    m_matrices.clear();
+    m_texts.clear();
+    m_bitmaps.clear();
+}
+
+
+void RECORDING_GAL::BeginRecording( double aLayerDepth )
+{
+    GAL::SetLayerDepth( aLayerDepth );
+
+    addCommand( CMD_IS_FILL ).m_values[0] = isFillEnabled;
+    addCommand( CMD_IS_STROKE ).m_values[0] = isStrokeEnabled;
+    addColor( CMD_FILL_COLOR, fillColor );
+    addColor( CMD_STROKE_COLOR, strokeColor );
+    addCommand( CMD_LINE_WIDTH ).m_values[0] = lineWidth;
+}
+
+
+RECORDING_GAL::COMMAND& RECORDING_GAL::addCommand( COMMAND_TYPE aType )
+{
+    m_commands.emplace_back();
+
+    COMMAND& cmd = m_commands.back();
+    cmd.m_type = aType;
+    cmd.m_index = 0;
+    cmd.m_count = 0;
+
+    return cmd;
+}
+
+
+void RECORDING_GAL::addColor( COMMAND_TYPE aType, const COLOR4D& aColor )
+{
+    COMMAND& cmd = addCommand( aType );
+
+    cmd.m_values[0] = aColor.r;
+    cmd.m_values[1] = aColor.g;
+    cmd.m_values[2] = aColor.b;
+    cmd.m_values[3] = aColor.a;
+}
+
+
+template <typename T>
+void RECORDING_GAL::addPoints( COMMAND_TYPE aType, const T& aPoints, size_t aCount )
+{
+    COMMAND& cmd = addCommand( aType );
+
+    cmd.m_index = m_pointLists.size();
+    cmd.m_count = aCount;
+
+    for( size_t i = 0; i < aCount; ++i )
+        m_pointLists.push_back( aPoints[i] );
+}
+
+
+void RECORDING_GAL::DrawLine( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint )
+{
+    COMMAND& cmd = addCommand( CMD_LINE );
+    cmd.m_points[0] = aStartPoint;
+    cmd.m_points[1] = aEndPoint;
+}
+
+
+void RECORDING_GAL::DrawSegment( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint,
+                                 double aWidth )
+{
+    COMMAND& cmd = addCommand( CMD_SEGMENT );
+    cmd.m_points[0] = aStartPoint;
+    cmd.m_points[1] = aEndPoint;
+    cmd.m_values[0] = aWidth;
+}
+
+
+void RECORDING_GAL::DrawPolyline( const std::deque<VECTOR2D>& aPointList )
+{
+    addPoints( CMD_POLYLINE, aPointList, aPointList.size() );
+}
+
+
+void RECORDING_GAL::DrawPolyline( const VECTOR2D aPointList[], int aListSize )
+{
+    addPoints( CMD_POLYLINE, aPointList, aListSize );
+}
+
+
+void RECORDING_GAL::DrawPolyline( const SHAPE_LINE_CHAIN& aLineChain )
+{
+    addCommand( CMD_POLYLINE_CHAIN ).m_index = m_lineChains.size();
+    m_lineChains.push_back( aLineChain );
+}
+
+
+void RECORDING_GAL::DrawCircle( const VECTOR2D& aCenterPoint, double aRadius )
+{
+    COMMAND& cmd = addCommand( CMD_CIRCLE );
+    cmd.m_points[0] = aCenterPoint;
+    cmd.m_values[0] = aRadius;
+}
+
+
+void RECORDING_GAL::DrawArc( const VECTOR2D& aCenterPoint, double aRadius, double aStartAngle,
+                             double aEndAngle )
+{
+    COMMAND& cmd = addCommand( CMD_ARC );
+    cmd.m_points[0] = aCenterPoint;
+    cmd.m_values[0] = aRadius;
+    cmd.m_values[1] = aStartAngle;
+    cmd.m_values[2] = aEndAngle;
+}
+
+
+void RECORDING_GAL::DrawArcSegment( const VECTOR2D& aCenterPoint, double aRadius,
+                                    double aStartAngle, double aEndAngle, double aWidth )
+{
+    COMMAND& cmd = addCommand( CMD_ARC_SEGMENT );
+    cmd.m_points[0] = aCenterPoint;
+    cmd.m_values[0] = aRadius;
+    cmd.m_values[1] = aStartAngle;
+    cmd.m_values[2] = aEndAngle;
+    cmd.m_values[3] = aWidth;
+}
+
+
+void RECORDING_GAL::DrawRectangle( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint )
+{
+    COMMAND& cmd = addCommand( CMD_RECTANGLE );
+    cmd.m_points[0] = aStartPoint;
+    cmd.m_points[1] = aEndPoint;
+}
+
+
+void RECORDING_GAL::DrawPolygon( const std::deque<VECTOR2D>& aPointList )
+{
+    addPoints( CMD_POLYGON, aPointList, aPointList.size() );
+}
+
+
+void RECORDING_GAL::DrawPolygon( const VECTOR2D aPointList[], int aListSize )
+{
+    addPoints( CMD_POLYGON, aPointList, aListSize );
+}
+
+
+void RECORDING_GAL::DrawPolygon( const SHAPE_POLY_SET& aPolySet )
+{
+    // The copy keeps the triangulation cached by the painter, if any
+    addCommand( CMD_POLYGON_SET ).m_index = m_polySets.size();
+    m_polySets.emplace_back( aPolySet );
+}
+
+
+void RECORDING_GAL::DrawPolygon( const SHAPE_LINE_CHAIN& aPolySet )
+{
+    addCommand( CMD_POLYGON_CHAIN ).m_index = m_lineChains.size();
+    m_lineChains.push_back( aPolySet );
+}
+
+
+void RECORDING_GAL::DrawCurve( const VECTOR2D& aStartPoint, const VECTOR2D& aControlPointA,
+                               const VECTOR2D& aControlPointB, const VECTOR2D& aEndPoint,
+                               double aFilterValue )
+{
+    const VECTOR2D points[] = { aStartPoint, aControlPointA, aControlPointB, aEndPoint };
+
+    addPoints( CMD_CURVE, points, 4 );
+    m_commands.back().m_values[0] = aFilterValue;
+}
+
+
+void RECORDING_GAL::DrawBitmap( const BITMAP_BASE& aBitmap )
+{
+    addCommand( CMD_BITMAP ).m_index = m_bitmaps.size();
+    m_bitmaps.push_back( &aBitmap );
+}
+
+
+void RECORDING_GAL::BitmapText( const wxString& aText, const VECTOR2D& aPosition,
+                                double aRotationAngle )
+{
+    // Bitmap texts are drawn differently by each GAL, so the target has to draw them
+    COMMAND& cmd = addCommand( CMD_BITMAP_TEXT );
+    cmd.m_index = m_texts.size();
+    cmd.m_points[0] = aPosition;
+    cmd.m_points[1] = GetGlyphSize();
+    cmd.m_values[0] = aRotationAngle;
+    cmd.m_values[1] = GetHorizontalJustify();
+    cmd.m_values[2] = GetVerticalJustify();
+    cmd.m_values[3] = ( IsFontBold() ? TEXT_BOLD : 0 ) | ( IsFontItalic() ? TEXT_ITALIC : 0 )
+                      | ( IsTextMirrored() ? TEXT_MIRRORED : 0 );
+
+    m_texts.push_back( aText );
+}
+
+
+void RECORDING_GAL::SetIsFill( bool aIsFillEnabled )
+{
+    GAL::SetIsFill( aIsFillEnabled );
+    addCommand( CMD_IS_FILL ).m_values[0] = aIsFillEnabled;
+}
+
+
+void RECORDING_GAL::SetIsStroke( bool aIsStrokeEnabled )
+{
+    GAL::SetIsStroke( aIsStrokeEnabled );
+    addCommand( CMD_IS_STROKE ).m_values[0] = aIsStrokeEnabled;
+}
+
+
+void RECORDING_GAL::SetFillColor( const COLOR4D& aColor )
+{
+    GAL::SetFillColor( aColor );
+    addColor( CMD_FILL_COLOR, aColor );
+}
+
+
+void RECORDING_GAL::SetStrokeColor( const COLOR4D& aColor )
+{
+    GAL::SetStrokeColor( aColor );
+    addColor( CMD_STROKE_COLOR, aColor );
+}
+
+
+void RECORDING_GAL::SetLineWidth( float aLineWidth )
+{
+    GAL::SetLineWidth( aLineWidth );
+    addCommand( CMD_LINE_WIDTH ).m_values[0] = aLineWidth;
+}
+
+
+void RECORDING_GAL::SetLayerDepth( double aLayerDepth )
+{
+    GAL::SetLayerDepth( aLayerDepth );
+    addCommand( CMD_LAYER_DEPTH ).m_values[0] = aLayerDepth;
+}
+
+
+void RECORDING_GAL::SetNegativeDrawMode( bool aSetting )
+{
+    addCommand( CMD_NEGATIVE_DRAW_MODE ).m_values[0] = aSetting;
+}
+
+
+void RECORDING_GAL::Transform( const MATRIX3x3D& aTransformation )
+{
+    addCommand( CMD_TRANSFORM ).m_index = m_matrices.size();
+    m_matrices.push_back( aTransformation );
+}
+
+
+void RECORDING_GAL::Rotate( double aAngle )
+{
+    addCommand( CMD_ROTATE ).m_values[0] = aAngle;
+}
+
+
+void RECORDING_GAL::Translate( const VECTOR2D& aTranslation )
+{
+    addCommand( CMD_TRANSLATE ).m_points[0] = aTranslation;
+}
+
+
+void RECORDING_GAL::Scale( const VECTOR2D& aScale )
+{
+    addCommand( CMD_SCALE ).m_points[0] = aScale;
+}
+
+
+void RECORDING_GAL::Save()
+{
+    addCommand( CMD_SAVE );
+}
+
+
+void RECORDING_GAL::Restore()
+{
+    addCommand( CMD_RESTORE );
+}
+
+
+void RECORDING_GAL::Replay( GAL* aGal, size_t aBegin, size_t aEnd ) const
+{
+    for( size_t i = aBegin; i < aEnd; ++i )
+    {
+        const COMMAND& cmd = m_commands[i];
+
+        switch( cmd.m_type )
+        {
+        case CMD_LINE:
+            aGal->DrawLine( cmd.m_points[0], cmd.m_points[1] );
+            break;
+
+        case CMD_SEGMENT:
+            aGal->DrawSegment( cmd.m_points[0], cmd.m_points[1], cmd.m_values[0] );
+            break;
+
+        case CMD_POLYLINE:
+            aGal->DrawPolyline( &m_pointLists[cmd.m_index], (int) cmd.m_count );
+            break;
+
+        case CMD_POLYLINE_CHAIN:
+            aGal->DrawPolyline( m_lineChains[cmd.m_index] );
+            break;
+
+        case CMD_CIRCLE:
+            aGal->DrawCircle( cmd.m_points[0], cmd.m_values[0] );
+            break;
+
+        case CMD_ARC:
+            aGal->DrawArc( cmd.m_points[0], cmd.m_values[0], cmd.m_values[1], cmd.m_values[2] );
+            break;
+
+        case CMD_ARC_SEGMENT:
+            aGal->DrawArcSegment( cmd.m_points[0], cmd.m_values[0], cmd.m_values[1],
+                                  cmd.m_values[2], cmd.m_values[3] );
+            break;
+
+        case CMD_RECTANGLE:
+            aGal->DrawRectangle( cmd.m_points[0], cmd.m_points[1] );
+            break;
+
+        case CMD_POLYGON:
+            aGal->DrawPolygon( &m_pointLists[cmd.m_index], (int) cmd.m_count );
+            break;
+
+        case CMD_POLYGON_SET:
+            aGal->DrawPolygon( m_polySets[cmd.m_index] );
+            break;
+
+        case CMD_POLYGON_CHAIN:
+            aGal->DrawPolygon( m_lineChains[cmd.m_index] );
+            break;
+
+        case CMD_CURVE:
+        {
+            const VECTOR2D* points = &m_pointLists[cmd.m_index];
+
+            aGal->DrawCurve( points[0], points[1], points[2], points[3], cmd.m_values[0] );
+        }
+            break;
+
+        case CMD_BITMAP:
+            aGal->DrawBitmap( *m_bitmaps[cmd.m_index] );
+            break;
+
+        case CMD_BITMAP_TEXT:
+        {
+            int flags = (int) cmd.m_values[3];
+
+            aGal->SetGlyphSize( cmd.m_points[1] );
+            aGal->SetHorizontalJustify( (EDA_TEXT_HJUSTIFY_T) (int) cmd.m_values[1] );
+            aGal->SetVerticalJustify( (EDA_TEXT_VJUSTIFY_T) (int) cmd.m_values[2] );
+            aGal->SetFontBold( flags & TEXT_BOLD );
+            aGal->SetFontItalic( flags & TEXT_ITALIC );
+            aGal->SetTextMirrored( flags & TEXT_MIRRORED );
+            aGal->BitmapText( m_texts[cmd.m_index], cmd.m_points[0], cmd.m_values[0] );
+        }
+            break;
+
+        case CMD_IS_FILL:
+            aGal->SetIsFill( cmd.m_values[0] != 0.0 );
+            break;
+
+        case CMD_IS_STROKE:
+            aGal->SetIsStroke( cmd.m_values[0] != 0.0 );
+            break;
+
+        case CMD_FILL_COLOR:
+            aGal->SetFillColor( COLOR4D( cmd.m_values[0], cmd.m_values[1], cmd.m_values[2],
+                                         cmd.m_values[3] ) );
+            break;
+
+        case CMD_STROKE_COLOR:
+            aGal->SetStrokeColor( COLOR4D( cmd.m_values[0], cmd.m_values[1], cmd.m_values[2],
+                                           cmd.m_values[3] ) );
+            break;
+
+        case CMD_LINE_WIDTH:
+            aGal->SetLineWidth( (float) cmd.m_values[0] );
+            break;
+
+        case CMD_LAYER_DEPTH:
+            aGal->SetLayerDepth( cmd.m_values[0] );
+            break;
+
+        case CMD_NEGATIVE_DRAW_MODE:
+            aGal->SetNegativeDrawMode( cmd.m_values[0] != 0.0 );
+            break;
+
+        case CMD_TRANSFORM:
+            aGal->Transform( m_matrices[cmd.m_index] );
+            break;
+
+        case CMD_ROTATE:
+            aGal->Rotate( cmd.m_values[0] );
+            break;
+
+        case CMD_TRANSLATE:
+            aGal->Translate( cmd.m_points[0] );
+            break;
+
+        case CMD_SCALE:
+            aGal->Scale( cmd.m_points[0] );
+            break;
+
+        case CMD_SAVE:
+            aGal->Save();
+            break;
+
+        case CMD_RESTORE:
+            aGal->Restore();
+            break;
+        }
+    }
+}
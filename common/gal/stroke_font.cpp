@@ -32,6 +32,8 @@
 #include <wx/string.h>
 #include <gr_text.h>
 
+#include <mutex>
+
 
 using namespace KIGFX;
 
@@ -44,6 +46,7 @@ const double STROKE_FONT::ITALIC_TILT = 1.0 / 8;
 
 GLYPH_LIST*         g_newStrokeFontGlyphs = nullptr;     ///< Glyph list
 std::vector<BOX2D>* g_newStrokeFontGlyphBoundingBoxes;   ///< Bounding boxes of the glyphs
+static std::mutex   s_newStrokeFontMutex;                ///< GALs can be created by any thread
 
 
 STROKE_FONT::STROKE_FONT( GAL* aGal ) :
@@ -54,6 +57,8 @@ STROKE_FONT::STROKE_FONT( GAL* aGal ) :
 
 bool STROKE_FONT::LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNewStrokeFontSize )
 {
+    std::lock_guard<std::mutex> lock( s_newStrokeFontMutex );
+
     if( g_newStrokeFontGlyphs )
     {
         m_glyphs = g_newStrokeFontGlyphs;
@@ -504,12 +509,13 @@ double STROKE_FONT::computeOverbarVerticalPosition() const
 
 VECTOR2D STROKE_FONT::computeTextLineSize( const UTF8& aText ) const
 {
-    return ComputeStringBoundaryLimits( aText, m_gal->GetGlyphSize(), m_gal->GetLineWidth() );
+    return ComputeStringBoundaryLimits( aText, m_gal->GetGlyphSize(), m_gal->GetLineWidth(),
+                                        m_gal->IsFontItalic() );
 }
 
 
 VECTOR2D STROKE_FONT::ComputeStringBoundaryLimits( const UTF8& aText, const VECTOR2D& aGlyphSize,
-                                                   double aGlyphThickness ) const
+                                                   double aGlyphThickness, bool aItalic ) const
 {
     VECTOR2D string_bbox;
     int line_count = 1;
@@ -607,7 +613,7 @@ VECTOR2D STROKE_FONT::ComputeStringBoundaryLimits( const UTF8& aText, const VECT
     string_bbox.y = line_count * GetInterline( aGlyphSize.y );
 
     // For italic correction, take in account italic tilt
-    if( m_gal->IsFontItalic() )
+    if( aItalic )
         string_bbox.x += string_bbox.y * STROKE_FONT::ITALIC_TILT;
 
     return string_bbox;
@@ -42,6 +42,7 @@
 #include <build_version.h>
 
 #include <gbr_metadata.h>
+#include <plot_output_buffer.h>
 
 
 GERBER_PLOTTER::GERBER_PLOTTER()
@@ -100,8 +101,21 @@ void GERBER_PLOTTER::SetGerberCoordinatesFormat( int aResolution, bool aUseInche
 
 void GERBER_PLOTTER::emitDcode( const DPOINT& pt, int dcode )
 {
+    PLOT_OUTPUT_BUFFER output( outputFile );
 
-    fprintf( outputFile, "X%dY%dD%02d*\n", KiROUND( pt.x ), KiROUND( pt.y ), dcode );
+    emitDcode( output, pt, dcode );
+}
+
+
+void GERBER_PLOTTER::emitDcode( PLOT_OUTPUT_BUFFER& aOutput, const DPOINT& pt, int dcode )
+{
+    // Same as "X%dY%dD%02d*\n", but much faster
+    aOutput.Char( 'X' ).Int( KiROUND( pt.x ) ).Char( 'Y' ).Int( KiROUND( pt.y ) ).Char( 'D' );
+
+    if( dcode >= 0 && dcode < 10 )
+        aOutput.Char( '0' );
+
+    aOutput.Int( dcode ).Text( "*\n" );
 }
 
 void GERBER_PLOTTER::ClearAllAttributes()
@@ -196,6 +210,8 @@ bool GERBER_PLOTTER::StartPlot()
     if( outputFile == NULL )
         return false;
 
+    setvbuf( outputFile, NULL, _IOFBF, PLOT_OUTPUT_BUFFER::FILE_BUFFER_SIZE );
+
     for( unsigned ii = 0; ii < m_headerExtraLines.GetCount(); ii++ )
     {
         if( ! m_headerExtraLines[ii].IsEmpty() )
@@ -339,7 +355,8 @@ void GERBER_PLOTTER::selectAperture( const wxSize&           aSize,
     {
         // Pick an existing aperture or create a new one
         m_currentApertureIdx = GetOrCreateAperture( aSize, aType, aApertureAttribute );
-        fprintf( outputFile, "D%d*\n", m_apertures[m_currentApertureIdx].m_DCode );
+        PLOT_OUTPUT_BUFFER output( outputFile );
+        output.Char( 'D' ).Int( m_apertures[m_currentApertureIdx].m_DCode ).Text( "*\n" );
     }
 }
 
@@ -534,9 +551,13 @@ void GERBER_PLOTTER::plotArc( const wxPoint& aCenter, double aStAngle, double aE
     else
         fprintf( outputFile, "G02*\n" );    // Active circular interpolation, CW
 
-    fprintf( outputFile, "X%dY%dI%dJ%dD01*\n",
-             KiROUND( devEnd.x ), KiROUND( devEnd.y ),
-             KiROUND( devCenter.x ), KiROUND( devCenter.y ) );
+    {
+        PLOT_OUTPUT_BUFFER output( outputFile );
+
+        output.Char( 'X' ).Int( KiROUND( devEnd.x ) ).Char( 'Y' ).Int( KiROUND( devEnd.y ) )
+              .Char( 'I' ).Int( KiROUND( devCenter.x ) ).Char( 'J' ).Int( KiROUND( devCenter.y ) )
+              .Text( "D01*\n" );
+    }
 
     fprintf( outputFile, "G01*\n" ); // Back to linear interpol (perhaps useless here).
 }
@@ -595,36 +616,48 @@ void GERBER_PLOTTER::PlotPoly( const std::vector< wxPoint >& aCornerList,
 
     if( aFill )
     {
-        fputs( "G36*\n", outputFile );
+        // Same as MoveTo() and LineTo() for each corner, but buffered (regions of filled zones
+        // can have a huge number of vertices)
+        PLOT_OUTPUT_BUFFER output( outputFile );
 
-        MoveTo( aCornerList[0] );
-        fputs( "G01*\n", outputFile );      // Set linear interpolation.
+        output.Text( "G36*\n" );
+
+        emitDcode( output, userToDeviceCoordinates( aCornerList[0] ), 2 );
+        output.Text( "G01*\n" );      // Set linear interpolation.
 
         for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
-            LineTo( aCornerList[ii] );
+            emitDcode( output, userToDeviceCoordinates( aCornerList[ii] ), 1 );
+
+        penState = 'D';
 
         // If the polygon is not closed, close it:
         if( aCornerList[0] != aCornerList[aCornerList.size()-1] )
-            FinishTo( aCornerList[0] );
+        {
+            emitDcode( output, userToDeviceCoordinates( aCornerList[0] ), 1 );
+            penState = 'Z';
+        }
 
-        fputs( "G37*\n", outputFile );
+        output.Text( "G37*\n" );
     }
 
     if( aWidth > 0 )    // Draw the polyline/polygon outline
     {
         SetCurrentLineWidth( aWidth, gbr_metadata );
 
-        MoveTo( aCornerList[0] );
+        // The aperture is selected: the outline can be buffered
+        PLOT_OUTPUT_BUFFER output( outputFile );
+
+        emitDcode( output, userToDeviceCoordinates( aCornerList[0] ), 2 );
 
         for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
-            LineTo( aCornerList[ii] );
+            emitDcode( output, userToDeviceCoordinates( aCornerList[ii] ), 1 );
 
         // Ensure the thick outline is closed for filled polygons
         // (if not filled, could be only a polyline)
         if( aFill && ( aCornerList[aCornerList.size()-1] != aCornerList[0] ) )
-            LineTo( aCornerList[0] );
+            emitDcode( output, userToDeviceCoordinates( aCornerList[0] ), 1 );
 
-        PenFinish();
+        penState = 'Z';     // Same as PenFinish()
     }
 }
 
@@ -39,6 +39,7 @@
 #include <wx/zstream.h>
 #include <wx/mstream.h>
 #include <math/util.h>      // for KiROUND
+#include <plot_output_buffer.h>
 
 
 /*
@@ -284,17 +285,20 @@ void PDF_PLOTTER::PlotPoly( const std::vector< wxPoint >& aCornerList,
 
     SetCurrentLineWidth( aWidth );
 
+    // Filled zones can have a huge number of vertices: buffer them
+    PLOT_OUTPUT_BUFFER output( workFile );
+
     DPOINT pos = userToDeviceCoordinates( aCornerList[0] );
-    fprintf( workFile, "%g %g m\n", pos.x, pos.y );
+    output.Significant( pos.x ).Char( ' ' ).Significant( pos.y ).Text( " m\n" );
 
     for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
     {
         pos = userToDeviceCoordinates( aCornerList[ii] );
-        fprintf( workFile, "%g %g l\n", pos.x, pos.y );
+        output.Significant( pos.x ).Char( ' ' ).Significant( pos.y ).Text( " l\n" );
     }
 
     // Close path and stroke(/fill)
-    fprintf( workFile, "%c\n", aFill == NO_FILL ? 'S' : 'b' );
+    output.Char( aFill == NO_FILL ? 'S' : 'b' ).Char( '\n' );
 }
 
 
@@ -315,10 +319,11 @@ void PDF_PLOTTER::PenTo( const wxPoint& pos, char plume )
 
     if( penState != plume || pos != penLastpos )
     {
-        DPOINT pos_dev = userToDeviceCoordinates( pos );
-        fprintf( workFile, "%g %g %c\n",
-                 pos_dev.x, pos_dev.y,
-                 ( plume=='D' ) ? 'l' : 'm' );
+        DPOINT             pos_dev = userToDeviceCoordinates( pos );
+        PLOT_OUTPUT_BUFFER output( workFile );
+
+        output.Significant( pos_dev.x ).Char( ' ' ).Significant( pos_dev.y ).Char( ' ' )
+              .Char( ( plume=='D' ) ? 'l' : 'm' ).Char( '\n' );
     }
     penState   = plume;
     penLastpos = pos;
@@ -488,6 +493,10 @@ int PDF_PLOTTER::startPdfStream(int handle)
     workFilename = filename + wxT(".tmp");
     workFile = wxFopen( workFilename, wxT( "w+b" ));
     wxASSERT( workFile );
+
+    if( workFile )
+        setvbuf( workFile, NULL, _IOFBF, PLOT_OUTPUT_BUFFER::FILE_BUFFER_SIZE );
+
     return handle;
 }
 
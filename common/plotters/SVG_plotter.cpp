@@ -101,6 +101,7 @@
 #include <plotter.h>
 #include <macros.h>
 #include <kicad_string.h>
+#include <plot_output_buffer.h>
 
 #include <cstdint>
 #include <wx/mstream.h>
@@ -581,22 +582,25 @@ void SVG_PLOTTER::PlotPoly( const std::vector<wxPoint>& aCornerList,
         break;
     }
 
+    // Filled zones can have a huge number of vertices: buffer them ("%f,%f\n" for each one)
+    PLOT_OUTPUT_BUFFER output( outputFile );
+
     DPOINT pos = userToDeviceCoordinates( aCornerList[0] );
-    fprintf( outputFile, "d=\"M %f,%f\n", pos.x, pos.y );
+    output.Text( "d=\"M " ).Fixed( pos.x, 6 ).Char( ',' ).Fixed( pos.y, 6 ).Char( '\n' );
 
     for( unsigned ii = 1; ii < aCornerList.size() - 1; ii++ )
     {
         pos = userToDeviceCoordinates( aCornerList[ii] );
-        fprintf( outputFile, "%f,%f\n", pos.x, pos.y );
+        output.Fixed( pos.x, 6 ).Char( ',' ).Fixed( pos.y, 6 ).Char( '\n' );
     }
 
     // If the cornerlist ends where it begins, then close the poly
     if( aCornerList.front() == aCornerList.back() )
-        fprintf( outputFile, "Z\" /> \n" );
+        output.Text( "Z\" /> \n" );
     else
     {
         pos = userToDeviceCoordinates( aCornerList.back() );
-        fprintf( outputFile, "%f,%f\n\" /> \n", pos.x, pos.y );
+        output.Fixed( pos.x, 6 ).Char( ',' ).Fixed( pos.y, 6 ).Text( "\n\" /> \n" );
     }
 }
 
@@ -681,14 +685,15 @@ void SVG_PLOTTER::PenTo( const wxPoint& pos, char plume )
             setSVGPlotStyle();
         }
 
-        fprintf( outputFile, "<path d=\"M%d %d\n",
-                 (int) pos_dev.x, (int) pos_dev.y );
+        PLOT_OUTPUT_BUFFER output( outputFile );
+        output.Text( "<path d=\"M" ).Int( (int) pos_dev.x ).Char( ' ' ).Int( (int) pos_dev.y )
+              .Char( '\n' );
     }
     else if( penState != plume || pos != penLastpos )
     {
-        DPOINT pos_dev = userToDeviceCoordinates( pos );
-        fprintf( outputFile, "L%d %d\n",
-                 (int) pos_dev.x, (int) pos_dev.y );
+        DPOINT             pos_dev = userToDeviceCoordinates( pos );
+        PLOT_OUTPUT_BUFFER output( outputFile );
+        output.Char( 'L' ).Int( (int) pos_dev.x ).Char( ' ' ).Int( (int) pos_dev.y ).Char( '\n' );
     }
 
     penState    = plume;
@@ -33,6 +33,12 @@
 #include "ws_data_item.h"
 #include <wx/filename.h>
 
+#include <mutex>
+
+
+/// The page layout model is shared by all the drawing lists, and set up for each of them
+static std::mutex s_worksheetMutex;
+
 
 wxString GetDefaultPlotExtension( PLOT_FORMAT aFormat )
 {
@@ -85,7 +91,11 @@ void PlotWorkSheet( PLOTTER* plotter, const PROJECT* aProject, const TITLE_BLOCK
     drawList.SetSheetName( aSheetDesc );
     drawList.SetProject( aProject );
 
-    drawList.BuildWorkSheetGraphicList( aPageInfo, aTitleBlock );
+    {
+        // Pages can be plotted by several threads at once
+        std::lock_guard<std::mutex> lock( s_worksheetMutex );
+        drawList.BuildWorkSheetGraphicList( aPageInfo, aTitleBlock );
+    }
 
     // Draw item list
     for( WS_DRAW_ITEM_BASE* item = drawList.GetFirst(); item; item = drawList.GetNext() )
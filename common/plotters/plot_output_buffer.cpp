@@ -0,0 +1,191 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <plot_output_buffer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+/// Max count of decimals of a fixed point number
+static const int MAX_DECIMALS = 17;
+
+/// Numbers from this value are formatted by snprintf()
+static const double MAX_INTEGER = 9.0e18;
+
+static const double s_powersOf10[MAX_DECIMALS + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+    1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17
+};
+
+
+PLOT_OUTPUT_BUFFER& PLOT_OUTPUT_BUFFER::Text( const char* aText )
+{
+    size_t len = strlen( aText );
+
+    reserve( len );
+
+    if( len > BUFFER_SIZE )
+    {
+        fwrite( aText, 1, len, m_file );
+        return *this;
+    }
+
+    memcpy( m_buffer + m_len, aText, len );
+    m_len += len;
+    return *this;
+}
+
+
+void PLOT_OUTPUT_BUFFER::Flush()
+{
+    if( m_len )
+        fwrite( m_buffer, 1, m_len, m_file );
+
+    m_len = 0;
+}
+
+
+/**
+ * Writes the digits of an unsigned number, at least aMinDigits of them (padded by zeros)
+ */
+static char* formatDigits( char* aBuffer, unsigned long long aValue, int aMinDigits = 1 )
+{
+    char digits[24];
+    int  count = 0;
+
+    do
+    {
+        digits[count++] = char( '0' + aValue % 10 );
+        aValue /= 10;
+    } while( aValue );
+
+    while( count < aMinDigits )
+        digits[count++] = '0';
+
+    while( count )
+        *aBuffer++ = digits[--count];
+
+    return aBuffer;
+}
+
+
+char* PLOT_OUTPUT_BUFFER::FormatInt( char* aBuffer, long long aValue )
+{
+    unsigned long long absValue = aValue;
+
+    if( aValue < 0 )
+    {
+        *aBuffer++ = '-';
+        absValue = 0ULL - absValue;
+    }
+
+    return formatDigits( aBuffer, absValue );
+}
+
+
+char* PLOT_OUTPUT_BUFFER::FormatFixed( char* aBuffer, double aValue, int aDecimals,
+                                       bool aTrimZeros )
+{
+    aDecimals = std::min( std::max( aDecimals, 0 ), MAX_DECIMALS );
+
+    double absValue = std::fabs( aValue );
+
+    // NaNs, infinites and huge values: not met in plots, leave them to the C library
+    if( !( absValue < MAX_INTEGER ) )
+    {
+        int len = snprintf( aBuffer, MAX_NUMBER_LEN, "%.17g", aValue );
+        return aBuffer + std::min<int>( std::max( len, 0 ), MAX_NUMBER_LEN - 1 );
+    }
+
+    // The integer and fractional parts are exact: rounding the fractional part alone keeps
+    // all the precision of the value
+    double             intPart = std::trunc( absValue );
+    unsigned long long integer = (unsigned long long) intPart;
+    unsigned long long unit = (unsigned long long) s_powersOf10[aDecimals];
+    unsigned long long fraction =
+            std::llround( ( absValue - intPart ) * s_powersOf10[aDecimals] );
+
+    if( fraction >= unit )
+    {
+        integer++;
+        fraction -= unit;
+    }
+
+    // Like printf, negative values rounded to 0 keep their sign
+    if( std::signbit( aValue ) )
+        *aBuffer++ = '-';
+
+    aBuffer = formatDigits( aBuffer, integer );
+
+    if( aTrimZeros )
+    {
+        while( aDecimals > 0 && fraction % 10 == 0 )
+        {
+            fraction /= 10;
+            aDecimals--;
+        }
+    }
+
+    if( aDecimals > 0 )
+    {
+        *aBuffer++ = '.';
+        aBuffer = formatDigits( aBuffer, fraction, aDecimals );
+    }
+
+    return aBuffer;
+}
+
+
+char* PLOT_OUTPUT_BUFFER::FormatSignificant( char* aBuffer, double aValue, int aDigits )
+{
+    // Decimals of tiny values are not significant in plots
+    const int maxDecimals = 10;
+
+    double absValue = std::fabs( aValue );
+
+    // Zero, and the values rounded to zero, are written without sign
+    if( absValue < 0.5 / s_powersOf10[maxDecimals] )
+    {
+        *aBuffer++ = '0';
+        return aBuffer;
+    }
+
+    if( !std::isfinite( absValue ) )
+        return FormatFixed( aBuffer, aValue, 0, true );
+
+    aDigits = std::min( std::max( aDigits, 1 ), MAX_DECIMALS );
+
+    int exponent = (int) std::floor( std::log10( absValue ) );
+    int decimals = aDigits - 1 - exponent;
+
+    // Rounding can carry to the next power of 10, which has one less decimal
+    if( decimals >= 0 && decimals <= MAX_DECIMALS
+            && std::round( absValue * s_powersOf10[decimals] ) >= s_powersOf10[aDigits] )
+    {
+        decimals--;
+    }
+
+    return FormatFixed( aBuffer, aValue, std::min( decimals, maxDecimals ), true );
+}
@@ -47,6 +47,7 @@
 #include <geometry/geometry_utils.h>
 #include <bezier_curves.h>
 #include <math/util.h>      // for KiROUND
+#include <plot_output_buffer.h>
 
 PLOTTER::PLOTTER( )
 {
@@ -87,6 +88,8 @@ bool PLOTTER::OpenFile( const wxString& aFullFilename )
     if( outputFile == NULL )
         return false ;
 
+    setvbuf( outputFile, NULL, _IOFBF, PLOT_OUTPUT_BUFFER::FILE_BUFFER_SIZE );
+
     return true;
 }
 
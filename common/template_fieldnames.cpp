@@ -28,6 +28,8 @@
 #include <macros.h>
 #include <pgm_base.h>
 
+#include <mutex>
+
 using namespace TFIELD_T;
 
 
@@ -40,6 +42,10 @@ const wxString TEMPLATE_FIELDNAME::GetDefaultFieldName( int aFieldNdx )
     static wxString datasheetDefault;
     static wxString fieldDefault;
 
+    // Fields are created concurrently when loading schematic sheets.
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock( mutex );
+
     // Fetching translations can take a surprising amount of time when loading libraries,
     // so only do it when necessary.
     if( Pgm().GetLocale() != locale )
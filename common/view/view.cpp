@@ -30,13 +30,21 @@
 #include <view/view.h>
 #include <view/view_group.h>
 #include <view/view_item.h>
+#include <view/view_lod_proxy.h>
 #include <view/view_rtree.h>
 #include <view/view_overlay.h>
 
 #include <gal/definitions.h>
 #include <gal/graphics_abstraction_layer.h>
+#include <gal/recording_gal.h>
 #include <painter.h>
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+
 #ifdef __WXDEBUG__
 #include <profile.h>
 #endif /* __WXDEBUG__  */
@@ -293,7 +301,9 @@ VIEW::VIEW( bool aIsDynamic ) :
     m_dynamic( aIsDynamic ),
     m_useDrawPriority( false ),
     m_nextDrawPriority( 0 ),
-    m_reverseDrawOrder( false )
+    m_reverseDrawOrder( false ),
+    m_parallelCaching( false ),
+    m_deferredGeometry( nullptr )
 {
     // Set m_boundary to define the max area size. The default area size
     // is defined here as the max value of a int.
@@ -401,6 +411,9 @@ void VIEW::Remove( VIEW_ITEM* aItem )
         l.items->Remove( aItem );
         MarkTargetDirty( l.target );
 
+        if( l.lodProxy )
+            l.lodProxy->Remove( aItem );
+
         // Clear the GAL cache
         int prevGroup = viewData->getGroup( layers[i] );
 
@@ -791,6 +804,10 @@ void VIEW::UpdateLayerColor( int aLayer )
         updateItemsColor visitor( aLayer, m_painter, m_gal );
         m_layers[aLayer].items->Query( r, visitor );
         MarkTargetDirty( m_layers[aLayer].target );
+
+        // Items drawn by themselves or as a part of a proxy depend on their color
+        if( m_layers[aLayer].lodProxy )
+            m_layers[aLayer].lodProxy->Invalidate();
     }
 }
 
@@ -822,6 +839,7 @@ void VIEW::UpdateAllLayersColor()
         }
     }
 
+    invalidateLODProxies();
     MarkDirty();
 }
 
@@ -961,7 +979,8 @@ struct VIEW::drawItem
     drawItem( VIEW* aView, int aLayer, bool aUseDrawPriority, bool aReverseDrawOrder ) :
         view( aView ), layer( aLayer ),
         useDrawPriority( aUseDrawPriority ),
-        reverseDrawOrder( aReverseDrawOrder )
+        reverseDrawOrder( aReverseDrawOrder ),
+        proxy( aView->activeLODProxy( aLayer ) )
     {
     }
 
@@ -975,6 +994,10 @@ struct VIEW::drawItem
         if( !drawCondition )
             return true;
 
+        // Items merged in the layer outlines are drawn by drawLODProxy()
+        if( proxy && proxy->Contains( aItem ) )
+            return true;
+
         if( useDrawPriority )
             drawItems.push_back( aItem );
         else
@@ -1003,14 +1026,239 @@ struct VIEW::drawItem
     VIEW* view;
     int layer, layers[VIEW_MAX_LAYERS];
     bool useDrawPriority, reverseDrawOrder;
+    const VIEW_LOD_PROXY* proxy;
+    std::vector<VIEW_ITEM*> drawItems;
+};
+
+
+struct VIEW::drawTileItem
+{
+    drawTileItem( VIEW* aView, PAINTER* aPainter, GAL* aGal, int aLayer, bool aUseDrawPriority,
+                  bool aReverseDrawOrder ) :
+        view( aView ), painter( aPainter ), gal( aGal ), layer( aLayer ),
+        useDrawPriority( aUseDrawPriority ),
+        reverseDrawOrder( aReverseDrawOrder ),
+        proxy( aView->activeLODProxy( aLayer ) )
+    {
+    }
+
+    bool operator()( VIEW_ITEM* aItem )
+    {
+        if( !aItem->viewPrivData() )
+            return false;
+
+        // Conditions that have to be fulfilled for an item to be drawn
+        bool drawCondition = aItem->viewPrivData()->isRenderable() &&
+                             aItem->ViewGetLOD( layer, view ) < view->m_scale;
+        if( !drawCondition )
+            return true;
+
+        if( proxy && proxy->Contains( aItem ) )
+            return true;
+
+        if( useDrawPriority )
+            drawItems.push_back( aItem );
+        else
+            draw( aItem );
+
+        return true;
+    }
+
+    void deferredDraw()
+    {
+        if( reverseDrawOrder )
+            std::sort( drawItems.begin(), drawItems.end(),
+                       []( VIEW_ITEM* a, VIEW_ITEM* b ) -> bool {
+                           return b->viewPrivData()->m_drawPriority < a->viewPrivData()->m_drawPriority;
+                       });
+        else
+            std::sort( drawItems.begin(), drawItems.end(),
+                       []( VIEW_ITEM* a, VIEW_ITEM* b ) -> bool {
+                           return a->viewPrivData()->m_drawPriority < b->viewPrivData()->m_drawPriority;
+                       });
+
+        for( auto item : drawItems )
+            draw( item );
+    }
+
+    void draw( VIEW_ITEM* aItem )
+    {
+        if( view->IsCached( layer ) )
+        {
+            int group = aItem->viewPrivData()->getGroup( layer );
+
+            if( group >= 0 )
+            {
+                gal->DrawGroup( group );
+                return;
+            }
+        }
+        else if( painter->Draw( aItem, layer ) )
+        {
+            return;
+        }
+
+        // Caching an item or drawing it by itself uses the VIEW GAL, so it is left to the VIEW
+        skipped = true;
+    }
+
+    VIEW* view;
+    PAINTER* painter;
+    GAL* gal;
+    int layer;
+    bool useDrawPriority, reverseDrawOrder;
+    const VIEW_LOD_PROXY* proxy;
     std::vector<VIEW_ITEM*> drawItems;
+    bool skipped = false;
 };
 
 
+size_t VIEW::redrawTiles( const BOX2I& aRect )
+{
+    if( !IsTargetDirty( TARGET_CACHED ) && !IsTargetDirty( TARGET_NONCACHED ) )
+        return 0;
+
+    // Each thread draws with its own painter
+    std::unique_ptr<PAINTER> firstPainter( m_painter->Clone( m_gal ) );
+
+    if( !firstPainter )
+        return 0;
+
+    std::vector<std::unique_ptr<PAINTER>> painters;
+    painters.push_back( std::move( firstPainter ) );
+
+    // Number of layers at the start of m_orderedLayers drawn by the tiles
+    size_t tiledLayers = m_orderedLayers.size();
+
+    while( tiledLayers > 0 )
+    {
+        int tileCount = m_gal->BeginTiles();
+
+        if( tileCount == 0 )
+            return 0;
+
+        size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                       tileCount );
+        parallelThreadCount = std::max<size_t>( parallelThreadCount, 1 );
+
+        while( painters.size() < parallelThreadCount )
+            painters.emplace_back( m_painter->Clone( m_gal ) );
+
+        // Parts of the view drawn by the tiles
+        std::vector<BOX2I> tileRects( tileCount );
+
+        for( int i = 0; i < tileCount; ++i )
+        {
+            BOX2I    screenRect = m_gal->GetTileRect( i );
+            VECTOR2D corner = ToWorld( VECTOR2D( screenRect.GetOrigin() ) );
+            BOX2D    rect( corner, ToWorld( VECTOR2D( screenRect.GetEnd() ) ) - corner );
+
+            rect.Normalize();
+
+            // Item bounding boxes use integer coordinates, so round the tile outwards
+            rect.Inflate( 1 );
+
+            if( rect.GetWidth() > std::numeric_limits<int>::max() ||
+                    rect.GetHeight() > std::numeric_limits<int>::max() )
+                tileRects[i] = aRect;
+            else
+                tileRects[i] = BOX2I( rect.GetPosition(), rect.GetSize() ).Intersect( aRect );
+        }
+
+        // Lowered to the first layer having an item the tiles cannot draw.  The tiles are
+        // composited below the layers drawn by the VIEW, so that layer and the ones above it
+        // are left to the VIEW, to keep the drawing order.
+        std::atomic<size_t> layerLimit( tiledLayers );
+
+        std::atomic<int>                 nextTile( 0 );
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        auto draw_lambda = [&]( size_t aThread ) -> size_t
+        {
+            PAINTER* painter = painters[aThread].get();
+            size_t   count = 0;
+
+            // Once the limit is lowered, the tiles are drawn again, so the pass is abandoned
+            for( int i = nextTile++; i < tileCount && layerLimit == tiledLayers; i = nextTile++ )
+            {
+                GAL* tile = m_gal->GetTile( i );
+                painter->SetGAL( tile );
+
+                for( size_t j = 0; j < layerLimit; ++j )
+                {
+                    VIEW_LAYER* l = m_orderedLayers[j];
+
+                    if( l->target == TARGET_OVERLAY || !l->visible || !IsTargetDirty( l->target )
+                            || !areRequiredLayersEnabled( l->id ) )
+                        continue;
+
+                    drawTileItem drawFunc( this, painter, tile, l->id, m_useDrawPriority,
+                                           m_reverseDrawOrder );
+
+                    tile->SetLayerDepth( l->renderingOrder );
+                    l->items->Query( tileRects[i], drawFunc );
+
+                    if( m_useDrawPriority )
+                        drawFunc.deferredDraw();
+
+                    if( drawFunc.proxy )
+                        drawLODProxy( l->id, tile, tileRects[i] );
+
+                    if( drawFunc.skipped )
+                    {
+                        size_t limit = layerLimit;
+
+                        while( j < limit && !layerLimit.compare_exchange_weak( limit, j ) )
+                            ;
+
+                        break;
+                    }
+                }
+
+                tile->Flush();
+                count++;
+            }
+
+            return count;
+        };
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, draw_lambda, ii );
+
+        // Finalize the threads
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].wait();
+
+        if( layerLimit == tiledLayers )
+        {
+            m_gal->SetTarget( TARGET_NONCACHED );
+            m_gal->EndTiles();
+            break;
+        }
+
+        // The tiles may hold layers above the limit, so they are started over
+        tiledLayers = layerLimit;
+    }
+
+    return tiledLayers;
+}
+
+
 void VIEW::redrawRect( const BOX2I& aRect )
 {
-    for( VIEW_LAYER* l : m_orderedLayers )
+    // The proxies are rebuilt first, as the tiles draw them concurrently
+    updateLODProxies( aRect );
+
+    // The tiles draw the first layers of all targets but the overlay
+    size_t tiledLayers = redrawTiles( aRect );
+
+    for( size_t j = 0; j < m_orderedLayers.size(); ++j )
     {
+        VIEW_LAYER* l = m_orderedLayers[j];
+
+        if( j < tiledLayers && l->target != TARGET_OVERLAY )
+            continue;
+
         if( l->visible && IsTargetDirty( l->target ) && areRequiredLayersEnabled( l->id ) )
         {
             drawItem drawFunc( this, l->id, m_useDrawPriority, m_reverseDrawOrder );
@@ -1021,11 +1269,116 @@ void VIEW::redrawRect( const BOX2I& aRect )
 
             if( m_useDrawPriority )
                 drawFunc.deferredDraw();
+
+            if( drawFunc.proxy )
+            {
+                // The outlines are not cached, as they change with the items
+                m_gal->SetTarget( TARGET_NONCACHED );
+                drawLODProxy( l->id, m_gal, aRect );
+                m_gal->SetTarget( l->target );
+            }
         }
     }
 }
 
 
+VIEW_LOD_PROXY* VIEW::activeLODProxy( int aLayer ) const
+{
+    VIEW_LOD_PROXY* proxy = m_layers.at( aLayer ).lodProxy.get();
+
+    if( proxy && m_scale < proxy->GetMaxScale() )
+        return proxy;
+
+    return nullptr;
+}
+
+
+void VIEW::updateLODProxies( const BOX2I& aRect )
+{
+    for( VIEW_LAYER* l : m_orderedLayers )
+    {
+        VIEW_LOD_PROXY* proxy = activeLODProxy( l->id );
+
+        if( !proxy || !l->visible || !IsTargetDirty( l->target )
+                || !areRequiredLayersEnabled( l->id ) )
+            continue;
+
+        // Vertices closer than a pixel are merged.  The cells built at another scale, or
+        // whose items are shown or hidden at this scale, are rebuilt.
+        int layer = l->id;
+
+        proxy->Rebuild( aRect, m_scale, ToWorld( 1.0 ),
+                [&]( const VIEW_ITEM* aItem ) -> double
+                {
+                    return aItem->ViewGetLOD( layer, this );
+                },
+                [&]( const VIEW_ITEM* aItem, SHAPE_POLY_SET& aOutlines ) -> bool
+                {
+                    return aItem->viewPrivData()->isRenderable()
+                           && m_painter->GetLODProxy( aItem, layer, aOutlines );
+                } );
+    }
+}
+
+
+void VIEW::drawLODProxy( int aLayer, GAL* aGal, const BOX2I& aRect )
+{
+    std::vector<const SHAPE_POLY_SET*> outlines;
+
+    m_layers.at( aLayer ).lodProxy->Query( aRect, outlines );
+
+    if( outlines.empty() )
+        return;
+
+    aGal->SetIsFill( true );
+    aGal->SetIsStroke( false );
+    aGal->SetFillColor( m_painter->GetSettings()->GetColor( nullptr, aLayer ) );
+
+    for( const SHAPE_POLY_SET* outline : outlines )
+        aGal->DrawPolygon( *outline );
+}
+
+
+void VIEW::invalidateLODProxies()
+{
+    for( LAYER_MAP_ITER i = m_layers.begin(); i != m_layers.end(); ++i )
+    {
+        if( i->second.lodProxy )
+            i->second.lodProxy->Invalidate();
+    }
+}
+
+
+void VIEW::SetLayerLODProxy( int aLayer, double aMaxScale, int aCellSize )
+{
+    wxCHECK( aLayer < (int) m_layers.size(), /*void*/ );
+
+    VIEW_LAYER& l = m_layers[aLayer];
+
+    if( aMaxScale <= 0.0 )
+    {
+        l.lodProxy.reset();
+    }
+    else
+    {
+        l.lodProxy = std::make_shared<VIEW_LOD_PROXY>( aMaxScale, aCellSize );
+
+        BOX2I r;
+        r.SetMaximum();
+
+        auto addItem = [&]( VIEW_ITEM* aItem ) -> bool
+        {
+            l.lodProxy->Add( aItem );
+            return true;
+        };
+
+        l.items->Query( r, addItem );
+    }
+
+    MarkTargetDirty( l.target );
+}
+
+
 void VIEW::draw( VIEW_ITEM* aItem, int aLayer, bool aImmediate )
 {
     auto viewData = aItem->viewPrivData();
@@ -1115,8 +1468,13 @@ void VIEW::Clear()
     m_allItems->clear();
 
     for( LAYER_MAP_ITER i = m_layers.begin(); i != m_layers.end(); ++i )
+    {
         i->second.items->RemoveAll();
 
+        if( i->second.lodProxy )
+            i->second.lodProxy->Clear();
+    }
+
     m_nextDrawPriority = 0;
 
     m_gal->ClearCache();
@@ -1245,11 +1603,19 @@ void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
         if( IsCached( layerId ) )
         {
             if( aUpdateFlags & ( GEOMETRY | LAYERS | REPAINT ) )
-                updateItemGeometry( aItem, layerId );
+            {
+                if( m_deferredGeometry )
+                    m_deferredGeometry->emplace_back( aItem, layerId );
+                else
+                    updateItemGeometry( aItem, layerId );
+            }
             else if( aUpdateFlags & COLOR )
                 updateItemColor( aItem, layerId );
         }
 
+        if( m_layers[layerId].lodProxy )
+            m_layers[layerId].lodProxy->Update( aItem );
+
         // Mark those layers as dirty, so the VIEW will be refreshed
         MarkTargetDirty( m_layers[layerId].target );
     }
@@ -1322,6 +1688,136 @@ void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
 }
 
 
+void VIEW::updateGeometryParallel( const std::vector<LAYER_ITEM_PAIR>& aJobs )
+{
+    // Below this count, creating the threads and recording costs more than it saves
+    const size_t minParallelJobs = 64;
+
+    // Painters may modify an item temporarily while drawing it, so all the layers of an item
+    // are drawn by the same thread
+    std::vector<size_t> itemStarts;
+
+    for( size_t i = 0; i < aJobs.size(); ++i )
+    {
+        if( i == 0 || aJobs[i].first != aJobs[i - 1].first )
+            itemStarts.push_back( i );
+    }
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   itemStarts.size() );
+
+    // The recording GALs are linked to the options, so they have to be destroyed first
+    GAL_DISPLAY_OPTIONS                         recordingOptions;
+    std::vector<std::unique_ptr<RECORDING_GAL>> recorders;
+    std::vector<std::unique_ptr<PAINTER>>       painters;
+
+    if( aJobs.size() >= minParallelJobs && parallelThreadCount > 1 )
+    {
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        {
+            recorders.emplace_back( new RECORDING_GAL( recordingOptions, m_gal ) );
+            PAINTER* painter = m_painter->Clone( recorders.back().get() );
+
+            if( !painter )
+            {
+                painters.clear();
+                break;
+            }
+
+            painters.emplace_back( painter );
+        }
+    }
+
+    if( painters.empty() )
+    {
+        for( const LAYER_ITEM_PAIR& job : aJobs )
+            updateItemGeometry( job.first, job.second );
+
+        return;
+    }
+
+    struct RECORDED_JOB
+    {
+        size_t m_thread;        ///< index of the recording GAL
+        size_t m_begin;         ///< first recorded command
+        size_t m_end;           ///< command following the last recorded one
+        bool   m_drawn;         ///< false if the painter could not draw the item
+    };
+
+    std::vector<RECORDED_JOB>        recorded( aJobs.size() );
+    std::atomic<size_t>              nextItem( 0 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto record_lambda = [&]( size_t aThread ) -> size_t
+    {
+        RECORDING_GAL* recorder = recorders[aThread].get();
+        PAINTER*       painter = painters[aThread].get();
+        size_t         count = 0;
+
+        for( size_t i = nextItem++; i < itemStarts.size(); i = nextItem++ )
+        {
+            size_t end = i + 1 < itemStarts.size() ? itemStarts[i + 1] : aJobs.size();
+
+            for( size_t j = itemStarts[i]; j < end; ++j )
+            {
+                const VIEW_LAYER& l = m_layers.at( aJobs[j].second );
+                RECORDED_JOB&     job = recorded[j];
+
+                job.m_thread = aThread;
+                job.m_begin = recorder->GetCommandCount();
+                recorder->BeginRecording( l.renderingOrder );
+                job.m_drawn = painter->Draw( static_cast<EDA_ITEM*>( aJobs[j].first ),
+                                             aJobs[j].second );
+                job.m_end = recorder->GetCommandCount();
+                count++;
+            }
+        }
+
+        return count;
+    };
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii] = std::async( std::launch::async, record_lambda, ii );
+
+    // Finalize the threads
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii].wait();
+
+    // Build the cached groups on the thread owning the GAL, in the order of the jobs
+    for( size_t j = 0; j < aJobs.size(); ++j )
+    {
+        VIEW_ITEM* item = aJobs[j].first;
+        int        layer = aJobs[j].second;
+        auto       viewData = item->viewPrivData();
+
+        if( !viewData )
+            continue;
+
+        VIEW_LAYER& l = m_layers.at( layer );
+
+        m_gal->SetTarget( l.target );
+        m_gal->SetLayerDepth( l.renderingOrder );
+
+        int group = viewData->getGroup( layer );
+
+        if( group >= 0 )
+            m_gal->DeleteGroup( group );
+
+        group = m_gal->BeginGroup();
+        viewData->setGroup( layer, group );
+
+        const RECORDED_JOB& job = recorded[j];
+
+        if( job.m_drawn )
+            recorders[job.m_thread]->Replay( m_gal, job.m_begin, job.m_end );
+        else
+            item->ViewDraw( layer, this ); // Alternative drawing method
+
+        m_gal->EndGroup();
+    }
+}
+
+
 void VIEW::updateBbox( VIEW_ITEM* aItem )
 {
     int layers[VIEW_MAX_LAYERS], layers_count;
@@ -1355,6 +1851,9 @@ void VIEW::updateLayers( VIEW_ITEM* aItem )
         l.items->Remove( aItem );
         MarkTargetDirty( l.target );
 
+        if( l.lodProxy )
+            l.lodProxy->Remove( aItem );
+
         if( IsCached( l.id ) )
         {
             // Redraw the item from scratch
@@ -1415,6 +1914,8 @@ void VIEW::RecacheAllItems()
             l->items->Query( r, visitor );
         }
     }
+
+    invalidateLODProxies();
 }
 
 
@@ -1424,6 +1925,12 @@ void VIEW::UpdateItems()
     {
         GAL_UPDATE_CONTEXT ctx( m_gal );
 
+        // Collect the geometry updates, to run them at once in several threads
+        std::vector<LAYER_ITEM_PAIR> deferredGeometry;
+
+        if( m_parallelCaching )
+            m_deferredGeometry = &deferredGeometry;
+
         for( VIEW_ITEM* item : *m_allItems )
         {
             auto viewData = item->viewPrivData();
@@ -1437,6 +1944,11 @@ void VIEW::UpdateItems()
                 viewData->m_requiredUpdate = NONE;
             }
         }
+
+        m_deferredGeometry = nullptr;
+
+        if( !deferredGeometry.empty() )
+            updateGeometryParallel( deferredGeometry );
     }
 }
 
@@ -0,0 +1,259 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <view/view_lod_proxy.h>
+#include <view/view_item.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <thread>
+
+using namespace KIGFX;
+
+
+/**
+ * Drops the vertices of a closed contour closer than aTolerance to the previous kept vertex.
+ * Contours that would be left with less than 3 vertices are kept as they are.
+ */
+static void decimateContour( SHAPE_LINE_CHAIN& aContour, double aTolerance )
+{
+    if( aContour.PointCount() <= 3 )
+        return;
+
+    const VECTOR2I::extended_type minDistSq = (VECTOR2I::extended_type) ( aTolerance * aTolerance );
+    SHAPE_LINE_CHAIN              decimated;
+    VECTOR2I                      last = aContour.CPoint( 0 );
+
+    decimated.Append( last );
+
+    for( int i = 1; i < aContour.PointCount(); ++i )
+    {
+        const VECTOR2I& p = aContour.CPoint( i );
+
+        if( ( p - last ).SquaredEuclideanNorm() >= minDistSq )
+        {
+            decimated.Append( p );
+            last = p;
+        }
+    }
+
+    if( decimated.PointCount() < 3 )
+        return;
+
+    decimated.SetClosed( true );
+    aContour = decimated;
+}
+
+
+VIEW_LOD_PROXY::VIEW_LOD_PROXY( double aMaxScale, int aCellSize ) :
+    m_maxScale( aMaxScale ),
+    m_cellSize( std::max( aCellSize, 1 ) )
+{
+}
+
+
+void VIEW_LOD_PROXY::Add( VIEW_ITEM* aItem )
+{
+    BOX2I    bbox = aItem->ViewBBox();
+    VECTOR2I center = bbox.Centre();
+    CELL_KEY key( (int) std::floor( (double) center.x / m_cellSize ),
+                  (int) std::floor( (double) center.y / m_cellSize ) );
+
+    ITEM& item = m_items[aItem];
+    item.m_cell = key;
+    item.m_bbox = bbox;
+    item.m_proxied = false;
+
+    CELL& cell = m_cells[key];
+
+    if( cell.m_items.empty() )
+        cell.m_bbox = bbox;
+    else
+        cell.m_bbox.Merge( bbox );
+
+    cell.m_items.insert( aItem );
+    cell.m_dirty = true;
+}
+
+
+void VIEW_LOD_PROXY::Remove( VIEW_ITEM* aItem )
+{
+    auto it = m_items.find( aItem );
+
+    if( it == m_items.end() )
+        return;
+
+    auto cell = m_cells.find( it->second.m_cell );
+
+    if( cell != m_cells.end() )
+    {
+        cell->second.m_items.erase( aItem );
+        cell->second.m_dirty = true;
+
+        if( cell->second.m_items.empty() )
+            m_cells.erase( cell );
+    }
+
+    m_items.erase( it );
+}
+
+
+void VIEW_LOD_PROXY::Update( VIEW_ITEM* aItem )
+{
+    Remove( aItem );
+    Add( aItem );
+}
+
+
+void VIEW_LOD_PROXY::Clear()
+{
+    m_cells.clear();
+    m_items.clear();
+}
+
+
+void VIEW_LOD_PROXY::Invalidate()
+{
+    for( auto& cell : m_cells )
+        cell.second.m_dirty = true;
+}
+
+
+bool VIEW_LOD_PROXY::Contains( const VIEW_ITEM* aItem ) const
+{
+    auto it = m_items.find( aItem );
+
+    return it != m_items.end() && it->second.m_proxied;
+}
+
+
+void VIEW_LOD_PROXY::Rebuild( const BOX2I& aRect, double aScale, double aTolerance,
+                              const LOD_FUNC& aGetLOD, const OUTLINE_FUNC& aGetOutline )
+{
+    std::vector<CELL*> dirtyCells;
+
+    for( auto& cell : m_cells )
+    {
+        if( cell.second.NeedsRebuild( aScale ) && cell.second.m_bbox.Intersects( aRect ) )
+            dirtyCells.push_back( &cell.second );
+    }
+
+    if( dirtyCells.empty() )
+        return;
+
+    size_t parallelThreadCount =
+            std::min<size_t>( std::thread::hardware_concurrency(), dirtyCells.size() );
+    parallelThreadCount = std::max<size_t>( parallelThreadCount, 1 );
+
+    std::atomic<size_t>              nextCell( 0 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto rebuild_lambda = [&]() -> size_t
+    {
+        size_t count = 0;
+
+        for( size_t i = nextCell++; i < dirtyCells.size(); i = nextCell++ )
+        {
+            rebuildCell( *dirtyCells[i], aScale, aTolerance, aGetLOD, aGetOutline );
+            count++;
+        }
+
+        return count;
+    };
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii] = std::async( std::launch::async, rebuild_lambda );
+
+    // Finalize the threads
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii].wait();
+}
+
+
+void VIEW_LOD_PROXY::Query( const BOX2I& aRect, std::vector<const SHAPE_POLY_SET*>& aOutlines ) const
+{
+    for( const auto& cell : m_cells )
+    {
+        if( cell.second.m_outlines.OutlineCount() > 0 && cell.second.m_bbox.Intersects( aRect ) )
+            aOutlines.push_back( &cell.second.m_outlines );
+    }
+}
+
+
+void VIEW_LOD_PROXY::rebuildCell( CELL& aCell, double aScale, double aTolerance,
+                                  const LOD_FUNC& aGetLOD, const OUTLINE_FUNC& aGetOutline )
+{
+    SHAPE_POLY_SET& outlines = aCell.m_outlines;
+    bool            first = true;
+
+    outlines.RemoveAllContours();
+
+    // The outlines are valid as long as the tolerance is close enough to the scale, and no
+    // LOD threshold of the items is crossed
+    aCell.m_minScale = aScale / TOLERANCE_SCALE_RANGE;
+    aCell.m_maxScale = aScale * TOLERANCE_SCALE_RANGE;
+
+    for( VIEW_ITEM* viewItem : aCell.m_items )
+    {
+        // Only the values of the map are modified, so cells can be rebuilt concurrently
+        ITEM& item = m_items.find( viewItem )->second;
+
+        if( first )
+            aCell.m_bbox = item.m_bbox;
+        else
+            aCell.m_bbox.Merge( item.m_bbox );
+
+        first = false;
+
+        // The item is drawn at the scales above its LOD
+        double lod = aGetLOD( viewItem );
+
+        if( lod < aScale )
+            aCell.m_minScale = std::max( aCell.m_minScale, lod );
+        else
+            aCell.m_maxScale = std::min( aCell.m_maxScale, lod );
+
+        SHAPE_POLY_SET itemOutlines;
+        item.m_proxied = lod < aScale && aGetOutline( viewItem, itemOutlines );
+
+        if( item.m_proxied )
+            outlines.Append( itemOutlines );
+    }
+
+    outlines.SimplifyClustered( SHAPE_POLY_SET::PM_FAST );
+
+    for( int ii = 0; ii < outlines.OutlineCount(); ++ii )
+    {
+        for( SHAPE_LINE_CHAIN& contour : outlines.Polygon( ii ) )
+            decimateContour( contour, aTolerance );
+    }
+
+    // Removing vertices may have made some contours intersect, fracturing simplifies them again.
+    // Fractured polygons have no holes, so every GAL fills them the same way.
+    outlines.Fracture( SHAPE_POLY_SET::PM_FAST );
+    outlines.CacheTriangulation();
+
+    aCell.m_dirty = false;
+}
@@ -39,10 +39,12 @@
 #include <wx/image.h>
 #include <wx/tipwin.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>   // used only for debug
 #include <ctime>    // used for representation of x axes involving date
 #include <set>
+#include <vector>
 
 // Memory leak debugging
 #ifdef _DEBUG
@@ -696,24 +698,74 @@ void mpFXY::Plot( wxDC& dc, mpWindow& w )
         }
         else
         {
-            wxPoint* points = new wxPoint[GetCount()];
-            int      count = 0;
+            // Long traces have many points per pixel column: only the first, lowest, highest
+            // and last point of each column are drawn, which gives the same picture.  Points
+            // outside the plot area are gathered in a single column on each side.  This is
+            // done on each redraw, so it follows zoom changes.
+            std::vector<wxPoint> points;
+            wxCoord              column = 0;
+            wxPoint              first, last, low, high;
+            bool                 lowFirst = true;
+            bool                 empty = true;
+
+            points.reserve( std::min<size_t>( GetCount(), 4 * ( endPx - startPx + 3 ) ) );
+
+            auto addPoint =
+                    [&]( const wxPoint& aPoint )
+                    {
+                        if( points.empty() || points.back() != aPoint )
+                            points.push_back( aPoint );
+                    };
+
+            auto flushColumn =
+                    [&]()
+                    {
+                        addPoint( first );
+                        addPoint( lowFirst ? low : high );
+                        addPoint( lowFirst ? high : low );
+                        addPoint( last );
+                    };
 
             while( GetNextXY( x, y ) )
             {
                 double px = m_scaleX->TransformToPlot( x );
                 double py = m_scaleY->TransformToPlot( y );
 
-                wxCoord x1 = w.x2p( px );
-                wxCoord y1 = w.y2p( py );
+                wxPoint p( w.x2p( px ), w.y2p( py ) );
+                wxCoord newColumn = std::max( startPx - 1, std::min( endPx + 1, p.x ) );
+
+                if( !empty && newColumn == column )
+                {
+                    if( p.y < low.y )
+                    {
+                        low = p;
+                        lowFirst = false;
+                    }
+
+                    if( p.y > high.y )
+                    {
+                        high = p;
+                        lowFirst = true;
+                    }
 
-                points[count++] = wxPoint( x1, y1 );
+                    last = p;
+                    continue;
+                }
+
+                if( !empty )
+                    flushColumn();
+
+                column = newColumn;
+                first = last = low = high = p;
+                lowFirst = true;
+                empty = false;
             }
 
-            if( count > 0 )
-                dc.DrawLines( count, points );
+            if( !empty )
+                flushColumn();
 
-            delete[] points;
+            if( !points.empty() )
+                dc.DrawLines( (int) points.size(), points.data() );
         }
 
         if( !m_name.IsEmpty() && m_showName )
@@ -3428,6 +3480,41 @@ void mpFXYVector::SetData( const std::vector<double>& xs, const std::vector<doub
 }
 
 
+void mpFXYVector::AppendData( const std::vector<double>& xs, const std::vector<double>& ys )
+{
+    // Check if the data vectora are of the same size
+    if( xs.size() != ys.size() )
+    {
+        wxLogError( "wxMathPlot error: X and Y vector are not of the same length!" );
+        return;
+    }
+
+    if( xs.empty() )
+        return;
+
+    if( m_xs.empty() )
+    {
+        SetData( xs, ys );
+        return;
+    }
+
+    m_xs.insert( m_xs.end(), xs.begin(), xs.end() );
+    m_ys.insert( m_ys.end(), ys.begin(), ys.end() );
+
+    for( double x : xs )
+    {
+        m_minX = std::min( m_minX, x );
+        m_maxX = std::max( m_maxX, x );
+    }
+
+    for( double y : ys )
+    {
+        m_minY = std::min( m_minY, y );
+        m_maxY = std::max( m_maxY, y );
+    }
+}
+
+
 // -----------------------------------------------------------------------------
 // mpText - provided by Val Greene
 // -----------------------------------------------------------------------------
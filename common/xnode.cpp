@@ -88,4 +88,220 @@ void XNODE::FormatContents( OUTPUTFORMATTER* out, int nestLevel )
     }
 }
 
+void XNODE_BUILDER::addChild( XNODE* aNode )
+{
+    if( m_open.empty() )
+    {
+        wxASSERT_MSG( !m_root, "XNODE_BUILDER: a document has a single root" );
+        delete m_root;
+        m_root = aNode;
+        return;
+    }
+
+    // wxXmlNode::AddChild() walks all the existing children, so keep track of the last one
+    m_open.back()->InsertChildAfter( aNode, m_lastChild.back() );
+    m_lastChild.back() = aNode;
+}
+
+
+void XNODE_BUILDER::StartElement( const wxString& aName )
+{
+    XNODE* n = new XNODE( wxXML_ELEMENT_NODE, aName );
+
+    addChild( n );
+    m_open.push_back( n );
+    m_lastChild.push_back( nullptr );
+}
+
+
+void XNODE_BUILDER::AddAttribute( const wxString& aName, const wxString& aValue )
+{
+    wxCHECK_RET( !m_open.empty(), "XNODE_BUILDER: no open element" );
+
+    m_open.back()->AddAttribute( aName, aValue );
+}
+
+
+void XNODE_BUILDER::AddText( const wxString& aContent )
+{
+    wxCHECK_RET( !m_open.empty(), "XNODE_BUILDER: no open element" );
+
+    addChild( new XNODE( wxXML_TEXT_NODE, wxEmptyString, aContent ) );
+}
+
+
+void XNODE_BUILDER::EndElement()
+{
+    wxCHECK_RET( !m_open.empty(), "XNODE_BUILDER: no open element" );
+
+    m_open.pop_back();
+    m_lastChild.pop_back();
+}
+
+
+XNODE* XNODE_BUILDER::ReleaseRoot()
+{
+    XNODE* root = m_root;
+
+    m_root = nullptr;
+    m_open.clear();
+    m_lastChild.clear();
+
+    return root;
+}
+
+
+/**
+ * Escapes aText the way wxXmlDocument::Save() does, for a text node or for the value of
+ * an attribute.
+ */
+static std::string xmlEscape( const wxString& aText, bool aAttribute )
+{
+    wxString escaped;
+
+    escaped.reserve( aText.length() );
+
+    for( wxString::const_iterator it = aText.begin(); it != aText.end(); ++it )
+    {
+        const wxUniChar c = *it;
+
+        switch( c.GetValue() )
+        {
+        case '<':  escaped += wxT( "&lt;" );   break;
+        case '>':  escaped += wxT( "&gt;" );   break;
+        case '&':  escaped += wxT( "&amp;" );  break;
+        case '\r': escaped += wxT( "&#xD;" ); break;
+
+        default:
+            if( aAttribute && c == '"' )
+                escaped += wxT( "&quot;" );
+            else if( aAttribute && c == '\t' )
+                escaped += wxT( "&#x9;" );
+            else if( aAttribute && c == '\n' )
+                escaped += wxT( "&#xA;" );
+            else
+                escaped += c;
+        }
+    }
+
+    return TO_UTF8( escaped );
+}
+
+
+XNODE_STREAM::XNODE_STREAM( OUTPUTFORMATTER* aOut, FORMAT aFormat ) :
+    m_out( aOut ),
+    m_format( aFormat )
+{
+    if( m_format == XML )
+        m_out->Print( 0, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" );
+}
+
+
+void XNODE_STREAM::beginChild( bool aIsText )
+{
+    ELEMENT& parent = m_open.back();
+
+    if( m_format == XML )
+    {
+        // The start tag of the parent is left open until we know it has children
+        if( parent.m_childCount == 0 )
+            m_out->Print( 0, ">" );
+
+        // Text children are not indented
+        if( !aIsText )
+            m_out->Print( 0, "\n%*s", int( 2 * m_open.size() ), "" );
+    }
+    else
+    {
+        // XNODE::Format() starts the first child element on a new line, and ends every
+        // element followed by a sibling with a new line.
+        if( ( parent.m_childCount == 0 && !aIsText ) || parent.m_pendingNewline )
+            m_out->Print( 0, "\n" );
+
+        parent.m_pendingNewline = false;
+    }
+
+    parent.m_childCount++;
+    parent.m_lastChildIsText = aIsText;
+}
+
+
+void XNODE_STREAM::StartElement( const wxString& aName )
+{
+    if( !m_open.empty() )
+        beginChild( false );
+
+    ELEMENT element;
+    element.m_name            = TO_UTF8( aName );
+    element.m_childCount      = 0;
+    element.m_lastChildIsText = false;
+    element.m_pendingNewline  = false;
+
+    if( m_format == XML )
+        m_out->Print( 0, "<%s", element.m_name.c_str() );
+    else
+        m_out->Print( int( m_open.size() ), "(%s", element.m_name.c_str() );
+
+    m_open.push_back( element );
+}
+
+
+void XNODE_STREAM::AddAttribute( const wxString& aName, const wxString& aValue )
+{
+    wxCHECK_RET( !m_open.empty() && m_open.back().m_childCount == 0,
+                 "XNODE_STREAM: attributes must precede the children of an element" );
+
+    if( m_format == XML )
+    {
+        m_out->Print( 0, " %s=\"%s\"", TO_UTF8( aName ), xmlEscape( aValue, true ).c_str() );
+    }
+    else
+    {
+        m_out->Print( 0, " (%s %s)", TO_UTF8( aName ), m_out->Quotew( aValue ).c_str() );
+    }
+}
+
+
+void XNODE_STREAM::AddText( const wxString& aContent )
+{
+    wxCHECK_RET( !m_open.empty(), "XNODE_STREAM: no open element" );
+
+    beginChild( true );
+
+    if( m_format == XML )
+        m_out->Print( 0, "%s", xmlEscape( aContent, false ).c_str() );
+    else
+        m_out->Print( 0, " %s", m_out->Quotew( aContent ).c_str() );
+}
+
+
+void XNODE_STREAM::EndElement()
+{
+    wxCHECK_RET( !m_open.empty(), "XNODE_STREAM: no open element" );
+
+    const ELEMENT& element = m_open.back();
+
+    if( m_format == XML )
+    {
+        if( element.m_childCount == 0 )
+            m_out->Print( 0, "/>" );
+        else if( element.m_lastChildIsText )
+            m_out->Print( 0, "</%s>", element.m_name.c_str() );
+        else
+            m_out->Print( 0, "\n%*s</%s>", int( 2 * ( m_open.size() - 1 ) ), "",
+                          element.m_name.c_str() );
+    }
+    else
+    {
+        m_out->Print( 0, ")" );
+    }
+
+    m_open.pop_back();
+
+    if( !m_open.empty() )
+        m_open.back().m_pendingNewline = true;
+    else if( m_format == XML )
+        m_out->Print( 0, "\n" );
+}
+
 // EOF
@@ -68,14 +68,15 @@ bool SCH_EDIT_FRAME::TestDanglingEnds()
     for( auto item : GetScreen()->Items() )
         item->GetEndPoints( endPoints );
 
+    DANGLING_END_ITEM_INDEX index( std::move( endPoints ) );
+
     for( auto item : GetScreen()->Items() )
     {
-        if( item->UpdateDanglingState( endPoints ) )
+        if( item->UpdateDanglingState( index ) )
         {
             GetCanvas()->GetView()->Update( item, KIGFX::REPAINT );
             hasStateChanged = true;
         }
-        item->GetEndPoints( endPoints );
     }
 
     return hasStateChanged;
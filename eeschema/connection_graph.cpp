@@ -24,7 +24,9 @@
 #include <future>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <profile.h>
+#include <trace_helpers.h>
 
 #include <common.h>
 #include <erc.h>
@@ -348,8 +350,12 @@ void CONNECTION_GRAPH::Reset()
     for( auto& subgraph : m_subgraphs )
         delete subgraph;
 
+    for( auto& subgraph : m_absorbed_subgraphs )
+        delete subgraph;
+
     m_items.clear();
     m_subgraphs.clear();
+    m_absorbed_subgraphs.clear();
     m_driver_subgraphs.clear();
     m_sheet_to_subgraphs_map.clear();
     m_invisible_power_pins.clear();
@@ -363,51 +369,71 @@ void CONNECTION_GRAPH::Reset()
     m_last_net_code = 1;
     m_last_bus_code = 1;
     m_last_subgraph_code = 1;
+    m_sheet_paths.clear();
+    m_screen_item_counts.clear();
+    m_sheet_signatures.clear();
 }
 
 
-void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnconditional )
+void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnconditional,
+                                    std::function<void( SCH_ITEM* )>* aChangedItemHandler )
 {
     PROF_COUNTER recalc_time;
-    PROF_COUNTER update_items;
 
-    if( aUnconditional )
-        Reset();
+    m_timings.Clear();
 
-    for( const SCH_SHEET_PATH& sheet : aSheetList )
+    if( aUnconditional || !updateIncremental( aSheetList, aChangedItemHandler ) )
     {
-        std::vector<SCH_ITEM*> items;
+        PROF_COUNTER update_items;
+
+        Reset();
 
-        for( auto item : sheet.LastScreen()->Items() )
+        std::vector<std::pair<SCH_SHEET_PATH, std::vector<SCH_ITEM*>>> sheets;
+
+        for( const SCH_SHEET_PATH& sheet : aSheetList )
         {
-            if( item->IsConnectable() && ( aUnconditional || item->IsConnectivityDirty() ) )
-                items.push_back( item );
+            sheets.emplace_back( sheet, std::vector<SCH_ITEM*>() );
+
+            for( auto item : sheet.LastScreen()->Items() )
+            {
+                if( item->IsConnectable() )
+                    sheets.back().second.push_back( item );
+            }
         }
 
-        updateItemConnectivity( sheet, items );
+        updateSheetConnectivity( sheets );
 
-        // UpdateDanglingState() also adds connected items for SCH_TEXT
-        sheet.LastScreen()->TestDanglingEnds( &sheet );
-    }
+        update_items.Stop();
+        m_timings.m_updateItems = update_items.msecs();
 
-    update_items.Stop();
-    wxLogTrace( "CONN_PROFILE", "UpdateItemConnectivity() %0.4f ms", update_items.msecs() );
+        wxLogTrace( traceConnectivityProfile,
+                    "UpdateItemConnectivity() %zu sheets on %zu threads: %0.4f ms",
+                    m_timings.m_sheetCount, m_timings.m_threadCount, m_timings.m_updateItems );
 
-    PROF_COUNTER build_graph;
+        PROF_COUNTER build_graph;
 
-    buildConnectionGraph();
+        buildConnectionGraph( m_items );
+        recordSheets( aSheetList );
 
-    build_graph.Stop();
-    wxLogTrace( "CONN_PROFILE", "BuildConnectionGraph() %0.4f ms", build_graph.msecs() );
+        build_graph.Stop();
+        m_timings.m_buildGraph = build_graph.msecs();
+
+        wxLogTrace( traceConnectivityProfile, "BuildConnectionGraph() %0.4f ms",
+                    m_timings.m_buildGraph );
+    }
 
     recalc_time.Stop();
-    wxLogTrace( "CONN_PROFILE", "Recalculate time %0.4f ms", recalc_time.msecs() );
+    m_timings.m_total = recalc_time.msecs();
+
+    wxLogTrace( traceConnectivityProfile, "Recalculate time (%s) %0.4f ms",
+                m_timings.m_incremental ? "incremental" : "full", m_timings.m_total );
 
 #ifndef DEBUG
-    // Pressure relief valve for release builds
+    // Pressure relief valve for release builds.  Only the updates done while editing count:
+    // loading a large schematic may well take longer than this.
     const double max_recalc_time_msecs = 250.;
 
-    if( m_allowRealTime && ADVANCED_CFG::GetCfg().m_realTimeConnectivity &&
+    if( !aUnconditional && m_allowRealTime && ADVANCED_CFG::GetCfg().m_realTimeConnectivity &&
         recalc_time.msecs() > max_recalc_time_msecs )
     {
         m_allowRealTime = false;
@@ -416,8 +442,635 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
 }
 
 
+/**
+ * Appends to aList the items that are part of the connection graph for a schematic item: the
+ * pins of a symbol or a sheet, or the item itself.
+ */
+static void getGraphItems( SCH_ITEM* aItem, const SCH_SHEET_PATH& aSheet,
+                           std::vector<SCH_ITEM*>& aList )
+{
+    if( aItem->Type() == SCH_COMPONENT_T )
+    {
+        for( SCH_PIN* pin : static_cast<SCH_COMPONENT*>( aItem )->GetSchPins( &aSheet ) )
+            aList.push_back( pin );
+    }
+    else if( aItem->Type() == SCH_SHEET_T )
+    {
+        for( SCH_SHEET_PIN* pin : static_cast<SCH_SHEET*>( aItem )->GetPins() )
+            aList.push_back( pin );
+    }
+    else
+    {
+        aList.push_back( aItem );
+    }
+}
+
+
+/**
+ * Resets the connection of an item which is rebuilt without updating its graphical
+ * connectivity.  The connection type is set as updateItemConnectivity() would.
+ */
+static void resetItemConnection( SCH_ITEM* aItem, const SCH_SHEET_PATH& aSheet )
+{
+    SCH_CONNECTION* conn = aItem->InitializeConnection( aSheet );
+
+    switch( aItem->Type() )
+    {
+    case SCH_LINE_T:
+        conn->SetType( aItem->GetLayer() == LAYER_BUS ? CONNECTION_TYPE::BUS :
+                                                        CONNECTION_TYPE::NET );
+        break;
+
+    case SCH_BUS_BUS_ENTRY_T:
+        conn->SetType( CONNECTION_TYPE::BUS );
+        break;
+
+    case SCH_BUS_WIRE_ENTRY_T:
+        conn->SetType( CONNECTION_TYPE::NET );
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+/**
+ * Hashes the texts the driver names of a sheet are made of: the sheet path, symbol
+ * references and units, label texts, and sheet and sheet pin names.  They can change without
+ * the items being flagged with SCH_ITEM::IsConnectivityDirty(), for instance when annotating
+ * or editing fields.
+ */
+static size_t driverNameSignature( const SCH_SHEET_PATH& aSheet )
+{
+    std::hash<wxString> hashText;
+    size_t              signature = hashText( aSheet.PathHumanReadable() );
+
+    auto combine =
+            [&]( size_t aHash )
+            {
+                signature ^= aHash + 0x9e3779b9 + ( signature << 6 ) + ( signature >> 2 );
+            };
+
+    for( SCH_ITEM* item : aSheet.LastScreen()->Items() )
+    {
+        switch( item->Type() )
+        {
+        case SCH_COMPONENT_T:
+        {
+            SCH_COMPONENT* component = static_cast<SCH_COMPONENT*>( item );
+
+            combine( hashText( component->GetRef( &aSheet ) ) );
+            combine( hashText( component->GetLibId().Format().wx_str() ) );
+            combine( std::hash<int>()( component->GetUnitSelection( &aSheet ) ) );
+            break;
+        }
+
+        case SCH_LABEL_T:
+        case SCH_GLOBAL_LABEL_T:
+        case SCH_HIER_LABEL_T:
+            combine( hashText( static_cast<SCH_TEXT*>( item )->GetShownText() ) );
+            break;
+
+        case SCH_SHEET_T:
+        {
+            SCH_SHEET* sheet = static_cast<SCH_SHEET*>( item );
+
+            combine( hashText( sheet->GetName() ) );
+
+            for( SCH_SHEET_PIN* pin : sheet->GetPins() )
+                combine( hashText( pin->GetShownText() ) );
+
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    return signature;
+}
+
+
+bool CONNECTION_GRAPH::updateIncremental( const SCH_SHEET_LIST& aSheetList,
+                                          std::function<void( SCH_ITEM* )>* aChangedItemHandler )
+{
+    // Sheets were added, removed or reordered: start over
+    if( m_subgraphs.empty() || aSheetList.size() != m_sheet_paths.size()
+            || !std::equal( aSheetList.begin(), aSheetList.end(), m_sheet_paths.begin() ) )
+    {
+        return false;
+    }
+
+    PROF_COUNTER update_items;
+
+    // A screen must have its connectivity updated if any of its items changed, or if items
+    // were removed from it (which can't be flagged, since they are not there anymore)
+    std::unordered_set<SCH_SCREEN*> checked_screens;
+    std::unordered_set<SCH_SCREEN*> dirty_screens;
+
+    for( const SCH_SHEET_PATH& sheet : aSheetList )
+    {
+        SCH_SCREEN* screen = sheet.LastScreen();
+
+        if( !checked_screens.insert( screen ).second )
+            continue;
+
+        size_t count = 0;
+        bool   dirty = false;
+
+        for( SCH_ITEM* item : screen->Items() )
+        {
+            if( item->IsConnectable() )
+            {
+                count++;
+                dirty |= item->IsConnectivityDirty();
+            }
+        }
+
+        auto previous_count = m_screen_item_counts.find( screen );
+
+        if( dirty || previous_count == m_screen_item_counts.end()
+                || previous_count->second != count )
+        {
+            dirty_screens.insert( screen );
+            m_screen_item_counts[ screen ] = count;
+        }
+    }
+
+    // Changes to the driver names are not always flagged on the items
+    for( const SCH_SHEET_PATH& sheet : aSheetList )
+    {
+        size_t& signature = m_sheet_signatures[ sheet ];
+        size_t  current = driverNameSignature( sheet );
+
+        if( signature != current )
+        {
+            dirty_screens.insert( sheet.LastScreen() );
+            signature = current;
+        }
+    }
+
+    if( dirty_screens.empty() )
+    {
+        m_timings.m_incremental = true;
+        return true;
+    }
+
+    std::unordered_set<SCH_SHEET_PATH> dirty_sheets;
+    std::vector<std::pair<SCH_SHEET_PATH, std::vector<SCH_ITEM*>>> dirty_sheet_items;
+
+    // The graph items now on the dirty sheets.  Those of the removed items are not there.
+    std::unordered_set<SCH_ITEM*> live_items;
+
+    // Names of the global nets the dirty sheets connect to
+    std::unordered_set<wxString> global_names;
+
+    for( const SCH_SHEET_PATH& sheet : aSheetList )
+    {
+        if( !dirty_screens.count( sheet.LastScreen() ) )
+            continue;
+
+        dirty_sheets.insert( sheet );
+        dirty_sheet_items.emplace_back( sheet, std::vector<SCH_ITEM*>() );
+
+        std::vector<SCH_ITEM*> graph_items;
+
+        for( SCH_ITEM* item : sheet.LastScreen()->Items() )
+        {
+            if( !item->IsConnectable() )
+                continue;
+
+            dirty_sheet_items.back().second.push_back( item );
+            getGraphItems( item, sheet, graph_items );
+        }
+
+        for( SCH_ITEM* item : graph_items )
+        {
+            live_items.insert( item );
+
+            if( item->Type() == SCH_GLOBAL_LABEL_T )
+            {
+                global_names.insert( static_cast<SCH_TEXT*>( item )->GetShownText() );
+            }
+            else if( item->Type() == SCH_PIN_T )
+            {
+                SCH_PIN* pin = static_cast<SCH_PIN*>( item );
+
+                if( pin->IsPowerConnection() )
+                    global_names.insert( pin->GetName() );
+            }
+        }
+    }
+
+    // Find the affected subgraphs, starting with those of the dirty sheets and of the
+    // hierarchical links to them
+    std::unordered_set<CONNECTION_SUBGRAPH*> affected;
+    std::vector<CONNECTION_SUBGRAPH*>        search_list;
+
+    auto add_subgraph =
+            [&]( CONNECTION_SUBGRAPH* aSubgraph )
+            {
+                while( aSubgraph->m_absorbed )
+                    aSubgraph = aSubgraph->m_absorbed_by;
+
+                if( affected.insert( aSubgraph ).second )
+                    search_list.push_back( aSubgraph );
+            };
+
+    for( CONNECTION_SUBGRAPH* subgraph : m_subgraphs )
+    {
+        if( dirty_sheets.count( subgraph->m_sheet ) )
+            add_subgraph( subgraph );
+    }
+
+    for( const auto& it : dirty_sheet_items )
+    {
+        const SCH_SHEET_PATH& sheet = it.first;
+
+        if( sheet.size() > 1 )
+        {
+            SCH_SHEET_PATH parent = sheet;
+            parent.pop_back();
+
+            if( !dirty_sheets.count( parent ) && m_sheet_to_subgraphs_map.count( parent ) )
+            {
+                for( CONNECTION_SUBGRAPH* candidate : m_sheet_to_subgraphs_map.at( parent ) )
+                {
+                    for( SCH_SHEET_PIN* pin : candidate->m_hier_pins )
+                    {
+                        if( pin->GetParent() == sheet.Last() )
+                        {
+                            add_subgraph( candidate );
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        for( SCH_ITEM* item : it.second )
+        {
+            if( item->Type() != SCH_SHEET_T )
+                continue;
+
+            SCH_SHEET_PATH child = sheet;
+            child.push_back( static_cast<SCH_SHEET*>( item ) );
+
+            if( !dirty_sheets.count( child ) && m_sheet_to_subgraphs_map.count( child ) )
+            {
+                for( CONNECTION_SUBGRAPH* candidate : m_sheet_to_subgraphs_map.at( child ) )
+                {
+                    if( !candidate->m_hier_ports.empty() )
+                        add_subgraph( candidate );
+                }
+            }
+        }
+    }
+
+    // Then everything sharing a net name, a bus link or a hierarchical link with them
+    std::unordered_map<wxString, std::vector<CONNECTION_SUBGRAPH*>> name_to_subgraphs;
+    std::unordered_map<CONNECTION_SUBGRAPH*, std::vector<CONNECTION_SUBGRAPH*>> hier_children;
+    std::unordered_set<wxString> searched_names;
+
+    for( CONNECTION_SUBGRAPH* subgraph : m_driver_subgraphs )
+    {
+        if( !subgraph->m_cached_name.IsEmpty() )
+            name_to_subgraphs[subgraph->m_cached_name].push_back( subgraph );
+
+        if( CONNECTION_SUBGRAPH* parent = subgraph->m_hier_parent )
+        {
+            while( parent->m_absorbed )
+                parent = parent->m_absorbed_by;
+
+            hier_children[parent].push_back( subgraph );
+        }
+    }
+
+    auto add_name =
+            [&]( const wxString& aName )
+            {
+                if( aName.IsEmpty() || !searched_names.insert( aName ).second )
+                    return;
+
+                auto it = name_to_subgraphs.find( aName );
+
+                if( it != name_to_subgraphs.end() )
+                {
+                    for( CONNECTION_SUBGRAPH* subgraph : it->second )
+                        add_subgraph( subgraph );
+                }
+            };
+
+    for( const wxString& name : global_names )
+        add_name( name );
+
+    for( size_t ii = 0; ii < search_list.size(); ii++ )
+    {
+        CONNECTION_SUBGRAPH* subgraph = search_list[ii];
+
+        add_name( subgraph->m_cached_name );
+
+        if( subgraph->m_hier_parent )
+            add_subgraph( subgraph->m_hier_parent );
+
+        auto children = hier_children.find( subgraph );
+
+        if( children != hier_children.end() )
+        {
+            for( CONNECTION_SUBGRAPH* child : children->second )
+                add_subgraph( child );
+        }
+
+        for( const auto& kv : subgraph->m_bus_neighbors )
+        {
+            for( CONNECTION_SUBGRAPH* neighbor : kv.second )
+                add_subgraph( neighbor );
+        }
+
+        for( const auto& kv : subgraph->m_bus_parents )
+        {
+            for( CONNECTION_SUBGRAPH* parent : kv.second )
+                add_subgraph( parent );
+        }
+    }
+
+    // Past this point, rebuilding everything is cheaper
+    if( affected.size() > m_subgraphs.size() / 2 )
+    {
+        wxLogTrace( traceConnectivityProfile, "%zu of %zu subgraphs affected, recalculating all",
+                    affected.size(), m_subgraphs.size() );
+        return false;
+    }
+
+    // Collect the items to rebuild, remembering their previous connections, and reset those
+    // which are not on a dirty sheet (updateItemConnectivity() handles the others)
+    struct PREVIOUS_CONNECTION
+    {
+        SCH_CONNECTION* m_connection;
+        wxString        m_name;
+        int             m_net_code;
+    };
+
+    std::unordered_set<SCH_ITEM*> rebuild_items;
+    std::unordered_map<SCH_ITEM*, std::vector<PREVIOUS_CONNECTION>> previous;
+
+    for( CONNECTION_SUBGRAPH* subgraph : affected )
+    {
+        bool on_dirty_sheet = dirty_sheets.count( subgraph->m_sheet );
+
+        for( SCH_ITEM* item : subgraph->m_items )
+        {
+            if( on_dirty_sheet && !live_items.count( item ) )
+            {
+                m_items.erase( item );
+                continue;
+            }
+
+            if( rebuild_items.insert( item ).second && aChangedItemHandler )
+            {
+                for( const auto& it : item->m_connection_map )
+                {
+                    previous[item].push_back( { it.second, it.second->Name(),
+                                                it.second->NetCode() } );
+                }
+            }
+
+            if( on_dirty_sheet )
+                continue;
+
+            for( const auto& it : item->m_connection_map )
+            {
+                if( it.second->SubgraphCode() == subgraph->m_code )
+                    resetItemConnection( item, it.first );
+            }
+        }
+    }
+
+    removeSubgraphs( affected );
+
+    m_invisible_power_pins.erase(
+            std::remove_if( m_invisible_power_pins.begin(), m_invisible_power_pins.end(),
+                    [&]( const std::pair<SCH_SHEET_PATH, SCH_PIN*>& aEntry )
+                    {
+                        return dirty_sheets.count( aEntry.first ) > 0;
+                    } ),
+            m_invisible_power_pins.end() );
+
+    updateSheetConnectivity( dirty_sheet_items );
+
+    rebuild_items.insert( live_items.begin(), live_items.end() );
+
+    update_items.Stop();
+    m_timings.m_updateItems = update_items.msecs();
+    m_timings.m_incremental = true;
+
+    wxLogTrace( traceConnectivityProfile,
+                "Incremental update of %zu sheets on %zu threads, %zu subgraphs: %0.4f ms",
+                m_timings.m_sheetCount, m_timings.m_threadCount, affected.size(),
+                m_timings.m_updateItems );
+
+    PROF_COUNTER build_graph;
+
+    buildConnectionGraph( rebuild_items );
+
+    build_graph.Stop();
+    m_timings.m_buildGraph = build_graph.msecs();
+
+    wxLogTrace( traceConnectivityProfile, "BuildConnectionGraph() %0.4f ms",
+                m_timings.m_buildGraph );
+
+    if( aChangedItemHandler )
+    {
+        for( SCH_ITEM* item : rebuild_items )
+        {
+            auto it = previous.find( item );
+            bool changed = ( it == previous.end() );
+
+            for( size_t ii = 0; !changed && ii < it->second.size(); ii++ )
+            {
+                const PREVIOUS_CONNECTION& prev = it->second[ii];
+
+                changed = prev.m_connection->Name() != prev.m_name
+                          || prev.m_connection->NetCode() != prev.m_net_code;
+            }
+
+            if( changed )
+                ( *aChangedItemHandler )( item );
+        }
+    }
+
+    return true;
+}
+
+
+void CONNECTION_GRAPH::removeSubgraphs( const std::unordered_set<CONNECTION_SUBGRAPH*>& aSubgraphs )
+{
+    std::unordered_set<const CONNECTION_SUBGRAPH*> removed( aSubgraphs.begin(),
+                                                            aSubgraphs.end() );
+
+    auto is_removed =
+            [&]( const CONNECTION_SUBGRAPH* aSubgraph )
+            {
+                return removed.count( aSubgraph ) > 0;
+            };
+
+    // The absorbed subgraphs go along with the subgraph that absorbed them
+    std::vector<CONNECTION_SUBGRAPH*> absorbed;
+
+    for( CONNECTION_SUBGRAPH* subgraph : m_absorbed_subgraphs )
+    {
+        CONNECTION_SUBGRAPH* absorber = subgraph;
+
+        while( absorber->m_absorbed )
+            absorber = absorber->m_absorbed_by;
+
+        if( aSubgraphs.count( absorber ) )
+        {
+            removed.insert( subgraph );
+            absorbed.push_back( subgraph );
+        }
+    }
+
+    m_absorbed_subgraphs.erase( std::remove_if( m_absorbed_subgraphs.begin(),
+                                                m_absorbed_subgraphs.end(), is_removed ),
+                                m_absorbed_subgraphs.end() );
+
+    m_subgraphs.erase( std::remove_if( m_subgraphs.begin(), m_subgraphs.end(), is_removed ),
+                       m_subgraphs.end() );
+
+    m_driver_subgraphs.erase( std::remove_if( m_driver_subgraphs.begin(),
+                                              m_driver_subgraphs.end(), is_removed ),
+                              m_driver_subgraphs.end() );
+
+    auto purge =
+            [&]( auto& aMap )
+            {
+                for( auto it = aMap.begin(); it != aMap.end(); )
+                {
+                    auto& vec = it->second;
+                    vec.erase( std::remove_if( vec.begin(), vec.end(), is_removed ), vec.end() );
+
+                    if( vec.empty() )
+                        it = aMap.erase( it );
+                    else
+                        ++it;
+                }
+            };
+
+    purge( m_sheet_to_subgraphs_map );
+    purge( m_net_name_to_subgraphs_map );
+    purge( m_global_label_cache );
+    purge( m_local_label_cache );
+    purge( m_net_code_to_subgraphs_map );
+
+    for( CONNECTION_SUBGRAPH* subgraph : absorbed )
+        delete subgraph;
+
+    for( CONNECTION_SUBGRAPH* subgraph : aSubgraphs )
+        delete subgraph;
+}
+
+
+void CONNECTION_GRAPH::recordSheets( const SCH_SHEET_LIST& aSheetList )
+{
+    m_sheet_paths.assign( aSheetList.begin(), aSheetList.end() );
+    m_screen_item_counts.clear();
+    m_sheet_signatures.clear();
+
+    for( const SCH_SHEET_PATH& sheet : aSheetList )
+    {
+        m_sheet_signatures[ sheet ] = driverNameSignature( sheet );
+
+        size_t& count = m_screen_item_counts[ sheet.LastScreen() ];
+        count = 0;
+
+        for( SCH_ITEM* item : sheet.LastScreen()->Items() )
+        {
+            if( item->IsConnectable() )
+                count++;
+        }
+    }
+}
+
+
+void CONNECTION_GRAPH::updateSheetConnectivity(
+        const std::vector<std::pair<SCH_SHEET_PATH, std::vector<SCH_ITEM*>>>& aSheets )
+{
+    // Sheets sharing a screen share their items, so each group of sheets using the same
+    // screen is handled by a single thread
+    std::vector<std::vector<size_t>> screen_groups;
+    std::unordered_map<SCH_SCREEN*, size_t> screen_group_index;
+
+    for( size_t ii = 0; ii < aSheets.size(); ii++ )
+    {
+        auto result = screen_group_index.emplace( aSheets[ii].first.LastScreen(),
+                                                  screen_groups.size() );
+
+        if( result.second )
+            screen_groups.emplace_back();
+
+        screen_groups[ result.first->second ].push_back( ii );
+    }
+
+    // Per-sheet results, merged once all the threads are done
+    std::vector<std::vector<SCH_ITEM*>> graph_items( aSheets.size() );
+    std::vector<std::vector<std::pair<SCH_SHEET_PATH, SCH_PIN*>>> power_pins( aSheets.size() );
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   screen_groups.size() );
+
+    std::atomic<size_t> nextGroup( 0 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto update_lambda = [&]() -> size_t
+    {
+        for( size_t groupId = nextGroup++; groupId < screen_groups.size(); groupId = nextGroup++ )
+        {
+            for( size_t ii : screen_groups[groupId] )
+            {
+                const SCH_SHEET_PATH& sheet = aSheets[ii].first;
+
+                updateItemConnectivity( sheet, aSheets[ii].second, graph_items[ii],
+                                        power_pins[ii] );
+
+                // UpdateDanglingState() also adds connected items for SCH_TEXT
+                sheet.LastScreen()->TestDanglingEnds( &sheet );
+            }
+        }
+
+        return 1;
+    };
+
+    if( parallelThreadCount <= 1 )
+        update_lambda();
+    else
+    {
+        for( size_t ii = 0; ii < parallelThreadCount; ii++ )
+            returns[ii] = std::async( std::launch::async, update_lambda );
+
+        // Finalize the threads
+        for( size_t ii = 0; ii < parallelThreadCount; ii++ )
+            returns[ii].wait();
+    }
+
+    // Merge in sheet order, so that the net codes don't depend on the thread scheduling
+    for( size_t ii = 0; ii < aSheets.size(); ii++ )
+    {
+        m_items.insert( graph_items[ii].begin(), graph_items[ii].end() );
+        m_invisible_power_pins.insert( m_invisible_power_pins.end(), power_pins[ii].begin(),
+                                       power_pins[ii].end() );
+    }
+
+    m_timings.m_sheetCount = aSheets.size();
+    m_timings.m_threadCount = std::max<size_t>( parallelThreadCount, 1 );
+}
+
+
 void CONNECTION_GRAPH::updateItemConnectivity( SCH_SHEET_PATH aSheet,
-                                               const std::vector<SCH_ITEM*>& aItemList )
+        const std::vector<SCH_ITEM*>& aItemList, std::vector<SCH_ITEM*>& aGraphItems,
+        std::vector<std::pair<SCH_SHEET_PATH, SCH_PIN*>>& aInvisiblePowerPins )
 {
     std::unordered_map< wxPoint, std::vector<SCH_ITEM*> > connection_map;
 
@@ -438,7 +1091,7 @@ void CONNECTION_GRAPH::updateItemConnectivity( SCH_SHEET_PATH aSheet,
                 pin->Connection( aSheet )->Reset();
 
                 connection_map[ pin->GetTextPos() ].push_back( pin );
-                m_items.insert( pin );
+                aGraphItems.push_back( pin );
             }
         }
         else if( item->Type() == SCH_COMPONENT_T )
@@ -465,15 +1118,15 @@ void CONNECTION_GRAPH::updateItemConnectivity( SCH_SHEET_PATH aSheet,
                 // Invisible power pins need to be post-processed later
 
                 if( pin->IsPowerConnection() && !pin->IsVisible() )
-                    m_invisible_power_pins.emplace_back( std::make_pair( aSheet, pin ) );
+                    aInvisiblePowerPins.emplace_back( std::make_pair( aSheet, pin ) );
 
                 connection_map[ pos ].push_back( pin );
-                m_items.insert( pin );
+                aGraphItems.push_back( pin );
             }
         }
         else
         {
-            m_items.insert( item );
+            aGraphItems.push_back( item );
             auto conn = item->InitializeConnection( aSheet );
 
             // Set bus/net property here so that the propagation code uses it
@@ -633,7 +1286,7 @@ void CONNECTION_GRAPH::updateItemConnectivity( SCH_SHEET_PATH aSheet,
 //     on some portion of the items.
 
 
-void CONNECTION_GRAPH::buildConnectionGraph()
+void CONNECTION_GRAPH::buildConnectionGraph( const std::unordered_set<SCH_ITEM*>& aItems )
 {
     // Recache all bus aliases for later use
 
@@ -645,9 +1298,12 @@ void CONNECTION_GRAPH::buildConnectionGraph()
             m_bus_alias_cache[ alias->GetName() ] = alias;
     }
 
-    // Build subgraphs from items (on a per-sheet basis)
+    // Build subgraphs from items (on a per-sheet basis).  The subgraphs already in the graph
+    // are kept; the new ones are added from first_new_subgraph on.
 
-    for( SCH_ITEM* item : m_items )
+    const size_t first_new_subgraph = m_subgraphs.size();
+
+    for( SCH_ITEM* item : aItems )
     {
         for( const auto& it : item->m_connection_map )
         {
@@ -729,20 +1385,22 @@ void CONNECTION_GRAPH::buildConnectionGraph()
 
     // Resolve drivers for subgraphs and propagate connectivity info
 
-    // We don't want to spin up a new thread for fewer than 8 nets (overhead costs)
-    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
-            ( m_subgraphs.size() + 3 ) / 4 );
-
-    std::atomic<size_t> nextSubgraph( 0 );
-    std::vector<std::future<size_t>> returns( parallelThreadCount );
     std::vector<CONNECTION_SUBGRAPH*> dirty_graphs;
 
-    std::copy_if( m_subgraphs.begin(), m_subgraphs.end(), std::back_inserter( dirty_graphs ),
+    std::copy_if( m_subgraphs.begin() + first_new_subgraph, m_subgraphs.end(),
+                  std::back_inserter( dirty_graphs ),
                   [&] ( const CONNECTION_SUBGRAPH* candidate )
                   {
                       return candidate->m_dirty;
                   } );
 
+    // We don't want to spin up a new thread for fewer than 8 nets (overhead costs)
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+            ( dirty_graphs.size() + 3 ) / 4 );
+
+    std::atomic<size_t> nextSubgraph( 0 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
     auto update_lambda = [&nextSubgraph, &dirty_graphs]() -> size_t
     {
         for( size_t subgraphId = nextSubgraph++; subgraphId < dirty_graphs.size(); subgraphId = nextSubgraph++ )
@@ -832,7 +1490,7 @@ void CONNECTION_GRAPH::buildConnectionGraph()
         return 1;
     };
 
-    if( parallelThreadCount == 1 )
+    if( parallelThreadCount <= 1 )
         update_lambda();
     else
     {
@@ -844,19 +1502,26 @@ void CONNECTION_GRAPH::buildConnectionGraph()
             returns[ii].wait();
     }
 
-    // Now discard any non-driven subgraphs from further consideration
+    // Now discard any non-driven subgraphs from further consideration.  driver_subgraphs holds
+    // the new ones, which are processed below; m_driver_subgraphs holds all of them.
+
+    std::vector<CONNECTION_SUBGRAPH*> driver_subgraphs;
 
-    std::copy_if( m_subgraphs.begin(), m_subgraphs.end(), std::back_inserter( m_driver_subgraphs ),
+    std::copy_if( m_subgraphs.begin() + first_new_subgraph, m_subgraphs.end(),
+                  std::back_inserter( driver_subgraphs ),
                   [&] ( const CONNECTION_SUBGRAPH* candidate ) -> bool
                   {
                       return candidate->m_driver;
                   } );
 
+    m_driver_subgraphs.insert( m_driver_subgraphs.end(), driver_subgraphs.begin(),
+                               driver_subgraphs.end() );
+
     // Check for subgraphs with the same net name but only weak drivers.
     // For example, two wires that are both connected to hierarchical
     // sheet pins that happen to have the same name, but are not the same.
 
-    for( auto&& subgraph : m_driver_subgraphs )
+    for( auto&& subgraph : driver_subgraphs )
     {
         wxString full_name = subgraph->m_driver_connection->Name();
         wxString name = subgraph->m_driver_connection->Name( true );
@@ -949,6 +1614,7 @@ void CONNECTION_GRAPH::buildConnectionGraph()
             m_net_code_to_subgraphs_map[ key ].push_back( subgraph );
             m_subgraphs.push_back( subgraph );
             m_driver_subgraphs.push_back( subgraph );
+            driver_subgraphs.push_back( subgraph );
 
             invisible_pin_subgraphs[code] = subgraph;
         }
@@ -963,12 +1629,12 @@ void CONNECTION_GRAPH::buildConnectionGraph()
     // codes, merging subgraphs together that use label connections, etc.
 
     // Cache remaining valid subgraphs by sheet path
-    for( auto subgraph : m_driver_subgraphs )
+    for( auto subgraph : driver_subgraphs )
         m_sheet_to_subgraphs_map[ subgraph->m_sheet ].emplace_back( subgraph );
 
     std::unordered_set<CONNECTION_SUBGRAPH*> invalidated_subgraphs;
 
-    for( CONNECTION_SUBGRAPH* subgraph : m_driver_subgraphs )
+    for( CONNECTION_SUBGRAPH* subgraph : driver_subgraphs )
     {
         if( subgraph->m_absorbed )
             continue;
@@ -1261,13 +1927,19 @@ void CONNECTION_GRAPH::buildConnectionGraph()
     }
 
     // Absorbed subgraphs should no longer be considered
+    auto is_absorbed = [&] ( const CONNECTION_SUBGRAPH* candidate ) -> bool
+                       {
+                           return candidate->m_absorbed;
+                       };
+
     m_driver_subgraphs.erase( std::remove_if( m_driver_subgraphs.begin(), m_driver_subgraphs.end(),
-                              [&] ( const CONNECTION_SUBGRAPH* candidate ) -> bool
-                              {
-                                  return candidate->m_absorbed;
-                              } ),
+                                              is_absorbed ),
                               m_driver_subgraphs.end() );
 
+    driver_subgraphs.erase( std::remove_if( driver_subgraphs.begin(), driver_subgraphs.end(),
+                                            is_absorbed ),
+                            driver_subgraphs.end() );
+
     // Store global subgraphs for later reference
     std::vector<CONNECTION_SUBGRAPH*> global_subgraphs;
     std::copy_if( m_driver_subgraphs.begin(), m_driver_subgraphs.end(),
@@ -1286,7 +1958,7 @@ void CONNECTION_GRAPH::buildConnectionGraph()
     // connecting bus members to their neighboring subgraphs, and then propagate connections
     // through the hierarchy
 
-    for( auto subgraph : m_driver_subgraphs )
+    for( auto subgraph : driver_subgraphs )
     {
         if( !subgraph->m_dirty )
             continue;
@@ -1348,7 +2020,7 @@ void CONNECTION_GRAPH::buildConnectionGraph()
     // we need to identify the appropriate bus members to link together (and their final names),
     // and then update all instances of the old name in the hierarchy.
 
-    for( CONNECTION_SUBGRAPH* subgraph : m_driver_subgraphs )
+    for( CONNECTION_SUBGRAPH* subgraph : driver_subgraphs )
     {
         if( subgraph->m_bus_parents.size() < 2 )
             continue;
@@ -1414,6 +2086,8 @@ void CONNECTION_GRAPH::buildConnectionGraph()
             subgraph->m_dirty = false;
         }
 
+        subgraph->m_cached_name = subgraph->m_driver_connection->Name();
+
         if( subgraph->m_driver_connection->IsBus() )
             continue;
 
@@ -1422,13 +2096,14 @@ void CONNECTION_GRAPH::buildConnectionGraph()
         m_net_code_to_subgraphs_map[ key ].push_back( subgraph );
     }
 
-    // Clean up and deallocate stale subgraphs
+    // Set aside the stale subgraphs.  They are deleted along with the subgraph that absorbed
+    // them, since the label caches still refer to them.
     m_subgraphs.erase( std::remove_if( m_subgraphs.begin(), m_subgraphs.end(),
-            [&]( const CONNECTION_SUBGRAPH* sg )
+            [&]( CONNECTION_SUBGRAPH* sg )
             {
                 if( sg->m_absorbed )
                 {
-                    delete sg;
+                    m_absorbed_subgraphs.push_back( sg );
                     return true;
                 }
                 else
@@ -1918,55 +2593,149 @@ std::vector<const CONNECTION_SUBGRAPH*> CONNECTION_GRAPH::GetBusesNeedingMigrati
 
 int CONNECTION_GRAPH::RunERC()
 {
-    int error_count = 0;
+    // Graph is supposed to be up-to-date before calling RunERC()
+    wxASSERT( std::none_of( m_subgraphs.begin(), m_subgraphs.end(),
+                            []( const CONNECTION_SUBGRAPH* aSubgraph )
+                            {
+                                return aSubgraph->m_dirty;
+                            } ) );
+
+    bool checkDrivers = g_ErcSettings->IsTestEnabled( ERCE_DRIVER_CONFLICT );
+    bool checkBusToNet = g_ErcSettings->IsTestEnabled( ERCE_BUS_TO_NET_CONFLICT );
+    bool checkBusEntries = g_ErcSettings->IsTestEnabled( ERCE_BUS_ENTRY_CONFLICT );
+    bool checkBusToBus = g_ErcSettings->IsTestEnabled( ERCE_BUS_TO_BUS_CONFLICT );
+    bool checkLabels = g_ErcSettings->IsTestEnabled( ERCE_LABEL_NOT_CONNECTED )
+                       || g_ErcSettings->IsTestEnabled( ERCE_GLOBLABEL );
+
+    // The subgraphs are checked concurrently.  Each thread keeps its own list of violations,
+    // tagged with the index of the subgraph, and the lists are merged in subgraph order at the
+    // end so that the markers don't depend on the thread scheduling.
+    typedef std::vector<std::pair<size_t, ERC_VIOLATION>> INDEXED_VIOLATIONS;
+
+    // We don't want to spin up a new thread for fewer than 8 subgraphs (overhead costs)
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+            ( m_subgraphs.size() + 3 ) / 4 );
 
-    for( auto&& subgraph : m_subgraphs )
+    parallelThreadCount = std::max<size_t>( parallelThreadCount, 1 );
+
+    std::vector<INDEXED_VIOLATIONS> threadViolations( parallelThreadCount );
+    std::vector<int>                threadErrorCounts( parallelThreadCount, 0 );
+    std::atomic<size_t>             nextSubgraph( 0 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    // Driver resolution updates the subgraphs, and the label check looks at the drivers of
+    // the hierarchical parent of a subgraph, so drivers are resolved in a first pass
+    auto drivers_lambda = [&]( size_t aThread ) -> size_t
     {
-        // Graph is supposed to be up-to-date before calling RunERC()
-        wxASSERT( !subgraph->m_dirty );
+        for( size_t ii = nextSubgraph++; ii < m_subgraphs.size(); ii = nextSubgraph++ )
+        {
+            if( checkDrivers && !m_subgraphs[ii]->ResolveDrivers() )
+                threadErrorCounts[aThread]++;
+        }
+
+        return 1;
+    };
+
+    auto checks_lambda = [&]( size_t aThread ) -> size_t
+    {
+        ERC_VIOLATIONS violations;
+
+        for( size_t ii = nextSubgraph++; ii < m_subgraphs.size(); ii = nextSubgraph++ )
+        {
+            const CONNECTION_SUBGRAPH* subgraph = m_subgraphs[ii];
+            int&                       errorCount = threadErrorCounts[aThread];
+
+            /**
+             * NOTE:
+             *
+             * We could check that labels attached to bus subgraphs follow the
+             * proper format (i.e. actually define a bus).
+             *
+             * This check doesn't need to be here right now because labels
+             * won't actually be connected to bus wires if they aren't in the right
+             * format due to their TestDanglingEnds() implementation.
+             */
 
-        /**
-         * NOTE:
-         *
-         * We could check that labels attached to bus subgraphs follow the
-         * proper format (i.e. actually define a bus).
-         *
-         * This check doesn't need to be here right now because labels
-         * won't actually be connected to bus wires if they aren't in the right
-         * format due to their TestDanglingEnds() implementation.
-         */
+            if( checkBusToNet && !ercCheckBusToNetConflicts( subgraph, violations ) )
+                errorCount++;
 
-        if( g_ErcSettings->IsTestEnabled( ERCE_DRIVER_CONFLICT ) && !subgraph->ResolveDrivers() )
-            error_count++;
+            if( checkBusEntries && !ercCheckBusToBusEntryConflicts( subgraph, violations ) )
+                errorCount++;
 
-        if( g_ErcSettings->IsTestEnabled( ERCE_BUS_TO_NET_CONFLICT )
-                && !ercCheckBusToNetConflicts( subgraph ) )
-            error_count++;
+            if( checkBusToBus && !ercCheckBusToBusConflicts( subgraph, violations ) )
+                errorCount++;
 
-        if( g_ErcSettings->IsTestEnabled( ERCE_BUS_ENTRY_CONFLICT )
-                && !ercCheckBusToBusEntryConflicts( subgraph ) )
-            error_count++;
+            // The following checks are always performed since they don't currently
+            // have an option exposed to the user
 
-        if( g_ErcSettings->IsTestEnabled( ERCE_BUS_TO_BUS_CONFLICT )
-                && !ercCheckBusToBusConflicts( subgraph ) )
-            error_count++;
+            if( !ercCheckNoConnects( subgraph, violations ) )
+                errorCount++;
 
-        // The following checks are always performed since they don't currently
-        // have an option exposed to the user
+            if( checkLabels && !ercCheckLabels( subgraph, violations ) )
+                errorCount++;
 
-        if( !ercCheckNoConnects( subgraph ) )
-            error_count++;
+            for( const ERC_VIOLATION& violation : violations )
+                threadViolations[aThread].emplace_back( ii, violation );
 
-        if( ( g_ErcSettings->IsTestEnabled( ERCE_LABEL_NOT_CONNECTED )
-                || g_ErcSettings->IsTestEnabled( ERCE_GLOBLABEL ) ) && !ercCheckLabels( subgraph ) )
-            error_count++;
+            violations.clear();
+        }
+
+        return 1;
+    };
+
+    for( const auto& pass : { std::function<size_t( size_t )>( drivers_lambda ),
+                              std::function<size_t( size_t )>( checks_lambda ) } )
+    {
+        nextSubgraph = 0;
+
+        if( parallelThreadCount == 1 )
+            pass( 0 );
+        else
+        {
+            for( size_t ii = 0; ii < parallelThreadCount; ii++ )
+                returns[ii] = std::async( std::launch::async, pass, ii );
+
+            // Finalize the threads
+            for( size_t ii = 0; ii < parallelThreadCount; ii++ )
+                returns[ii].wait();
+        }
     }
 
+    // Merge the violations found by each thread, in subgraph order, and create the markers
+    INDEXED_VIOLATIONS violations;
+
+    for( INDEXED_VIOLATIONS& list : threadViolations )
+        violations.insert( violations.end(), list.begin(), list.end() );
+
+    std::stable_sort( violations.begin(), violations.end(),
+                      []( const std::pair<size_t, ERC_VIOLATION>& a,
+                          const std::pair<size_t, ERC_VIOLATION>& b )
+                      {
+                          return a.first < b.first;
+                      } );
+
+    for( const auto& it : violations )
+    {
+        const ERC_VIOLATION& violation = it.second;
+
+        ERC_ITEM* ercItem = new ERC_ITEM( violation.m_errorCode );
+        ercItem->SetItems( violation.m_mainItem, violation.m_auxItem );
+
+        SCH_MARKER* marker = new SCH_MARKER( ercItem, violation.m_position );
+        violation.m_screen->Append( marker );
+    }
+
+    int error_count = 0;
+
+    for( int count : threadErrorCounts )
+        error_count += count;
+
     return error_count;
 }
 
 
-bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSubgraph )
+bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
+                                                  ERC_VIOLATIONS& aViolations )
 {
     auto sheet = aSubgraph->m_sheet;
     auto screen = sheet.LastScreen();
@@ -2009,11 +2778,8 @@ bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSu
 
     if( net_item && bus_item )
     {
-        ERC_ITEM* ercItem = new ERC_ITEM( ERCE_BUS_TO_NET_CONFLICT );
-        ercItem->SetItems( net_item, bus_item );
-
-        SCH_MARKER* marker = new SCH_MARKER( ercItem, net_item->GetPosition() );
-        screen->Append( marker );
+        aViolations.push_back( { ERCE_BUS_TO_NET_CONFLICT, net_item, bus_item,
+                                 net_item->GetPosition(), screen } );
 
         return false;
     }
@@ -2022,7 +2788,8 @@ bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSu
 }
 
 
-bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSubgraph )
+bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
+                                                  ERC_VIOLATIONS& aViolations )
 {
     wxString msg;
     auto sheet = aSubgraph->m_sheet;
@@ -2077,11 +2844,8 @@ bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSu
 
         if( !match )
         {
-            ERC_ITEM* ercItem = new ERC_ITEM( ERCE_BUS_TO_BUS_CONFLICT );
-            ercItem->SetItems( label, port );
-
-            SCH_MARKER* marker = new SCH_MARKER( ercItem, label->GetPosition() );
-            screen->Append( marker );
+            aViolations.push_back( { ERCE_BUS_TO_BUS_CONFLICT, label, port, label->GetPosition(),
+                                     screen } );
 
             return false;
         }
@@ -2091,7 +2855,8 @@ bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSu
 }
 
 
-bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH* aSubgraph )
+bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
+                                                       ERC_VIOLATIONS& aViolations )
 {
     bool conflict = false;
     auto sheet = aSubgraph->m_sheet;
@@ -2157,11 +2922,8 @@ bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH
 
     if( conflict )
     {
-        ERC_ITEM* ercItem = new ERC_ITEM( ERCE_BUS_ENTRY_CONFLICT );
-        ercItem->SetItems( bus_entry, bus_wire );
-
-        SCH_MARKER* marker = new SCH_MARKER( ercItem, bus_entry->GetPosition() );
-        screen->Append( marker );
+        aViolations.push_back( { ERCE_BUS_ENTRY_CONFLICT, bus_entry, bus_wire,
+                                 bus_entry->GetPosition(), screen } );
 
         return false;
     }
@@ -2171,7 +2933,8 @@ bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH
 
 
 // TODO(JE) Check sheet pins here too?
-bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph )
+bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
+                                           ERC_VIOLATIONS& aViolations )
 {
     wxString msg;
     auto sheet = aSubgraph->m_sheet;
@@ -2210,22 +2973,16 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
 
         if( pin && has_invalid_items )
         {
-            ERC_ITEM* ercItem = new ERC_ITEM( ERCE_NOCONNECT_CONNECTED );
-            ercItem->SetItems( pin );
-
-            SCH_MARKER* marker = new SCH_MARKER( ercItem, pin->GetTransformedPosition() );
-            screen->Append( marker );
+            aViolations.push_back( { ERCE_NOCONNECT_CONNECTED, pin, nullptr,
+                                     pin->GetTransformedPosition(), screen } );
 
             return false;
         }
 
         if( !has_other_items )
         {
-            ERC_ITEM* ercItem = new ERC_ITEM( ERCE_NOCONNECT_NOT_CONNECTED );
-            ercItem->SetItems( aSubgraph->m_no_connect );
-
-            SCH_MARKER* marker = new SCH_MARKER( ercItem, aSubgraph->m_no_connect->GetPosition() );
-            screen->Append( marker );
+            aViolations.push_back( { ERCE_NOCONNECT_NOT_CONNECTED, aSubgraph->m_no_connect,
+                                     nullptr, aSubgraph->m_no_connect->GetPosition(), screen } );
 
             return false;
         }
@@ -2276,11 +3033,8 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
 
         if( pin && !has_other_connections && pin->GetType() != ELECTRICAL_PINTYPE::PT_NC )
         {
-            ERC_ITEM* ercItem = new ERC_ITEM( ERCE_PIN_NOT_CONNECTED );
-            ercItem->SetItems( pin );
-
-            SCH_MARKER* marker = new SCH_MARKER( ercItem, pin->GetTransformedPosition() );
-            screen->Append( marker );
+            aViolations.push_back( { ERCE_PIN_NOT_CONNECTED, pin, nullptr,
+                                     pin->GetTransformedPosition(), screen } );
 
             return false;
         }
@@ -2290,7 +3044,8 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
 }
 
 
-bool CONNECTION_GRAPH::ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph )
+bool CONNECTION_GRAPH::ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph,
+                                       ERC_VIOLATIONS& aViolations )
 {
     // Label connection rules:
     // Local labels are flagged if they don't connect to any pins and don't have a no-connect
@@ -2368,11 +3123,8 @@ bool CONNECTION_GRAPH::ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph )
 
     if( !has_other_connections )
     {
-        ERC_ITEM* ercItem = new ERC_ITEM( is_global ? ERCE_GLOBLABEL : ERCE_LABEL_NOT_CONNECTED );
-        ercItem->SetItems( text );
-
-        SCH_MARKER* marker = new SCH_MARKER( ercItem, text->GetPosition() );
-        aSubgraph->m_sheet.LastScreen()->Append( marker );
+        aViolations.push_back( { is_global ? ERCE_GLOBLABEL : ERCE_LABEL_NOT_CONNECTED, text,
+                                 nullptr, text->GetPosition(), aSubgraph->m_sheet.LastScreen() } );
 
         return false;
     }
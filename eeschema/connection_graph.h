@@ -21,6 +21,7 @@
 #ifndef _CONNECTION_GRAPH_H
 #define _CONNECTION_GRAPH_H
 
+#include <functional>
 #include <mutex>
 #include <vector>
 
@@ -196,6 +197,55 @@ public:
 
     // If not null, this indicates the subgraph on a higher level sheet that is linked to this one
     CONNECTION_SUBGRAPH* m_hier_parent;
+
+    /**
+     * The final name of the driver connection when the graph was last built.  Incremental
+     * updates use it to find the subgraphs of a net without touching the items, which may
+     * have been deleted since.
+     */
+    wxString m_cached_name;
+};
+
+/**
+ * Phase timings and sizes of the last CONNECTION_GRAPH::Recalculate() call.
+ *
+ * Times are in milliseconds.  They are also reported through the #traceConnectivityProfile
+ * trace mask.
+ */
+struct CONNECTION_GRAPH_TIMINGS
+{
+    CONNECTION_GRAPH_TIMINGS()
+    {
+        Clear();
+    }
+
+    void Clear()
+    {
+        m_updateItems = 0.0;
+        m_buildGraph = 0.0;
+        m_total = 0.0;
+        m_sheetCount = 0;
+        m_threadCount = 0;
+        m_incremental = false;
+    }
+
+    ///> Time spent updating item connectivity and dangling ends on each sheet
+    double m_updateItems;
+
+    ///> Time spent building the subgraphs and resolving and propagating their drivers
+    double m_buildGraph;
+
+    ///> Total time of the recalculation
+    double m_total;
+
+    ///> Number of sheets whose item connectivity was updated
+    size_t m_sheetCount;
+
+    ///> Number of threads used to update the sheets
+    size_t m_threadCount;
+
+    ///> True if only a part of the graph was updated
+    bool m_incremental;
 };
 
 /// Associates a net code with the final name of a net
@@ -227,10 +277,19 @@ public:
     /**
      * Updates the connection graph for the given list of sheets.
      *
-     * @param aSheetList is the list of possibly modified sheets
+     * Unless aUnconditional is set, only the sheets holding items flagged with
+     * SCH_ITEM::IsConnectivityDirty() (or from which items were removed) have their graphical
+     * connectivity updated, and only the subgraphs of the nets touching those sheets are
+     * rebuilt and propagated again.  The whole graph is rebuilt if the hierarchy changed or if
+     * most of the graph would be affected anyway.
+     *
+     * @param aSheetList is the list of all the sheets of the schematic
      * @param aUnconditional is true if an unconditional full recalculation should be done
+     * @param aChangedItemHandler is called, after an incremental update, for each item whose
+     *                            net name or code changed (including new items)
      */
-    void Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnconditional = false );
+    void Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnconditional = false,
+                      std::function<void( SCH_ITEM* )>* aChangedItemHandler = nullptr );
 
     /**
      * Returns a bus alias pointer for the given name if it exists (from cache)
@@ -260,6 +319,9 @@ public:
 
     const NET_MAP& GetNetMap() const { return m_net_code_to_subgraphs_map; }
 
+    /// Returns the phase timings of the last call to Recalculate()
+    const CONNECTION_GRAPH_TIMINGS& GetLastTimings() const { return m_timings; }
+
     // TODO(JE) Remove this when pressure valve is removed
     static bool m_allowRealTime;
 
@@ -270,6 +332,10 @@ private:
     // The owner of all CONNECTION_SUBGRAPH objects
     std::vector<CONNECTION_SUBGRAPH*> m_subgraphs;
 
+    // Subgraphs absorbed into another one.  They are kept (and owned here) until the absorbing
+    // subgraph is rebuilt, because the label caches below still refer to them.
+    std::vector<CONNECTION_SUBGRAPH*> m_absorbed_subgraphs;
+
     // Cache of a subset of m_subgraphs
     std::vector<CONNECTION_SUBGRAPH*> m_driver_subgraphs;
 
@@ -301,8 +367,18 @@ private:
 
     int m_last_subgraph_code;
 
+    // The sheets the graph was built for, and the count of connectable items on their screens
+    SCH_SHEET_PATHS m_sheet_paths;
+
+    std::unordered_map<SCH_SCREEN*, size_t> m_screen_item_counts;
+
+    // Signatures of the texts driver names are made of, per sheet (see driverNameSignature())
+    std::unordered_map<SCH_SHEET_PATH, size_t> m_sheet_signatures;
+
     std::mutex m_item_mutex;
 
+    CONNECTION_GRAPH_TIMINGS m_timings;
+
     // Needed for m_userUnits for now; maybe refactor later
     SCH_EDIT_FRAME* m_frame;
 
@@ -328,13 +404,54 @@ private:
      * checks to ensure that the items should actually connect, the items are
      * linked together using ConnectedItems().
      *
-     * As a side effect, items are loaded into m_items for BuildConnectionGraph()
+     * This only touches the items of the sheet's screen, so it can run concurrently for
+     * sheets that do not share a screen.
      *
      * @param aSheet is the path to the sheet of all items in the list
      * @param aItemList is a list of items to consider
+     * @param aGraphItems is filled with the items to load into m_items for buildConnectionGraph()
+     * @param aInvisiblePowerPins is filled with the invisible power pins found on the sheet
      */
     void updateItemConnectivity( SCH_SHEET_PATH aSheet,
-                                 const std::vector<SCH_ITEM*>& aItemList );
+                                 const std::vector<SCH_ITEM*>& aItemList,
+                                 std::vector<SCH_ITEM*>& aGraphItems,
+                                 std::vector<std::pair<SCH_SHEET_PATH, SCH_PIN*>>& aInvisiblePowerPins );
+
+    /**
+     * Updates the item connectivity and the dangling ends of each given sheet, and loads the
+     * items into m_items.
+     *
+     * Sheets are processed concurrently, except that sheets sharing a screen are handled by
+     * the same thread since they share their items.  The results are merged in the order of
+     * aSheets, so they do not depend on the thread scheduling.
+     *
+     * @param aSheets is the list of sheets to update, each with its connectable items
+     */
+    void updateSheetConnectivity(
+            const std::vector<std::pair<SCH_SHEET_PATH, std::vector<SCH_ITEM*>>>& aSheets );
+
+    /**
+     * Updates the graph for the items changed since the last recalculation.
+     *
+     * The graphical connectivity of each sheet holding changed (or removed) items is rebuilt.
+     * Then the subgraphs affected by the change are removed from the graph: all the subgraphs
+     * of these sheets, the subgraphs linked to them through the hierarchy, and recursively all
+     * the subgraphs sharing a net name, a bus link or a hierarchical link with those.  Their
+     * items are then fed again to buildConnectionGraph(), with the rest of the graph used as is.
+     *
+     * @return false if the graph must be rebuilt entirely instead (nothing was changed then)
+     */
+    bool updateIncremental( const SCH_SHEET_LIST& aSheetList,
+                            std::function<void( SCH_ITEM* )>* aChangedItemHandler );
+
+    /**
+     * Deletes the given subgraphs (and the subgraphs they absorbed), and removes them from
+     * all the caches.
+     */
+    void removeSubgraphs( const std::unordered_set<CONNECTION_SUBGRAPH*>& aSubgraphs );
+
+    /// Records the sheets and screen contents the graph was built for
+    void recordSheets( const SCH_SHEET_LIST& aSheetList );
 
     /**
      * Generates the connection graph (after all item connectivity has been updated)
@@ -348,8 +465,13 @@ private:
      * the driver is first selected by CONNECTION_SUBGRAPH::ResolveDrivers(),
      * and then the connection for the chosen driver is propagated to all the
      * other items in the subgraph.
+     *
+     * Only the items that are not part of a subgraph yet are considered, so that
+     * the subgraphs already in the graph are left as is.
+     *
+     * @param aItems is the list of items to build subgraphs from
      */
-    void buildConnectionGraph();
+    void buildConnectionGraph( const std::unordered_set<SCH_ITEM*>& aItems );
 
     /**
      * Helper to assign a new net code to a connection
@@ -396,15 +518,33 @@ private:
 
     void recacheSubgraphName( CONNECTION_SUBGRAPH* aSubgraph, const wxString& aOldName );
 
+    /**
+     * An error found by one of the ercCheck*() methods.
+     *
+     * The checks run concurrently, so they don't create markers themselves (creating items
+     * is not thread-safe): RunERC() creates the markers once all the checks are done.
+     */
+    struct ERC_VIOLATION
+    {
+        int         m_errorCode;
+        SCH_ITEM*   m_mainItem;
+        SCH_ITEM*   m_auxItem;
+        wxPoint     m_position;
+        SCH_SCREEN* m_screen;
+    };
+
+    typedef std::vector<ERC_VIOLATION> ERC_VIOLATIONS;
+
     /**
      * Checks one subgraph for conflicting connections between net and bus labels
      *
      * For example, a net wire connected to a bus port/pin, or vice versa
      *
      * @param  aSubgraph      is the subgraph to examine
+     * @param  aViolations    is the list to add the errors found to
      * @return                true for no errors, false for errors
      */
-    bool ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSubgraph );
+    bool ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSubgraph, ERC_VIOLATIONS& aViolations );
 
     /**
      * Checks one subgraph for conflicting connections between two bus items
@@ -414,9 +554,10 @@ private:
      * sheet pin
      *
      * @param  aSubgraph      is the subgraph to examine
+     * @param  aViolations    is the list to add the errors found to
      * @return                true for no errors, false for errors
      */
-    bool ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSubgraph );
+    bool ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSubgraph, ERC_VIOLATIONS& aViolations );
 
     /**
      * Checks one subgraph for conflicting bus entry to bus connections
@@ -428,9 +569,10 @@ private:
      * "USB.DP" but someone might accidentally just enter "DP"
      *
      * @param  aSubgraph      is the subgraph to examine
+     * @param  aViolations    is the list to add the errors found to
      * @return                true for no errors, false for errors
      */
-    bool ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH* aSubgraph );
+    bool ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH* aSubgraph, ERC_VIOLATIONS& aViolations );
 
     /**
      * Checks one subgraph for proper presence or absence of no-connect symbols
@@ -439,9 +581,10 @@ private:
      * A pin without a no-connect symbol should have at least one connection
      *
      * @param  aSubgraph      is the subgraph to examine
+     * @param  aViolations    is the list to add the errors found to
      * @return                true for no errors, false for errors
      */
-    bool ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph );
+    bool ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph, ERC_VIOLATIONS& aViolations );
 
     /**
      * Checks one subgraph for proper connection of labels
@@ -449,10 +592,10 @@ private:
      * Labels should be connected to something
      *
      * @param  aSubgraph      is the subgraph to examine
-     * @param  aCheckGlobalLabels is true if global labels should be checked for loneliness
+     * @param  aViolations    is the list to add the errors found to
      * @return                true for no errors, false for errors
      */
-    bool ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph );
+    bool ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph, ERC_VIOLATIONS& aViolations );
 
 };
 
@@ -499,6 +499,7 @@ bool DIALOG_EDIT_COMPONENT_IN_SCHEMATIC::TransferDataFromWindow()
     }
 
     m_cmp->UpdatePins();
+    GetParent()->GetScreen()->Update( m_cmp );
 
     GetParent()->TestDanglingEnds();
     GetParent()->RefreshItem( m_cmp );
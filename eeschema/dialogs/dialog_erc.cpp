@@ -208,9 +208,9 @@ void DIALOG_ERC::TestErc( REPORTER& aReporter )
         TestConflictingBusAliases();
     }
 
-    // The connection graph has a whole set of ERC checks it can run
+    // The connection graph has a whole set of ERC checks it can run, on a full rebuild
     aReporter.ReportTail( _( "Checking conflicts...\n" ) );
-    m_parent->RecalculateConnections( NO_CLEANUP );
+    m_parent->RecalculateConnections( NO_CLEANUP, true );
     g_ConnectionGraph->RunERC();
 
     // Test is all units of each multiunit component have the same footprint assigned.
@@ -40,6 +40,13 @@
 #include <sch_reference_list.h>
 #include <wx/ffile.h>
 
+#include <atomic>
+#include <functional>
+#include <future>
+#include <map>
+#include <thread>
+#include <unordered_map>
+
 
 /* ERC tests :
  *  1 - conflicts between connected pins ( example: 2 connected outputs )
@@ -543,40 +550,71 @@ void TestOthersItems( NETLIST_OBJECT_LIST* aList, unsigned aNetItemRef, unsigned
 
 // this code try to detect similar labels, i.e. labels which are identical
 // when they are compared using case insensitive coparisons.
+//
+// Labels are grouped by their case-folded name, so only the labels of a group are compared
+// together instead of comparing every label to every other one.
 
 
-// A helper struct to compare NETLIST_OBJECT items by sheetpath and label texts
-// for a std::set<NETLIST_OBJECT*> container
-// the full text is "sheetpath+label" for local labels and "label" for global labels
-struct compare_labels
+// A label name, with the label used to build diag messages and the number of labels using
+// this name (in a sheet for local labels, in the full project for global labels)
+struct SIMILAR_LABEL_NAME
 {
-    bool operator() ( const NETLIST_OBJECT* lab1, const NETLIST_OBJECT* lab2 ) const
-    {
-        wxString str1 = lab1->m_SheetPath.PathAsString() + lab1->m_Label;
-        wxString str2 = lab2->m_SheetPath.PathAsString() + lab2->m_Label;
-
-        return str1.Cmp( str2 ) < 0;
-    }
+    NETLIST_OBJECT* m_label = nullptr;
+    int             m_count = 0;
 };
 
-struct compare_label_names
+// Label names, sorted using case sensitive comparisons
+typedef std::map<wxString, SIMILAR_LABEL_NAME> SIMILAR_LABEL_NAMES;
+
+typedef std::vector<std::pair<NETLIST_OBJECT*, NETLIST_OBJECT*>> SIMILAR_LABEL_PAIRS;
+
+
+// Helper function: find the names of aNames which are equal when using case insensitive
+// comparisons, and append to aPairs the labels to diagnose, the label having the lower count
+// first.  If aSkipGlobalPairs is true, pairs of global labels are not reported.
+static void findSimilarLabels( const SIMILAR_LABEL_NAMES& aNames,
+                               const std::function<int( const NETLIST_OBJECT* )>& aCount,
+                               bool aSkipGlobalPairs, SIMILAR_LABEL_PAIRS& aPairs )
 {
-    bool operator() ( const NETLIST_OBJECT* lab1, const NETLIST_OBJECT* lab2 ) const
+    std::unordered_map<wxString, std::vector<NETLIST_OBJECT*>> groups;
+    std::vector<const std::vector<NETLIST_OBJECT*>*> similarGroups;
+
+    for( const auto& name : aNames )
     {
-        return lab1->m_Label.Cmp( lab2->m_Label ) < 0;
+        if( !name.second.m_label )
+            continue;
+
+        std::vector<NETLIST_OBJECT*>& group = groups[ name.first.Lower() ];
+
+        group.push_back( name.second.m_label );
+
+        if( group.size() == 2 )
+            similarGroups.push_back( &group );
     }
-};
 
-struct compare_paths
-{
-    bool operator() ( const NETLIST_OBJECT* lab1, const NETLIST_OBJECT* lab2 ) const
+    for( const std::vector<NETLIST_OBJECT*>* group : similarGroups )
     {
-        return lab1->m_SheetPath.Path() < lab2->m_SheetPath.Path();
+        for( size_t ii = 0; ii < group->size(); ii++ )
+        {
+            NETLIST_OBJECT* labelA = ( *group )[ii];
+
+            for( size_t jj = ii + 1; jj < group->size(); jj++ )
+            {
+                NETLIST_OBJECT* labelB = ( *group )[jj];
+
+                if( aSkipGlobalPairs && labelA->IsLabelGlobal() && labelB->IsLabelGlobal() )
+                    continue;
+
+                if( aCount( labelA ) <= aCount( labelB ) )
+                    aPairs.emplace_back( labelA, labelB );
+                else
+                    aPairs.emplace_back( labelB, labelA );
+            }
+        }
     }
-};
+}
+
 
-// Helper functions to build the warning messages about Similar Labels:
-static int countIndenticalLabels( std::vector<NETLIST_OBJECT*>& aList, NETLIST_OBJECT* aRef );
 static void SimilarLabelsDiagnose( NETLIST_OBJECT* aItemA, NETLIST_OBJECT* aItemB );
 
 
@@ -585,21 +623,20 @@ void NETLIST_OBJECT_LIST::TestforSimilarLabels()
     // Similar labels which are different when using case sensitive comparisons
     // but are equal when using case insensitive comparisons
 
-    // list of all labels (used the better item to build diag messages)
-    std::vector<NETLIST_OBJECT*> fullLabelList;
-    // list of all labels , each label appears only once (used to to detect similar labels)
-    std::set<NETLIST_OBJECT*, compare_labels> uniqueLabelList;
-    wxString msg;
-
-    // Build a list of differents labels. If inside a given sheet there are
-    // more than one given label, only one label is stored.
+    // Build the list of different labels of each sheet path.  If inside a given sheet there
+    // are more than one given label, only the first one is stored.
     // not also the sheet labels are not taken in account for 2 reasons:
     //  * they are in the root sheet but they are seen only from the child sheet
     //  * any mismatch between child sheet hierarchical labels and the sheet label
     //    already detected by ERC
+    std::map<KIID_PATH, SIMILAR_LABEL_NAMES> sheetLabels;
+    SIMILAR_LABEL_NAMES                      globalLabels;
+
     for( unsigned netItem = 0; netItem < size(); ++netItem )
     {
-        switch( GetItemType( netItem ) )
+        NETLIST_OBJECT* label = GetItem( netItem );
+
+        switch( label->m_Type )
         {
         case NETLIST_ITEM::LABEL:
         case NETLIST_ITEM::BUSLABELMEMBER:
@@ -608,10 +645,19 @@ void NETLIST_OBJECT_LIST::TestforSimilarLabels()
         case NETLIST_ITEM::HIERLABEL:
         case NETLIST_ITEM::HIERBUSLABELMEMBER:
         case NETLIST_ITEM::GLOBLABEL:
-            // add this label in lists
-            uniqueLabelList.insert( GetItem( netItem ) );
-            fullLabelList.push_back( GetItem( netItem ) );
+        {
+            SIMILAR_LABEL_NAME& name = sheetLabels[ label->m_SheetPath.Path() ][ label->m_Label ];
+
+            if( !name.m_label )
+                name.m_label = label;
+
+            name.m_count++;
+
+            if( label->IsLabelGlobal() )
+                globalLabels[ label->m_Label ].m_count++;
+
             break;
+        }
 
         case NETLIST_ITEM::SHEETLABEL:
         case NETLIST_ITEM::SHEETBUSLABELMEMBER:
@@ -620,110 +666,103 @@ void NETLIST_OBJECT_LIST::TestforSimilarLabels()
         }
     }
 
-    // build global labels and compare
-    std::set<NETLIST_OBJECT*, compare_label_names> loc_labelList;
-
-    for( NETLIST_OBJECT* label : uniqueLabelList )
+    // Global labels are compared once for the full project: for each name, use the label
+    // stored for a sheet coming first in "sheetpath+label" order
+    for( const auto& sheet : sheetLabels )
     {
-        if( label->IsLabelGlobal() )
-            loc_labelList.insert( label );
-    }
+        for( const auto& name : sheet.second )
+        {
+            NETLIST_OBJECT* label = name.second.m_label;
 
-    // compare global labels (same label names appears only once in list)
-    for( auto it = loc_labelList.begin(); it != loc_labelList.end(); ++it )
-    {
-        auto it_aux = it;
+            if( !label->IsLabelGlobal() )
+                continue;
 
-        for( ++it_aux; it_aux != loc_labelList.end(); ++it_aux )
-        {
-            if( (*it)->m_Label.CmpNoCase( (*it_aux)->m_Label ) == 0 )
-            {
-                // Create new marker for ERC.
-                int cntA = countIndenticalLabels( fullLabelList, *it );
-                int cntB = countIndenticalLabels( fullLabelList, *it_aux );
+            NETLIST_OBJECT*& globalLabel = globalLabels[ name.first ].m_label;
 
-                if( cntA <= cntB )
-                    SimilarLabelsDiagnose( (*it), (*it_aux) );
-                else
-                    SimilarLabelsDiagnose( (*it_aux), (*it) );
+            if( !globalLabel
+                    || ( label->m_SheetPath.PathAsString() + label->m_Label ).Cmp(
+                            globalLabel->m_SheetPath.PathAsString() + globalLabel->m_Label ) < 0 )
+            {
+                globalLabel = label;
             }
         }
     }
 
-    // Build paths list
-    std::set<NETLIST_OBJECT*, compare_paths> pathsList;
-
-    for( NETLIST_OBJECT* label : uniqueLabelList )
-        pathsList.insert( label );
-
-    // Examine each label inside a sheet path:
-    for( NETLIST_OBJECT* candidate : pathsList )
+    // Number of labels identical to aLabel:
+    //  for global label: global labels in the full project
+    //  for local label: all labels in the current sheet
+    auto countLabels = [&]( const SIMILAR_LABEL_NAMES& aSheet, const NETLIST_OBJECT* aLabel )
     {
-        loc_labelList.clear();
+        const SIMILAR_LABEL_NAMES& names = aLabel->IsLabelGlobal() ? globalLabels : aSheet;
+        auto it = names.find( aLabel->m_Label );
 
-        for( NETLIST_OBJECT* uniqueLabel : uniqueLabelList)
-        {
-            if( candidate->m_SheetPath.Path() == uniqueLabel->m_SheetPath.Path() )
-                loc_labelList.insert( uniqueLabel );
-        }
+        return it == names.end() ? 0 : it->second.m_count;
+    };
 
-        // at this point, loc_labelList contains labels of the current sheet path.
-        // Detect similar labels (same label names appears only once in list)
+    SIMILAR_LABEL_PAIRS globalPairs;
 
-        for( auto ref_it = loc_labelList.begin(); ref_it != loc_labelList.end(); ++ref_it )
-        {
-            NETLIST_OBJECT* ref_item = *ref_it;
-            auto it_aux = ref_it;
+    findSimilarLabels( globalLabels,
+                       [&]( const NETLIST_OBJECT* aLabel )
+                       {
+                           return countLabels( globalLabels, aLabel );
+                       },
+                       false, globalPairs );
 
-            for( ++it_aux; it_aux != loc_labelList.end(); ++it_aux )
-            {
-                // global label versus global label was already examined.
-                // here, at least one label must be local
-                if( ref_item->IsLabelGlobal() && ( *it_aux )->IsLabelGlobal() )
-                    continue;
+    // Examine the labels of each sheet path.  Global label versus global label was already
+    // examined, so at least one label of a pair must be local.  Sheets are independent, so
+    // they are examined in parallel, and the markers created afterwards in sheet order.
+    std::vector<const SIMILAR_LABEL_NAMES*> sheets;
 
-                if( ref_item->m_Label.CmpNoCase( ( *it_aux )->m_Label ) == 0 )
-                {
-                    // Create new marker for ERC.
-                    int cntA = countIndenticalLabels( fullLabelList, ref_item );
-                    int cntB = countIndenticalLabels( fullLabelList, *it_aux );
-
-                    if( cntA <= cntB )
-                        SimilarLabelsDiagnose( ref_item, ( *it_aux ) );
-                    else
-                        SimilarLabelsDiagnose( ( *it_aux ), ref_item );
-                }
-            }
-        }
-    }
-}
+    for( const auto& sheet : sheetLabels )
+        sheets.push_back( &sheet.second );
 
+    std::vector<SIMILAR_LABEL_PAIRS> sheetPairs( sheets.size() );
 
-// Helper function: count the number of labels identical to aLabel
-//  for global label: global labels in the full project
-//  for local label: all labels in the current sheet
-static int countIndenticalLabels( std::vector<NETLIST_OBJECT*>& aList, NETLIST_OBJECT* aRef )
-{
-    int count = 0;
+    // Not worth a thread for less than 16 sheets
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   ( sheets.size() + 15 ) / 16 );
 
-    if( aRef->IsLabelGlobal() )
+    std::atomic<size_t> nextSheet( 0 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto sheet_lambda = [&]() -> size_t
     {
-        for( NETLIST_OBJECT* i : aList )
+        for( size_t ii = nextSheet++; ii < sheets.size(); ii = nextSheet++ )
         {
-            if( i->IsLabelGlobal() && i->m_Label == aRef->m_Label )
-                count++;
+            const SIMILAR_LABEL_NAMES& sheet = *sheets[ii];
+
+            findSimilarLabels( sheet,
+                               [&]( const NETLIST_OBJECT* aLabel )
+                               {
+                                   return countLabels( sheet, aLabel );
+                               },
+                               true, sheetPairs[ii] );
         }
-    }
+
+        return 1;
+    };
+
+    if( parallelThreadCount <= 1 )
+        sheet_lambda();
     else
     {
-        for( NETLIST_OBJECT* i : aList )
-        {
-            if( i->m_Label == aRef->m_Label && i->m_SheetPath.Path() == aRef->m_SheetPath.Path() )
-                count++;
-        }
+        for( size_t ii = 0; ii < parallelThreadCount; ii++ )
+            returns[ii] = std::async( std::launch::async, sheet_lambda );
+
+        // Finalize the threads
+        for( size_t ii = 0; ii < parallelThreadCount; ii++ )
+            returns[ii].wait();
     }
 
-    return count;
+    // Create new markers for ERC.
+    for( const auto& pair : globalPairs )
+        SimilarLabelsDiagnose( pair.first, pair.second );
+
+    for( const SIMILAR_LABEL_PAIRS& pairs : sheetPairs )
+    {
+        for( const auto& pair : pairs )
+            SimilarLabelsDiagnose( pair.first, pair.second );
+    }
 }
 
 
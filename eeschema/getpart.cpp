@@ -268,6 +268,7 @@ void SCH_EDIT_FRAME::ConvertPart( SCH_COMPONENT* aComponent )
         // The alternate symbol may cause a change in the connection status so test the
         // connections so the connection indicators are drawn correctly.
         aComponent->UpdatePins();
+        GetScreen()->Update( aComponent );
         TestDanglingEnds();
         aComponent->ClearFlags();
         aComponent->SetFlags( savedFlags );   // Restore m_Flags (modified by SetConvert())
@@ -26,6 +26,7 @@
 #include "netlist_exporter_generic.h"
 
 #include <build_version.h>
+#include <confirm.h>
 #include <sch_base_frame.h>
 #include <class_library.h>
 #include <connection_graph.h>
@@ -44,39 +45,48 @@ bool NETLIST_EXPORTER_GENERIC::WriteNetlist( const wxString& aOutFileName, unsig
     for( unsigned ii = 0; ii < m_masterList->size(); ii++ )
         m_masterList->GetItem( ii )->m_Flag = 0;
 
-    // output the XML format netlist.
-    wxXmlDocument   xdoc;
+    // output the XML format netlist, written as it is produced rather than built as a
+    // wxXmlDocument first.  The output is the same as wxXmlDocument::Save() with an indent of 2.
+    try
+    {
+        FILE_OUTPUTFORMATTER formatter( aOutFileName, wxT( "wb" ) );
+        XNODE_STREAM         stream( &formatter, XNODE_STREAM::XML );
 
-    xdoc.SetRoot( makeRoot( GNL_ALL ) );
+        writeRoot( stream, GNL_ALL );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        DisplayError( NULL, ioe.What() );
+        return false;
+    }
 
-    return xdoc.Save( aOutFileName, 2 /* indent bug, today was ignored by wxXml lib */ );
+    return true;
 }
 
 
-XNODE* NETLIST_EXPORTER_GENERIC::makeRoot( int aCtl )
+void NETLIST_EXPORTER_GENERIC::writeRoot( XNODE_SINK& aSink, int aCtl )
 {
-    XNODE*      xroot = node( "export" );
-
-    xroot->AddAttribute( "version", "D" );
+    aSink.StartElement( "export" );
+    aSink.AddAttribute( "version", "D" );
 
     if( aCtl & GNL_HEADER )
         // add the "design" header
-        xroot->AddChild( makeDesignHeader() );
+        writeDesignHeader( aSink );
 
     if( aCtl & GNL_COMPONENTS )
-        xroot->AddChild( makeComponents() );
+        writeComponents( aSink );
 
     if( aCtl & GNL_PARTS )
-        xroot->AddChild( makeLibParts() );
+        writeLibParts( aSink );
 
     if( aCtl & GNL_LIBRARIES )
-        // must follow makeGenericLibParts()
-        xroot->AddChild( makeLibraries() );
+        // must follow writeLibParts()
+        writeLibraries( aSink );
 
     if( aCtl & GNL_NETS )
-        xroot->AddChild( makeListOfNets() );
+        writeListOfNets( aSink );
 
-    return xroot;
+    aSink.EndElement();
 }
 
 
@@ -91,7 +101,8 @@ struct COMP_FIELDS
 };
 
 
-void NETLIST_EXPORTER_GENERIC::addComponentFields( XNODE* xcomp, SCH_COMPONENT* comp, SCH_SHEET_PATH* aSheet )
+void NETLIST_EXPORTER_GENERIC::writeComponentFields( XNODE_SINK& aSink, SCH_COMPONENT* comp,
+                                                     SCH_SHEET_PATH* aSheet )
 {
     COMP_FIELDS fields;
 
@@ -169,37 +180,41 @@ void NETLIST_EXPORTER_GENERIC::addComponentFields( XNODE* xcomp, SCH_COMPONENT*
 
     // Do not output field values blank in netlist:
     if( fields.value.size() )
-        xcomp->AddChild( node( "value", fields.value ) );
+        aSink.AddElement( "value", fields.value );
     else    // value field always written in netlist
-        xcomp->AddChild( node( "value", "~" ) );
+        aSink.AddElement( "value", "~" );
 
     if( fields.footprint.size() )
-        xcomp->AddChild( node( "footprint", fields.footprint ) );
+        aSink.AddElement( "footprint", fields.footprint );
 
     if( fields.datasheet.size() )
-        xcomp->AddChild( node( "datasheet", fields.datasheet ) );
+        aSink.AddElement( "datasheet", fields.datasheet );
 
     if( fields.f.size() )
     {
-        XNODE* xfields;
-        xcomp->AddChild( xfields = node( "fields" ) );
+        aSink.StartElement( "fields" );
 
         // non MANDATORY fields are output alphabetically
         for( std::map< wxString, wxString >::const_iterator it = fields.f.begin();
              it != fields.f.end();  ++it )
         {
-            XNODE*  xfield;
-            xfields->AddChild( xfield = node( "field", it->second ) );
-            xfield->AddAttribute( "name", it->first );
+            aSink.StartElement( "field" );
+            aSink.AddAttribute( "name", it->first );
+
+            if( it->second.Len() > 0 )
+                aSink.AddText( it->second );
+
+            aSink.EndElement();
         }
-    }
 
+        aSink.EndElement();
+    }
 }
 
 
-XNODE* NETLIST_EXPORTER_GENERIC::makeComponents()
+void NETLIST_EXPORTER_GENERIC::writeComponents( XNODE_SINK& aSink )
 {
-    XNODE*      xcomps = node( "components" );
+    aSink.StartElement( "components" );
 
     m_ReferencesAlreadyFound.Clear();
 
@@ -240,62 +255,59 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeComponents()
             if( !comp )
                 continue;
 
-            XNODE* xcomp;  // current component being constructed
-
             // Output the component's elements in order of expected access frequency.
             // This may not always look best, but it will allow faster execution
             // under XSL processing systems which do sequential searching within
             // an element.
 
-            xcomps->AddChild( xcomp = node( "comp" ) );
-            xcomp->AddAttribute( "ref", comp->GetRef( &sheetList[i] ) );
+            aSink.StartElement( "comp" );
+            aSink.AddAttribute( "ref", comp->GetRef( &sheetList[i] ) );
 
-            addComponentFields( xcomp, comp, &sheetList[i] );
+            writeComponentFields( aSink, comp, &sheetList[i] );
 
-            XNODE*  xlibsource;
-            xcomp->AddChild( xlibsource = node( "libsource" ) );
+            aSink.StartElement( "libsource" );
 
             // "logical" library name, which is in anticipation of a better search
             // algorithm for parts based on "logical_lib.part" and where logical_lib
             // is merely the library name minus path and extension.
             if( comp->GetPartRef() )
-                xlibsource->AddAttribute( "lib", comp->GetPartRef()->GetLibId().GetLibNickname() );
+                aSink.AddAttribute( "lib", comp->GetPartRef()->GetLibId().GetLibNickname() );
 
             // We only want the symbol name, not the full LIB_ID.
-            xlibsource->AddAttribute( "part", comp->GetLibId().GetLibItemName() );
+            aSink.AddAttribute( "part", comp->GetLibId().GetLibItemName() );
 
-            xlibsource->AddAttribute( "description", comp->GetDescription() );
+            aSink.AddAttribute( "description", comp->GetDescription() );
+            aSink.EndElement();
 
-            XNODE* xsheetpath;
+            aSink.StartElement( "sheetpath" );
+            aSink.AddAttribute( "names", sheetList[i].PathHumanReadable() );
+            aSink.AddAttribute( "tstamps", sheetList[i].PathAsString() );
+            aSink.EndElement();
 
-            xcomp->AddChild( xsheetpath = node( "sheetpath" ) );
-            xsheetpath->AddAttribute( "names", sheetList[i].PathHumanReadable() );
-            xsheetpath->AddAttribute( "tstamps", sheetList[i].PathAsString() );
-            xcomp->AddChild( node( "tstamp", comp->m_Uuid.AsString() ) );
+            aSink.AddElement( "tstamp", comp->m_Uuid.AsString() );
+            aSink.EndElement();
         }
     }
 
-    return xcomps;
+    aSink.EndElement();
 }
 
 
-XNODE* NETLIST_EXPORTER_GENERIC::makeDesignHeader()
+void NETLIST_EXPORTER_GENERIC::writeDesignHeader( XNODE_SINK& aSink )
 {
     SCH_SCREEN* screen;
-    XNODE*     xdesign = node( "design" );
-    XNODE*     xtitleBlock;
-    XNODE*     xsheet;
-    XNODE*     xcomment;
     wxString   sheetTxt;
     wxFileName sourceFileName;
 
+    aSink.StartElement( "design" );
+
     // the root sheet is a special sheet, call it source
-    xdesign->AddChild( node( "source", g_RootSheet->GetScreen()->GetFileName() ) );
+    aSink.AddElement( "source", g_RootSheet->GetScreen()->GetFileName() );
 
-    xdesign->AddChild( node( "date", DateAndTime() ) );
+    aSink.AddElement( "date", DateAndTime() );
 
     // which Eeschema tool
-    xdesign->AddChild( node( "tool", wxString( "Eeschema " ) + GetBuildVersion() ) );
+    aSink.AddElement( "tool", wxString( "Eeschema " ) + GetBuildVersion() );
 
     /*
         Export the sheets information
@@ -306,97 +318,72 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeDesignHeader()
     {
         screen = sheetList[i].LastScreen();
 
-        xdesign->AddChild( xsheet = node( "sheet" ) );
+        aSink.StartElement( "sheet" );
 
         // get the string representation of the sheet index number.
         // Note that sheet->GetIndex() is zero index base and we need to increment the
         // number by one to make it human readable
         sheetTxt.Printf( "%u", i + 1 );
-        xsheet->AddAttribute( "number", sheetTxt );
-        xsheet->AddAttribute( "name", sheetList[i].PathHumanReadable() );
-        xsheet->AddAttribute( "tstamps", sheetList[i].PathAsString() );
+        aSink.AddAttribute( "number", sheetTxt );
+        aSink.AddAttribute( "name", sheetList[i].PathHumanReadable() );
+        aSink.AddAttribute( "tstamps", sheetList[i].PathAsString() );
 
 
         TITLE_BLOCK tb = screen->GetTitleBlock();
 
-        xsheet->AddChild( xtitleBlock = node( "title_block" ) );
+        aSink.StartElement( "title_block" );
 
-        xtitleBlock->AddChild( node( "title", tb.GetTitle() ) );
-        xtitleBlock->AddChild( node( "company", tb.GetCompany() ) );
-        xtitleBlock->AddChild( node( "rev", tb.GetRevision() ) );
-        xtitleBlock->AddChild( node( "date", tb.GetDate() ) );
+        aSink.AddElement( "title", tb.GetTitle() );
+        aSink.AddElement( "company", tb.GetCompany() );
+        aSink.AddElement( "rev", tb.GetRevision() );
+        aSink.AddElement( "date", tb.GetDate() );
 
         // We are going to remove the fileName directories.
         sourceFileName = wxFileName( screen->GetFileName() );
-        xtitleBlock->AddChild( node( "source", sourceFileName.GetFullName() ) );
-
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "1" );
-        xcomment->AddAttribute( "value", tb.GetComment( 0 ) );
-
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "2" );
-        xcomment->AddAttribute( "value", tb.GetComment( 1 ) );
-
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "3" );
-        xcomment->AddAttribute( "value", tb.GetComment( 2 ) );
-
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "4" );
-        xcomment->AddAttribute( "value", tb.GetComment( 3 ) );
-
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "5" );
-        xcomment->AddAttribute( "value", tb.GetComment( 4 ) );
-
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "6" );
-        xcomment->AddAttribute( "value", tb.GetComment( 5 ) );
-
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "7" );
-        xcomment->AddAttribute( "value", tb.GetComment( 6 ) );
+        aSink.AddElement( "source", sourceFileName.GetFullName() );
 
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "8" );
-        xcomment->AddAttribute( "value", tb.GetComment( 7 ) );
+        for( int ii = 0; ii < 9; ii++ )
+        {
+            aSink.StartElement( "comment" );
+            aSink.AddAttribute( "number", wxString::Format( "%d", ii + 1 ) );
+            aSink.AddAttribute( "value", tb.GetComment( ii ) );
+            aSink.EndElement();
+        }
 
-        xtitleBlock->AddChild( xcomment = node( "comment" ) );
-        xcomment->AddAttribute( "number", "9" );
-        xcomment->AddAttribute( "value", tb.GetComment( 8 ) );
+        aSink.EndElement();     // title_block
+        aSink.EndElement();     // sheet
     }
 
-    return xdesign;
+    aSink.EndElement();
 }
 
 
-XNODE* NETLIST_EXPORTER_GENERIC::makeLibraries()
+void NETLIST_EXPORTER_GENERIC::writeLibraries( XNODE_SINK& aSink )
 {
-    XNODE*  xlibs = node( "libraries" );     // auto_ptr
+    aSink.StartElement( "libraries" );
 
     for( std::set<wxString>::iterator it = m_libraries.begin(); it!=m_libraries.end();  ++it )
     {
         wxString    libNickname = *it;
-        XNODE*      xlibrary;
 
         if( m_libTable->HasLibrary( libNickname ) )
         {
-            xlibs->AddChild( xlibrary = node( "library" ) );
-            xlibrary->AddAttribute( "logical", libNickname );
-            xlibrary->AddChild( node( "uri",  m_libTable->GetFullURI( libNickname ) ) );
+            aSink.StartElement( "library" );
+            aSink.AddAttribute( "logical", libNickname );
+            aSink.AddElement( "uri",  m_libTable->GetFullURI( libNickname ) );
+            aSink.EndElement();
         }
 
         // @todo: add more fun stuff here
     }
 
-    return xlibs;
+    aSink.EndElement();
 }
 
 
-XNODE* NETLIST_EXPORTER_GENERIC::makeLibParts()
+void NETLIST_EXPORTER_GENERIC::writeLibParts( XNODE_SINK& aSink )
 {
-    XNODE*      xlibparts = node( "libparts" );   // auto_ptr
+    aSink.StartElement( "libparts" );
 
     LIB_PINS    pinList;
     LIB_FIELDS  fieldList;
@@ -411,47 +398,49 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeLibParts()
         if( !libNickname.IsEmpty() )
             m_libraries.insert( libNickname );  // inserts component's library if unique
 
-        XNODE* xlibpart;
-        xlibparts->AddChild( xlibpart = node( "libpart" ) );
-        xlibpart->AddAttribute( "lib", libNickname );
-        xlibpart->AddAttribute( "part", lcomp->GetName()  );
+        aSink.StartElement( "libpart" );
+        aSink.AddAttribute( "lib", libNickname );
+        aSink.AddAttribute( "part", lcomp->GetName()  );
 
         //----- show the important properties -------------------------
         if( !lcomp->GetDescription().IsEmpty() )
-            xlibpart->AddChild( node( "description", lcomp->GetDescription() ) );
+            aSink.AddElement( "description", lcomp->GetDescription() );
 
         if( !lcomp->GetDocFileName().IsEmpty() )
-            xlibpart->AddChild( node( "docs",  lcomp->GetDocFileName() ) );
+            aSink.AddElement( "docs",  lcomp->GetDocFileName() );
 
         // Write the footprint list
         if( lcomp->GetFootprints().GetCount() )
         {
-            XNODE*  xfootprints;
-            xlibpart->AddChild( xfootprints = node( "footprints" ) );
+            aSink.StartElement( "footprints" );
 
             for( unsigned i=0; i<lcomp->GetFootprints().GetCount(); ++i )
             {
-                xfootprints->AddChild( node( "fp", lcomp->GetFootprints()[i] ) );
+                aSink.AddElement( "fp", lcomp->GetFootprints()[i] );
             }
+
+            aSink.EndElement();
         }
 
         //----- show the fields here ----------------------------------
         fieldList.clear();
         lcomp->GetFields( fieldList );
 
-        XNODE*     xfields;
-        xlibpart->AddChild( xfields = node( "fields" ) );
+        aSink.StartElement( "fields" );
 
         for( unsigned i=0;  i<fieldList.size();  ++i )
         {
             if( !fieldList[i].GetText().IsEmpty() )
             {
-                XNODE*     xfield;
-                xfields->AddChild( xfield = node( "field", fieldList[i].GetText() ) );
-                xfield->AddAttribute( "name", fieldList[i].GetCanonicalName() );
+                aSink.StartElement( "field" );
+                aSink.AddAttribute( "name", fieldList[i].GetCanonicalName() );
+                aSink.AddText( fieldList[i].GetText() );
+                aSink.EndElement();
             }
         }
 
+        aSink.EndElement();
+
         //----- show the pins here ------------------------------------
         pinList.clear();
         lcomp->GetPins( pinList, 0, 0 );
@@ -476,35 +465,35 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeLibParts()
 
         if( pinList.size() )
         {
-            XNODE*     pins;
+            aSink.StartElement( "pins" );
 
-            xlibpart->AddChild( pins = node( "pins" ) );
             for( unsigned i=0; i<pinList.size();  ++i )
             {
-                XNODE*     pin;
-
-                pins->AddChild( pin = node( "pin" ) );
-                pin->AddAttribute( "num", pinList[i]->GetNumber() );
-                pin->AddAttribute( "name", pinList[i]->GetName() );
-                pin->AddAttribute( "type", pinList[i]->GetCanonicalElectricalTypeName() );
+                aSink.StartElement( "pin" );
+                aSink.AddAttribute( "num", pinList[i]->GetNumber() );
+                aSink.AddAttribute( "name", pinList[i]->GetName() );
+                aSink.AddAttribute( "type", pinList[i]->GetCanonicalElectricalTypeName() );
+                aSink.EndElement();
 
                 // caution: construction work site here, drive slowly
             }
+
+            aSink.EndElement();
         }
+
+        aSink.EndElement();     // libpart
     }
 
-    return xlibparts;
+    aSink.EndElement();
 }
 
 
-XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets( bool aUseGraph )
+void NETLIST_EXPORTER_GENERIC::writeListOfNets( XNODE_SINK& aSink, bool aUseGraph )
 {
-    XNODE*      xnets = node( "nets" );      // auto_ptr if exceptions ever get used.
     wxString    netCodeTxt;
     wxString    netName;
     wxString    ref;
 
-    XNODE*      xnet = 0;
     int         netCode;
     int         lastNetCode = -1;
     int         sameNetcodeCount = 0;
@@ -519,6 +508,8 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets( bool aUseGraph )
 
     m_LibParts.clear();     // must call this function before using m_LibParts.
 
+    aSink.StartElement( "nets" );
+
     if( aUseGraph )
     {
         wxASSERT( m_graph );
@@ -533,7 +524,6 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets( bool aUseGraph )
             // Code starts at 1
             code++;
 
-            XNODE* xnode;
             std::vector<std::pair<SCH_PIN*, SCH_SHEET_PATH>> sorted_items;
 
             for( auto subgraph : subgraphs )
@@ -582,17 +572,17 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets( bool aUseGraph )
 
                 if( !added )
                 {
-                    xnets->AddChild( xnet = node( "net" ) );
+                    aSink.StartElement( "net" );
                     netCodeTxt.Printf( "%d", code );
-                    xnet->AddAttribute( "code", netCodeTxt );
-                    xnet->AddAttribute( "name", net_name );
+                    aSink.AddAttribute( "code", netCodeTxt );
+                    aSink.AddAttribute( "name", net_name );
 
                     added = true;
                 }
 
-                xnet->AddChild( xnode = node( "node" ) );
-                xnode->AddAttribute( "ref", refText );
-                xnode->AddAttribute( "pin", pinText );
+                aSink.StartElement( "node" );
+                aSink.AddAttribute( "ref", refText );
+                aSink.AddAttribute( "pin", pinText );
 
                 wxString pinName;
 
@@ -600,9 +590,13 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets( bool aUseGraph )
                     pinName = pin->GetName();
 
                 if( !pinName.IsEmpty() )
-                    xnode->AddAttribute( "pinfunction", pinName );
+                    aSink.AddAttribute( "pinfunction", pinName );
 
+                aSink.EndElement();
             }
+
+            if( added )
+                aSink.EndElement();     // net
         }
     }
     else
@@ -615,6 +609,9 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets( bool aUseGraph )
             // New net found, write net id;
             if( ( netCode = nitem->GetNet() ) != lastNetCode )
             {
+                if( sameNetcodeCount > 0 )
+                    aSink.EndElement();     // net
+
                 sameNetcodeCount = 0;   // item count for this net
                 netName = nitem->GetNetName();
                 lastNetCode  = netCode;
@@ -635,34 +632,27 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets( bool aUseGraph )
 
             if( ++sameNetcodeCount == 1 )
             {
-                xnets->AddChild( xnet = node( "net" ) );
+                aSink.StartElement( "net" );
                 netCodeTxt.Printf( "%d", netCode );
-                xnet->AddAttribute( "code", netCodeTxt );
-                xnet->AddAttribute( "name", netName );
+                aSink.AddAttribute( "code", netCodeTxt );
+                aSink.AddAttribute( "name", netName );
             }
 
-            XNODE*      xnode;
-            xnet->AddChild( xnode = node( "node" ) );
-            xnode->AddAttribute( "ref", ref );
-            xnode->AddAttribute( "pin",  nitem->GetPinNumText() );
+            aSink.StartElement( "node" );
+            aSink.AddAttribute( "ref", ref );
+            aSink.AddAttribute( "pin",  nitem->GetPinNumText() );
 
             if( !nitem->GetPinNameText().IsEmpty() )
-                xnode->AddAttribute( "pinfunction", nitem->GetPinNameText() );
-        }
-    }
-
-    return xnets;
-}
+                aSink.AddAttribute( "pinfunction", nitem->GetPinNameText() );
 
+            aSink.EndElement();
+        }
 
-XNODE* NETLIST_EXPORTER_GENERIC::node( const wxString& aName, const wxString& aTextualContent /* = wxEmptyString*/ )
-{
-    XNODE* n = new XNODE( wxXML_ELEMENT_NODE, aName );
-
-    if( aTextualContent.Len() > 0 )     // excludes wxEmptyString, the parameter's default value
-        n->AddChild( new XNODE( wxXML_TEXT_NODE, wxEmptyString, aTextualContent ) );
+        if( sameNetcodeCount > 0 )
+            aSink.EndElement();     // net
+    }
 
-    return n;
+    aSink.EndElement();
 }
 
 
@@ -40,7 +40,7 @@ class SYMBOL_LIB_TABLE;
 
 /**
  * Enum GNL
- * is a set of bit which control the totality of the tree built by makeRoot()
+ * is a set of bit which control the totality of the document produced by writeRoot()
  */
 enum GNL_T
 {
@@ -85,63 +85,49 @@ public:
 #define GNL_ALL     ( GNL_LIBRARIES | GNL_COMPONENTS | GNL_PARTS | GNL_HEADER | GNL_NETS )
 
 protected:
-   /**
-     * Function node
-     * is a convenience function that creates a new XNODE with an optional textual child.
-     * It also provides some insulation from a possible change in XML library.
-     *
-     * @param aName is the name to associate with a new node of type wxXML_ELEMENT_NODE.
-     * @param aTextualContent is optional, and if given is the text to include in a child
-     *   of the returned node, and has type wxXML_TEXT_NODE.
-     */
-    XNODE* node( const wxString& aName, const wxString& aTextualContent = wxEmptyString );
-
     /**
-     * Function makeGenericRoot
-     * builds the entire document tree for the generic export.  This is factored
-     * out here so we can write the tree in either S-expression file format
-     * or in XML if we put the tree built here into a wxXmlDocument.
+     * Function writeRoot
+     * produces the entire document for the generic export.  This is factored out here so
+     * we can write the document in either S-expression file format or in XML, and either
+     * build it as a tree (XNODE_BUILDER) or stream it to a file (XNODE_STREAM).
+     * @param aSink - the receiver of the document
      * @param aCtl - a bitset or-ed together from GNL_ENUM values
-     * @return XNODE* - the root nodes
      */
-    XNODE* makeRoot( int aCtl = GNL_ALL );
+    void writeRoot( XNODE_SINK& aSink, int aCtl = GNL_ALL );
 
     /**
-     * Function makeComponents
-     * @return XNODE* - returns a sub-tree holding all the schematic components.
+     * Function writeComponents
+     * produces the "components" element holding all the schematic components.
      */
-    XNODE* makeComponents();
+    void writeComponents( XNODE_SINK& aSink );
 
     /**
-     * Function makeDesignHeader
-     * fills out a project "design" header into an XML node.
-     * @return XNODE* - the design header
+     * Function writeDesignHeader
+     * produces the project "design" header element.
      */
-    XNODE* makeDesignHeader();
+    void writeDesignHeader( XNODE_SINK& aSink );
 
     /**
-     * Function makeLibParts
-     * fills out an XML node with the unique library parts and returns it.
-     * @return XNODE* - the library parts nodes
+     * Function writeLibParts
+     * produces the "libparts" element holding the unique library parts.
+     * Must be called after writeComponents().
      */
-    XNODE* makeLibParts();
+    void writeLibParts( XNODE_SINK& aSink );
 
     /**
-     * Function makeListOfNets
-     * fills out an XML node with a list of nets and returns it.
-     * @return XNODE* - the list of nets nodes
+     * Function writeListOfNets
+     * produces the "nets" element holding the list of nets.
      */
-    XNODE* makeListOfNets( bool aUseGraph = true );
+    void writeListOfNets( XNODE_SINK& aSink, bool aUseGraph = true );
 
     /**
-     * Function makeLibraries
-     * fills out an XML node with a list of used libraries and returns it.
-     * Must have called makeGenericLibParts() before this function.
-     * @return XNODE* - the library nodes
+     * Function writeLibraries
+     * produces the "libraries" element holding the list of used libraries.
+     * Must be called after writeLibParts().
      */
-    XNODE* makeLibraries();
+    void writeLibraries( XNODE_SINK& aSink );
 
-    void addComponentFields(  XNODE* xcomp, SCH_COMPONENT* comp, SCH_SHEET_PATH* aSheet );
+    void writeComponentFields( XNODE_SINK& aSink, SCH_COMPONENT* comp, SCH_SHEET_PATH* aSheet );
 };
 
 #endif
@@ -60,7 +60,8 @@ void NETLIST_EXPORTER_KICAD::Format( OUTPUTFORMATTER* aOut, int aCtl )
     for( unsigned ii = 0; ii < m_masterList->size(); ii++ )
         m_masterList->GetItem( ii )->m_Flag = 0;
 
-    std::unique_ptr<XNODE> xroot( makeRoot( aCtl ) );
+    // Write the netlist as it is produced, with the same layout as XNODE::Format()
+    XNODE_STREAM stream( aOut, XNODE_STREAM::SEXPR );
 
-    xroot->Format( aOut, 0 );
+    writeRoot( stream, aCtl );
 }
@@ -237,8 +237,8 @@ NETLIST_OBJECT_LIST* SCH_EDIT_FRAME::CreateNetlist( bool aSilent,
 
 NETLIST_OBJECT_LIST* SCH_EDIT_FRAME::BuildNetListBase( bool updateStatusText )
 {
-    // Ensure netlist is up to date
-    RecalculateConnections( NO_CLEANUP );
+    // Ensure netlist is up to date; the netlist is built from a full rebuild of the graph
+    RecalculateConnections( NO_CLEANUP, true );
 
     // I own this list until I return it to the new owner.
     std::unique_ptr<NETLIST_OBJECT_LIST> ret( new NETLIST_OBJECT_LIST() );
@@ -36,6 +36,8 @@
 #include <lib_pin.h>
 #include <sch_item.h>
 
+#include <unordered_map>
+
 class NETLIST_OBJECT_LIST;
 class SCH_COMPONENT;
 
@@ -302,6 +304,9 @@ class NETLIST_OBJECT_LIST : public NETLIST_OBJECTS
     int m_lastBusNetCode;   // Used in intermediate calculation:
                             // last net code created for bus members
 
+    // Used in intermediate calculation: the label type objects of the list, by label text
+    std::unordered_map<wxString, NETLIST_OBJECTS> m_labelsByName;
+
 public:
     /**
      * Constructor.
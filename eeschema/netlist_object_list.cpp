@@ -32,6 +32,7 @@
 #include <sch_text.h>
 #include <sch_sheet.h>
 #include <algorithm>
+#include <map>
 
 #define IS_WIRE false
 #define IS_BUS true
@@ -203,6 +204,15 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
     // Updating the Bus Labels Netcode connected by Bus
     connectBusLabels();
 
+    // Index label objects by their text, since only labels having the same text are connected
+    m_labelsByName.clear();
+
+    for( unsigned ii = 0; ii < size(); ii++ )
+    {
+        if( GetItem( ii )->IsLabelType() )
+            m_labelsByName[ GetItem( ii )->m_Label ].push_back( GetItem( ii ) );
+    }
+
     // Group objects by label.
     for( unsigned ii = 0; ii < size(); ii++ )
     {
@@ -247,6 +257,8 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
             sheetLabelConnect( GetItem( ii ) );
     }
 
+    m_labelsByName.clear();
+
     // Sort objects by NetCode
     SortListbyNetcode();
 
@@ -502,10 +514,13 @@ void NETLIST_OBJECT_LIST::sheetLabelConnect( NETLIST_OBJECT* SheetLabel )
     if( SheetLabel->GetNet() == 0 )
         return;
 
-    for( unsigned ii = 0; ii < size(); ii++ )
-    {
-        NETLIST_OBJECT* ObjetNet = GetItem( ii );
+    auto labels = m_labelsByName.find( SheetLabel->m_Label );
 
+    if( labels == m_labelsByName.end() )
+        return;
+
+    for( NETLIST_OBJECT* ObjetNet : labels->second )
+    {
         if( ObjetNet->m_SheetPath != SheetLabel->m_SheetPathInclude )
             continue;  //use SheetInclude, not the sheet!!
 
@@ -532,40 +547,48 @@ void NETLIST_OBJECT_LIST::connectBusLabels()
 {
     // Propagate the net code between all bus label member objects connected by they name.
     // If the net code is not yet existing, a new one is created
-    // Search is done in the entire list
+    // Search is done in the entire list: bus label members are connected when they have
+    // the same bus net code and member, so group them first by these values.
+    std::map<std::pair<int, int>, NETLIST_OBJECTS> groups;
+    std::vector<NETLIST_OBJECTS*> groupList;    // groups, in the order of their first member
+
     for( unsigned ii = 0; ii < size(); ii++ )
     {
         NETLIST_OBJECT* Label = GetItem( ii );
 
         if( Label->IsLabelBusMemberType() )
         {
-            if( Label->GetNet() == 0 )
-            {
-                // Not yet existiing net code: create a new one.
-                Label->SetNet( m_lastNetCode );
-                m_lastNetCode++;
-            }
+            NETLIST_OBJECTS& group = groups[ std::make_pair( Label->m_BusNetCode,
+                                                             Label->m_Member ) ];
 
-            for( unsigned jj = ii + 1; jj < size(); jj++ )
-            {
-                NETLIST_OBJECT* LabelInTst =  GetItem( jj );
+            if( group.empty() )
+                groupList.push_back( &group );
 
-                if( LabelInTst->IsLabelBusMemberType() )
-                {
-                    if( LabelInTst->m_BusNetCode != Label->m_BusNetCode )
-                        continue;
+            group.push_back( Label );
+        }
+    }
 
-                    if( LabelInTst->m_Member != Label->m_Member )
-                        continue;
+    for( NETLIST_OBJECTS* group : groupList )
+    {
+        NETLIST_OBJECT* Label = group->front();
 
-                    if( LabelInTst->GetNet() == 0 )
-                        // Append this object to the current net
-                        LabelInTst->SetNet( Label->GetNet() );
-                    else
-                        // Merge the 2 net codes, they are connected.
-                        propagateNetCode( LabelInTst->GetNet(), Label->GetNet(), IS_WIRE );
-                }
-            }
+        if( Label->GetNet() == 0 )
+        {
+            // Not yet existiing net code: create a new one.
+            Label->SetNet( m_lastNetCode );
+            m_lastNetCode++;
+        }
+
+        for( unsigned jj = 1; jj < group->size(); jj++ )
+        {
+            NETLIST_OBJECT* LabelInTst = ( *group )[jj];
+
+            if( LabelInTst->GetNet() == 0 )
+                // Append this object to the current net
+                LabelInTst->SetNet( Label->GetNet() );
+            else
+                // Merge the 2 net codes, they are connected.
+                propagateNetCode( LabelInTst->GetNet(), Label->GetNet(), IS_WIRE );
         }
     }
 }
@@ -743,10 +766,13 @@ void NETLIST_OBJECT_LIST::labelConnect( NETLIST_OBJECT* aLabelRef )
     if( aLabelRef->GetNet() == 0 )
         return;
 
-    for( unsigned i = 0; i < size(); i++ )
-    {
-        NETLIST_OBJECT* item = GetItem( i );
+    auto labels = m_labelsByName.find( aLabelRef->m_Label );
+
+    if( labels == m_labelsByName.end() )
+        return;
 
+    for( NETLIST_OBJECT* item : labels->second )
+    {
         if( item->GetNet() == aLabelRef->GetNet() )
             continue;
 
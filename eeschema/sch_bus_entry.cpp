@@ -192,7 +192,7 @@ void SCH_BUS_ENTRY_BASE::Rotate( wxPoint aPosition )
 }
 
 
-bool SCH_BUS_WIRE_ENTRY::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList,
+bool SCH_BUS_WIRE_ENTRY::UpdateDanglingState( const DANGLING_END_ITEM_INDEX& aItemList,
                                               const SCH_SHEET_PATH* aPath )
 {
     bool previousStateStart = m_isDanglingStart;
@@ -200,45 +200,49 @@ bool SCH_BUS_WIRE_ENTRY::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aI
 
     m_isDanglingStart = m_isDanglingEnd = true;
 
-    // Wires and buses are stored in the list as a pair, start and end. This
-    // variable holds the start position from one iteration so it can be used
-    // when the end position is found.
-    wxPoint seg_start;
-
     // Store the connection type and state for the start (0) and end (1)
     bool has_wire[2] = { false };
     bool has_bus[2] = { false };
 
-    for( DANGLING_END_ITEM& each_item : aItemList )
-    {
-        if( each_item.GetItem() == this )
-            continue;
+    auto hasWireAt =
+            [&]( const wxPoint& aPos ) -> bool
+            {
+                bool found = false;
 
-        switch( each_item.GetType() )
-        {
-        case WIRE_START_END:
-        case WIRE_END_END:
-            if( m_pos == each_item.GetPosition() )
-                has_wire[0] = true;
-            else if( m_End() == each_item.GetPosition() )
-                has_wire[1] = true;
+                aItemList.ForEachAt( aPos,
+                        [&]( size_t, const DANGLING_END_ITEM& each_item ) -> bool
+                        {
+                            found = each_item.GetItem() != this
+                                        && ( each_item.GetType() == WIRE_START_END
+                                             || each_item.GetType() == WIRE_END_END );
+                            return !found;
+                        } );
 
-            break;
+                return found;
+            };
 
-        case BUS_START_END:
-            seg_start = each_item.GetPosition();
-            break;
+    has_wire[0] = hasWireAt( m_pos );
+    has_wire[1] = m_End() != m_pos && hasWireAt( m_End() );
 
-        case BUS_END_END:
-            if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_pos ) )
-                has_bus[0] = true;
-            else if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_End() ) )
-                has_bus[1] = true;
+    // Wires and buses are stored in the list as a pair, start and end.
+    const std::vector<DANGLING_END_ITEM>& items = aItemList.Items();
+
+    for( size_t ii : aItemList.SegmentsAt( m_pos, true ) )
+    {
+        if( IsPointOnSegment( items[ii].GetPosition(), items[ii + 1].GetPosition(), m_pos ) )
+            has_bus[0] = true;
+    }
 
-            break;
+    // Only the buses which do not go through the start point count for the end point
+    for( size_t ii : aItemList.SegmentsAt( m_End(), true ) )
+    {
+        const wxPoint& seg_start = items[ii].GetPosition();
+        const wxPoint& seg_end = items[ii + 1].GetPosition();
 
-        default:
-            break;
+        if( !IsPointOnSegment( seg_start, seg_end, m_pos )
+                && IsPointOnSegment( seg_start, seg_end, m_End() ) )
+        {
+            has_bus[1] = true;
         }
     }
 
@@ -255,7 +259,7 @@ bool SCH_BUS_WIRE_ENTRY::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aI
 }
 
 
-bool SCH_BUS_BUS_ENTRY::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList,
+bool SCH_BUS_BUS_ENTRY::UpdateDanglingState( const DANGLING_END_ITEM_INDEX& aItemList,
                                              const SCH_SHEET_PATH* aPath )
 {
     bool previousStateStart = m_isDanglingStart;
@@ -263,30 +267,19 @@ bool SCH_BUS_BUS_ENTRY::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aIt
 
     m_isDanglingStart = m_isDanglingEnd = true;
 
-    // Wires and buses are stored in the list as a pair, start and end. This
-    // variable holds the start position from one iteration so it can be used
-    // when the end position is found.
-    wxPoint seg_start;
+    // Wires and buses are stored in the list as a pair, start and end.
+    const std::vector<DANGLING_END_ITEM>& items = aItemList.Items();
 
-    for( DANGLING_END_ITEM& each_item : aItemList )
+    for( size_t ii : aItemList.SegmentsAt( m_pos, true ) )
     {
-        if( each_item.GetItem() == this )
-            continue;
+        if( IsPointOnSegment( items[ii].GetPosition(), items[ii + 1].GetPosition(), m_pos ) )
+            m_isDanglingStart = false;
+    }
 
-        switch( each_item.GetType() )
-        {
-        case BUS_START_END:
-            seg_start = each_item.GetPosition();
-            break;
-        case BUS_END_END:
-            if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_pos ) )
-                m_isDanglingStart = false;
-            if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_End() ) )
-                m_isDanglingEnd = false;
-            break;
-        default:
-            break;
-        }
+    for( size_t ii : aItemList.SegmentsAt( m_End(), true ) )
+    {
+        if( IsPointOnSegment( items[ii].GetPosition(), items[ii + 1].GetPosition(), m_End() ) )
+            m_isDanglingEnd = false;
     }
 
     return (previousStateStart != m_isDanglingStart) || (previousStateEnd != m_isDanglingEnd);
@@ -89,25 +89,26 @@ std::string toUTFTildaText( const wxString& txt )
  */
 static LIB_PART* dummy()
 {
-    static LIB_PART* part;
-
-    if( !part )
+    // Initialized once, even when components are created concurrently.
+    static LIB_PART* part = []()
     {
-        part = new LIB_PART( wxEmptyString );
+        LIB_PART* newPart = new LIB_PART( wxEmptyString );
 
-        LIB_RECTANGLE* square = new LIB_RECTANGLE( part );
+        LIB_RECTANGLE* square = new LIB_RECTANGLE( newPart );
 
         square->MoveTo( wxPoint( Mils2iu( -200 ), Mils2iu( 200 ) ) );
         square->SetEndPosition( wxPoint( Mils2iu( 200 ), Mils2iu( -200 ) ) );
 
-        LIB_TEXT* text = new LIB_TEXT( part );
+        LIB_TEXT* text = new LIB_TEXT( newPart );
 
         text->SetTextSize( wxSize( Mils2iu( 150 ), Mils2iu( 150 ) ) );
         text->SetText( wxString( wxT( "??" ) ) );
 
-        part->AddDrawItem( square );
-        part->AddDrawItem( text );
-    }
+        newPart->AddDrawItem( square );
+        newPart->AddDrawItem( text );
+
+        return newPart;
+    }();
 
     return part;
 }
@@ -652,6 +653,9 @@ void SCH_COMPONENT::SetRef( const SCH_SHEET_PATH* sheet, const wxString& ref )
 
     rf->SetText( ref );  // for drawing.
 
+    for( std::unique_ptr<SCH_PIN>& pin : m_pins )
+        pin->ClearDefaultNetName( sheet );
+
     // Reinit the m_prefix member if needed
     wxString prefix = ref;
 
@@ -1016,6 +1020,9 @@ void SCH_COMPONENT::ClearAnnotation( SCH_SHEET_PATH* aSheetPath )
     // But this call cannot made here.
     m_Fields[REFERENCE].SetText( defRef ); //for drawing.
 
+    for( std::unique_ptr<SCH_PIN>& pin : m_pins )
+        pin->ClearDefaultNetName( aSheetPath );
+
     SetModified();
 }
 
@@ -1453,7 +1460,7 @@ void SCH_COMPONENT::GetEndPoints( std::vector <DANGLING_END_ITEM>& aItemList )
 }
 
 
-bool SCH_COMPONENT::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList,
+bool SCH_COMPONENT::UpdateDanglingState( const DANGLING_END_ITEM_INDEX& aItemList,
                                          const SCH_SHEET_PATH* aPath )
 {
     bool changed = false;
@@ -1465,37 +1472,32 @@ bool SCH_COMPONENT::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemLi
 
         wxPoint pos = m_transform.TransformCoordinate( pin->GetLocalPosition() ) + m_Pos;
 
-        for( DANGLING_END_ITEM& each_item : aItemList )
-        {
-            // Some people like to stack pins on top of each other in a symbol to indicate
-            // internal connection. While technically connected, it is not particularly useful
-            // to display them that way, so skip any pins that are in the same symbol as this
-            // one.
-            if( each_item.GetParent() == this )
-                continue;
-
-            switch( each_item.GetType() )
-            {
-            case PIN_END:
-            case LABEL_END:
-            case SHEET_LABEL_END:
-            case WIRE_START_END:
-            case WIRE_END_END:
-            case NO_CONNECT_END:
-            case JUNCTION_END:
-
-                if( pos == each_item.GetPosition() )
-                    pin->SetIsDangling( false );
-
-                break;
-
-            default:
-                break;
-            }
-
-            if( !pin->IsDangling() )
-                break;
-        }
+        aItemList.ForEachAt( pos,
+                [&]( size_t, const DANGLING_END_ITEM& each_item ) -> bool
+                {
+                    // Some people like to stack pins on top of each other in a symbol to
+                    // indicate internal connection. While technically connected, it is not
+                    // particularly useful to display them that way, so skip any pins that are
+                    // in the same symbol as this one.
+                    if( each_item.GetParent() == this )
+                        return true;
+
+                    switch( each_item.GetType() )
+                    {
+                    case PIN_END:
+                    case LABEL_END:
+                    case SHEET_LABEL_END:
+                    case WIRE_START_END:
+                    case WIRE_END_END:
+                    case NO_CONNECT_END:
+                    case JUNCTION_END:
+                        pin->SetIsDangling( false );
+                        return false;
+
+                    default:
+                        return true;
+                    }
+                } );
 
         changed = ( changed || ( previousState != pin->IsDangling() ) );
     }
@@ -467,6 +467,12 @@ public:
      */
     SCH_PIN_PTRS GetSchPins( const SCH_SHEET_PATH* aSheet = nullptr ) const;
 
+    /**
+     * @return the SCH_PINs of all the units of the component.  They are rebuilt by
+     *         UpdatePins(), so pointers to them must not be kept.
+     */
+    const SCH_PINS& GetRawPins() const { return m_pins; }
+
     /**
      * Print a component
      *
@@ -563,7 +569,7 @@ public:
      *
      * @return true if any pin's state has changed.
      */
-    bool UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList,
+    bool UpdateDanglingState( const DANGLING_END_ITEM_INDEX& aItemList,
                               const SCH_SHEET_PATH* aPath = nullptr ) override;
 
     wxPoint GetPinPhysicalPosition( const LIB_PIN* Pin ) const;
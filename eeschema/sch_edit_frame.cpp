@@ -46,6 +46,7 @@
 #include <profile.h>
 #include <project.h>
 #include <reporter.h>
+#include <sch_component.h>
 #include <sch_edit_frame.h>
 #include <sch_painter.h>
 #include <sch_sheet.h>
@@ -59,6 +60,7 @@
 #include <tool/tool_dispatcher.h>
 #include <tool/tool_manager.h>
 #include <tool/zoom_tool.h>
+#include <trace_helpers.h>
 #include <tools/ee_actions.h>
 #include <tools/ee_inspection_tool.h>
 #include <tools/ee_point_editor.h>
@@ -1000,6 +1002,7 @@ void SCH_EDIT_FRAME::AddItemToScreenAndUndoList( SCH_ITEM* aItem, bool aUndoAppe
             SaveCopyInUndoList( undoItem, UR_CHANGED, aUndoAppend );     // save the parent sheet
 
             parentSheet->AddPin( (SCH_SHEET_PIN*) aItem );
+            screen->Update( parentSheet );
         }
         else if( aItem->Type() == SCH_FIELD_T )
         {
@@ -1088,7 +1091,7 @@ int SCH_EDIT_FRAME::GetSeverity( int aErrorCode ) const
 }
 
 
-void SCH_EDIT_FRAME::RecalculateConnections( SCH_CLEANUP_FLAGS aCleanupFlags )
+void SCH_EDIT_FRAME::RecalculateConnections( SCH_CLEANUP_FLAGS aCleanupFlags, bool aUnconditional )
 {
     SCH_SHEET_LIST list( g_RootSheet );
     PROF_COUNTER   timer;
@@ -1105,9 +1108,24 @@ void SCH_EDIT_FRAME::RecalculateConnections( SCH_CLEANUP_FLAGS aCleanupFlags )
     }
 
     timer.Stop();
-    wxLogTrace( "CONN_PROFILE", "SchematicCleanUp() %0.4f ms", timer.msecs() );
+    wxLogTrace( traceConnectivityProfile, "SchematicCleanUp() %0.4f ms", timer.msecs() );
 
-    g_ConnectionGraph->Recalculate( list, true );
+    // Repaint the items of the current sheet whose net changed
+    std::function<void( SCH_ITEM* )> changeHandler =
+            [&]( SCH_ITEM* aItem )
+            {
+                if( aItem->Type() == SCH_PIN_T )
+                    aItem = static_cast<SCH_PIN*>( aItem )->GetParentComponent();
+                else if( aItem->Type() == SCH_SHEET_PIN_T )
+                    aItem = static_cast<SCH_SHEET_PIN*>( aItem )->GetParent();
+
+                GetCanvas()->GetView()->Update( aItem, KIGFX::REPAINT );
+            };
+
+    // Only the items changed since the last update are processed, unless the whole schematic
+    // has been cleaned up (i.e. it was just loaded) or a full rebuild was requested
+    g_ConnectionGraph->Recalculate( list, aUnconditional || aCleanupFlags == GLOBAL_CLEANUP,
+                                    &changeHandler );
 }
 
 
@@ -992,8 +992,12 @@ public:
 
     /**
      * Generates the connection data for the entire schematic hierarchy.
+     *
+     * @param aCleanupFlags selects the sheets cleaned up first.
+     * @param aUnconditional rebuilds the whole connection graph instead of updating only the
+     *                       nets touched by the changes since the last update.
      */
-    void RecalculateConnections( SCH_CLEANUP_FLAGS aCleanupFlags );
+    void RecalculateConnections( SCH_CLEANUP_FLAGS aCleanupFlags, bool aUnconditional = false );
 
     /**
      * Allows Eeschema to install its preferences panels into the preferences dialog.
@@ -145,6 +145,65 @@ ITEM_SET& SCH_ITEM::ConnectedItems( const SCH_SHEET_PATH& aSheet )
 }
 
 
+DANGLING_END_ITEM_INDEX::DANGLING_END_ITEM_INDEX( std::vector<DANGLING_END_ITEM> aItems ) :
+        m_items( std::move( aItems ) )
+{
+    m_byPosition.resize( m_items.size() );
+
+    for( size_t ii = 0; ii < m_items.size(); ii++ )
+    {
+        m_byPosition[ii] = ii;
+
+        // Wires and buses are stored in the list as a pair, start and end
+        if( ii + 1 < m_items.size() )
+        {
+            const wxPoint& start = m_items[ii].GetPosition();
+            const wxPoint& end = m_items[ii + 1].GetPosition();
+            int            min[2] = { std::min( start.x, end.x ), std::min( start.y, end.y ) };
+            int            max[2] = { std::max( start.x, end.x ), std::max( start.y, end.y ) };
+
+            if( m_items[ii].GetType() == WIRE_START_END )
+            {
+                m_wireStarts.push_back( ii );
+                m_wireTree.Insert( min, max, ii );
+            }
+            else if( m_items[ii].GetType() == BUS_START_END )
+            {
+                m_busStarts.push_back( ii );
+                m_busTree.Insert( min, max, ii );
+            }
+        }
+    }
+
+    // Stable, so that the items at a given position keep the order of the list
+    std::stable_sort( m_byPosition.begin(), m_byPosition.end(),
+                      [&]( size_t a, size_t b )
+                      {
+                          return lessPos( m_items[a].GetPosition(), m_items[b].GetPosition() );
+                      } );
+}
+
+
+std::vector<size_t> DANGLING_END_ITEM_INDEX::SegmentsAt( const wxPoint& aPos, bool aBus,
+                                                         int aAccuracy ) const
+{
+    int                 min[2] = { aPos.x - aAccuracy, aPos.y - aAccuracy };
+    int                 max[2] = { aPos.x + aAccuracy, aPos.y + aAccuracy };
+    std::vector<size_t> found;
+
+    ( aBus ? m_busTree : m_wireTree ).Search( min, max,
+            [&]( const size_t& aIdx ) -> bool
+            {
+                found.push_back( aIdx );
+                return true;
+            } );
+
+    std::sort( found.begin(), found.end() );
+
+    return found;
+}
+
+
 void SCH_ITEM::AddConnectionTo( const SCH_SHEET_PATH& aSheet, SCH_ITEM* aItem )
 {
     m_connected_items[ aSheet ].insert( aItem );
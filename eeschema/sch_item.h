@@ -25,12 +25,14 @@
 #ifndef SCH_ITEM_H
 #define SCH_ITEM_H
 
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include <base_struct.h>
 #include <general.h>
+#include <geometry/rtree.h>
 #include <sch_sheet_path.h>
 #include <render_settings.h>
 
@@ -138,6 +140,72 @@ public:
 };
 
 
+/**
+ * DANGLING_END_ITEM_INDEX
+ * indexes a list of DANGLING_END_ITEMs by position, so that testing an item for dangling
+ * ends doesn't have to scan every end point of the screen.  The wire and bus segments are
+ * also indexed by bounding box for the items which connect anywhere along a segment.
+ */
+class DANGLING_END_ITEM_INDEX
+{
+public:
+    DANGLING_END_ITEM_INDEX( std::vector<DANGLING_END_ITEM> aItems );
+
+    DANGLING_END_ITEM_INDEX( const DANGLING_END_ITEM_INDEX& ) = delete;
+    DANGLING_END_ITEM_INDEX& operator=( const DANGLING_END_ITEM_INDEX& ) = delete;
+
+    /// The end points in their original order (wires and buses as start/end pairs).
+    const std::vector<DANGLING_END_ITEM>& Items() const { return m_items; }
+
+    /**
+     * Calls aFunc( index, item ) for each end point at \a aPos, in the order of Items(),
+     * until aFunc returns false.
+     */
+    template <typename FUNC>
+    void ForEachAt( const wxPoint& aPos, FUNC aFunc ) const
+    {
+        auto it = std::lower_bound( m_byPosition.begin(), m_byPosition.end(), aPos,
+                                    [&]( size_t aIdx, const wxPoint& aPt )
+                                    {
+                                        return lessPos( m_items[aIdx].GetPosition(), aPt );
+                                    } );
+
+        for( ; it != m_byPosition.end() && m_items[*it].GetPosition() == aPos; ++it )
+        {
+            if( !aFunc( *it, m_items[*it] ) )
+                break;
+        }
+    }
+
+    /// Indices in Items() of the wire start points; the end point follows each of them.
+    const std::vector<size_t>& WireStarts() const { return m_wireStarts; }
+
+    /// Indices in Items() of the bus start points; the end point follows each of them.
+    const std::vector<size_t>& BusStarts() const { return m_busStarts; }
+
+    /**
+     * Returns the indices in Items() of the start points of the wires, or of the buses when
+     * \a aBus is true, whose bounding box inflated by \a aAccuracy contains \a aPos.  They
+     * are sorted in the order of Items(), and the segments must still be hit tested.
+     */
+    std::vector<size_t> SegmentsAt( const wxPoint& aPos, bool aBus, int aAccuracy = 0 ) const;
+
+private:
+    static bool lessPos( const wxPoint& a, const wxPoint& b )
+    {
+        return a.x < b.x || ( a.x == b.x && a.y < b.y );
+    }
+
+    std::vector<DANGLING_END_ITEM> m_items;
+    std::vector<size_t>            m_byPosition;    // indices in m_items, sorted by position
+    std::vector<size_t>            m_wireStarts;
+    std::vector<size_t>            m_busStarts;
+
+    RTree<size_t, int, 2, double>  m_wireTree;      // wire start indices by bounding box
+    RTree<size_t, int, 2, double>  m_busTree;       // bus start indices by bounding box
+};
+
+
 typedef std::unordered_set<SCH_ITEM*> ITEM_SET;
 
 /**
@@ -317,11 +385,11 @@ public:
      * If aSheet is passed a non-null pointer to a SCH_SHEET_PATH, the overrided method can
      * optionally use it to update sheet-local connectivity information
      *
-     * @param aItemList - List of items to test item against.
+     * @param aItemList - Index of the items to test item against.
      * @param aSheet - Sheet path to update connections for
      * @return True if the dangling state has changed from it's current setting.
      */
-    virtual bool UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList,
+    virtual bool UpdateDanglingState( const DANGLING_END_ITEM_INDEX& aItemList,
                                       const SCH_SHEET_PATH* aPath = nullptr )
     {
         return false;
@@ -21,9 +21,12 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <boost/algorithm/string/join.hpp>
 #include <cctype>
+#include <future>
 #include <set>
+#include <thread>
 
 #include <wx/mstream.h>
 #include <wx/filename.h>
@@ -68,6 +71,7 @@
 #include <confirm.h>
 #include <tool/selection.h>
 #include <default_values.h>    // For some default values
+#include <settings/settings_manager.h>
 
 
 #define Mils2Iu( x ) Mils2iu( x )
@@ -76,6 +80,10 @@
 // Must be the first line of part library document (.dcm) files.
 #define DOCFILE_IDENT     "EESchema-DOCLIB  Version 2.0"
 
+// Must be the first line of the symbol library index files, followed by the index version.
+#define INDEXFILE_IDENT   "EESchema-LIBINDEX Version"
+#define INDEXFILE_VERSION 1
+
 #define SCH_PARSE_ERROR( text, reader, pos )                         \
     THROW_PARSE_ERROR( text, reader.GetSource(), reader.Line(),      \
                        reader.LineNumber(), pos - reader.Line() )
@@ -485,7 +493,28 @@ class SCH_LEGACY_PLUGIN_CACHE
     int             m_versionMinor;
     int             m_libType;      // Is this cache a component or symbol library.
 
+    /// File position of a DEF line whose drawing has not been loaded yet.
+    struct DEFERRED_PART
+    {
+        long     m_offset;
+        unsigned m_lineNumber;
+    };
+
+    std::map<LIB_PART*, DEFERRED_PART> m_deferredParts;  // Root symbols without drawing yet.
+    wxString                           m_deferredFileName;
+
     void                  loadHeader( FILE_LINE_READER& aReader );
+    void                  loadDefinitions();
+    bool                  loadIndex();
+    void                  saveIndex();
+    wxFileName            getIndexFileName() const;
+    wxString              getIndexSource() const;
+    void                  loadDeferredPart( LIB_PART* aPart );
+    void                  loadDeferredParts();
+    void                  loadDrawing( LIB_PART* aPart, DEFERRED_PART aDeferred,
+                                       FILE_LINE_READER& aReader );
+    std::map<wxString, DEFERRED_PART> rebuildIndex();
+    static void           skipDrawEntries( LINE_READER& aReader );
     static void           loadAliases( std::unique_ptr<LIB_PART>& aPart, LINE_READER& aReader,
                                        LIB_PART_MAP* aMap = nullptr );
     static void           loadField( std::unique_ptr<LIB_PART>& aPart, LINE_READER& aReader );
@@ -557,7 +586,7 @@ public:
     wxString GetFileName() const { return m_libFileName.GetFullPath(); }
 
     static LIB_PART* LoadPart( LINE_READER& aReader, int aMajorVersion, int aMinorVersion,
-                               LIB_PART_MAP* aMap = nullptr );
+                               LIB_PART_MAP* aMap = nullptr, bool aSkipDrawEntries = false );
     static void      SaveSymbol( LIB_PART* aSymbol, OUTPUTFORMATTER& aFormatter,
                                  LIB_PART_MAP* aMap = nullptr );
 };
@@ -579,6 +608,7 @@ void SCH_LEGACY_PLUGIN::init( KIWAY* aKiway, const PROPERTIES* aProperties )
 {
     m_version = 0;
     m_rootSheet = NULL;
+    m_rootModified = false;
     m_props = aProperties;
     m_kiway = aKiway;
     m_cache = NULL;
@@ -648,84 +678,158 @@ SCH_SHEET* SCH_LEGACY_PLUGIN::Load( const wxString& aFileName, KIWAY* aKiway,
 
     wxASSERT( m_currentPath.size() == 1 );  // only the project path should remain
 
+    // Set the file as modified so the user can be warned about the fixed components.
+    if( m_rootModified && m_rootSheet->GetScreen() )
+        m_rootSheet->GetScreen()->SetModify();
+
     return sheet;
 }
 
 
-// Everything below this comment is recursive.  Modify with care.
-
 void SCH_LEGACY_PLUGIN::loadHierarchy( SCH_SHEET* aSheet )
 {
-    SCH_SCREEN* screen = NULL;
+    // A file to load, for the first sheet using it.
+    struct LOAD_JOB
+    {
+        SCH_SHEET*                m_sheet;
+        wxString                  m_fileName;
+        std::unique_ptr<IO_ERROR> m_ioError;
+        bool                      m_rootModified;
+    };
+
+    // The hierarchy is loaded breadth-first.  The screens of each level are created and
+    // shared on the main thread, their files are parsed concurrently, and the sub-sheets
+    // found in them are linked on the main thread to make the next level.  Each sheet comes
+    // with the path its file name is relative to: the path of its parent sheet file.
+    std::vector<std::pair<SCH_SHEET*, wxString>> level;
 
-    if( !aSheet->GetScreen() )
+    level.emplace_back( aSheet, m_currentPath.top() );
+
+    while( !level.empty() )
     {
-        // SCH_SCREEN objects store the full path and file name where the SCH_SHEET object only
-        // stores the file name and extension.  Add the project path to the file name and
-        // extension to compare when calling SCH_SHEET::SearchHierarchy().
-        wxFileName fileName = aSheet->GetFileName();
-        fileName.SetExt( "sch" );
-
-        if( !fileName.IsAbsolute() )
-            fileName.MakeAbsolute( m_currentPath.top() );
-
-        // Save the current path so that it gets restored when decending and ascending the
-        // sheet hierarchy which allows for sheet schematic files to be nested in folders
-        // relative to the last path a schematic was loaded from.
-        wxLogTrace( traceSchLegacyPlugin, "Saving path    \"%s\"", m_currentPath.top() );
-        m_currentPath.push( fileName.GetPath() );
-        wxLogTrace( traceSchLegacyPlugin, "Current path   \"%s\"", m_currentPath.top() );
-        wxLogTrace( traceSchLegacyPlugin, "Loading        \"%s\"", fileName.GetFullPath() );
-
-        m_rootSheet->SearchHierarchy( fileName.GetFullPath(), &screen );
-
-        if( screen )
+        std::vector<LOAD_JOB> jobs;
+
+        for( const std::pair<SCH_SHEET*, wxString>& entry : level )
         {
-            aSheet->SetScreen( screen );
+            SCH_SHEET*  sheet = entry.first;
+            SCH_SCREEN* screen = NULL;
+
+            if( sheet->GetScreen() )
+                continue;
+
+            // SCH_SCREEN objects store the full path and file name where the SCH_SHEET object
+            // only stores the file name and extension.  Add the project path to the file name
+            // and extension to compare when calling SCH_SHEET::SearchHierarchy().
+            wxFileName fileName = sheet->GetFileName();
+            fileName.SetExt( "sch" );
+
+            if( !fileName.IsAbsolute() )
+                fileName.MakeAbsolute( entry.second );
+
+            wxLogTrace( traceSchLegacyPlugin, "Loading        \"%s\"", fileName.GetFullPath() );
+
+            // This also finds the screens created for the previous sheets of this level.
+            m_rootSheet->SearchHierarchy( fileName.GetFullPath(), &screen );
 
-            // Do not need to load the sub-sheets - this has already been done.
+            if( screen )
+            {
+                sheet->SetScreen( screen );
+
+                // Do not need to load the sub-sheets - this has already been done.
+                continue;
+            }
+
+            sheet->SetScreen( new SCH_SCREEN( m_kiway ) );
+            sheet->GetScreen()->SetFileName( fileName.GetFullPath() );
+
+            jobs.push_back( { sheet, fileName.GetFullPath(), nullptr, false } );
         }
-        else
-        {
-            aSheet->SetScreen( new SCH_SCREEN( m_kiway ) );
-            aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
 
-            try
+        size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                       jobs.size() );
+
+        std::atomic<size_t> nextJob( 0 );
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        auto load_lambda = [&]() -> size_t
+        {
+            for( size_t ii = nextJob++; ii < jobs.size(); ii = nextJob++ )
             {
-                loadFile( fileName.GetFullPath(), aSheet->GetScreen() );
+                LOAD_JOB& job = jobs[ii];
+
+                // The parsing state of the plugin is per file, so each file gets its own.
+                SCH_LEGACY_PLUGIN loader;
+
+                loader.init( m_kiway, m_props );
+                loader.m_rootSheet = m_rootSheet;
+
+                try
+                {
+                    loader.loadFile( job.m_fileName, job.m_sheet->GetScreen() );
+                }
+                catch( const IO_ERROR& ioe )
+                {
+                    job.m_ioError.reset( new IO_ERROR( ioe ) );
+                }
+
+                job.m_rootModified = loader.m_rootModified;
             }
-            catch( const IO_ERROR& ioe )
+
+            return 1;
+        };
+
+        if( parallelThreadCount <= 1 )
+            load_lambda();
+        else
+        {
+            for( size_t ii = 0; ii < parallelThreadCount; ii++ )
+                returns[ii] = std::async( std::launch::async, load_lambda );
+
+            // Finalize the threads
+            for( size_t ii = 0; ii < parallelThreadCount; ii++ )
+                returns[ii].wait();
+        }
+
+        std::vector<std::pair<SCH_SHEET*, wxString>> nextLevel;
+
+        // Link in sheet order, so that the hierarchy doesn't depend on the thread scheduling
+        for( LOAD_JOB& job : jobs )
+        {
+            if( job.m_ioError )
             {
                 // If there is a problem loading the root sheet, there is no recovery.
-                if( aSheet == m_rootSheet )
-                    throw( ioe );
+                if( job.m_sheet == m_rootSheet )
+                    throw IO_ERROR( *job.m_ioError );
 
                 // For all subsheets, queue up the error message for the caller.
                 if( !m_error.IsEmpty() )
                     m_error += "\n";
 
-                m_error += ioe.What();
+                m_error += job.m_ioError->What();
             }
 
-            for( auto aItem : aSheet->GetScreen()->Items().OfType( SCH_SHEET_T ) )
+            if( job.m_rootModified )
+                m_rootModified = true;
+
+            wxString path = wxFileName( job.m_fileName ).GetPath();
+
+            for( auto aItem : job.m_sheet->GetScreen()->Items().OfType( SCH_SHEET_T ) )
             {
                 wxCHECK2( aItem->Type() == SCH_SHEET_T, continue );
                 auto sheet = static_cast<SCH_SHEET*>( aItem );
 
-                // Set the parent to aSheet.  This effectively creates a method to find
+                // Set the parent to the sheet.  This effectively creates a method to find
                 // the root sheet from any sheet so a pointer to the root sheet does not
                 // need to be stored globally.  Note: this is not the same as a hierarchy.
                 // Complex hierarchies can have multiple copies of a sheet.  This only
                 // provides a simple tree to find the root sheet.
-                sheet->SetParent( aSheet );
+                sheet->SetParent( job.m_sheet );
 
-                // Recursion starts here.
-                loadHierarchy( sheet );
+                nextLevel.emplace_back( sheet, path );
             }
         }
 
-        m_currentPath.pop();
-        wxLogTrace( traceSchLegacyPlugin, "Restoring path \"%s\"", m_currentPath.top() );
+        level = std::move( nextLevel );
     }
 }
 
@@ -1548,8 +1652,7 @@ SCH_COMPONENT* SCH_LEGACY_PLUGIN::loadComponent( LINE_READER& aReader )
                 unit = 1;
 
                 // Set the file as modified so the user can be warned.
-                if( m_rootSheet->GetScreen() )
-                    m_rootSheet->GetScreen()->SetModify();
+                m_rootModified = true;
             }
 
             component->SetUnit( unit );
@@ -1562,8 +1665,7 @@ SCH_COMPONENT* SCH_LEGACY_PLUGIN::loadComponent( LINE_READER& aReader )
                 convert = 1;
 
                 // Set the file as modified so the user can be warned.
-                if( m_rootSheet->GetScreen() )
-                    m_rootSheet->GetScreen()->SetModify();
+                m_rootModified = true;
             }
 
             component->SetConvert( convert );
@@ -2538,6 +2640,9 @@ LIB_PART* SCH_LEGACY_PLUGIN_CACHE::removeSymbol( LIB_PART* aPart )
 
 void SCH_LEGACY_PLUGIN_CACHE::AddSymbol( const LIB_PART* aPart )
 {
+    // The library file is about to be rewritten, so the deferred drawings must be read now.
+    loadDeferredParts();
+
     // aPart is cloned in PART_LIB::AddPart().  The cache takes ownership of aPart.
     wxString name = aPart->GetName();
     LIB_PART_MAP::iterator it = m_symbols.find( name );
@@ -2568,6 +2673,30 @@ void SCH_LEGACY_PLUGIN_CACHE::Load()
     wxLogTrace( traceSchLegacyPlugin, "Loading legacy symbol file \"%s\"",
                 m_libFileName.GetFullPath() );
 
+    // Only the symbol definitions are read here.  The drawing of each symbol (the expensive
+    // part, mostly pins) is loaded on first use by loadDeferredPart().
+    m_deferredFileName = m_libFileName.GetFullPath();
+
+    if( !loadIndex() )
+    {
+        loadDefinitions();
+        saveIndex();
+    }
+
+    ++m_modHash;
+
+    // Remember the file modification time of library file when the
+    // cache snapshot was made, so that in a networked environment we will
+    // reload the cache as needed.
+    m_fileModTime = GetLibModificationTime();
+
+    if( USE_OLD_DOC_FILE_FORMAT( m_versionMajor, m_versionMinor ) )
+        loadDocs();
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::loadDefinitions()
+{
     FILE_LINE_READER reader( m_libFileName.GetFullPath() );
 
     if( !reader.ReadLine() )
@@ -2609,7 +2738,7 @@ void SCH_LEGACY_PLUGIN_CACHE::Load()
         m_libType = LIBRARY_TYPE_EESCHEMA;
     }
 
-    while( reader.ReadLine() )
+    for( long pos = reader.CurPos(); reader.ReadLine(); pos = reader.CurPos() )
     {
         line = reader.Line();
 
@@ -2622,22 +2751,345 @@ void SCH_LEGACY_PLUGIN_CACHE::Load()
 
         if( strCompare( "DEF", line ) )
         {
-            // Read one DEF/ENDDEF part entry from library:
-            LIB_PART* part = LoadPart( reader, m_versionMajor, m_versionMinor, &m_symbols );
+            DEFERRED_PART deferred = { pos, reader.LineNumber() - 1 };
+
+            // Read one DEF/ENDDEF part entry from library, without its drawing:
+            LIB_PART* part = LoadPart( reader, m_versionMajor, m_versionMinor, &m_symbols, true );
 
             m_symbols[ part->GetName() ] = part;
+            m_deferredParts[ part ] = deferred;
         }
     }
+}
 
-    ++m_modHash;
 
-    // Remember the file modification time of library file when the
-    // cache snapshot was made, so that in a networked environment we will
-    // reload the cache as needed.
-    m_fileModTime = GetLibModificationTime();
+wxFileName SCH_LEGACY_PLUGIN_CACHE::getIndexFileName() const
+{
+    // Index files are named after a hash of the library path.  The full path is stored in
+    // the index itself, so a hash collision only costs a rebuild of the index.
+    std::string path( TO_UTF8( GetRealFile().GetFullPath() ) );
+    wxFileName  fn;
 
-    if( USE_OLD_DOC_FILE_FORMAT( m_versionMajor, m_versionMinor ) )
-        loadDocs();
+    fn.AssignDir( SETTINGS_MANAGER::GetUserSettingsPath() );
+    fn.AppendDir( "symbol_index" );
+    fn.SetName( wxString::Format( "%016llx",
+                                  (unsigned long long) std::hash<std::string>()( path ) ) );
+    fn.SetExt( "idx" );
+
+    return fn;
+}
+
+
+wxString SCH_LEGACY_PLUGIN_CACHE::getIndexSource() const
+{
+    // Any change of the library file size or modification time invalidates its index.
+    wxFileName fn = GetRealFile();
+
+    return wxString::Format( "SOURCE %s %s %s",
+                             fn.GetSize().ToString(),
+                             fn.GetModificationTime().GetValue().ToString(),
+                             fn.GetFullPath() );
+}
+
+
+bool SCH_LEGACY_PLUGIN_CACHE::loadIndex()
+{
+    wxFileName indexFn = getIndexFileName();
+
+    if( !indexFn.FileExists() )
+        return false;
+
+    try
+    {
+        FILE_LINE_READER reader( indexFn.GetFullPath() );
+        const char*      line = reader.ReadLine();
+
+        if( !line || !strCompare( INDEXFILE_IDENT, line, &line )
+          || parseInt( reader, line, &line ) != INDEXFILE_VERSION )
+            return false;
+
+        if( !reader.ReadLine() || FROM_UTF8( reader.Line() ).Trim() != getIndexSource() )
+            return false;
+
+        if( !reader.ReadLine() )
+            return false;
+
+        line = reader.Line();
+
+        if( !strCompare( "VERSION", line, &line ) )
+            return false;
+
+        m_versionMajor = parseInt( reader, line, &line );
+        m_versionMinor = parseInt( reader, line, &line );
+        m_libType = parseInt( reader, line, &line );
+
+        DEFERRED_PART deferred = { -1, 0 };
+
+        while( reader.ReadLine() )
+        {
+            line = reader.Line();
+
+            if( strCompare( "OFFSET", line, &line ) )
+            {
+                deferred.m_offset = parseInt( reader, line, &line );
+                deferred.m_lineNumber = parseInt( reader, line, &line );
+            }
+            else if( strCompare( "DEF", line ) )
+            {
+                if( deferred.m_offset < 0 )
+                    SCH_PARSE_ERROR( "OFFSET expected", reader, line );
+
+                // The index is written by SaveSymbol(), so in the current file format.
+                LIB_PART* part = LoadPart( reader, LIB_VERSION_MAJOR, LIB_VERSION_MINOR,
+                                           &m_symbols, true );
+
+                m_symbols[ part->GetName() ] = part;
+                m_deferredParts[ part ] = deferred;
+                deferred.m_offset = -1;
+            }
+        }
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        wxLogTrace( traceSchLegacyPlugin, "Ignoring symbol library index \"%s\": %s",
+                    indexFn.GetFullPath(), ioe.What() );
+
+        for( LIB_PART_MAP::iterator it = m_symbols.begin();  it != m_symbols.end();  ++it )
+            delete it->second;
+
+        m_symbols.clear();
+        m_deferredParts.clear();
+        return false;
+    }
+
+    wxLogTrace( traceSchLegacyPlugin, "Loaded %zu symbols from index \"%s\"",
+                m_symbols.size(), indexFn.GetFullPath() );
+
+    return true;
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::saveIndex()
+{
+    wxFileName indexFn = getIndexFileName();
+    wxString   tmpFileName = indexFn.GetFullPath() + ".tmp";
+
+    if( !indexFn.DirExists() && !indexFn.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+        return;
+
+    // The index is only a cache: failing to write it is not an error.
+    try
+    {
+        FILE_OUTPUTFORMATTER formatter( tmpFileName );
+
+        formatter.Print( 0, "%s %d\n", INDEXFILE_IDENT, INDEXFILE_VERSION );
+        formatter.Print( 0, "%s\n", TO_UTF8( getIndexSource() ) );
+        formatter.Print( 0, "VERSION %d %d %d\n", m_versionMajor, m_versionMinor, m_libType );
+
+        for( LIB_PART_MAP::iterator it = m_symbols.begin();  it != m_symbols.end();  it++ )
+        {
+            auto deferred = m_deferredParts.find( it->second );
+
+            if( !it->second->IsRoot() || deferred == m_deferredParts.end() )
+                continue;
+
+            formatter.Print( 0, "OFFSET %ld %u\n", deferred->second.m_offset,
+                             deferred->second.m_lineNumber );
+
+            SaveSymbol( it->second, formatter, &m_symbols );
+        }
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        wxLogTrace( traceSchLegacyPlugin, "Cannot write symbol library index \"%s\": %s",
+                    indexFn.GetFullPath(), ioe.What() );
+        wxRemoveFile( tmpFileName );
+        return;
+    }
+
+    // Renaming a complete file prevents another instance from reading a partial index.
+    if( !wxRenameFile( tmpFileName, indexFn.GetFullPath(), true ) )
+        wxRemoveFile( tmpFileName );
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::loadDeferredPart( LIB_PART* aPart )
+{
+    // The drawing of derived symbols is the drawing of their root symbol.
+    if( aPart->IsAlias() )
+        aPart = aPart->GetParent().lock().get();
+
+    auto it = m_deferredParts.find( aPart );
+
+    if( it == m_deferredParts.end() )
+        return;
+
+    FILE_LINE_READER reader( m_deferredFileName );
+
+    loadDrawing( aPart, it->second, reader );
+    m_deferredParts.erase( aPart );
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::loadDeferredParts()
+{
+    if( m_deferredParts.empty() )
+        return;
+
+    FILE_LINE_READER reader( m_deferredFileName );
+
+    while( !m_deferredParts.empty() )
+    {
+        // loadDrawing() may rebuild the index, which updates m_deferredParts.
+        LIB_PART* part = m_deferredParts.begin()->first;
+
+        loadDrawing( part, m_deferredParts.begin()->second, reader );
+        m_deferredParts.erase( part );
+    }
+}
+
+
+/**
+ * Returns the symbol name of a DEF line as LoadPart() reads it.
+ */
+static wxString parseDefName( const char* aLine )
+{
+    if( !strCompare( "DEF", aLine, &aLine ) )
+        return wxEmptyString;
+
+    wxStringTokenizer tokens( wxString::FromUTF8( aLine ), " \r\n\t" );
+    wxString          name = tokens.GetNextToken();
+
+    // A leading '~' only hides the value field.
+    if( name.IsEmpty() )
+        return wxT( "~" );
+    else if( name[0] == '~' )
+        return name.Right( name.Length() - 1 );
+
+    return name;
+}
+
+
+/**
+ * Rewrites the index from the library file and updates the file positions of the symbols
+ * whose drawing is not loaded yet.
+ *
+ * @return the file positions of the library symbols, by name.
+ */
+std::map<wxString, SCH_LEGACY_PLUGIN_CACHE::DEFERRED_PART>
+SCH_LEGACY_PLUGIN_CACHE::rebuildIndex()
+{
+    wxLogTrace( traceSchLegacyPlugin, "Rebuilding the stale symbol index of \"%s\"",
+                m_libFileName.GetFullPath() );
+
+    // The symbols already loaded may be in use: the definitions are read again in scratch
+    // maps to write the index, and only their file positions are kept.
+    LIB_PART_MAP                       symbols;
+    std::map<LIB_PART*, DEFERRED_PART> deferredParts;
+
+    std::swap( symbols, m_symbols );
+    std::swap( deferredParts, m_deferredParts );
+
+    std::map<wxString, DEFERRED_PART> positions;
+
+    try
+    {
+        loadDefinitions();
+        saveIndex();
+
+        for( const auto& it : m_deferredParts )
+            positions[ it.first->GetName() ] = it.second;
+    }
+    catch( ... )
+    {
+        for( LIB_PART_MAP::iterator it = m_symbols.begin();  it != m_symbols.end();  ++it )
+            delete it->second;
+
+        m_symbols = std::move( symbols );
+        m_deferredParts = std::move( deferredParts );
+        throw;
+    }
+
+    for( LIB_PART_MAP::iterator it = m_symbols.begin();  it != m_symbols.end();  ++it )
+        delete it->second;
+
+    m_symbols = std::move( symbols );
+    m_deferredParts = std::move( deferredParts );
+
+    // The symbols not in the library file anymore keep their definition, without drawing.
+    for( auto it = m_deferredParts.begin(); it != m_deferredParts.end(); )
+    {
+        auto position = positions.find( it->first->GetName() );
+
+        if( position == positions.end() )
+        {
+            it = m_deferredParts.erase( it );
+        }
+        else
+        {
+            it->second = position->second;
+            ++it;
+        }
+    }
+
+    return positions;
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::loadDrawing( LIB_PART* aPart, DEFERRED_PART aDeferred,
+                                           FILE_LINE_READER& aReader )
+{
+    aReader.Seek( aDeferred.m_offset, aDeferred.m_lineNumber );
+
+    const char* line = aReader.ReadLine();
+
+    // The library file was changed without its size or modification time changing: the
+    // index gives the position of another symbol.
+    if( !line || parseDefName( line ) != aPart->GetName() )
+    {
+        std::map<wxString, DEFERRED_PART> positions = rebuildIndex();
+        auto                              position = positions.find( aPart->GetName() );
+
+        if( position != positions.end() )
+        {
+            aDeferred = position->second;
+            aReader.Seek( aDeferred.m_offset, aDeferred.m_lineNumber );
+            line = aReader.ReadLine();
+        }
+    }
+
+    if( !line || parseDefName( line ) != aPart->GetName() )
+        THROW_IO_ERROR( wxString::Format( _( "Symbol \"%s\" not found at line %u of "
+                                             "library file \"%s\"" ),
+                                          aPart->GetName(), aDeferred.m_lineNumber + 1,
+                                          m_deferredFileName ) );
+
+    // The fields of aPart are already loaded.  Only the items of the DRAW section are
+    // read here, in a scratch part, and moved to aPart.
+    std::unique_ptr<LIB_PART> drawing( new LIB_PART( wxEmptyString ) );
+
+    while( ( line = aReader.ReadLine() ) != nullptr )
+    {
+        if( strCompare( "DRAW", line ) )
+        {
+            loadDrawEntries( drawing, aReader, m_versionMajor, m_versionMinor );
+            break;
+        }
+        else if( strCompare( "ENDDEF", line ) )
+        {
+            break;
+        }
+    }
+
+    for( LIB_ITEM& item : drawing->GetDrawItems() )
+    {
+        if( item.Type() == LIB_FIELD_T )
+            continue;
+
+        LIB_ITEM* newItem = (LIB_ITEM*) item.Clone();
+        newItem->SetParent( aPart );
+        aPart->AddDrawItem( newItem );
+    }
 }
 
 
@@ -2768,7 +3220,8 @@ void SCH_LEGACY_PLUGIN_CACHE::loadHeader( FILE_LINE_READER& aReader )
 
 
 LIB_PART* SCH_LEGACY_PLUGIN_CACHE::LoadPart( LINE_READER& aReader, int aMajorVersion,
-                                             int aMinorVersion, LIB_PART_MAP* aMap )
+                                             int aMinorVersion, LIB_PART_MAP* aMap,
+                                             bool aSkipDrawEntries )
 {
     const char* line = aReader.Line();
 
@@ -2925,7 +3378,12 @@ LIB_PART* SCH_LEGACY_PLUGIN_CACHE::LoadPart( LINE_READER& aReader, int aMajorVer
         else if( *line == 'F' )                             // Fields
             loadField( part, aReader );
         else if( strCompare( "DRAW", line, &line ) )        // Drawing objects.
-            loadDrawEntries( part, aReader, aMajorVersion, aMinorVersion );
+        {
+            if( aSkipDrawEntries )
+                skipDrawEntries( aReader );
+            else
+                loadDrawEntries( part, aReader, aMajorVersion, aMinorVersion );
+        }
         else if( strCompare( "$FPLIST", line, &line ) )     // Footprint filter list
             loadFootprintFilters( part, aReader );
         else if( strCompare( "ENDDEF", line, &line ) )      // End of part description
@@ -3118,6 +3576,22 @@ void SCH_LEGACY_PLUGIN_CACHE::loadField( std::unique_ptr<LIB_PART>& aPart,
 }
 
 
+void SCH_LEGACY_PLUGIN_CACHE::skipDrawEntries( LINE_READER& aReader )
+{
+    const char* line = aReader.Line();
+
+    wxCHECK_RET( strCompare( "DRAW", line, &line ), "Invalid DRAW section" );
+
+    while( ( line = aReader.ReadLine() ) != nullptr )
+    {
+        if( strCompare( "ENDDRAW", line, &line ) )
+            return;
+    }
+
+    SCH_PARSE_ERROR( "file ended prematurely loading component draw element", aReader, line );
+}
+
+
 void SCH_LEGACY_PLUGIN_CACHE::loadDrawEntries( std::unique_ptr<LIB_PART>& aPart,
                                                LINE_READER&               aReader,
                                                int                        aMajorVersion,
@@ -3740,6 +4214,8 @@ void SCH_LEGACY_PLUGIN_CACHE::Save( bool aSaveDocFile )
     if( !m_isModified )
         return;
 
+    loadDeferredParts();
+
     // Write through symlinks, don't replace them
     wxFileName fn = GetRealFile();
 
@@ -3761,6 +4237,13 @@ void SCH_LEGACY_PLUGIN_CACHE::Save( bool aSaveDocFile )
     m_fileModTime = fn.GetModificationTime();
     m_isModified = false;
 
+    // Don't rely on the file modification time to invalidate the index of the library,
+    // it may not change if the library is saved twice within its resolution.
+    wxFileName indexFn = getIndexFileName();
+
+    if( indexFn.FileExists() )
+        wxRemoveFile( indexFn.GetFullPath() );
+
     if( aSaveDocFile )
         saveDocFile();
 }
@@ -4269,6 +4752,8 @@ void SCH_LEGACY_PLUGIN_CACHE::saveDocFile()
 
 void SCH_LEGACY_PLUGIN_CACHE::DeleteSymbol( const wxString& aSymbolName )
 {
+    loadDeferredParts();
+
     LIB_PART_MAP::iterator it = m_symbols.find( aSymbolName );
 
     if( it == m_symbols.end() )
@@ -4391,8 +4876,14 @@ void SCH_LEGACY_PLUGIN::EnumerateSymbolLib( std::vector<LIB_PART*>& aSymbolList,
 
     bool powerSymbolsOnly = ( aProperties &&
                               aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
+    bool indexOnly = ( aProperties &&
+                       aProperties->find( SYMBOL_LIB_TABLE::PropIndexOnly ) != aProperties->end() );
     cacheLib( aLibraryPath );
 
+    // Symbols listed for the index only do not need their drawing.
+    if( !indexOnly )
+        m_cache->loadDeferredParts();
+
     const LIB_PART_MAP& symbols = m_cache->m_symbols;
 
     for( LIB_PART_MAP::const_iterator it = symbols.begin();  it != symbols.end();  ++it )
@@ -4417,6 +4908,8 @@ LIB_PART* SCH_LEGACY_PLUGIN::LoadSymbol( const wxString& aLibraryPath, const wxS
     if( it == m_cache->m_symbols.end() )
         return nullptr;
 
+    m_cache->loadDeferredPart( it->second );
+
     return it->second;
 }
 
@@ -511,7 +511,7 @@ void SCH_LINE::GetEndPoints( std::vector <DANGLING_END_ITEM>& aItemList )
 }
 
 
-bool SCH_LINE::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList,
+bool SCH_LINE::UpdateDanglingState( const DANGLING_END_ITEM_INDEX& aItemList,
                                     const SCH_SHEET_PATH* aPath )
 {
     bool previousStartState = m_startIsDangling;
@@ -521,25 +521,31 @@ bool SCH_LINE::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList,
 
     if( GetLayer() == LAYER_WIRE )
     {
-        for( DANGLING_END_ITEM item : aItemList )
-        {
-            if( item.GetItem() == this )
-                continue;
-
-            if(     item.GetType() == BUS_START_END ||
-                    item.GetType() == BUS_END_END  ||
-                    item.GetType() == BUS_ENTRY_END )
-                continue;
-
-            if( m_start == item.GetPosition() )
-                m_startIsDangling = false;
-
-            if( m_end == item.GetPosition() )
-                m_endIsDangling = false;
-
-            if( !m_startIsDangling && !m_endIsDangling )
-                break;
-        }
+        auto isConnected =
+                [&]( const wxPoint& aPos ) -> bool
+                {
+                    bool connected = false;
+
+                    aItemList.ForEachAt( aPos,
+                            [&]( size_t, const DANGLING_END_ITEM& item ) -> bool
+                            {
+                                if( item.GetItem() == this
+                                        || item.GetType() == BUS_START_END
+                                        || item.GetType() == BUS_END_END
+                                        || item.GetType() == BUS_ENTRY_END )
+                                {
+                                    return true;
+                                }
+
+                                connected = true;
+                                return false;
+                            } );
+
+                    return connected;
+                };
+
+        m_startIsDangling = !isConnected( m_start );
+        m_endIsDangling = !isConnected( m_end );
     }
     else if( GetLayer() == LAYER_BUS || IsGraphicLine() )
     {
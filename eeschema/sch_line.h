@@ -183,7 +183,7 @@ public:
 
     void GetEndPoints( std::vector<DANGLING_END_ITEM>& aItemList ) override;
 
-    bool UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList,
+    bool UpdateDanglingState( const DANGLING_END_ITEM_INDEX& aItemList,
                               const SCH_SHEET_PATH* aPath = nullptr ) override;
 
     bool IsStartDangling() const { return m_startIsDangling; }
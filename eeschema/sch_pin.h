@@ -66,6 +66,12 @@ public:
 
     wxString GetDefaultNetName( const SCH_SHEET_PATH aPath );
 
+    /**
+     * Forgets the default net names cached for \a aPath, or for all the sheet paths when
+     * \a aPath is null.  They are made of the reference of the parent component.
+     */
+    void ClearDefaultNetName( const SCH_SHEET_PATH* aPath );
+
     wxString GetSelectMenuText( EDA_UNITS aUnits ) const override;
     void GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame, MSG_PANEL_ITEMS& aList ) override;
 
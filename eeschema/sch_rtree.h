@@ -25,10 +25,12 @@
 #ifndef EESCHEMA_SCH_RTREE_H_
 #define EESCHEMA_SCH_RTREE_H_
 
+#include <algorithm>
 #include <core/typeinfo.h>
 #include <eda_rect.h>
 #include <sch_item.h>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include <geometry/rtree.h>
@@ -273,4 +275,150 @@ private:
 };
 
 
+/**
+ * EE_PIN_RTREE -
+ * Implements an R-tree of the connection pins of schematic items (component pins and sheet
+ * pins).  Every pin is stored as its own entry, but the entries refer to the item owning the
+ * pin: pins are rebuilt by their owner (e.g. when a component is relinked to its symbol) so
+ * they cannot be stored safely.  The rectangles inserted for an owner are kept so that it can
+ * be removed even after it was moved or its pins were rebuilt.
+ * Non-owning.
+ */
+class EE_PIN_RTREE
+{
+private:
+    using pin_rtree = RTree<SCH_ITEM*, int, 3, double>;
+
+public:
+    EE_PIN_RTREE()
+    {
+        this->m_tree = new pin_rtree();
+    }
+
+    ~EE_PIN_RTREE()
+    {
+        delete this->m_tree;
+    }
+
+    /**
+     * Function Insert()
+     * Inserts the pins of an item into the tree.  An item already in the tree is replaced.
+     * @param aOwner is the item owning the pins
+     * @param aPinRects is the bounding box of each pin of aOwner
+     */
+    void insert( SCH_ITEM* aOwner, const std::vector<EDA_RECT>& aPinRects )
+    {
+        remove( aOwner );
+
+        if( aPinRects.empty() )
+            return;
+
+        const int type = int( aOwner->Type() );
+
+        for( const EDA_RECT& rect : aPinRects )
+        {
+            const int mmin[3] = { type, rect.GetX(), rect.GetY() };
+            const int mmax[3] = { type, rect.GetRight(), rect.GetBottom() };
+
+            m_tree->Insert( mmin, mmax, aOwner );
+        }
+
+        m_entries[ aOwner ] = aPinRects;
+    }
+
+    /**
+     * Function Remove()
+     * Removes all the pins of an item from the tree.  The item itself is not dereferenced.
+     * @return true if the item had pins in the tree
+     */
+    bool remove( SCH_ITEM* aOwner )
+    {
+        auto it = m_entries.find( aOwner );
+
+        if( it == m_entries.end() )
+            return false;
+
+        for( const EDA_RECT& rect : it->second )
+        {
+            // The type of an item never changes, but it cannot be read from a deleted item
+            const int mmin[3] = { INT_MIN, rect.GetX(), rect.GetY() };
+            const int mmax[3] = { INT_MAX, rect.GetRight(), rect.GetBottom() };
+
+            m_tree->Remove( mmin, mmax, aOwner );
+        }
+
+        m_entries.erase( it );
+        return true;
+    }
+
+    /**
+     * Function RemoveAll()
+     * Removes all items from the tree
+     */
+    void clear()
+    {
+        m_tree->RemoveAll();
+        m_entries.clear();
+    }
+
+    /**
+     * Determine if an item has pins in the tree.
+     */
+    bool contains( SCH_ITEM* aOwner ) const
+    {
+        return m_entries.count( aOwner ) > 0;
+    }
+
+    /**
+     * Returns the number of items (not pins) in the tree
+     */
+    size_t size() const
+    {
+        return m_entries.size();
+    }
+
+    bool empty() const
+    {
+        return m_entries.empty();
+    }
+
+    /**
+     * Returns the items of type aType (or of any type for SCH_LOCATE_ANY_T) having at least
+     * one pin within aAccuracy of aPoint.  Each item is returned once, even if several of its
+     * pins are close to aPoint.
+     */
+    std::vector<SCH_ITEM*> Owners( KICAD_T aType, const wxPoint& aPoint, int aAccuracy = 0 ) const
+    {
+        KICAD_T type = BaseType( aType );
+        int     mmin[3] = { type, aPoint.x - aAccuracy, aPoint.y - aAccuracy };
+        int     mmax[3] = { type, aPoint.x + aAccuracy, aPoint.y + aAccuracy };
+
+        if( type == SCH_LOCATE_ANY_T )
+        {
+            mmin[0] = INT_MIN;
+            mmax[0] = INT_MAX;
+        }
+
+        std::vector<SCH_ITEM*> owners;
+
+        auto visitor = [&owners]( SCH_ITEM* aOwner ) {
+            if( std::find( owners.begin(), owners.end(), aOwner ) == owners.end() )
+                owners.push_back( aOwner );
+
+            return true;
+        };
+
+        m_tree->Search( mmin, mmax, visitor );
+
+        return owners;
+    }
+
+private:
+    pin_rtree* m_tree;
+
+    ///> The pin rectangles inserted for each item
+    std::unordered_map<SCH_ITEM*, std::vector<EDA_RECT>> m_entries;
+};
+
+
 #endif /* EESCHEMA_SCH_RTREE_H_ */
@@ -170,11 +170,46 @@ void SCH_SCREEN::Append( SCH_ITEM* aItem )
     if( aItem->Type() != SCH_SHEET_PIN_T && aItem->Type() != SCH_FIELD_T )
     {
         m_rtree.insert( aItem );
+        updatePinIndex( aItem );
         --m_modification_sync;
     }
 }
 
 
+void SCH_SCREEN::updatePinIndex( SCH_ITEM* aItem )
+{
+    std::vector<EDA_RECT> pinRects;
+
+    // Pins are indexed by their bounding box, extended to their connection point
+    if( aItem->Type() == SCH_COMPONENT_T )
+    {
+        SCH_COMPONENT* component = static_cast<SCH_COMPONENT*>( aItem );
+
+        for( const std::unique_ptr<SCH_PIN>& pin : component->GetRawPins() )
+        {
+            EDA_RECT rect = pin->GetBoundingBox();
+            rect.Merge( pin->GetTransformedPosition() );
+            pinRects.push_back( rect );
+        }
+    }
+    else if( aItem->Type() == SCH_SHEET_T )
+    {
+        for( SCH_SHEET_PIN* pin : static_cast<SCH_SHEET*>( aItem )->GetPins() )
+        {
+            EDA_RECT rect = pin->GetBoundingBox();
+            rect.Merge( pin->GetPosition() );
+            pinRects.push_back( rect );
+        }
+    }
+    else
+    {
+        return;
+    }
+
+    m_pinIndex.insert( aItem, pinRects );
+}
+
+
 void SCH_SCREEN::Append( SCH_SCREEN* aScreen )
 {
     wxCHECK_RET( aScreen, "Invalid screen object." );
@@ -191,9 +226,14 @@ void SCH_SCREEN::Append( SCH_SCREEN* aScreen )
 void SCH_SCREEN::Clear( bool aFree )
 {
     if( aFree )
+    {
         FreeDrawList();
+    }
     else
+    {
         m_rtree.clear();
+        m_pinIndex.clear();
+    }
 
     // Clear the project settings
     m_ScreenNumber = m_NumberOfScreens = 1;
@@ -215,6 +255,7 @@ void SCH_SCREEN::FreeDrawList()
             } );
 
     m_rtree.clear();
+    m_pinIndex.clear();
 
     for( auto item : delete_list )
         delete item;
@@ -230,6 +271,7 @@ void SCH_SCREEN::Update( SCH_ITEM* aItem )
 
 bool SCH_SCREEN::Remove( SCH_ITEM* aItem )
 {
+    m_pinIndex.remove( aItem );
     return m_rtree.remove( aItem );
 }
 
@@ -350,9 +392,14 @@ bool SCH_SCREEN::IsJunctionNeeded( const wxPoint& aPosition, bool aNew )
             else if( item->GetLayer() == LAYER_BUS )
                 lines[BUSES].push_back( (SCH_LINE*) item );
         }
+    }
+
+    for( SCH_ITEM* item : m_pinIndex.Owners( SCH_LOCATE_ANY_T, aPosition ) )
+    {
+        if( item->GetEditFlags() & STRUCT_DELETED )
+            continue;
 
-        if( ( ( item->Type() == SCH_COMPONENT_T ) || ( item->Type() == SCH_SHEET_T ) )
-                && ( item->IsConnected( aPosition ) ) )
+        if( item->IsConnected( aPosition ) )
             pin_count++;
     }
 
@@ -649,7 +696,8 @@ LIB_PIN* SCH_SCREEN::GetPin( const wxPoint& aPosition, SCH_COMPONENT** aComponen
     SCH_COMPONENT*  component = NULL;
     LIB_PIN*        pin = NULL;
 
-    for( SCH_ITEM* item : Items().Overlapping( SCH_COMPONENT_T, aPosition ) )
+    // Only the components having a pin at aPosition are tested
+    for( SCH_ITEM* item : m_pinIndex.Owners( SCH_COMPONENT_T, aPosition ) )
     {
         component = static_cast<SCH_COMPONENT*>( item );
 
@@ -698,7 +746,7 @@ SCH_SHEET_PIN* SCH_SCREEN::GetSheetLabel( const wxPoint& aPosition )
 {
     SCH_SHEET_PIN* sheetPin = nullptr;
 
-    for( SCH_ITEM* item : Items().OfType( SCH_SHEET_T ) )
+    for( SCH_ITEM* item : m_pinIndex.Owners( SCH_SHEET_T, aPosition ) )
     {
         auto sheet = static_cast<SCH_SHEET*>( item );
 
@@ -716,7 +764,7 @@ size_t SCH_SCREEN::CountConnectedItems( const wxPoint& aPos, bool aTestJunctions
 {
     size_t count = 0;
 
-    for( SCH_ITEM* item : Items() )
+    for( SCH_ITEM* item : Items().Overlapping( aPos ) )
     {
         if( ( item->Type() != SCH_JUNCTION_T || aTestJunctions ) && item->IsConnected( aPos ) )
             count++;
@@ -777,9 +825,11 @@ bool SCH_SCREEN::TestDanglingEnds( const SCH_SHEET_PATH* aPath )
     for( SCH_ITEM* item : Items() )
         item->GetEndPoints( endPoints );
 
+    DANGLING_END_ITEM_INDEX index( std::move( endPoints ) );
+
     for( SCH_ITEM* item : Items() )
     {
-        if( item->UpdateDanglingState( endPoints, aPath ) )
+        if( item->UpdateDanglingState( index, aPath ) )
             hasStateChanged = true;
     }
 
@@ -793,11 +843,8 @@ SCH_LINE* SCH_SCREEN::GetLine( const wxPoint& aPosition, int aAccuracy, int aLay
     // an accuracy of 0 had problems with rounding errors; use at least 1
     aAccuracy = std::max( aAccuracy, 1 );
 
-    for( SCH_ITEM* item : Items() )
+    for( SCH_ITEM* item : Items().Overlapping( SCH_LINE_T, aPosition, aAccuracy ) )
     {
-        if( item->Type() != SCH_LINE_T )
-            continue;
-
         if( item->GetLayer() != aLayer )
             continue;
 
@@ -109,12 +109,20 @@ private:
 
     EE_RTREE m_rtree;
 
+    /// The pins of the components and sheets in m_rtree, for the connection point queries
+    EE_PIN_RTREE m_pinIndex;
+
     int m_modification_sync; ///< inequality with PART_LIBS::GetModificationHash()
                              ///< will trigger ResolveAll().
 
     /// List of bus aliases stored in this screen
     std::unordered_set< std::shared_ptr< BUS_ALIAS > > m_aliases;
 
+    /**
+     * (Re)inserts the pins of a component or a sheet into m_pinIndex.
+     */
+    void updatePinIndex( SCH_ITEM* aItem );
+
 public:
 
     /**
@@ -139,6 +147,14 @@ public:
         return m_rtree.empty();
     }
 
+    /**
+     * @return the index of the component pins and sheet pins of the screen.
+     */
+    const EE_PIN_RTREE& Pins() const
+    {
+        return m_pinIndex;
+    }
+
     static inline bool ClassOf( const EDA_ITEM* aItem )
     {
         return aItem && SCH_SCREEN_T == aItem->Type();
@@ -20,8 +20,11 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <boost/algorithm/string/join.hpp>
 #include <cctype>
+#include <future>
+#include <thread>
 
 // For some reason wxWidgets is built with wxUSE_BASE64 unset so expose the wxWidgets
 // base64 code.
@@ -484,79 +487,138 @@ SCH_SHEET* SCH_SEXPR_PLUGIN::Load( const wxString& aFileName, KIWAY* aKiway,
 }
 
 
-// Everything below this comment is recursive.  Modify with care.
-
 void SCH_SEXPR_PLUGIN::loadHierarchy( SCH_SHEET* aSheet )
 {
-    SCH_SCREEN* screen = NULL;
-
-    if( !aSheet->GetScreen() )
+    // A file to load, for the first sheet using it.
+    struct LOAD_JOB
     {
-        // SCH_SCREEN objects store the full path and file name where the SCH_SHEET object only
-        // stores the file name and extension.  Add the project path to the file name and
-        // extension to compare when calling SCH_SHEET::SearchHierarchy().
-        wxFileName fileName = aSheet->GetFileName();
+        SCH_SHEET*                m_sheet;
+        wxString                  m_fileName;
+        std::unique_ptr<IO_ERROR> m_ioError;
+    };
 
-        if( !fileName.IsAbsolute() )
-            fileName.MakeAbsolute( m_currentPath.top() );
+    // The hierarchy is loaded breadth-first.  The screens of each level are created and
+    // shared on the main thread, their files are parsed concurrently, and the sub-sheets
+    // found in them are linked on the main thread to make the next level.  Each sheet comes
+    // with the path its file name is relative to: the path of its parent sheet file.
+    std::vector<std::pair<SCH_SHEET*, wxString>> level;
 
-        // Save the current path so that it gets restored when decending and ascending the
-        // sheet hierarchy which allows for sheet schematic files to be nested in folders
-        // relative to the last path a schematic was loaded from.
-        wxLogTrace( traceSchLegacyPlugin, "Saving path    \"%s\"", m_currentPath.top() );
-        m_currentPath.push( fileName.GetPath() );
-        wxLogTrace( traceSchLegacyPlugin, "Current path   \"%s\"", m_currentPath.top() );
-        wxLogTrace( traceSchLegacyPlugin, "Loading        \"%s\"", fileName.GetFullPath() );
+    level.emplace_back( aSheet, m_currentPath.top() );
 
-        m_rootSheet->SearchHierarchy( fileName.GetFullPath(), &screen );
+    while( !level.empty() )
+    {
+        std::vector<LOAD_JOB> jobs;
 
-        if( screen )
+        for( const std::pair<SCH_SHEET*, wxString>& entry : level )
         {
-            aSheet->SetScreen( screen );
+            SCH_SHEET*  sheet = entry.first;
+            SCH_SCREEN* screen = NULL;
+
+            if( sheet->GetScreen() )
+                continue;
+
+            // SCH_SCREEN objects store the full path and file name where the SCH_SHEET object
+            // only stores the file name and extension.  Add the project path to the file name
+            // and extension to compare when calling SCH_SHEET::SearchHierarchy().
+            wxFileName fileName = sheet->GetFileName();
+
+            if( !fileName.IsAbsolute() )
+                fileName.MakeAbsolute( entry.second );
+
+            wxLogTrace( traceSchLegacyPlugin, "Loading        \"%s\"", fileName.GetFullPath() );
+
+            // This also finds the screens created for the previous sheets of this level.
+            m_rootSheet->SearchHierarchy( fileName.GetFullPath(), &screen );
+
+            if( screen )
+            {
+                sheet->SetScreen( screen );
+
+                // Do not need to load the sub-sheets - this has already been done.
+                continue;
+            }
 
-            // Do not need to load the sub-sheets - this has already been done.
+            sheet->SetScreen( new SCH_SCREEN( m_kiway ) );
+            sheet->GetScreen()->SetFileName( fileName.GetFullPath() );
+
+            jobs.push_back( { sheet, fileName.GetFullPath(), nullptr } );
         }
-        else
-        {
-            aSheet->SetScreen( new SCH_SCREEN( m_kiway ) );
-            aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
 
-            try
+        size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                       jobs.size() );
+
+        std::atomic<size_t> nextJob( 0 );
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        auto load_lambda = [&]() -> size_t
+        {
+            for( size_t ii = nextJob++; ii < jobs.size(); ii = nextJob++ )
             {
-                loadFile( fileName.GetFullPath(), aSheet->GetScreen() );
+                LOAD_JOB& job = jobs[ii];
 
-                for( auto aItem : aSheet->GetScreen()->Items().OfType( SCH_SHEET_T ) )
+                try
                 {
-                    assert( aItem->Type() == SCH_SHEET_T );
-                    auto sheet = static_cast<SCH_SHEET*>( aItem );
-
-                    // Set the parent to aSheet.  This effectively creates a method to find
-                    // the root sheet from any sheet so a pointer to the root sheet does not
-                    // need to be stored globally.  Note: this is not the same as a hierarchy.
-                    // Complex hierarchies can have multiple copies of a sheet.  This only
-                    // provides a simple tree to find the root sheet.
-                    sheet->SetParent( aSheet );
-
-                    // Recursion starts here.
-                    loadHierarchy( sheet );
+                    loadFile( job.m_fileName, job.m_sheet->GetScreen() );
+                }
+                catch( const IO_ERROR& ioe )
+                {
+                    job.m_ioError.reset( new IO_ERROR( ioe ) );
                 }
             }
-            catch( const IO_ERROR& ioe )
+
+            return 1;
+        };
+
+        if( parallelThreadCount <= 1 )
+            load_lambda();
+        else
+        {
+            for( size_t ii = 0; ii < parallelThreadCount; ii++ )
+                returns[ii] = std::async( std::launch::async, load_lambda );
+
+            // Finalize the threads
+            for( size_t ii = 0; ii < parallelThreadCount; ii++ )
+                returns[ii].wait();
+        }
+
+        std::vector<std::pair<SCH_SHEET*, wxString>> nextLevel;
+
+        // Link in sheet order, so that the hierarchy doesn't depend on the thread scheduling
+        for( LOAD_JOB& job : jobs )
+        {
+            if( job.m_ioError )
             {
                 // If there is a problem loading the root sheet, there is no recovery.
-                if( aSheet == m_rootSheet )
-                    throw( ioe );
+                if( job.m_sheet == m_rootSheet )
+                    throw IO_ERROR( *job.m_ioError );
 
                 // For all subsheets, queue up the error message for the caller.
                 if( !m_error.IsEmpty() )
                     m_error += "\n";
 
-                m_error += ioe.What();
+                m_error += job.m_ioError->What();
+                continue;
+            }
+
+            wxString path = wxFileName( job.m_fileName ).GetPath();
+
+            for( auto aItem : job.m_sheet->GetScreen()->Items().OfType( SCH_SHEET_T ) )
+            {
+                assert( aItem->Type() == SCH_SHEET_T );
+                auto sheet = static_cast<SCH_SHEET*>( aItem );
+
+                // Set the parent to the sheet.  This effectively creates a method to find
+                // the root sheet from any sheet so a pointer to the root sheet does not
+                // need to be stored globally.  Note: this is not the same as a hierarchy.
+                // Complex hierarchies can have multiple copies of a sheet.  This only
+                // provides a simple tree to find the root sheet.
+                sheet->SetParent( job.m_sheet );
+
+                nextLevel.emplace_back( sheet, path );
             }
         }
 
-        m_currentPath.pop();
-        wxLogTrace( traceSchLegacyPlugin, "Restoring path \"%s\"", m_currentPath.top() );
+        level = std::move( nextLevel );
     }
 }
 
@@ -39,6 +39,8 @@
 #include <trace_helpers.h>
 #include <pgm_base.h>
 
+#include <mutex>
+
 
 const wxString SCH_SHEET::GetDefaultFieldName( int aFieldNdx )
 {
@@ -47,6 +49,10 @@ const wxString SCH_SHEET::GetDefaultFieldName( int aFieldNdx )
     static wxString sheetfilenameDefault;
     static wxString fieldDefault;
 
+    // Sheets are created concurrently when loading schematic sheets.
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock( mutex );
+
     // Fetching translations can take a surprising amount of time when loading libraries,
     // so only do it when necessary.
     if( Pgm().GetLocale() != locale )
@@ -832,7 +838,7 @@ void SCH_SHEET::GetEndPoints( std::vector <DANGLING_END_ITEM>& aItemList )
 }
 
 
-bool SCH_SHEET::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList,
+bool SCH_SHEET::UpdateDanglingState( const DANGLING_END_ITEM_INDEX& aItemList,
                                      const SCH_SHEET_PATH* aPath )
 {
     bool changed = false;
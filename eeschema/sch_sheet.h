@@ -35,6 +35,7 @@ class SCH_SHEET;
 class SCH_SHEET_PIN;
 class SCH_SHEET_PATH;
 class DANGLING_END_ITEM;
+class DANGLING_END_ITEM_INDEX;
 class SCH_EDIT_FRAME;
 class NETLIST_OBJECT_LIST;
 
@@ -541,7 +542,7 @@ public:
 
     void GetEndPoints( std::vector <DANGLING_END_ITEM>& aItemList ) override;
 
-    bool UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList,
+    bool UpdateDanglingState( const DANGLING_END_ITEM_INDEX& aItemList,
                               const SCH_SHEET_PATH* aPath = nullptr ) override;
 
     bool IsConnectable() const override { return true; }
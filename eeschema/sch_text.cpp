@@ -321,7 +321,7 @@ void SCH_TEXT::GetEndPoints( std::vector <DANGLING_END_ITEM>& aItemList )
 }
 
 
-bool SCH_TEXT::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList,
+bool SCH_TEXT::UpdateDanglingState( const DANGLING_END_ITEM_INDEX& aItemList,
                                     const SCH_SHEET_PATH* aPath )
 {
     // Normal text labels cannot be tested for dangling ends.
@@ -332,76 +332,79 @@ bool SCH_TEXT::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList,
     m_isDangling       = true;
     m_connectionType   = CONNECTION_TYPE::NONE;
 
-    for( unsigned ii = 0; ii < aItemList.size(); ii++ )
-    {
-        DANGLING_END_ITEM& item = aItemList[ii];
+    const std::vector<DANGLING_END_ITEM>& items = aItemList.Items();
+    const size_t none = items.size();
 
-        if( item.GetItem() == this )
-            continue;
+    // Only the first connection found in the list is recorded, so look for the first end
+    // point at the label position and for the first wire or bus the label sits on, then use
+    // whichever comes first.
+    size_t firstEnd = none;
 
-        switch( item.GetType() )
-        {
-        case PIN_END:
-        case LABEL_END:
-        case SHEET_LABEL_END:
-        case NO_CONNECT_END:
-            if( GetTextPos() == item.GetPosition() )
+    aItemList.ForEachAt( GetTextPos(),
+            [&]( size_t aIdx, const DANGLING_END_ITEM& item ) -> bool
             {
-                m_isDangling = false;
-
-                if( aPath && item.GetType() != PIN_END )
-                    m_connected_items[ *aPath ].insert( static_cast<SCH_ITEM*>( item.GetItem() ) );
-            }
-
-            break;
+                if( item.GetItem() == this )
+                    return true;
 
+                switch( item.GetType() )
+                {
+                case PIN_END:
+                case LABEL_END:
+                case SHEET_LABEL_END:
+                case NO_CONNECT_END:
+                    firstEnd = aIdx;
+                    return false;
+
+                default:
+                    return true;
+                }
+            } );
 
-        case BUS_START_END:
-            m_connectionType = CONNECTION_TYPE::BUS;
-            KI_FALLTHROUGH;
+    size_t firstSegment = none;
+    int    accuracy = 1;   // We have rounding issues with an accuracy of 0
 
-        case WIRE_START_END:
+    for( bool bus : { false, true } )
+    {
+        for( size_t ii : aItemList.SegmentsAt( GetTextPos(), bus, accuracy ) )
         {
-            // These schematic items have created 2 DANGLING_END_ITEM one per end.  But being
-            // a paranoid programmer, I'll check just in case.
-            ii++;
-
-            wxCHECK_MSG( ii < aItemList.size(), previousState != m_isDangling,
-                         wxT( "Dangling end type list overflow.  Bad programmer!" ) );
+            if( ii > std::min( firstEnd, firstSegment ) )
+                break;
 
-            int accuracy = 1;   // We have rounding issues with an accuracy of 0
-
-            DANGLING_END_ITEM & nextItem = aItemList[ii];
-            m_isDangling = !TestSegmentHit( GetTextPos(), item.GetPosition(),
-                                            nextItem.GetPosition(), accuracy );
-
-            if( !m_isDangling )
+            if( TestSegmentHit( GetTextPos(), items[ii].GetPosition(),
+                                items[ii + 1].GetPosition(), accuracy ) )
             {
-                if( m_connectionType != CONNECTION_TYPE::BUS )
-                    m_connectionType = CONNECTION_TYPE::NET;
-
-                // Add the line to the connected items, since it won't be picked
-                // up by a search of intersecting connection points
-                if( aPath )
-                {
-                    auto sch_item = static_cast<SCH_ITEM*>( item.GetItem() );
-                    AddConnectionTo( *aPath, sch_item );
-                    sch_item->AddConnectionTo( *aPath, this );
-                }
+                firstSegment = ii;
+                break;
             }
         }
-            break;
+    }
 
-        default:
-            break;
-        }
+    if( firstEnd < firstSegment )
+    {
+        const DANGLING_END_ITEM& item = items[firstEnd];
 
-        if( !m_isDangling )
-            break;
+        m_isDangling = false;
+
+        if( aPath && item.GetType() != PIN_END )
+            m_connected_items[ *aPath ].insert( static_cast<SCH_ITEM*>( item.GetItem() ) );
     }
+    else if( firstSegment != none )
+    {
+        const DANGLING_END_ITEM& item = items[firstSegment];
+
+        m_isDangling = false;
+        m_connectionType = ( item.GetType() == BUS_START_END ) ? CONNECTION_TYPE::BUS
+                                                               : CONNECTION_TYPE::NET;
 
-    if( m_isDangling )
-        m_connectionType = CONNECTION_TYPE::NONE;
+        // Add the line to the connected items, since it won't be picked
+        // up by a search of intersecting connection points
+        if( aPath )
+        {
+            auto sch_item = static_cast<SCH_ITEM*>( item.GetItem() );
+            AddConnectionTo( *aPath, sch_item );
+            sch_item->AddConnectionTo( *aPath, this );
+        }
+    }
 
     return previousState != m_isDangling;
 }
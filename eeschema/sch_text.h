@@ -290,12 +290,15 @@ public:
 
     void GetEndPoints( std::vector< DANGLING_END_ITEM >& aItemList ) override;
 
-    bool UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList,
+    bool UpdateDanglingState( const DANGLING_END_ITEM_INDEX& aItemList,
                               const SCH_SHEET_PATH* aPath = nullptr ) override;
 
     bool IsDangling() const override { return m_isDangling; }
     void SetIsDangling( bool aIsDangling ) { m_isDangling = aIsDangling; }
 
+    /// @return the type of the wire or bus segment the label sits on, NONE if it is not on one.
+    CONNECTION_TYPE GetConnectionType() const { return m_connectionType; }
+
     void GetConnectionPoints( std::vector< wxPoint >& aPoints ) const override;
 
     wxString GetSelectMenuText( EDA_UNITS aUnits ) const override;
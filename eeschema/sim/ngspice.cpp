@@ -35,6 +35,7 @@
 #include <wx/stdpaths.h>
 #include <wx/dir.h>
 
+#include <algorithm>
 #include <stdexcept>
 
 using namespace std;
@@ -50,7 +51,8 @@ NGSPICE::NGSPICE()
           m_ngSpice_AllPlots( nullptr ),
           m_ngSpice_AllVecs( nullptr ),
           m_ngSpice_Running( nullptr ),
-          m_error( false )
+          m_error( false ),
+          m_liveResolved( false )
 {
     init_dll();
 }
@@ -226,6 +228,69 @@ vector<double> NGSPICE::GetPhasePlot( const string& aName, int aMaxLen )
 }
 
 
+int NGSPICE::GetPlotData( const string& aName, const double*& aReal, const COMPLEX*& aComplex )
+{
+    // ngcomplex_t and std::complex<double> are both a pair of doubles
+    static_assert( sizeof( ngcomplex_t ) == sizeof( COMPLEX ), "Incompatible complex types" );
+
+    LOCALE_IO c_locale;       // ngspice works correctly only with C locale
+    vector_info* vi = m_ngGet_Vec_Info( (char*) aName.c_str() );
+
+    aReal = nullptr;
+    aComplex = nullptr;
+
+    if( !vi )
+        return 0;
+
+    if( vi->v_realdata )
+        aReal = vi->v_realdata;
+    else if( vi->v_compdata )
+        aComplex = reinterpret_cast<const COMPLEX*>( vi->v_compdata );
+    else
+        return 0;
+
+    return vi->v_length;
+}
+
+
+void NGSPICE::SetLiveVectors( const vector<string>& aNames )
+{
+    std::lock_guard<std::mutex> lock( m_liveMutex );
+
+    m_liveVectors.clear();
+    m_liveResolved = false;
+
+    for( const string& name : aNames )
+        m_liveVectors.push_back( { name, -1, {} } );
+}
+
+
+bool NGSPICE::GetLivePlot( const string& aName, size_t aOffset, vector<double>& aData )
+{
+    std::lock_guard<std::mutex> lock( m_liveMutex );
+
+    for( const LIVE_VECTOR& vec : m_liveVectors )
+    {
+        if( vec.m_name != aName )
+            continue;
+
+        // Nothing has been sent yet
+        if( !m_liveResolved )
+            return true;
+
+        if( vec.m_index < 0 )
+            return false;
+
+        if( aOffset < vec.m_data.size() )
+            aData.insert( aData.end(), vec.m_data.begin() + aOffset, vec.m_data.end() );
+
+        return true;
+    }
+
+    return false;
+}
+
+
 bool NGSPICE::LoadNetlist( const string& aNetlist )
 {
     LOCALE_IO c_locale;       // ngspice works correctly only with C locale
@@ -255,6 +320,16 @@ bool NGSPICE::LoadNetlist( const string& aNetlist )
 bool NGSPICE::Run()
 {
     LOCALE_IO c_locale;               // ngspice works correctly only with C locale
+
+    {
+        std::lock_guard<std::mutex> lock( m_liveMutex );
+
+        for( LIVE_VECTOR& vec : m_liveVectors )
+            vec.m_data.clear();
+
+        m_liveResolved = false;
+    }
+
     return Command( "bg_run" );     // bg_* commands execute in a separate thread
 }
 
@@ -389,7 +464,8 @@ void NGSPICE::init_dll()
     m_ngSpice_AllVecs = (ngSpice_AllVecs) m_dll.GetSymbol( "ngSpice_AllVecs" );
     m_ngSpice_Running = (ngSpice_Running) m_dll.GetSymbol( "ngSpice_running" ); // it is not a typo
 
-    m_ngSpice_Init( &cbSendChar, &cbSendStat, &cbControlledExit, NULL, NULL, &cbBGThreadRunning, this );
+    m_ngSpice_Init( &cbSendChar, &cbSendStat, &cbControlledExit, &cbSendData, NULL,
+                    &cbBGThreadRunning, this );
 
     // Load a custom spinit file, to fix the problem with loading .cm files
     // Switch to the executable directory, so the relative paths are correct
@@ -551,6 +627,72 @@ int NGSPICE::cbBGThreadRunning( bool is_running, int id, void* user )
 }
 
 
+/**
+ * Checks if a vector name sent by ngspice while running refers to a vector named in Spice
+ * convention: ngspice sends e.g. "out" for V(out) and "v1#branch" for I(V1).
+ */
+static bool matchLiveVector( const string& aName, const char* aSentName )
+{
+    auto toLower =
+            []( string aStr )
+            {
+                std::transform( aStr.begin(), aStr.end(), aStr.begin(), ::tolower );
+                return aStr;
+            };
+
+    const string branch = "#branch";
+    string       name = toLower( aName );
+    string       sent = toLower( aSentName );
+
+    if( name == sent )
+        return true;
+
+    if( sent.size() > branch.size()
+            && sent.compare( sent.size() - branch.size(), branch.size(), branch ) == 0 )
+        return name == "i(" + sent.substr( 0, sent.size() - branch.size() ) + ")";
+
+    return name == "v(" + sent + ")";
+}
+
+
+int NGSPICE::cbSendData( pvecvaluesall vdata, int numvecs, int id, void* user )
+{
+    // Called by the background thread for each computed point
+    NGSPICE* sim = reinterpret_cast<NGSPICE*>( user );
+    std::lock_guard<std::mutex> lock( sim->m_liveMutex );
+
+    if( sim->m_liveVectors.empty() )
+        return 0;
+
+    if( !sim->m_liveResolved )
+    {
+        for( LIVE_VECTOR& vec : sim->m_liveVectors )
+        {
+            vec.m_index = -1;
+
+            for( int i = 0; i < vdata->veccount; i++ )
+            {
+                if( matchLiveVector( vec.m_name, vdata->vecsa[i]->name ) )
+                {
+                    vec.m_index = i;
+                    break;
+                }
+            }
+        }
+
+        sim->m_liveResolved = true;
+    }
+
+    for( LIVE_VECTOR& vec : sim->m_liveVectors )
+    {
+        if( vec.m_index >= 0 && vec.m_index < vdata->veccount )
+            vec.m_data.push_back( vdata->vecsa[vec.m_index]->creal );
+    }
+
+    return 0;
+}
+
+
 int NGSPICE::cbControlledExit( int status, bool immediate, bool exit_upon_quit, int id, void* user )
 {
     // Something went wrong, reload the dll
@@ -30,6 +30,8 @@
 #include <wx/dynlib.h>
 #include <ngspice/sharedspice.h>
 
+#include <mutex>
+
 class wxDynamicLibrary;
 
 class NGSPICE : public SPICE_SIMULATOR {
@@ -77,6 +79,17 @@ public:
     ///> @copydoc SPICE_SIMULATOR::GetPhasePlot()
     std::vector<double> GetPhasePlot( const std::string& aName, int aMaxLen = -1 ) override;
 
+    ///> @copydoc SPICE_SIMULATOR::GetPlotData()
+    int GetPlotData( const std::string& aName, const double*& aReal,
+                     const COMPLEX*& aComplex ) override;
+
+    ///> @copydoc SPICE_SIMULATOR::SetLiveVectors()
+    void SetLiveVectors( const std::vector<std::string>& aNames ) override;
+
+    ///> @copydoc SPICE_SIMULATOR::GetLivePlot()
+    bool GetLivePlot( const std::string& aName, size_t aOffset,
+                      std::vector<double>& aData ) override;
+
     ///> @copydoc SPICE_SIMULATOR::GetNetlist()
     virtual const std::string GetNetlist() const override;
 
@@ -123,6 +136,7 @@ private:
     static int cbSendChar( char* what, int id, void* user );
     static int cbSendStat( char* what, int id, void* user );
     static int cbBGThreadRunning( bool is_running, int id, void* user );
+    static int cbSendData( pvecvaluesall vdata, int numvecs, int id, void* user );
     static int cbControlledExit( int status, bool immediate, bool exit_upon_quit, int id, void* user );
 
     // Assures ngspice is in a valid state and reinitializes it if need be
@@ -136,6 +150,23 @@ private:
 
     ///> current netlist
     std::string m_netlist;
+
+    ///> A vector collected while the simulation is running
+    struct LIVE_VECTOR
+    {
+        std::string         m_name;     ///< name in Spice convention, as in SetLiveVectors()
+        int                 m_index;    ///< index in the data sent by ngspice, -1 if not sent
+        std::vector<double> m_data;
+    };
+
+    ///> Vectors collected while the simulation is running, filled by cbSendData()
+    std::vector<LIVE_VECTOR> m_liveVectors;
+
+    ///> True when LIVE_VECTOR::m_index has been set for the current run
+    bool m_liveResolved;
+
+    ///> Protects the live vectors, written by the ngspice background thread
+    std::mutex m_liveMutex;
 };
 
 #endif /* NGSPICE_H */
@@ -120,6 +120,7 @@ wxString SIM_PLOT_FRAME::m_savedWorkbooksPath;
 SIM_PLOT_FRAME::SIM_PLOT_FRAME( KIWAY* aKiway, wxWindow* aParent )
         : SIM_PLOT_FRAME_BASE( aParent ),
           m_lastSimPlot( nullptr ),
+          m_livePlot( nullptr ),
           m_welcomePanel( nullptr ),
           m_plotNumber( 0 )
 {
@@ -172,6 +173,9 @@ SIM_PLOT_FRAME::SIM_PLOT_FRAME( KIWAY* aKiway, wxWindow* aParent )
     Connect( EVT_SIM_FINISHED, wxCommandEventHandler( SIM_PLOT_FRAME::onSimFinished ), NULL, this );
     Connect( EVT_SIM_CURSOR_UPDATE, wxCommandEventHandler( SIM_PLOT_FRAME::onCursorUpdate ), NULL, this );
 
+    m_liveTimer.SetOwner( this );
+    Bind( wxEVT_TIMER, &SIM_PLOT_FRAME::onLiveUpdate, this, m_liveTimer.GetId() );
+
     // Toolbar buttons
     m_toolSimulate = m_toolBar->AddTool( ID_SIM_RUN, _( "Run/Stop Simulation" ),
             KiBitmap( sim_run_xpm ), _( "Run Simulation" ), wxITEM_NORMAL );
@@ -229,6 +233,7 @@ SIM_PLOT_FRAME::SIM_PLOT_FRAME( KIWAY* aKiway, wxWindow* aParent )
 
 SIM_PLOT_FRAME::~SIM_PLOT_FRAME()
 {
+    m_liveTimer.Stop();
     m_simulator->SetReporter( nullptr );
     delete m_reporter;
     delete m_signalsIconColorList;
@@ -458,6 +463,7 @@ void SIM_PLOT_FRAME::StartSimulation( const wxString& aSimCommand )
     m_simulator->LoadNetlist( formatter.GetString() );
     updateTuners();
     applyTuners();
+    setLiveTraces();
     m_simulator->Run();
 }
 
@@ -696,6 +702,31 @@ bool SIM_PLOT_FRAME::updatePlot( const TRACE_DESC& aDescriptor, SIM_PLOT_PANEL*
     if( xAxisName.IsEmpty() )
         return false;
 
+    // Transient vectors are real and plotted as they are, so they are passed without copying
+    if( simType == ST_TRANSIENT )
+    {
+        const double*  real_x;
+        const double*  real_y;
+        const COMPLEX* complexData;
+        int            count = m_simulator->GetPlotData( (const char*) xAxisName.c_str(),
+                                                         real_x, complexData );
+
+        if( count > 0 && real_x
+                && m_simulator->GetPlotData( (const char*) spiceVector.c_str(), real_y,
+                                             complexData ) == count
+                && real_y )
+        {
+            if( aPanel->AddTrace( aDescriptor.GetTitle(), count, real_x, real_y,
+                                  aDescriptor.GetType() ) )
+            {
+                m_plots[aPanel].m_traces.insert( std::make_pair( aDescriptor.GetTitle(),
+                                                                 aDescriptor ) );
+            }
+
+            return true;
+        }
+    }
+
     auto data_x = m_simulator->GetMagPlot( (const char*) xAxisName.c_str() );
     unsigned int size = data_x.size();
 
@@ -791,6 +822,44 @@ bool SIM_PLOT_FRAME::updatePlot( const TRACE_DESC& aDescriptor, SIM_PLOT_PANEL*
 }
 
 
+void SIM_PLOT_FRAME::setLiveTraces()
+{
+    std::vector<std::string> vectors;
+    SIM_PLOT_PANEL*          plotPanel = CurrentPlot();
+
+    m_livePlot = nullptr;
+
+    // AC and DC traces are converted or split once the simulation has finished, and these
+    // analyses are short anyway
+    if( plotPanel && plotPanel->GetType() == ST_TRANSIENT
+            && m_exporter->GetSimType() == ST_TRANSIENT )
+    {
+        vectors.push_back( m_simulator->GetXAxis( ST_TRANSIENT ) );
+
+        for( const auto& trace : m_plots[plotPanel].m_traces )
+        {
+            const TRACE_DESC& desc = trace.second;
+            TRACE*            t = plotPanel->GetTrace( trace.first );
+
+            if( !t )
+                continue;
+
+            vectors.push_back( m_exporter->ComponentToVector( desc.GetName(), desc.GetType(),
+                                                              desc.GetParam() ).ToStdString() );
+            t->SetData( std::vector<double>(), std::vector<double>() );
+        }
+
+        if( vectors.size() > 1 )
+            m_livePlot = plotPanel;
+    }
+
+    if( !m_livePlot )
+        vectors.clear();
+
+    m_simulator->SetLiveVectors( vectors );
+}
+
+
 void SIM_PLOT_FRAME::updateSignalList()
 {
     m_signals->ClearAll();
@@ -1473,6 +1542,9 @@ void SIM_PLOT_FRAME::onSimStarted( wxCommandEvent& aEvent )
 {
     m_toolBar->SetToolNormalBitmap( ID_SIM_RUN, KiBitmap( sim_stop_xpm ) );
     SetCursor( wxCURSOR_ARROWWAIT );
+
+    if( m_livePlot )
+        m_liveTimer.Start( 250 );
 }
 
 
@@ -1481,6 +1553,11 @@ void SIM_PLOT_FRAME::onSimFinished( wxCommandEvent& aEvent )
     m_toolBar->SetToolNormalBitmap( ID_SIM_RUN, KiBitmap( sim_run_xpm ) );
     SetCursor( wxCURSOR_ARROW );
 
+    // The traces are updated below with the complete vectors
+    m_liveTimer.Stop();
+    m_livePlot = nullptr;
+    m_simulator->SetLiveVectors( std::vector<std::string>() );
+
     SIM_TYPE simType = m_exporter->GetSimType();
 
     if( simType == ST_UNKNOWN )
@@ -1548,6 +1625,54 @@ void SIM_PLOT_FRAME::onSimFinished( wxCommandEvent& aEvent )
 }
 
 
+void SIM_PLOT_FRAME::onLiveUpdate( wxTimerEvent& aEvent )
+{
+    // The panel may have been closed while the simulation was running
+    if( !m_livePlot || !m_plots.count( m_livePlot ) )
+        return;
+
+    std::string xAxisName = m_simulator->GetXAxis( ST_TRANSIENT );
+    bool        updated = false;
+
+    for( const auto& trace : m_plots[m_livePlot].m_traces )
+    {
+        const TRACE_DESC&   desc = trace.second;
+        TRACE*              t = m_livePlot->GetTrace( trace.first );
+        std::vector<double> data_x, data_y;
+
+        if( !t )
+            continue;
+
+        wxString spiceVector = m_exporter->ComponentToVector( desc.GetName(), desc.GetType(),
+                                                              desc.GetParam() );
+        size_t   offset = t->GetDataX().size();
+
+        if( !m_simulator->GetLivePlot( xAxisName, offset, data_x )
+                || !m_simulator->GetLivePlot( spiceVector.ToStdString(), offset, data_y ) )
+        {
+            continue;
+        }
+
+        // More points may have been computed between both calls
+        size_t size = std::min( data_x.size(), data_y.size() );
+
+        if( size == 0 )
+            continue;
+
+        data_x.resize( size );
+        data_y.resize( size );
+        t->AppendData( data_x, data_y );
+        updated = true;
+    }
+
+    if( updated )
+    {
+        m_livePlot->GetPlotWin()->UpdateAll();
+        m_livePlot->ResetScales();
+    }
+}
+
+
 void SIM_PLOT_FRAME::onSimUpdate( wxCommandEvent& aEvent )
 {
     if( IsSimulationRunning() )
@@ -1565,6 +1690,7 @@ void SIM_PLOT_FRAME::onSimUpdate( wxCommandEvent& aEvent )
         m_simConsole->Clear();
         // Do not export netlist, it is already stored in the simulator
         applyTuners();
+        setLiveTraces();
         m_simulator->Run();
     }
 }
@@ -41,6 +41,7 @@
 #include <dialogs/dialog_sim_settings.h>
 
 #include <wx/event.h>
+#include <wx/timer.h>
 
 #include <list>
 #include <memory>
@@ -252,6 +253,12 @@ private:
      */
     bool updatePlot( const TRACE_DESC& aDescriptor, SIM_PLOT_PANEL* aPanel );
 
+    /**
+     * @brief Selects the traces of the current plot to be updated while the simulation runs,
+     * and clears their data. Only transient analyses are plotted while running.
+     */
+    void setLiveTraces();
+
     /**
      * @brief Updates the list of currently plotted signals.
      */
@@ -335,6 +342,7 @@ private:
     void onSimReport( wxCommandEvent& aEvent );
     void onSimStarted( wxCommandEvent& aEvent );
     void onSimFinished( wxCommandEvent& aEvent );
+    void onLiveUpdate( wxTimerEvent& aEvent );
 
     // adjust the sash dimension of splitter windows after reading
     // the config settings
@@ -400,6 +408,12 @@ private:
     ///> Panel that was used as the most recent one for simulations
     SIM_PLOT_PANEL* m_lastSimPlot;
 
+    ///> Panel whose traces are updated while the simulation runs, or nullptr
+    SIM_PLOT_PANEL* m_livePlot;
+
+    ///> Appends the points computed by the running simulation to the traces of m_livePlot
+    wxTimer m_liveTimer;
+
     ///> imagelists uset to add a small coloured icon to signal names
     ///> and cursors name, the same color as the corresponding signal traces
     wxImageList* m_signalsIconColorList;
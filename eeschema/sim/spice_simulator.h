@@ -145,6 +145,37 @@ public:
      */
     virtual std::vector<double> GetPhasePlot( const std::string& aName, int aMaxLen = -1 ) = 0;
 
+    /**
+     * @brief Gives read-only access to a requested vector, without copying its values.
+     * The values belong to the simulator and are valid only until the next command or run,
+     * so they must not be stored.
+     * @param aName is the vector named in Spice convention (e.g. V(3), I(R1)).
+     * @param aReal is set to the values of a real vector, or to nullptr.
+     * @param aComplex is set to the values of a complex vector, or to nullptr.
+     * @return Count of values. It is 0 if there is no vector with requested name.
+     */
+    virtual int GetPlotData( const std::string& aName, const double*& aReal,
+                             const COMPLEX*& aComplex ) = 0;
+
+    /**
+     * @brief Selects vectors to be collected while the simulation is running, so they can
+     * be plotted before it finishes. It takes effect at the next run.
+     * @param aNames are the vectors named in Spice convention (e.g. V(3), I(R1)), including
+     * the X axis vector.
+     */
+    virtual void SetLiveVectors( const std::vector<std::string>& aNames ) = 0;
+
+    /**
+     * @brief Appends the real values of a vector computed so far by the running simulation,
+     * starting at a given index. It may be called from the GUI while the simulation runs.
+     * @param aName is a vector name passed to SetLiveVectors().
+     * @param aOffset is the index of the first value to be appended.
+     * @param aData receives the values.
+     * @return False if the vector is not collected while the simulation runs.
+     */
+    virtual bool GetLivePlot( const std::string& aName, size_t aOffset,
+                              std::vector<double>& aData ) = 0;
+
     /**
      * @brief Returns current SPICE netlist used by the simulator.
      * @return The netlist.
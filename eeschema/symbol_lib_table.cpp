@@ -45,6 +45,7 @@ static const wxString global_tbl_name( "sym-lib-table" );
 
 const char* SYMBOL_LIB_TABLE::PropPowerSymsOnly = "pwr_sym_only";
 const char* SYMBOL_LIB_TABLE::PropNonPowerSymsOnly = "non_pwr_sym_only";
+const char* SYMBOL_LIB_TABLE::PropIndexOnly = "index_only";
 int SYMBOL_LIB_TABLE::m_modifyHash = 1;     // starts at 1 and goes up
 
 
@@ -309,13 +310,28 @@ void SYMBOL_LIB_TABLE::LoadSymbolLib( std::vector<LIB_PART*>& aSymbolList,
 
     wxString options = row->GetOptions();
 
+    // The symbols are only listed, so plugins may defer loading their drawings until
+    // LoadSymbol() is called.  Library table options are separated by '|'.
+    wxString listOptions = options.IsEmpty() ? wxString( PropIndexOnly )
+                                             : options + "|" + PropIndexOnly;
+
     if( aPowerSymbolsOnly )
-        row->SetOptions( row->GetOptions() + " " + PropPowerSymsOnly );
+        listOptions += wxString( "|" ) + PropPowerSymsOnly;
 
-    row->plugin->EnumerateSymbolLib( aSymbolList, row->GetFullURI( true ), row->GetProperties() );
+    row->SetOptions( listOptions );
 
-    if( aPowerSymbolsOnly )
+    try
+    {
+        row->plugin->EnumerateSymbolLib( aSymbolList, row->GetFullURI( true ),
+                                         row->GetProperties() );
+    }
+    catch( ... )
+    {
         row->SetOptions( options );
+        throw;
+    }
+
+    row->SetOptions( options );
 
     // The library cannot know its own name, because it might have been renamed or moved.
     // Therefore footprints cannot know their own library nickname when residing in
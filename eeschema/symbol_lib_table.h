@@ -112,6 +112,7 @@ public:
 
     static const char* PropPowerSymsOnly;
     static const char* PropNonPowerSymsOnly;
+    static const char* PropIndexOnly;           ///< symbols may be listed without their drawing
 
     virtual void Parse( LIB_TABLE_LEXER* aLexer ) override;
 
@@ -158,6 +159,18 @@ public:
     void EnumerateSymbolLib( const wxString& aNickname, wxArrayString& aAliasNames,
                              bool aPowerSymbolsOnly = false );
 
+    /**
+     * Return the symbols contained within the library given by @a aNickname, for listing.
+     *
+     * The symbols may not have their drawing (pins and graphic items) loaded yet.  Use
+     * LoadSymbol() to get a complete symbol.
+     *
+     * @param aAliasList is a reference to a vector for the symbols.
+     * @param aNickname is a locator for the "library", it is a "name" in LIB_TABLE_ROW.
+     * @param aPowerSymbolsOnly is a flag to enumerate only power symbols.
+     *
+     * @throw IO_ERROR if the library cannot be found or loaded.
+     */
     void LoadSymbolLib( std::vector<LIB_PART*>& aAliasList, const wxString& aNickname,
                         bool aPowerSymbolsOnly = false );
 
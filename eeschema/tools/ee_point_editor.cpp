@@ -596,6 +596,7 @@ void EE_POINT_EDITOR::updateItem() const
             pin->SetPosition( pos );
         }
 
+        m_frame->GetScreen()->Update( sheet );
         break;
     }
 
@@ -615,6 +616,7 @@ void EE_POINT_EDITOR::updateItem() const
             else if( connection->HasFlag( ENDPOINT ) )
                 connection->SetEndPoint( line->GetPosition() );
 
+            m_frame->GetScreen()->Update( connection );
             getView()->Update( connection, KIGFX::GEOMETRY );
         }
 
@@ -627,9 +629,11 @@ void EE_POINT_EDITOR::updateItem() const
             else if( connection->HasFlag( ENDPOINT ) )
                 connection->SetEndPoint( line->GetEndPoint() );
 
+            m_frame->GetScreen()->Update( connection );
             getView()->Update( connection, KIGFX::GEOMETRY );
         }
 
+        m_frame->GetScreen()->Update( line );
         break;
     }
 
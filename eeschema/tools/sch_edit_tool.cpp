@@ -372,6 +372,24 @@ const KICAD_T rotatableItems[] = {
 };
 
 
+/**
+ * Updates the screen indexes for an item rotated or mirrored in place.  Sheet pins and fields
+ * are indexed with their parent.
+ */
+static void updateScreenItem( SCH_SCREEN* aScreen, SCH_ITEM* aItem )
+{
+    if( aItem->Type() == SCH_SHEET_PIN_T || aItem->Type() == SCH_FIELD_T )
+    {
+        if( aItem->GetParent() )
+            aScreen->Update( static_cast<SCH_ITEM*>( aItem->GetParent() ) );
+    }
+    else
+    {
+        aScreen->Update( aItem );
+    }
+}
+
+
 int SCH_EDIT_TOOL::Rotate( const TOOL_EVENT& aEvent )
 {
     EE_SELECTION& selection = m_selectionTool->RequestSelection( rotatableItems );
@@ -483,6 +501,7 @@ int SCH_EDIT_TOOL::Rotate( const TOOL_EVENT& aEvent )
             break;
         }
 
+        updateScreenItem( m_frame->GetScreen(), item );
         connections = item->IsConnectable();
         m_frame->RefreshItem( item );
     }
@@ -530,6 +549,7 @@ int SCH_EDIT_TOOL::Rotate( const TOOL_EVENT& aEvent )
                 }
             }
 
+            updateScreenItem( m_frame->GetScreen(), item );
             connections |= item->IsConnectable();
             m_frame->RefreshItem( item );
         }
@@ -667,6 +687,7 @@ int SCH_EDIT_TOOL::Mirror( const TOOL_EVENT& aEvent )
             break;
         }
 
+        updateScreenItem( m_frame->GetScreen(), item );
         connections = item->IsConnectable();
         m_frame->RefreshItem( item );
     }
@@ -707,6 +728,7 @@ int SCH_EDIT_TOOL::Mirror( const TOOL_EVENT& aEvent )
                     item->MirrorY( mirrorPoint.x );
             }
 
+            updateScreenItem( m_frame->GetScreen(), item );
             connections |= item->IsConnectable();
             m_frame->RefreshItem( item );
         }
@@ -987,6 +1009,7 @@ int SCH_EDIT_TOOL::DoDelete( const TOOL_EVENT& aEvent )
                 SCH_SHEET*     sheet = pin->GetParent();
 
                 sheet->RemovePin( pin );
+                m_frame->GetScreen()->Update( sheet );
             }
             else
                 m_frame->RemoveFromScreen( sch_item );
@@ -230,8 +230,10 @@ int SCH_MOVE_TOOL::Main( const TOOL_EVENT& aEvent )
                     for( EDA_ITEM* item : selection )
                         static_cast<SCH_ITEM*>( item )->GetEndPoints( internalPoints );
 
+                    DANGLING_END_ITEM_INDEX index( internalPoints );
+
                     for( EDA_ITEM* item : selection )
-                        static_cast<SCH_ITEM*>( item )->UpdateDanglingState( internalPoints );
+                        static_cast<SCH_ITEM*>( item )->UpdateDanglingState( index );
                 }
                 // Generic setup
                 //
@@ -448,8 +450,11 @@ int SCH_MOVE_TOOL::Main( const TOOL_EVENT& aEvent )
         {
             switch( item->Type() )
             {
-            // Moving sheet pins does not change the BBox.
+            // Sheet pins are indexed with their sheet
             case SCH_SHEET_PIN_T:
+                if( item->GetParent() )
+                    m_frame->GetScreen()->Update( static_cast<SCH_ITEM*>( item->GetParent() ) );
+
                 break;
 
             // Moving fields should update the associated component
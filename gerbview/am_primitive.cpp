@@ -107,8 +107,8 @@ void AM_PRIMITIVE::DrawBasicShape( const GERBER_DRAW_ITEM* aParent,
                             aShapeBuffer.Append( polybuffer[0].x, polybuffer[0].y );}
 
     // Draw the primitive shape for flashed items.
-    static std::vector<wxPoint> polybuffer;     // create a static buffer to avoid a lot of memory reallocation
-    polybuffer.clear();
+    // Not static: macro shapes are built by the threads loading several files at once
+    std::vector<wxPoint> polybuffer;
 
     wxPoint curPos = aShapePos;
     D_CODE* tool   = aParent->GetDcodeDescr();
@@ -781,11 +781,62 @@ int AM_PRIMITIVE::GetShapeDim( const GERBER_DRAW_ITEM* aParent )
 
 SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent,
                                                        wxPoint aShapePos )
+{
+    // The shape depends only on the D code parameters and on the item transform, so it is
+    // built once at the origin and moved to the item position
+    std::vector<double> key;
+    D_CODE*             tool = aParent->GetDcodeDescr();
+
+    if( tool )
+    {
+        for( unsigned ii = 1; ii <= tool->GetParamCount(); ii++ )
+            key.push_back( tool->GetParam( ii ) );
+    }
+
+    aParent->GetABTransformParams( key );
+
+    auto cached = m_shapeCache.find( key );
+
+    if( cached == m_shapeCache.end() )
+    {
+        // Each parameter set of a macro is usually flashed many times, so a full cache
+        // means the parameters vary a lot: start over rather than keeping every shape
+        if( m_shapeCache.size() >= SHAPE_CACHE_MAX_SIZE )
+            m_shapeCache.clear();
+
+        m_shapeCacheMisses++;
+        cached = m_shapeCache.emplace( key, SHAPE_POLY_SET() ).first;
+        BuildApertureMacroShape( aParent, wxPoint( 0, 0 ), cached->second );
+
+        // The item offsets (image offset, justification, layer offset) are not part of the
+        // key, so the shape is stored relative to the position of the origin of this item
+        cached->second.Move( -aParent->GetABPosition( wxPoint( 0, 0 ) ) );
+    }
+    else
+    {
+        m_shapeCacheHits++;
+    }
+
+    m_shape = cached->second;
+    m_shape.Move( aParent->GetABPosition( aShapePos ) );
+
+    m_boundingBox = EDA_RECT( wxPoint( 0, 0 ), wxSize( 1, 1 ) );
+    auto bb = m_shape.BBox();
+    wxPoint center( bb.Centre().x, bb.Centre().y );
+    m_boundingBox.Move( aParent->GetABPosition( center ) );
+    m_boundingBox.Inflate( bb.GetWidth() / 2, bb.GetHeight() / 2 );
+
+    return &m_shape;
+}
+
+
+void APERTURE_MACRO::BuildApertureMacroShape( const GERBER_DRAW_ITEM* aParent,
+                                              wxPoint aShapePos, SHAPE_POLY_SET& aShape )
 {
     SHAPE_POLY_SET holeBuffer;
     bool hasHole = false;
 
-    m_shape.RemoveAllContours();
+    aShape.RemoveAllContours();
 
     for( AM_PRIMITIVES::iterator prim_macro = primitives.begin();
          prim_macro != primitives.end(); ++prim_macro )
@@ -794,14 +845,14 @@ SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* a
             continue;
 
         if( prim_macro->IsAMPrimitiveExposureOn( aParent ) )
-            prim_macro->DrawBasicShape( aParent, m_shape, aShapePos );
+            prim_macro->DrawBasicShape( aParent, aShape, aShapePos );
         else
         {
             prim_macro->DrawBasicShape( aParent, holeBuffer, aShapePos );
 
             if( holeBuffer.OutlineCount() )     // we have a new hole in shape: remove the hole
             {
-                m_shape.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
+                aShape.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
                 holeBuffer.RemoveAllContours();
                 hasHole = true;
             }
@@ -811,15 +862,7 @@ SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* a
     // If a hole is defined inside a polygon, we must fracture the polygon
     // to be able to drawn it (i.e link holes by overlapping edges)
     if( hasHole )
-        m_shape.Fracture( SHAPE_POLY_SET::PM_FAST );
-
-    m_boundingBox = EDA_RECT( wxPoint( 0, 0 ), wxSize( 1, 1 ) );
-    auto bb = m_shape.BBox();
-    wxPoint center( bb.Centre().x, bb.Centre().y );
-    m_boundingBox.Move( aParent->GetABPosition( center ) );
-    m_boundingBox.Inflate( bb.GetWidth() / 2, bb.GetHeight() / 2 );
-
-    return &m_shape;
+        aShape.Fracture( SHAPE_POLY_SET::PM_FAST );
 }
 
 
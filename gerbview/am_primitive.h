@@ -30,6 +30,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <map>
 #include <vector>
 #include <set>
 
@@ -176,6 +177,29 @@ struct APERTURE_MACRO
     SHAPE_POLY_SET m_shape;     ///< The shape of the item, calculated by GetApertureMacroShape
     EDA_RECT m_boundingBox;     ///< The bounding box of the item, calculated by GetApertureMacroShape
 
+    /**
+     * Shapes of the macro at the origin, built by GetApertureMacroShape.  The key is made of
+     * the D code parameter values and of the item transform (see
+     * GERBER_DRAW_ITEM::GetABTransformParams()).
+     */
+    std::map<std::vector<double>, SHAPE_POLY_SET> m_shapeCache;
+    unsigned m_shapeCacheHits = 0;      ///< Number of shapes found in m_shapeCache
+    unsigned m_shapeCacheMisses = 0;    ///< Number of shapes built and added to m_shapeCache
+
+    /// m_shapeCache is cleared when it holds this number of shapes
+    static const size_t SHAPE_CACHE_MAX_SIZE = 1024;
+
+    /**
+     * Function ClearShapeCache
+     * removes the shapes cached by GetApertureMacroShape, and resets the cache statistics.
+     */
+    void ClearShapeCache()
+    {
+        m_shapeCache.clear();
+        m_shapeCacheHits = 0;
+        m_shapeCacheMisses = 0;
+    }
+
     /**
      * function GetLocalParam
      * Usually, parameters are defined inside the aperture primitive
@@ -199,6 +223,16 @@ struct APERTURE_MACRO
      */
     SHAPE_POLY_SET* GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent, wxPoint aShapePos );
 
+    /**
+     * Function BuildApertureMacroShape
+     * Build the shape of the macro from its primitives, without using the cache.
+     * @param aParent = the parent GERBER_DRAW_ITEM which is actually drawn
+     * @param aShapePos = the actual shape position
+     * @param aShape = the buffer receiving the shape
+     */
+    void BuildApertureMacroShape( const GERBER_DRAW_ITEM* aParent, wxPoint aShapePos,
+                                  SHAPE_POLY_SET& aShape );
+
    /**
      * Function DrawApertureMacroShape
      * Draw the primitive shape for flashed items.
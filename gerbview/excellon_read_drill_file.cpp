@@ -245,15 +245,7 @@ static EXCELLON_CMD excellon_G_CmdList[] =
 bool GERBVIEW_FRAME::Read_EXCELLON_File( const wxString& aFullFileName )
 {
     wxString msg;
-    int layerId = GetActiveLayer();      // current layer used in GerbView
-    GERBER_FILE_IMAGE_LIST* images = GetGerberLayout()->GetImagesList();
-    auto gerber_layer = images->GetGbrImage( layerId );
-
-    // OIf the active layer contains old gerber or nc drill data, remove it
-    if( gerber_layer )
-        Erase_Current_DrawLayer( false );
-
-    EXCELLON_IMAGE* drill_layer = new EXCELLON_IMAGE( layerId );
+    EXCELLON_IMAGE* drill_layer = new EXCELLON_IMAGE( GetActiveLayer() );
 
     // Read the Excellon drill file:
     bool success = drill_layer->LoadFile( aFullFileName );
@@ -266,6 +258,21 @@ bool GERBVIEW_FRAME::Read_EXCELLON_File( const wxString& aFullFileName )
         return false;
     }
 
+    return addExcellonImage( drill_layer );
+}
+
+
+bool GERBVIEW_FRAME::addExcellonImage( EXCELLON_IMAGE* drill_layer )
+{
+    int layerId = GetActiveLayer();      // current layer used in GerbView
+    GERBER_FILE_IMAGE_LIST* images = GetGerberLayout()->GetImagesList();
+    auto gerber_layer = images->GetGbrImage( layerId );
+
+    // OIf the active layer contains old gerber or nc drill data, remove it
+    if( gerber_layer )
+        Erase_Current_DrawLayer( false );
+
+    drill_layer->m_GraphicLayer = layerId;
     layerId = images->AddGbrImage( drill_layer, layerId );
 
     if( layerId < 0 )
@@ -289,7 +296,7 @@ bool GERBVIEW_FRAME::Read_EXCELLON_File( const wxString& aFullFileName )
             GetCanvas()->GetView()->Add( (KIGFX::VIEW_ITEM*) item );
     }
 
-    return success;
+    return true;
 }
 
 /*
@@ -665,7 +672,7 @@ bool EXCELLON_IMAGE::Execute_Drill_Command( char*& text )
                     return false;
                 }
 
-                gbritem = new GERBER_DRAW_ITEM( this );
+                gbritem = NewDrawItem();
                 AddItemToList( gbritem );
 
                 if( m_SlotOn )  // Oblong hole
@@ -899,7 +906,7 @@ void EXCELLON_IMAGE::FinishRouteCommand()
 
     for( size_t ii = 1; ii < m_RoutePositions.size(); ii++ )
     {
-        GERBER_DRAW_ITEM* gbritem = new GERBER_DRAW_ITEM( this );
+        GERBER_DRAW_ITEM* gbritem = NewDrawItem();
 
         if( m_RoutePositions[ii].m_rmode == 0 )     // linear routing
         {
@@ -38,6 +38,10 @@
 #include <wildcards_and_files_ext.h>
 #include <widgets/progress_reporter.h>
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 // HTML Messages used more than one time:
 #define MSG_NO_MORE_LAYER\
     _( "<b>No more available free graphic layer</b> in Gerbview to load files" )
@@ -291,8 +295,8 @@ bool GERBVIEW_FRAME::loadListOfGerberAndDrillFiles( const wxString& aPath,
     wxString msg;
     WX_STRING_REPORTER reporter( &msg );
 
-    // Create progress dialog (only used if more than 1 file to load
-    std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
+    std::vector<wxString> fullFileNames;
+    std::vector<bool>     isDrillFile;
 
     for( unsigned ii = 0; ii < aFilenameList.GetCount(); ii++ )
     {
@@ -313,62 +317,146 @@ bool GERBVIEW_FRAME::loadListOfGerberAndDrillFiles( const wxString& aPath,
             continue;
         }
 
-        m_lastFileName = filename.GetFullPath();
+        fullFileNames.push_back( filename.GetFullPath() );
+        isDrillFile.push_back( aFileType && (*aFileType)[ii] == 1 );
+    }
+
+    // Create progress dialog (only used if more than 1 file to load
+    std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
 
-        if( !progress && ( aFilenameList.GetCount() > 1 ) )
+    if( fullFileNames.size() > 1 )
+    {
+        progress = std::make_unique<WX_PROGRESS_REPORTER>( this,
+                        _( "Loading Gerber files..." ), 1, false );
+        progress->SetMaxProgress( fullFileNames.size() );
+        progress->Report( wxString::Format( _( "Loading %zu files" ), fullFileNames.size() ) );
+        progress->KeepRefreshing();
+    }
+
+    // The files are independent until they are put on layers, so they are read in parallel.
+    // Images which cannot be read are left null.
+    std::vector<std::unique_ptr<GERBER_FILE_IMAGE>> loadedImages( fullFileNames.size() );
+    std::atomic<size_t> nextFile( 0 );
+    size_t              parallelThreadCount =
+            std::min<size_t>( std::thread::hardware_concurrency(), fullFileNames.size() );
+    parallelThreadCount = std::max<size_t>( parallelThreadCount, 1 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto load_lambda = [&]( PROGRESS_REPORTER* aReporter ) -> size_t
+    {
+        size_t num = 0;
+
+        for( size_t i = nextFile++; i < fullFileNames.size(); i = nextFile++ )
         {
-            progress = std::make_unique<WX_PROGRESS_REPORTER>( this,
-                            _( "Loading Gerber files..." ), 1, false );
-            progress->SetMaxProgress( aFilenameList.GetCount() - 1 );
-            progress->Report( wxString::Format( _("Loading %u/%zu %s" ), ii+1,
-                                            aFilenameList.GetCount(), m_lastFileName ) );
+            // The images are created on layer 0, and moved to their layer when they are added
+            if( isDrillFile[i] )
+            {
+                std::unique_ptr<EXCELLON_IMAGE> drill = std::make_unique<EXCELLON_IMAGE>( 0 );
+
+                if( drill->LoadFile( fullFileNames[i] ) )
+                    loadedImages[i] = std::move( drill );
+            }
+            else
+            {
+                std::unique_ptr<GERBER_FILE_IMAGE> gerber =
+                        std::make_unique<GERBER_FILE_IMAGE>( 0 );
+
+                if( gerber->LoadGerberFile( fullFileNames[i] ) )
+                    loadedImages[i] = std::move( gerber );
+            }
+
+            if( aReporter )
+            {
+                aReporter->Report( wxString::Format( _( "Loading %s" ), fullFileNames[i] ) );
+                aReporter->AdvanceProgress();
+            }
+
+            num++;
         }
-        else if( progress )
+
+        return num;
+    };
+
+    {
+        // The locale is switched once for all the threads
+        LOCALE_IO toggleIo;
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, load_lambda, progress.get() );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        {
+            // Here we balance returns with a 100ms timeout to allow UI updating
+            std::future_status status;
+            do
+            {
+                if( progress )
+                    progress->KeepRefreshing();
+
+                status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+            } while( status != std::future_status::ready );
+        }
+    }
+
+    progress.reset();
+
+    // Put the images on the layers, in the order of the list
+    for( size_t ii = 0; ii < loadedImages.size(); ii++ )
+    {
+        if( !loadedImages[ii] )
         {
-            progress->Report( wxString::Format( _("Loading %u/%zu %s" ), ii+1,
-                                            aFilenameList.GetCount(), m_lastFileName ) );
-            progress->KeepRefreshing();
+            wxString warning;
+            warning << "<b>" << _( "File not loaded:" ) << "</b><br>"
+                    << fullFileNames[ii] << "<br>";
+            reporter.Report( warning, RPT_SEVERITY_WARNING );
+            success = false;
+            continue;
         }
 
+        m_lastFileName = fullFileNames[ii];
+
         SetActiveLayer( layer, false );
 
         visibility[ layer ] = true;
 
-        if( aFileType && (*aFileType)[ii] == 1 )
+        bool added;
+
+        if( isDrillFile[ii] )
         {
-            LoadExcellonFiles( filename.GetFullPath() );
-            layer = GetActiveLayer();   // Loading NC drill file changes the active layer
+            added = addExcellonImage( static_cast<EXCELLON_IMAGE*>( loadedImages[ii].release() ) );
+
+            if( added )
+                UpdateFileHistory( m_lastFileName, &m_drillFileHistory );
         }
         else
         {
-            if( Read_GERBER_File( filename.GetFullPath() ) )
-            {
+            added = addGerberImage( loadedImages[ii].release() );
+
+            if( added )
                 UpdateFileHistory( m_lastFileName );
+        }
+
+        if( !added )
+            continue;
 
-                layer = getNextAvailableLayer( layer );
+        layer = getNextAvailableLayer( layer );
 
-                if( layer == NO_AVAILABLE_LAYERS && ii < aFilenameList.GetCount()-1 )
-                {
-                    success = false;
-                    reporter.Report( MSG_NO_MORE_LAYER, RPT_SEVERITY_ERROR );
-
-                    // Report the name of not loaded files:
-                    ii += 1;
-                    while( ii < aFilenameList.GetCount() )
-                    {
-                        filename = aFilenameList[ii++];
-                        wxString txt = wxString::Format( MSG_NOT_LOADED, filename.GetFullName() );
-                        reporter.Report( txt, RPT_SEVERITY_ERROR );
-                    }
-                    break;
-                }
+        if( layer == NO_AVAILABLE_LAYERS && ii < loadedImages.size() - 1 )
+        {
+            success = false;
+            reporter.Report( MSG_NO_MORE_LAYER, RPT_SEVERITY_ERROR );
 
-                SetActiveLayer( layer, false );
+            // Report the name of not loaded files:
+            while( ++ii < loadedImages.size() )
+            {
+                filename = fullFileNames[ii];
+                wxString txt = wxString::Format( MSG_NOT_LOADED, filename.GetFullName() );
+                reporter.Report( txt, RPT_SEVERITY_ERROR );
             }
+            break;
         }
 
-        if( progress )
-            progress->AdvanceProgress();
+        SetActiveLayer( layer, false );
     }
 
     if( !success )
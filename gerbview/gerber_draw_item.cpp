@@ -178,6 +178,17 @@ wxPoint GERBER_DRAW_ITEM::GetABPosition( const wxPoint& aXYPosition ) const
 }
 
 
+void GERBER_DRAW_ITEM::GetABTransformParams( std::vector<double>& aParams ) const
+{
+    aParams.push_back( m_swapAxis );
+    aParams.push_back( m_drawScale.x );
+    aParams.push_back( m_drawScale.y );
+    aParams.push_back( m_lyrRotation + m_GerberImageFile->m_ImageRotation );
+    aParams.push_back( m_mirrorA );
+    aParams.push_back( m_mirrorB );
+}
+
+
 wxPoint GERBER_DRAW_ITEM::GetXYPosition( const wxPoint& aABPosition ) const
 {
     // do the inverse transform made by GetABPosition
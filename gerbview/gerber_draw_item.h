@@ -212,6 +212,15 @@ public:
         return VECTOR2I( GetABPosition( wxPoint( aXYPosition.x, aXYPosition.y ) ) );
     }
 
+    /**
+     * Function GetABTransformParams
+     * appends the parameters of the transform made by GetABPosition(), but the offsets:
+     * axis selection, scale, rotation and mirroring.  Two items having the same parameters
+     * have shapes that differ only by a translation.
+     * @param aParams is the buffer to append the parameters to.
+     */
+    void GetABTransformParams( std::vector<double>& aParams ) const;
+
     /**
      * Function GetXYPosition
      * returns the image position of aPosition for this object.
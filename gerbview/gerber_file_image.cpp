@@ -45,6 +45,9 @@
  */
 extern int scaletoIU( double aCoord, bool isMetric );       // defined it rs274d_read_XY_and_IJ_coordiantes.cpp
 
+// Count of GERBER_DRAW_ITEMs allocated at once by GERBER_FILE_IMAGE::NewDrawItem()
+static const size_t DRAW_ITEM_BLOCK_SIZE = 512;
+
 /* Format Gerber: NOTES:
  * Tools and D_CODES
  *   tool number (identification of shapes)
@@ -95,6 +98,7 @@ GERBER_FILE_IMAGE::GERBER_FILE_IMAGE( int aLayer ) :
 
     m_Selected_Tool = 0;
     m_FileFunction = NULL;          // file function parameters
+    m_itemBlockUsed = 0;
 
     ResetDefaultValues();
 
@@ -105,10 +109,16 @@ GERBER_FILE_IMAGE::GERBER_FILE_IMAGE( int aLayer ) :
 
 GERBER_FILE_IMAGE::~GERBER_FILE_IMAGE()
 {
+    // Items are created in the blocks by placement new: all the blocks but the last one are full
+    for( size_t ii = 0; ii < m_itemBlocks.size(); ii++ )
+    {
+        size_t count = ii + 1 < m_itemBlocks.size() ? DRAW_ITEM_BLOCK_SIZE : m_itemBlockUsed;
 
-    for( auto item : GetItems() )
-        delete item;
+        for( size_t jj = 0; jj < count; jj++ )
+            reinterpret_cast<GERBER_DRAW_ITEM*>( &m_itemBlocks[ii][jj] )->~GERBER_DRAW_ITEM();
+    }
 
+    m_itemBlocks.clear();
     m_drawings.clear();
 
     for( unsigned ii = 0; ii < arrayDim( m_Aperture_List ); ii++ )
@@ -225,6 +235,10 @@ void GERBER_FILE_IMAGE::ResetDefaultValues()
     m_Selected_Tool = 0;
     m_Last_Pen_Command = 0;
     m_Exposure = false;
+
+    // Shapes cached for the items of the previous image are not reused
+    for( const APERTURE_MACRO& macro : m_aperture_macros )
+        const_cast<APERTURE_MACRO&>( macro ).ClearShapeCache();
 }
 
 
@@ -286,6 +300,30 @@ void GERBER_FILE_IMAGE::InitToolTable()
 }
 
 
+void* GERBER_FILE_IMAGE::allocDrawItem()
+{
+    if( m_itemBlocks.empty() || m_itemBlockUsed == DRAW_ITEM_BLOCK_SIZE )
+    {
+        m_itemBlocks.emplace_back( new DRAW_ITEM_STORAGE[DRAW_ITEM_BLOCK_SIZE] );
+        m_itemBlockUsed = 0;
+    }
+
+    return &m_itemBlocks.back()[m_itemBlockUsed++];
+}
+
+
+GERBER_DRAW_ITEM* GERBER_FILE_IMAGE::NewDrawItem()
+{
+    return new( allocDrawItem() ) GERBER_DRAW_ITEM( this );
+}
+
+
+GERBER_DRAW_ITEM* GERBER_FILE_IMAGE::NewDrawItem( const GERBER_DRAW_ITEM& aSource )
+{
+    return new( allocDrawItem() ) GERBER_DRAW_ITEM( aSource );
+}
+
+
 /**
  * Function StepAndRepeatItem
  * Gerber format has a command Step an Repeat
@@ -310,7 +348,7 @@ void GERBER_FILE_IMAGE::StepAndRepeatItem( const GERBER_DRAW_ITEM& aItem )
             if( jj == 0 && ii == 0 )
                 continue;
 
-            GERBER_DRAW_ITEM* dupItem = new GERBER_DRAW_ITEM( aItem );
+            GERBER_DRAW_ITEM* dupItem = NewDrawItem( aItem );
             wxPoint           move_vector;
             move_vector.x = scaletoIU( ii * GetLayerParams().m_StepForRepeat.x,
                                    GetLayerParams().m_StepForRepeatMetric );
@@ -25,8 +25,10 @@
 #ifndef GERBER_FILE_IMAGE_H
 #define GERBER_FILE_IMAGE_H
 
+#include <memory>
 #include <vector>
 #include <set>
+#include <type_traits>
 
 #include <dcode.h>
 #include <gerber_draw_item.h>
@@ -191,6 +193,17 @@ private:
                                                                 // -1 = negative items are
                                                                 // 0 = no negative items found
                                                                 // 1 = have negative items found
+
+    /// Raw storage of a GERBER_DRAW_ITEM created by NewDrawItem()
+    typedef std::aligned_storage<sizeof( GERBER_DRAW_ITEM ), alignof( GERBER_DRAW_ITEM )>::type
+            DRAW_ITEM_STORAGE;
+
+    std::vector<std::unique_ptr<DRAW_ITEM_STORAGE[]>> m_itemBlocks; ///< Blocks of GERBER_DRAW_ITEMs
+    size_t             m_itemBlockUsed;                         // Count of items created in the last block
+
+    /// Returns the storage of a new GERBER_DRAW_ITEM, allocating a new block if needed
+    void* allocDrawItem();
+
     /**
      * test for an end of line
      * if a end of line is found:
@@ -283,6 +296,19 @@ public:
      */
     int GetItemsCount() { return m_drawings.size(); }
 
+    /**
+     * Function NewDrawItem
+     * creates a new GERBER_DRAW_ITEM belonging to this image.  Items are allocated by blocks
+     * and are deleted with the image, so they must not be deleted by the caller.
+     */
+    GERBER_DRAW_ITEM* NewDrawItem();
+
+    /**
+     * Function NewDrawItem
+     * creates a copy of a GERBER_DRAW_ITEM, belonging to this image.
+     */
+    GERBER_DRAW_ITEM* NewDrawItem( const GERBER_DRAW_ITEM& aSource );
+
     /**
      * Add a new GERBER_DRAW_ITEM item to the drawings list
      * @param aItem is the GERBER_DRAW_ITEM to add to list
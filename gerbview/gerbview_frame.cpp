@@ -544,6 +544,17 @@ void GERBVIEW_FRAME::Liste_D_Codes()
             if( pt_D_code->m_InUse )
                 Line += wxT( " (in use)" );
 
+            APERTURE_MACRO* macro = pt_D_code->GetMacro();
+
+            if( macro )
+            {
+                Line += wxString::Format( wxT( "  macro '%s': %u cached shapes, %u hits, %u misses" ),
+                                          GetChars( macro->name ),
+                                          (unsigned) macro->m_shapeCache.size(),
+                                          macro->m_shapeCacheHits,
+                                          macro->m_shapeCacheMisses );
+            }
+
             list.Add( Line );
             jj++;
         }
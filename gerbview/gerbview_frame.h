@@ -40,6 +40,7 @@ class DCODE_SELECTION_BOX;
 class GERBER_LAYER_WIDGET;
 class GBR_LAYER_BOX_SELECTOR;
 class GERBER_DRAW_ITEM;
+class EXCELLON_IMAGE;
 class GERBER_FILE_IMAGE;
 class GERBER_FILE_IMAGE_LIST;
 class REPORTER;
@@ -210,6 +211,22 @@ private:
                                         const wxArrayString& aFilenameList,
                                         const std::vector<int>* aFileType = nullptr );
 
+    /**
+     * Puts a loaded Gerber image on the active layer, replacing the previous one, and adds
+     * its items to the view.
+     * @param aGerber is the image, owned by the images list on return.
+     * @return true if the image was added.
+     */
+    bool addGerberImage( GERBER_FILE_IMAGE* aGerber );
+
+    /**
+     * Puts a loaded NC drill image on the active layer, replacing the previous one, and adds
+     * its items to the view.
+     * @param aDrillLayer is the image, owned by the images list on return (deleted on error).
+     * @return true if the image was added.
+     */
+    bool addExcellonImage( EXCELLON_IMAGE* aDrillLayer );
+
 public:
     GERBVIEW_FRAME( KIWAY* aKiway, wxWindow* aParent );
     ~GERBVIEW_FRAME();
@@ -41,16 +41,7 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
 {
     wxString msg;
 
-    int layer = GetActiveLayer();
-    GERBER_FILE_IMAGE_LIST* images = GetImagesList();
-    GERBER_FILE_IMAGE* gerber = GetGbrImage( layer );
-
-    if( gerber != NULL )
-    {
-        Erase_Current_DrawLayer( false );
-    }
-
-    gerber = new GERBER_FILE_IMAGE( layer );
+    GERBER_FILE_IMAGE* gerber = new GERBER_FILE_IMAGE( GetActiveLayer() );
 
     // Read the gerber file. The image will be added only if it can be read
     // to avoid broken data.
@@ -64,6 +55,23 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
         return false;
     }
 
+    return addGerberImage( gerber );
+}
+
+
+bool GERBVIEW_FRAME::addGerberImage( GERBER_FILE_IMAGE* gerber )
+{
+    wxString msg;
+
+    int layer = GetActiveLayer();
+    GERBER_FILE_IMAGE_LIST* images = GetImagesList();
+
+    if( GetGbrImage( layer ) != NULL )
+    {
+        Erase_Current_DrawLayer( false );
+    }
+
+    gerber->m_GraphicLayer = layer;
     images->AddGbrImage( gerber, layer );
 
     // Display errors list
@@ -111,8 +119,10 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
 // size of a single line of text from a gerber file.
 // warning: some files can have *very long* lines, so the buffer must be large.
 #define GERBER_BUFZ 1000000
-// A large buffer to store one line
-static char lineBuffer[GERBER_BUFZ+1];
+
+// size of the stdio buffer of the gerber file: the file is read by large blocks,
+// and lines are then extracted from this buffer
+#define GERBER_FILE_BUFZ ( 4 * 1024 * 1024 )
 
 bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 {
@@ -120,6 +130,11 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
     int      D_commande = 0;       // command number for D commands like D02
     char*    text;
 
+    // A large buffer to store one line.  It is not static, because several files
+    // can be loaded at the same time
+    std::vector<char> buffer( GERBER_BUFZ + 1 );
+    char*    lineBuffer = buffer.data();
+
     ClearMessageList( );
     ResetDefaultValues();
 
@@ -129,6 +144,8 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
     if( m_Current_File == 0 )
         return false;
 
+    setvbuf( m_Current_File, NULL, _IOFBF, GERBER_FILE_BUFZ );
+
     m_FileName = aFullFileName;
 
     LOCALE_IO toggleIo;
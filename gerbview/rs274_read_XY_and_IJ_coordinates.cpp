@@ -29,6 +29,9 @@
 #include <gerber_file_image.h>
 #include <base_units.h>
 
+#include <algorithm>
+#include <cstring>
+
 
 /* These routines read the text string point from Text.
  * On exit, Text points the beginning of the sequence unread
@@ -70,14 +73,78 @@ int scaletoIU( double aCoord, bool isMetric )
 }
 
 
+/**
+ * Function readCoordValue
+ * reads the number following a coordinate letter and converts it to internal units.
+ * Digits are accumulated while the text is scanned, without copying them.
+ * @param aText points the first char of the number, and on return the first char after it
+ * @param aIsFloat is set to true if the number has a decimal point
+ * @param aMetric = true if the number is given in mm, false if in inches
+ * @param aFmtScale is the count of decimals of numbers without decimal point
+ * @param aDigitCount is the count of digits of numbers when trailing zeros are omitted,
+ * or -1 if they are not omitted
+ * @param aTruncate = true to ignore digits after the aDigitCount first ones
+ */
+static int readCoordValue( char*& aText, bool& aIsFloat, bool aMetric, int aFmtScale,
+                           int aDigitCount, bool aTruncate )
+{
+    char*     start = aText;
+    long long value = 0;
+    int       nbdigits = 0;     // (sign and decimal point are not counted)
+    bool      negative = false;
+
+    while( IsNumber( *aText ) )
+    {
+        if( *aText == '.' )     // Force decimal format if reading a floating point number
+            aIsFloat = true;
+        else if( *aText == '-' )
+            negative = true;
+        else if( *aText != '+' && ( !aTruncate || nbdigits < aDigitCount ) )
+        {
+            value = value * 10 + ( *aText - '0' );
+            nbdigits++;
+        }
+
+        aText++;
+    }
+
+    if( aIsFloat )
+    {
+        // When coordinates are float numbers, they are given in mm or inches
+        char line[256];
+        int  len = std::min<int>( aText - start, sizeof( line ) - 1 );
+
+        memcpy( line, start, len );
+        line[len] = 0;
+
+        if( aMetric )   // units are mm
+            return KiROUND( atof( line ) * IU_PER_MILS / 0.0254 );
+        else            // units are inches
+            return KiROUND( atof( line ) * IU_PER_MILS * 1000 );
+    }
+
+    // no trailing zero format, we need to add missing zeros.
+    while( nbdigits < aDigitCount )
+    {
+        value *= 10;
+        nbdigits++;
+    }
+
+    int    coord = (int) ( negative ? -value : value );
+    double real_scale = scale_list[aFmtScale];
+
+    if( aMetric )
+        real_scale = real_scale / 25.4;
+
+    return KiROUND( coord * real_scale );
+}
+
+
 wxPoint GERBER_FILE_IMAGE::ReadXYCoord( char*& Text, bool aExcellonMode )
 {
     wxPoint pos;
-    int     type_coord = 0, current_coord, nbdigits;
+    int     type_coord = 0, current_coord;
     bool    is_float   = false;
-    char*   text;
-    char    line[256];
-
 
     if( m_Relative )
         pos.x = pos.y = 0;
@@ -87,75 +154,23 @@ wxPoint GERBER_FILE_IMAGE::ReadXYCoord( char*& Text, bool aExcellonMode )
     if( Text == NULL )
         return pos;
 
-    text = line;
     while( *Text )
     {
         if( (*Text == 'X') || (*Text == 'Y') || (*Text == 'A') )
         {
             type_coord = *Text;
             Text++;
-            text     = line;
-            nbdigits = 0;
 
-            while( IsNumber( *Text ) )
-            {
-                if( *Text == '.' )  // Force decimat format if reading a floating point number
-                    is_float = true;
+            int fmt_scale = (type_coord == 'X') ? m_FmtScale.x : m_FmtScale.y;
+            int digit_count = -1;
 
-                // count digits only (sign and decimal point are not counted)
-                if( (*Text >= '0') && (*Text <='9') )
-                    nbdigits++;
-                *(text++) = *(Text++);
-            }
+            if( m_NoTrailingZeros )
+                digit_count = (type_coord == 'X') ? m_FmtLen.x : m_FmtLen.y;
 
-            *text = 0;
-
-            if( is_float )
-            {
-                // When X or Y (or A) values are float numbers, they are given in mm or inches
-                if( m_GerbMetric )  // units are mm
-                    current_coord = KiROUND( atof( line ) * IU_PER_MILS / 0.0254 );
-                else    // units are inches
-                    current_coord = KiROUND( atof( line ) * IU_PER_MILS * 1000 );
-            }
-            else
-            {
-                int fmt_scale = (type_coord == 'X') ? m_FmtScale.x : m_FmtScale.y;
-
-                if( m_NoTrailingZeros )
-                {
-                    // no trailing zero format, we need to add missing zeros.
-                    int digit_count = (type_coord == 'X') ? m_FmtLen.x : m_FmtLen.y;
-
-                    while( nbdigits < digit_count )
-                    {
-                        *(text++) = '0';
-                        nbdigits++;
-                    }
-
-                    if( aExcellonMode )
-                    {
-                        // Truncate the extra digits if the len is more than expected
-                        // because the conversion to internal units expect exactly
-                        // digit_count digits
-                        while( nbdigits > digit_count )
-                        {
-                            *(text--) = 0;
-                            nbdigits--;
-                        }
-                    }
-
-                    *text = 0;
-                }
-
-                current_coord = atoi( line );
-                double real_scale = scale_list[fmt_scale];
-
-                if( m_GerbMetric )
-                    real_scale = real_scale / 25.4;
-
-                current_coord = KiROUND( current_coord * real_scale );
-            }
+            // In Excellon files, truncate the extra digits if the len is more than expected
+            // because the conversion to internal units expect exactly digit_count digits
+            current_coord = readCoordValue( Text, is_float, m_GerbMetric, fmt_scale,
+                                            digit_count, m_NoTrailingZeros && aExcellonMode );
 
             if( type_coord == 'X' )
                 pos.x = current_coord;
@@ -192,71 +207,28 @@ wxPoint GERBER_FILE_IMAGE::ReadIJCoord( char*& Text )
 {
     wxPoint pos( 0, 0 );
 
-    int     type_coord = 0, current_coord, nbdigits;
+    int     type_coord = 0, current_coord;
     bool    is_float   = false;
-    char*   text;
-    char    line[256];
 
     if( Text == NULL )
         return pos;
 
-    text = line;
     while( *Text )
     {
         if( (*Text == 'I') || (*Text == 'J') )
         {
             type_coord = *Text;
             Text++;
-            text     = line;
-            nbdigits = 0;
-            while( IsNumber( *Text ) )
-            {
-                if( *Text == '.' )
-                    is_float = true;
 
-                // count digits only (sign and decimal point are not counted)
-                if( (*Text >= '0') && (*Text <='9') )
-                    nbdigits++;
+            int fmt_scale = (type_coord == 'I') ? m_FmtScale.x : m_FmtScale.y;
+            int digit_count = -1;
 
-                *(text++) = *(Text++);
-            }
-
-            *text = 0;
-            if( is_float )
-            {
-                // When X or Y values are float numbers, they are given in mm or inches
-                if( m_GerbMetric )  // units are mm
-                    current_coord = KiROUND( atof( line ) * IU_PER_MILS / 0.0254 );
-                else    // units are inches
-                    current_coord = KiROUND( atof( line ) * IU_PER_MILS * 1000 );
-            }
-            else
-            {
-                int fmt_scale =
-                    (type_coord == 'I') ? m_FmtScale.x : m_FmtScale.y;
+            if( m_NoTrailingZeros )
+                digit_count = (type_coord == 'I') ? m_FmtLen.x : m_FmtLen.y;
 
-                if( m_NoTrailingZeros )
-                {
-                    int min_digit =
-                        (type_coord == 'I') ? m_FmtLen.x : m_FmtLen.y;
-                    while( nbdigits < min_digit )
-                    {
-                        *(text++) = '0';
-                        nbdigits++;
-                    }
+            current_coord = readCoordValue( Text, is_float, m_GerbMetric, fmt_scale,
+                                            digit_count, false );
 
-                    *text = 0;
-                }
-
-                current_coord = atoi( line );
-
-                double real_scale = scale_list[fmt_scale];
-
-                if( m_GerbMetric )
-                    real_scale = real_scale / 25.4;
-
-                current_coord = KiROUND( current_coord * real_scale );
-            }
             if( type_coord == 'I' )
                 pos.x = current_coord;
             else if( type_coord == 'J' )
@@ -77,6 +77,16 @@ public:
     /// @copydoc COMPOSITOR::Present()
     virtual void Present() override;
 
+    /**
+     * Function DrawTile()
+     * paints a tile rendered on its own surface over the current buffer.
+     *
+     * @param aSurface is the surface the tile was rendered on.
+     * @param aX is the horizontal position of the tile in the buffer, in pixels.
+     * @param aY is the vertical position of the tile in the buffer, in pixels.
+     */
+    void DrawTile( cairo_surface_t* aSurface, int aX, int aY );
+
     void SetAntialiasingMode( CAIRO_ANTIALIASING_MODE aMode ); // clears all buffers
     CAIRO_ANTIALIASING_MODE GetAntialiasingMode() const
     {
@@ -54,6 +54,7 @@
 namespace KIGFX
 {
 class CAIRO_COMPOSITOR;
+class CAIRO_TILE_GAL;
 
 class CAIRO_GAL_BASE : public GAL
 {
@@ -291,6 +292,7 @@ protected:
     std::map<int, GROUP>        groups;             ///< List of graphic groups
     unsigned int                groupCounter;       ///< Counter used for generating keys for groups
     GROUP*                      currentGroup;       ///< Currently used group
+    CAIRO_GAL_BASE*             groupOwner;         ///< GAL storing the groups to draw
 
     double lineWidth;
     double linePixelWidth;
@@ -383,6 +385,28 @@ public:
 
     virtual void ClearTarget( RENDER_TARGET aTarget ) override;
 
+    /**
+     * Function SetTiledRendering
+     * turns on or off rendering the screen as tiles drawn in parallel (see BeginTiles()).
+     * It is on by default on machines with several cores.
+     */
+    void SetTiledRendering( bool aEnabled )
+    {
+        tiledRendering = aEnabled;
+    }
+
+    ///> @copydoc GAL::BeginTiles()
+    virtual int BeginTiles() override;
+
+    ///> @copydoc GAL::GetTile()
+    virtual GAL* GetTile( int aIndex ) override;
+
+    ///> @copydoc GAL::GetTileRect()
+    virtual BOX2I GetTileRect( int aIndex ) const override;
+
+    ///> @copydoc GAL::EndTiles()
+    virtual void EndTiles() override;
+
     /**
      * Function PostPaint
      * posts an event to m_paint_listener.  A post is used so that the actual drawing
@@ -415,6 +439,11 @@ protected:
     RENDER_TARGET           currentTarget;          ///< Current rendering target
     bool                    validCompositor;        ///< Compositor initialization flag
 
+    // Tiled rendering related variables
+    bool                    tiledRendering;         ///< Are tiles drawn in parallel
+    int                     tileCount;              ///< Number of tiles of the current frame
+    std::vector<std::unique_ptr<CAIRO_TILE_GAL>> tiles; ///< Tiles, kept between frames
+
     // Variables related to wxWidgets
     wxWindow*               parentWindow;           ///< Parent window
     wxEvtHandler*           mouseListener;          ///< Mouse listener
@@ -0,0 +1,92 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef CAIRO_TILE_GAL_H_
+#define CAIRO_TILE_GAL_H_
+
+#include <gal/cairo/cairo_gal.h>
+
+namespace KIGFX
+{
+
+/**
+ * Class CAIRO_TILE_GAL
+ * renders a rectangular part of the screen of another Cairo GAL on its own image surface.
+ *
+ * Tiles of the same GAL can be rendered by different threads at once, then composited by
+ * CAIRO_COMPOSITOR::DrawTile().  The groups cached by the parent GAL are drawn by the tiles
+ * with DrawGroup().  Without a parent, the tile renders a part of its own screen, so it can
+ * be used as a headless GAL as well.
+ */
+class CAIRO_TILE_GAL : public CAIRO_GAL_BASE
+{
+public:
+    /**
+     * @param aDisplayOptions are the display options of the tile.
+     * @param aParent is the GAL whose screen is split in tiles, or nullptr.
+     */
+    CAIRO_TILE_GAL( GAL_DISPLAY_OPTIONS& aDisplayOptions, CAIRO_GAL_BASE* aParent = nullptr );
+
+    /**
+     * Function BeginTile()
+     * prepares the tile for rendering a part of the screen: copies the view parameters of the
+     * parent GAL and clears the tile surface.
+     *
+     * @param aRect is the part of the screen to render, in screen coordinates.
+     * @param aAntialias is the antialiasing mode to use.
+     */
+    void BeginTile( const BOX2I& aRect, cairo_antialias_t aAntialias );
+
+    /**
+     * Function EndTile()
+     * finishes the rendering of the tile, so its surface can be composited.
+     */
+    void EndTile();
+
+    /// Returns the surface the tile is rendered on
+    cairo_surface_t* GetSurface() const
+    {
+        return surface;
+    }
+
+    /// Returns the part of the screen rendered by the tile
+    const BOX2I& GetRect() const
+    {
+        return m_rect;
+    }
+
+    ///> @copydoc GAL::ClearScreen()
+    void ClearScreen() override;
+
+    ///> @copydoc GAL::DrawGroup()
+    void DrawGroup( int aGroupNumber ) override;
+
+private:
+    CAIRO_GAL_BASE* m_parent;       ///< GAL whose screen is split in tiles
+    BOX2I           m_rect;         ///< Part of the screen rendered by the tile
+    int             m_groupDepth;   ///< Depth of nested DrawGroup() calls
+};
+
+} // namespace KIGFX
+
+#endif /* CAIRO_TILE_GAL_H_ */
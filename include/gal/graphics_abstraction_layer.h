@@ -31,6 +31,7 @@
 #include <stack>
 #include <limits>
 
+#include <math/box2.h>
 #include <math/matrix3x3.h>
 
 #include <gal/color4d.h>
@@ -609,6 +610,14 @@ public:
     /// @brief Compute the world <-> screen transformation matrix
     virtual void ComputeWorldScreenMatrix();
 
+    /**
+     * @brief Copy the view parameters of another GAL: screen size, world scale, look at
+     * point, rotation, flipping, depth range and the world <-> screen matrices.
+     *
+     * @param aGal is the GAL to copy the parameters from.
+     */
+    void CopyViewParameters( const GAL& aGal );
+
     /**
      * @brief Get the world <-> screen transformation matrix.
      *
@@ -838,6 +847,43 @@ public:
      */
     virtual void SetNegativeDrawMode( bool aSetting ) {};
 
+    // ---------------
+    // Tiled rendering
+    // ---------------
+
+    /**
+     * @brief Prepare the tiles the screen is split in, if the GAL renders them in parallel.
+     *
+     * Each tile is a GAL with the view parameters of this one, drawing the part of the screen
+     * returned by GetTileRect().  Different tiles may be drawn at the same time by different
+     * threads.  Items cached by this GAL can be drawn on the tiles with DrawGroup().  Calling
+     * it again before EndTiles() drops what was drawn on the tiles.
+     *
+     * @return the number of tiles, 0 if the GAL does not render tiles.
+     */
+    virtual int BeginTiles() { return 0; };
+
+    /**
+     * @brief Get a tile prepared by BeginTiles().
+     *
+     * @param aIndex is the index of the tile.
+     * @return the GAL drawing the tile.
+     */
+    virtual GAL* GetTile( int aIndex ) { return nullptr; };
+
+    /**
+     * @brief Get the part of the screen drawn by a tile.
+     *
+     * @param aIndex is the index of the tile.
+     * @return the tile rectangle, in screen coordinates.
+     */
+    virtual BOX2I GetTileRect( int aIndex ) const { return BOX2I(); };
+
+    /**
+     * @brief Composite the tiles drawn since BeginTiles() on the current target.
+     */
+    virtual void EndTiles() {};
+
     // -------------
     // Grid methods
     // -------------
@@ -28,6 +28,7 @@
 #include <gal/opengl/vertex_container.h>
 #include <map>
 #include <set>
+#include <vector>
 
 namespace KIGFX
 {
@@ -132,6 +133,13 @@ protected:
      */
     void defragment( VERTEX* aTarget );
 
+    /**
+     * Returns the stored items sorted by their offset.  Defragmentation keeps this order, so
+     * items cached one after another stay contiguous and are drawn as a single range (see
+     * GPU_CACHED_MANAGER::DrawIndices()).
+     */
+    std::vector<VERTEX_ITEM*> itemsByOffset() const;
+
     /**
      * Looks for consecutive free memory chunks and merges them, decreasing fragmentation of
      * memory.
@@ -27,6 +27,7 @@
 
 #include <gal/opengl/vertex_common.h>
 #include <boost/scoped_array.hpp>
+#include <vector>
 
 namespace KIGFX
 {
@@ -133,6 +134,9 @@ protected:
     ///> Resizes the indices buffer to aNewSize if necessary
     void resizeIndices( unsigned int aNewSize );
 
+    ///> Uploads the indices of the ranges to draw, unless they were uploaded by the last frame
+    void uploadIndices();
+
     ///> Buffers initialization flag
     bool m_buffersInitialized;
 
@@ -150,6 +154,17 @@ protected:
 
     ///> Current indices buffer size
     unsigned int m_indicesCapacity;
+
+    ///> Ranges of vertices to be drawn, consecutive ranges are merged
+    std::vector<GLint>   m_rangeOffsets;
+    std::vector<GLsizei> m_rangeSizes;
+
+    ///> Ranges whose indices are stored in the indices buffer
+    std::vector<GLint>   m_uploadedOffsets;
+    std::vector<GLsizei> m_uploadedSizes;
+
+    ///> Number of DrawIndices() calls since BeginDrawing()
+    unsigned int m_itemCount;
 };
 
 
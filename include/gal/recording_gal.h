@@ -0,0 +1,210 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef RECORDING_GAL_H_
+#define RECORDING_GAL_H_
+
+#include <gal/graphics_abstraction_layer.h>
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <deque>
+#include <vector>
+
+namespace KIGFX
+{
+
+/**
+ * Class RECORDING_GAL
+ * records drawing commands instead of executing them, so they can be replayed later on
+ * another GAL.
+ *
+ * It lets painters run in several threads at once, each of them drawing on its own
+ * RECORDING_GAL, while the cached groups of the real GAL are built in a single pass on the
+ * thread that owns its context (see VIEW::SetParallelCaching()).  Texts drawn with
+ * StrokeText() are recorded as the polylines of their glyphs, so their layout is done by
+ * the recording threads too.
+ */
+class RECORDING_GAL : public GAL
+{
+public:
+    /**
+     * @param aDisplayOptions are the display options of the target GAL.
+     * @param aTarget is the GAL the commands are going to be replayed on.  Its view parameters
+     * and engine type are reported to the painters.
+     */
+    RECORDING_GAL( GAL_DISPLAY_OPTIONS& aDisplayOptions, GAL* aTarget );
+
+    bool IsOpenGlEngine() override { return m_isOpenGl; }
+
+    bool IsCairoEngine() override { return m_isCairo; }
+
+    /**
+     * Function Clear()
+     * removes all the recorded commands.
+     */
+    void Clear();
+
+    /**
+     * Function GetCommandCount()
+     * @return the number of recorded commands, to be used as a bound for Replay().
+     */
+    size_t GetCommandCount() const
+    {
+        return m_commands.size();
+    }
+
+    /**
+     * Function BeginRecording()
+     * prepares the recording of a new item: sets the layer depth and records the current
+     * drawing state, so the item is replayed the same way whatever was replayed before it.
+     *
+     * @param aLayerDepth is the depth of the layer the item is drawn on.
+     */
+    void BeginRecording( double aLayerDepth );
+
+    /**
+     * Function Replay()
+     * executes a range of recorded commands on a GAL.
+     *
+     * @param aGal is the GAL executing the commands.
+     * @param aBegin is the first command to execute.
+     * @param aEnd is the command following the last one to execute.
+     */
+    void Replay( GAL* aGal, size_t aBegin, size_t aEnd ) const;
+
+    // Drawing methods
+    void DrawLine( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint ) override;
+
+    void DrawSegment( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint,
+                      double aWidth ) override;
+
+    void DrawPolyline( const std::deque<VECTOR2D>& aPointList ) override;
+    void DrawPolyline( const VECTOR2D aPointList[], int aListSize ) override;
+    void DrawPolyline( const SHAPE_LINE_CHAIN& aLineChain ) override;
+
+    void DrawCircle( const VECTOR2D& aCenterPoint, double aRadius ) override;
+
+    void DrawArc( const VECTOR2D& aCenterPoint, double aRadius, double aStartAngle,
+                  double aEndAngle ) override;
+
+    void DrawArcSegment( const VECTOR2D& aCenterPoint, double aRadius, double aStartAngle,
+                         double aEndAngle, double aWidth ) override;
+
+    void DrawRectangle( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint ) override;
+
+    void DrawPolygon( const std::deque<VECTOR2D>& aPointList ) override;
+    void DrawPolygon( const VECTOR2D aPointList[], int aListSize ) override;
+    void DrawPolygon( const SHAPE_POLY_SET& aPolySet ) override;
+    void DrawPolygon( const SHAPE_LINE_CHAIN& aPolySet ) override;
+
+    void DrawCurve( const VECTOR2D& aStartPoint, const VECTOR2D& aControlPointA,
+                    const VECTOR2D& aControlPointB, const VECTOR2D& aEndPoint,
+                    double aFilterValue = 0.0 ) override;
+
+    void DrawBitmap( const BITMAP_BASE& aBitmap ) override;
+
+    void BitmapText( const wxString& aText, const VECTOR2D& aPosition,
+                     double aRotationAngle ) override;
+
+    // Attribute setting methods
+    void SetIsFill( bool aIsFillEnabled ) override;
+    void SetIsStroke( bool aIsStrokeEnabled ) override;
+    void SetFillColor( const COLOR4D& aColor ) override;
+    void SetStrokeColor( const COLOR4D& aColor ) override;
+    void SetLineWidth( float aLineWidth ) override;
+    void SetLayerDepth( double aLayerDepth ) override;
+    void SetNegativeDrawMode( bool aSetting ) override;
+
+    // Transformation methods
+    void Transform( const MATRIX3x3D& aTransformation ) override;
+    void Rotate( double aAngle ) override;
+    void Translate( const VECTOR2D& aTranslation ) override;
+    void Scale( const VECTOR2D& aScale ) override;
+    void Save() override;
+    void Restore() override;
+
+private:
+    enum COMMAND_TYPE
+    {
+        CMD_LINE,
+        CMD_SEGMENT,
+        CMD_POLYLINE,
+        CMD_POLYLINE_CHAIN,
+        CMD_CIRCLE,
+        CMD_ARC,
+        CMD_ARC_SEGMENT,
+        CMD_RECTANGLE,
+        CMD_POLYGON,
+        CMD_POLYGON_SET,
+        CMD_POLYGON_CHAIN,
+        CMD_CURVE,
+        CMD_BITMAP,
+        CMD_BITMAP_TEXT,
+        CMD_IS_FILL,
+        CMD_IS_STROKE,
+        CMD_FILL_COLOR,
+        CMD_STROKE_COLOR,
+        CMD_LINE_WIDTH,
+        CMD_LAYER_DEPTH,
+        CMD_NEGATIVE_DRAW_MODE,
+        CMD_TRANSFORM,
+        CMD_ROTATE,
+        CMD_TRANSLATE,
+        CMD_SCALE,
+        CMD_SAVE,
+        CMD_RESTORE
+    };
+
+    struct COMMAND
+    {
+        COMMAND_TYPE m_type;
+        VECTOR2D     m_points[2];
+        double       m_values[4];       ///< radius, angles, width, color components...
+        size_t       m_index;           ///< index of the command data in the storage below
+        size_t       m_count;           ///< number of points stored in m_pointLists
+    };
+
+    COMMAND& addCommand( COMMAND_TYPE aType );
+
+    void addColor( COMMAND_TYPE aType, const COLOR4D& aColor );
+
+    ///> Stores a list of points in m_pointLists and records a command drawing it
+    template <typename T>
+    void addPoints( COMMAND_TYPE aType, const T& aPoints, size_t aCount );
+
+    std::vector<COMMAND>            m_commands;
+    std::vector<VECTOR2D>           m_pointLists;
+    std::deque<SHAPE_LINE_CHAIN>    m_lineChains;
+    std::deque<SHAPE_POLY_SET>      m_polySets;
+    std::vector<MATRIX3x3D>         m_matrices;
+    std::vector<wxString>           m_texts;
+    std::vector<const BITMAP_BASE*> m_bitmaps;
+
+    bool m_isOpenGl;
+    bool m_isCairo;
+};
+
+} // namespace KIGFX
+
+#endif /* RECORDING_GAL_H_ */
@@ -89,10 +89,11 @@ public:
     /**
      * Compute the boundary limits of aText (the bounding box of all shapes).
      * The overbar and alignment are not taken in account, '~' characters are skipped.
+     * @param aItalic adds the italic tilt to the width.
      * @return a VECTOR2D giving the width and height of text.
      */
     VECTOR2D ComputeStringBoundaryLimits( const UTF8& aText, const VECTOR2D& aGlyphSize,
-                                          double aGlyphThickness ) const;
+                                          double aGlyphThickness, bool aItalic = false ) const;
 
     /**
      * Compute the vertical position of an overbar, sometimes used in texts.
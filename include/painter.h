@@ -37,6 +37,7 @@
 
 class EDA_ITEM;
 class COLOR_SETTINGS;
+class SHAPE_POLY_SET;
 
 namespace KIGFX
 {
@@ -104,6 +105,37 @@ public:
      */
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) = 0;
 
+    /**
+     * Function Clone
+     * Creates a painter of the same type, with the same settings, drawing on another GAL.
+     * Painters whose Draw() can be called for different items from several threads at once
+     * return the new painter, so VIEW can cache items in parallel (see
+     * VIEW::SetParallelCaching()).
+     * @param aGal is the GAL the new painter draws on.
+     * @return the new painter, owned by the caller, or nullptr if items cannot be drawn
+     * concurrently.
+     */
+    virtual PAINTER* Clone( GAL* aGal )
+    {
+        return nullptr;
+    }
+
+    /**
+     * Function GetLODProxy
+     * Returns the outline of an item on a layer, drawn merged with the outlines of other items
+     * when the view is zoomed out (see VIEW::SetLayerLODProxy()).  The outline is filled with
+     * the color of the layer, so items drawn differently (eg. highlighted or outlined) are not
+     * merged.  The function is called from several threads at once.
+     * @param aItem is the item.
+     * @param aLayer is the layer.
+     * @param aOutlines receives the outline of the item.
+     * @return false if the item has to be drawn by itself.
+     */
+    virtual bool GetLODProxy( const VIEW_ITEM* aItem, int aLayer, SHAPE_POLY_SET& aOutlines ) const
+    {
+        return false;
+    }
+
 protected:
     /// Instance of graphic abstraction layer that gives an interface to call
     /// commands used to draw (eg. DrawLine, DrawCircle, etc.)
@@ -0,0 +1,127 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file plot_output_buffer.h
+ */
+
+#ifndef PLOT_OUTPUT_BUFFER_H_
+#define PLOT_OUTPUT_BUFFER_H_
+
+#include <cstddef>
+#include <cstdio>
+
+
+/**
+ * Class PLOT_OUTPUT_BUFFER
+ * formats the coordinates written by the plotters in a buffer, written to the plot file when
+ * full or flushed (at the latest by the destructor).
+ *
+ * Numbers are formatted without printf, so always with a '.' decimal separator whatever the
+ * locale is.  Int() gives the same text as "%d", Fixed() the same text as "%.<n>f" (but for
+ * the rounding of exact halves), and Significant() the same text as "%g" in the range where
+ * "%g" does not use an exponent.
+ *
+ * Writing directly to the plot file while a buffer holds text would mix the output: flush it
+ * first.
+ */
+class PLOT_OUTPUT_BUFFER
+{
+public:
+    PLOT_OUTPUT_BUFFER( FILE* aFile ) :
+        m_file( aFile ),
+        m_len( 0 )
+    {
+    }
+
+    ~PLOT_OUTPUT_BUFFER()
+    {
+        Flush();
+    }
+
+    PLOT_OUTPUT_BUFFER& Text( const char* aText );
+
+    PLOT_OUTPUT_BUFFER& Char( char aChar )
+    {
+        if( m_len == BUFFER_SIZE )
+            Flush();
+
+        m_buffer[m_len++] = aChar;
+        return *this;
+    }
+
+    PLOT_OUTPUT_BUFFER& Int( long long aValue )
+    {
+        reserve( MAX_NUMBER_LEN );
+        m_len = FormatInt( m_buffer + m_len, aValue ) - m_buffer;
+        return *this;
+    }
+
+    /// Appends aValue with aDecimals digits after the decimal point
+    PLOT_OUTPUT_BUFFER& Fixed( double aValue, int aDecimals )
+    {
+        reserve( MAX_NUMBER_LEN );
+        m_len = FormatFixed( m_buffer + m_len, aValue, aDecimals, false ) - m_buffer;
+        return *this;
+    }
+
+    /// Appends aValue with aDigits significant digits, without trailing zeros nor exponent
+    PLOT_OUTPUT_BUFFER& Significant( double aValue, int aDigits = 6 )
+    {
+        reserve( MAX_NUMBER_LEN );
+        m_len = FormatSignificant( m_buffer + m_len, aValue, aDigits ) - m_buffer;
+        return *this;
+    }
+
+    /// Writes the buffered text to the file
+    void Flush();
+
+    /**
+     * Functions FormatInt, FormatFixed and FormatSignificant
+     * write a number (not null terminated) in aBuffer, which must hold MAX_NUMBER_LEN chars.
+     * @return the end of the number in aBuffer.
+     */
+    static char* FormatInt( char* aBuffer, long long aValue );
+    static char* FormatFixed( char* aBuffer, double aValue, int aDecimals, bool aTrimZeros );
+    static char* FormatSignificant( char* aBuffer, double aValue, int aDigits );
+
+    static const size_t MAX_NUMBER_LEN = 48;
+
+    /// Size of the stdio buffer of the plot files, which get millions of small writes
+    static const size_t FILE_BUFFER_SIZE = 1 << 20;
+
+private:
+    static const size_t BUFFER_SIZE = 8192;
+
+    void reserve( size_t aLen )
+    {
+        if( m_len + aLen > BUFFER_SIZE )
+            Flush();
+    }
+
+    FILE*  m_file;
+    size_t m_len;
+    char   m_buffer[BUFFER_SIZE];
+};
+
+#endif  // PLOT_OUTPUT_BUFFER_H_
@@ -42,6 +42,7 @@ class COLOR_SETTINGS;
 class SHAPE_POLY_SET;
 class SHAPE_LINE_CHAIN;
 class GBR_NETLIST_METADATA;
+class PLOT_OUTPUT_BUFFER;
 
 /**
  * Enum PlotFormat
@@ -1370,6 +1371,12 @@ protected:
      */
     void emitDcode( const DPOINT& pt, int dcode );
 
+    /**
+     * Same as emitDcode( pt, dcode ), but writes the record in a PLOT_OUTPUT_BUFFER
+     * (used to write the many vertices of polygons)
+     */
+    void emitDcode( PLOT_OUTPUT_BUFFER& aOutput, const DPOINT& pt, int dcode );
+
     /**
      * print a Gerber net attribute object record.
      * In a gerber file, a net attribute is owned by a graphic object
@@ -244,6 +244,29 @@ public:
         rewind( m_fp );
         m_lineNum = 0;
     }
+
+    /**
+     * Function CurPos
+     * returns the file position of the next line to be read, suitable for Seek().
+     */
+    long CurPos() const
+    {
+        return ftell( m_fp );
+    }
+
+    /**
+     * Function Seek
+     * moves to a file position previously returned by CurPos().
+     *
+     * @param aPos is the file position of the next line to read.
+     * @param aLineNumber is the line number preceding this position.  As for the
+     *  constructor, the next ReadLine() will report one greater than this.
+     */
+    void Seek( long aPos, unsigned aLineNumber )
+    {
+        fseek( m_fp, aPos, SEEK_SET );
+        m_lineNum = aLineNumber;
+    }
 };
 
 
@@ -167,6 +167,13 @@ extern const wxChar* const traceZoomScroll;
  */
 extern const wxChar* const traceSymbolResolver;
 
+/**
+ * Flag to enable the phase timings of the schematic connectivity calculations.
+ *
+ * Use "CONN_PROFILE" to enable.
+ */
+extern const wxChar* const traceConnectivityProfile;
+
 ///@}
 
 /**
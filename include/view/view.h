@@ -42,6 +42,7 @@ class GAL;
 class VIEW_ITEM;
 class VIEW_GROUP;
 class VIEW_RTREE;
+class VIEW_LOD_PROXY;
 
 /**
  * VIEW.
@@ -405,6 +406,9 @@ public:
             // Target has to be redrawn after changing its visibility
             MarkTargetDirty( m_layers[aLayer].target );
             m_layers[aLayer].visible = aVisible;
+
+            // Items may be shown or hidden depending on the visibility of other layers
+            invalidateLODProxies();
         }
     }
 
@@ -640,6 +644,41 @@ public:
     void UpdateAllItemsConditionally( int aUpdateFlags,
                                       std::function<bool( VIEW_ITEM* )> aCondition );
 
+    /**
+     * Function SetParallelCaching()
+     * Turns on or off building the cached geometry of items in several threads when updating
+     * them (see UpdateItems()).  Painters draw the items on recording GALs in parallel, and the
+     * recorded commands are replayed on the GAL in a single pass.  It has effect only if the
+     * painter can be cloned (see PAINTER::Clone()).
+     * @param aEnabled tells if the geometry should be cached in parallel.
+     */
+    void SetParallelCaching( bool aEnabled )
+    {
+        m_parallelCaching = aEnabled;
+    }
+
+    /**
+     * Function IsUsingParallelCaching()
+     * @return true if the geometry of items is cached in parallel.
+     */
+    bool IsUsingParallelCaching() const
+    {
+        return m_parallelCaching;
+    }
+
+    /**
+     * Function SetLayerLODProxy()
+     * Makes the VIEW draw simplified outlines of the items of a layer instead of the items
+     * themselves, when the view scale is below a threshold.  The outlines are provided by
+     * PAINTER::GetLODProxy(), merged per cell of a grid and rebuilt only for the cells whose
+     * items changed (see VIEW_LOD_PROXY).
+     * @param aLayer is the layer.
+     * @param aMaxScale is the scale from which the items are drawn by themselves, or 0 to
+     * always draw the items.
+     * @param aCellSize is the size of the grid cells, in world units.
+     */
+    void SetLayerLODProxy( int aLayer, double aMaxScale, int aCellSize );
+
     /**
      * Function IsUsingDrawPriority()
      * @return true if draw priority is being respected while redrawing.
@@ -710,6 +749,7 @@ protected:
         int                     id;              ///< layer ID
         RENDER_TARGET           target;          ///< where the layer should be rendered
         std::set<int>           requiredLayers;  ///< layers that have to be enabled to show the layer
+        std::shared_ptr<VIEW_LOD_PROXY> lodProxy; ///< outlines drawn when zoomed out, or null
     };
 
     // Convenience typedefs
@@ -722,6 +762,7 @@ protected:
     struct clearLayerCache;
     struct recacheItem;
     struct drawItem;
+    struct drawTileItem;
     struct unlinkItem;
     struct updateItemsColor;
     struct changeItemsDepth;
@@ -731,6 +772,34 @@ protected:
     ///* Redraws contents within rect aRect
     void redrawRect( const BOX2I& aRect );
 
+    /**
+     * Function redrawTiles()
+     * Redraws the layers of the cached and noncached targets within rect aRect, as tiles drawn
+     * in parallel, if the GAL renders tiles and the painter can be cloned.  The tiles stop
+     * below the first layer having an item they cannot draw (not cached yet, or drawn by
+     * the item itself).
+     * @return the number of layers at the start of m_orderedLayers drawn by the tiles.
+     */
+    size_t redrawTiles( const BOX2I& aRect );
+
+    /**
+     * Function activeLODProxy()
+     * @return the proxy drawn instead of the items of a layer at the current scale, or null.
+     */
+    VIEW_LOD_PROXY* activeLODProxy( int aLayer ) const;
+
+    ///* Rebuilds the changed parts of the LOD proxies drawn within rect aRect
+    void updateLODProxies( const BOX2I& aRect );
+
+    /**
+     * Function drawLODProxy()
+     * Draws the outlines of the LOD proxy of a layer within rect aRect on a GAL.
+     */
+    void drawLODProxy( int aLayer, GAL* aGal, const BOX2I& aRect );
+
+    ///* Marks all the LOD proxies to be rebuilt, eg. after the drawing settings changed
+    void invalidateLODProxies();
+
     inline void markTargetClean( int aTarget )
     {
         wxCHECK( aTarget < TARGETS_NUMBER, /* void */ );
@@ -790,6 +859,15 @@ protected:
     /// Updates all informations needed to draw an item
     void updateItemGeometry( VIEW_ITEM* aItem, int aLayer );
 
+    /**
+     * Function updateGeometryParallel()
+     * Updates the cached geometry of items, drawing them in several threads.  Falls back to
+     * updateItemGeometry() if there are few of them or if the painter cannot be cloned.
+     * @param aJobs are the items and layers to update.  Pairs of the same item have to be
+     * consecutive, as all the layers of an item are drawn by the same thread.
+     */
+    void updateGeometryParallel( const std::vector<LAYER_ITEM_PAIR>& aJobs );
+
     /// Updates bounding box of an item
     void updateBbox( VIEW_ITEM* aItem );
 
@@ -867,6 +945,13 @@ protected:
     /// Flag to reverse the draw order when using draw priority
     bool m_reverseDrawOrder;
 
+    /// Flag to cache the geometry of items in parallel
+    bool m_parallelCaching;
+
+    /// Items and layers whose geometry update is deferred, while UpdateItems() collects them
+    /// for updateGeometryParallel()
+    std::vector<LAYER_ITEM_PAIR>* m_deferredGeometry;
+
     /// A control for printing: m_printMode <= 0 means no printing mode (normal draw mode
     /// m_printMode > 0 is a printing mode (currently means "we are in printing mode")
     int m_printMode;
@@ -0,0 +1,166 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __VIEW_LOD_PROXY_H
+#define __VIEW_LOD_PROXY_H
+
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <math/box2.h>
+#include <geometry/shape_poly_set.h>
+
+namespace KIGFX
+{
+class VIEW_ITEM;
+
+/**
+ * Class VIEW_LOD_PROXY
+ * holds simplified outlines of the items of a VIEW layer, drawn instead of the items
+ * themselves when the view is zoomed out (see VIEW::SetLayerLODProxy()).
+ *
+ * The layer is split in square cells, an item belonging to the cell of its bounding box
+ * center.  The outlines of the items of a cell are merged, and the vertices closer than the
+ * given tolerance are dropped, so a cell is drawn as a handful of polygons.  Adding, removing
+ * or updating an item only marks its cell to be rebuilt by the next Rebuild() call.
+ *
+ * A cell is also rebuilt when the scale crosses the LOD threshold of one of its items, as the
+ * item is then shown or hidden, or changes by more than TOLERANCE_SCALE_RANGE since the cell
+ * was built, as the tolerance is meant to follow the scale.
+ */
+class VIEW_LOD_PROXY
+{
+public:
+    /**
+     * Function returning the outline of an item on the layer of the proxy.
+     * @return false if the item has to be drawn by itself.
+     */
+    typedef std::function<bool( const VIEW_ITEM* aItem, SHAPE_POLY_SET& aOutlines )>
+            OUTLINE_FUNC;
+
+    /**
+     * Function returning the scale an item is drawn from, see VIEW_ITEM::ViewGetLOD().
+     */
+    typedef std::function<double( const VIEW_ITEM* aItem )> LOD_FUNC;
+
+    /// Factor the scale can change by before the cells are rebuilt with another tolerance
+    static constexpr double TOLERANCE_SCALE_RANGE = 2.0;
+
+    /**
+     * @param aMaxScale is the VIEW scale the items are drawn by themselves from.
+     * @param aCellSize is the size of the cells, in world units.
+     */
+    VIEW_LOD_PROXY( double aMaxScale, int aCellSize );
+
+    double GetMaxScale() const
+    {
+        return m_maxScale;
+    }
+
+    /// Adds an item of the layer, and marks its cell to be rebuilt.
+    void Add( VIEW_ITEM* aItem );
+
+    /// Removes an item of the layer, and marks its cell to be rebuilt.
+    void Remove( VIEW_ITEM* aItem );
+
+    /// Takes into account an item that changed, eg. was moved or hidden.
+    void Update( VIEW_ITEM* aItem );
+
+    /// Removes all the items.
+    void Clear();
+
+    /// Marks all the cells to be rebuilt, eg. after the drawing settings changed.
+    void Invalidate();
+
+    /**
+     * Function Contains()
+     * @return true if the item is drawn as a part of the outlines, as of the last rebuild of
+     * its cell.
+     */
+    bool Contains( const VIEW_ITEM* aItem ) const;
+
+    /**
+     * Function Rebuild()
+     * rebuilds the cells that changed, or were built for another scale, and may intersect a
+     * rectangle.  The cells are rebuilt by several threads, so aGetLOD and aGetOutline have to
+     * be thread safe.
+     * @param aRect is the rectangle, in world units.
+     * @param aScale is the VIEW scale the outlines are drawn at.
+     * @param aTolerance is the distance under which vertices are merged, in world units.
+     * @param aGetLOD returns the scale an item is drawn from, the items drawn at aScale only
+     * being merged in the outlines.
+     * @param aGetOutline returns the outline of an item.
+     */
+    void Rebuild( const BOX2I& aRect, double aScale, double aTolerance, const LOD_FUNC& aGetLOD,
+                  const OUTLINE_FUNC& aGetOutline );
+
+    /**
+     * Function Query()
+     * returns the outlines of the cells that may intersect a rectangle.
+     */
+    void Query( const BOX2I& aRect, std::vector<const SHAPE_POLY_SET*>& aOutlines ) const;
+
+private:
+    typedef std::pair<int, int> CELL_KEY;
+
+    struct ITEM
+    {
+        CELL_KEY m_cell;        ///< cell the item belongs to
+        BOX2I    m_bbox;        ///< bounding box of the item when it was added
+        bool     m_proxied;     ///< is the item a part of the cell outlines?
+    };
+
+    struct CELL
+    {
+        std::unordered_set<VIEW_ITEM*> m_items;
+        SHAPE_POLY_SET                 m_outlines;  ///< merged outlines of the proxied items
+        BOX2I                          m_bbox;      ///< bounding box of all items of the cell
+        bool                           m_dirty = true;
+
+        /// The outlines are valid for the scales above m_minScale, up to m_maxScale
+        double                         m_minScale = 0.0;
+        double                         m_maxScale = 0.0;
+
+        bool NeedsRebuild( double aScale ) const
+        {
+            return m_dirty || aScale <= m_minScale || aScale > m_maxScale;
+        }
+    };
+
+    void rebuildCell( CELL& aCell, double aScale, double aTolerance, const LOD_FUNC& aGetLOD,
+                      const OUTLINE_FUNC& aGetOutline );
+
+    double m_maxScale;
+    int    m_cellSize;
+
+    std::map<CELL_KEY, CELL>                 m_cells;
+    std::unordered_map<const VIEW_ITEM*, ITEM> m_items;
+};
+
+} // namespace KIGFX
+
+#endif
@@ -1577,6 +1577,12 @@ public:
      */
     virtual void SetData( const std::vector<double>& xs, const std::vector<double>& ys );
 
+    /** Appends points to the internal data, updating the bounding box incrementally.
+     *  Both vectors MUST be of the same length. This method DOES NOT refresh the mpWindow; do it manually.
+     * @sa SetData
+     */
+    virtual void AppendData( const std::vector<double>& xs, const std::vector<double>& ys );
+
     /** Clears all the data, leaving the layer empty.
      * @sa SetData
      */
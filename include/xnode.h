@@ -34,6 +34,9 @@
 
 #include <wx/xml/xml.h>
 
+#include <string>
+#include <vector>
+
 
 /**
  * XNODE
@@ -97,4 +100,140 @@ public:
 
 };
 
+/**
+ * XNODE_SINK
+ * receives a document tree as a sequence of calls made in document order.  This lets the
+ * code producing a document either build it in memory as an XNODE tree (XNODE_BUILDER) or
+ * write it out while it is produced (XNODE_STREAM), without building the tree.
+ * The attributes of an element must be given before its children.
+ */
+class XNODE_SINK
+{
+public:
+    virtual ~XNODE_SINK() {}
+
+    /**
+     * Function StartElement
+     * opens a new element, child of the currently open element (if any).
+     */
+    virtual void StartElement( const wxString& aName ) = 0;
+
+    /**
+     * Function AddAttribute
+     * adds an attribute to the currently open element.
+     */
+    virtual void AddAttribute( const wxString& aName, const wxString& aValue ) = 0;
+
+    /**
+     * Function AddText
+     * adds a textual child to the currently open element.
+     */
+    virtual void AddText( const wxString& aContent ) = 0;
+
+    /**
+     * Function EndElement
+     * closes the currently open element.
+     */
+    virtual void EndElement() = 0;
+
+    /**
+     * Function AddElement
+     * adds an element with an optional textual child.  Like an empty XNODE content, an
+     * empty aTextualContent adds no textual child.
+     */
+    void AddElement( const wxString& aName, const wxString& aTextualContent = wxEmptyString )
+    {
+        StartElement( aName );
+
+        if( aTextualContent.Len() > 0 )
+            AddText( aTextualContent );
+
+        EndElement();
+    }
+};
+
+
+/**
+ * XNODE_BUILDER
+ * builds an XNODE tree from the calls made to an XNODE_SINK.
+ */
+class XNODE_BUILDER : public XNODE_SINK
+{
+public:
+    XNODE_BUILDER() :
+        m_root( nullptr )
+    {
+    }
+
+    ~XNODE_BUILDER()
+    {
+        delete m_root;
+    }
+
+    void StartElement( const wxString& aName ) override;
+    void AddAttribute( const wxString& aName, const wxString& aValue ) override;
+    void AddText( const wxString& aContent ) override;
+    void EndElement() override;
+
+    /**
+     * Function ReleaseRoot
+     * @return the root of the tree built so far, which is then owned by the caller.
+     */
+    XNODE* ReleaseRoot();
+
+private:
+    void addChild( XNODE* aNode );
+
+    XNODE*              m_root;
+    std::vector<XNODE*> m_open;         ///< the open elements, innermost last
+    std::vector<XNODE*> m_lastChild;    ///< the last child of each open element
+};
+
+
+/**
+ * XNODE_STREAM
+ * writes the calls made to an XNODE_SINK out to an OUTPUTFORMATTER as they come, either as
+ * an S-expression laid out like XNODE::Format(), or as XML laid out like the output of
+ * wxXmlDocument::Save() with an indentation step of 2.  Only the chain of open elements is
+ * kept in memory.
+ */
+class XNODE_STREAM : public XNODE_SINK
+{
+public:
+    enum FORMAT
+    {
+        SEXPR,
+        XML
+    };
+
+    /**
+     * Constructor
+     * @param aOut is the formatter to write to.  The XML declaration is written right away.
+     * @param aFormat is the output format.
+     * @throw IO_ERROR if a system error writing the output, such as a full disk.
+     */
+    XNODE_STREAM( OUTPUTFORMATTER* aOut, FORMAT aFormat );
+
+    void StartElement( const wxString& aName ) override;
+    void AddAttribute( const wxString& aName, const wxString& aValue ) override;
+    void AddText( const wxString& aContent ) override;
+    void EndElement() override;
+
+private:
+    struct ELEMENT
+    {
+        std::string m_name;             ///< UTF8 name, for the XML end tag
+        int         m_childCount;
+        bool        m_lastChildIsText;
+        bool        m_pendingNewline;   ///< an S-expression child element was closed
+    };
+
+    /// Updates the innermost open element before a child is written to it.
+    void beginChild( bool aIsText );
+
+    OUTPUTFORMATTER*     m_out;
+    FORMAT               m_format;
+    std::vector<ELEMENT> m_open;
+};
+
 #endif  // XNODE_H_
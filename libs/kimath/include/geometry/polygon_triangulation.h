@@ -49,6 +49,7 @@
 #include <algorithm>
 #include <deque>
 #include <cmath>
+#include <vector>
 
 #include <clipper.hpp>
 #include <geometry/shape_line_chain.h>
@@ -179,7 +180,7 @@ private:
          */
         void zSort()
         {
-            std::deque<Vertex*> queue;
+            std::vector<Vertex*> queue;
 
             queue.push_back( this );
 
@@ -492,7 +493,7 @@ private:
 
         while( p && p->z <= maxZ )
         {
-            if( p != a && p != c
+            if( inBBox( p, minTX, minTY, maxTX, maxTY ) && p != a && p != c
                     && p->inTriangle( *a, *b, *c )
                     && area( p->prev, p, p->next ) >= 0 )
                 return false;
@@ -504,7 +505,7 @@ private:
 
         while( p && p->z >= minZ )
         {
-            if( p != a && p != c
+            if( inBBox( p, minTX, minTY, maxTX, maxTY ) && p != a && p != c
                     && p->inTriangle( *a, *b, *c )
                     && area( p->prev, p, p->next ) >= 0 )
                 return false;
@@ -514,6 +515,16 @@ private:
         return true;
     }
 
+    /**
+     * Function inBBox
+     * Cheap pre-check for isEar(): most of the vertices in the z-order range of a triangle
+     * are outside of its bounding box.
+     */
+    static bool inBBox( const Vertex* p, double aMinX, double aMinY, double aMaxX, double aMaxY )
+    {
+        return p->x >= aMinX && p->x <= aMaxX && p->y >= aMinY && p->y <= aMaxY;
+    }
+
     /**
      * Function splitPolygon
      * If we cannot find an ear to slice in the current polygon list, we
@@ -554,13 +565,15 @@ private:
      * either fully inside or fully outside the polygon.  Finally, by checking whether
      * the segment is enclosed by the local triangles, we distinguish between
      * these two cases and no further checks are needed.
+     * The constant-time local checks are done first, as the intersection test walks the
+     * whole polygon and most candidate diagonals of a large polygon fail locally.
      */
     bool goodSplit( const Vertex* a, const Vertex* b ) const
     {
         return a->next->i != b->i &&
                a->prev->i != b->i &&
-               !intersectsPolygon( a, b ) &&
-               locallyInside( a, b );
+               locallyInside( a, b ) &&
+               !intersectsPolygon( a, b );
     }
 
     /**
@@ -595,9 +608,23 @@ private:
      */
     bool intersectsPolygon( const Vertex* a, const Vertex* b ) const
     {
+        const double minX = std::min( a->x, b->x );
+        const double minY = std::min( a->y, b->y );
+        const double maxX = std::max( a->x, b->x );
+        const double maxY = std::max( a->y, b->y );
+
         const Vertex* p = a->next;
         do
         {
+            // Cheap rejection of the edges lying entirely on one side of the segment bbox
+            if( ( p->x < minX && p->next->x < minX ) || ( p->x > maxX && p->next->x > maxX )
+                    || ( p->y < minY && p->next->y < minY )
+                    || ( p->y > maxY && p->next->y > maxY ) )
+            {
+                p = p->next;
+                continue;
+            }
+
             if( p->i != a->i &&
                 p->next->i != a->i &&
                 p->i != b->i &&
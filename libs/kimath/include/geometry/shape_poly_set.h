@@ -26,6 +26,7 @@
 #ifndef __SHAPE_POLY_SET_H
 #define __SHAPE_POLY_SET_H
 
+#include <atomic>
 #include <cstdio>
 #include <deque>                        // for deque
 #include <iosfwd>                       // for string, stringstream
@@ -58,7 +59,11 @@
  *      outline or a hole.
  *      - Vertex (or corner): each one of the points that define a contour.
  *
- * TODO: add convex partitioning & spatial index
+ * Point containment, collision and distance queries on large sets are accelerated by a
+ * per-polygon R-tree of edges.  The index is built lazily once a set has been queried a few
+ * times without being modified, and is dropped by any non-const access to the outlines.
+ *
+ * TODO: add convex partitioning
  */
 class SHAPE_POLY_SET : public SHAPE
 {
@@ -240,7 +245,7 @@ class SHAPE_POLY_SET : public SHAPE
 
             const T& Get()
             {
-                return m_poly->Polygon( m_currentPolygon )[m_currentContour].CPoint(
+                return m_poly->CPolygon( m_currentPolygon )[m_currentContour].CPoint(
                         m_currentVertex );
             }
 
@@ -363,7 +368,8 @@ class SHAPE_POLY_SET : public SHAPE
 
             T Get()
             {
-                return m_poly->Polygon( m_currentPolygon )[m_currentContour].Segment( m_currentSegment );
+                return m_poly->CPolygon( m_currentPolygon )[m_currentContour].CSegment(
+                        m_currentSegment );
             }
 
             T operator*()
@@ -587,6 +593,7 @@ class SHAPE_POLY_SET : public SHAPE
         ///> Returns the reference to aIndex-th outline in the set
         SHAPE_LINE_CHAIN& Outline( int aIndex )
         {
+            invalidateCaches();
             return m_polys[aIndex][0];
         }
 
@@ -609,12 +616,14 @@ class SHAPE_POLY_SET : public SHAPE
         ///> Returns the reference to aHole-th hole in the aIndex-th outline
         SHAPE_LINE_CHAIN& Hole( int aOutline, int aHole )
         {
+            invalidateCaches();
             return m_polys[aOutline][aHole + 1];
         }
 
         ///> Returns the aIndex-th subpolygon in the set
         POLYGON& Polygon( int aIndex )
         {
+            invalidateCaches();
             return m_polys[aIndex];
         }
 
@@ -932,6 +941,24 @@ class SHAPE_POLY_SET : public SHAPE
         ///> For aFastMode meaning, see function booleanOp
         void Simplify( POLYGON_MODE aFastMode );
 
+        /**
+         * Gives the same result as Simplify(), but first groups the polygons into clusters of
+         * overlapping bounding boxes and merges each cluster separately, in parallel.  Much
+         * faster than a single union when the set holds many small, mostly disjoint polygons,
+         * such as the clearance knockouts of a zone.  The order of the resulting polygons
+         * differs from Simplify().
+         */
+        void SimplifyClustered( POLYGON_MODE aFastMode );
+
+        /**
+         * Merges the polygons like Simplify(), but tile by tile of a square grid of aTileSize,
+         * in parallel, and optionally fractures the result.  The resulting polygons cover the
+         * same area as Simplify() gives, but are cut at the tile edges.  Meant for huge sets
+         * overlapping everywhere, such as all the copper of a layer having planes, which
+         * SimplifyClustered() can't split.
+         */
+        void SimplifyTiled( POLYGON_MODE aFastMode, int aTileSize, bool aFracture = false );
+
         /**
          * Function NormalizeAreaOutlines
          * Convert a self-intersecting polygon to one (or more) non self-intersecting polygon(s)
@@ -1296,19 +1323,72 @@ class SHAPE_POLY_SET : public SHAPE
 
         SHAPE_POLY_SET& operator=( const SHAPE_POLY_SET& );
 
+        /**
+         * Triangulates the polygons of the set for rendering.  The fractured outlines are
+         * independent, so they are triangulated in parallel when there are several of them.
+         */
         void CacheTriangulation();
         bool IsTriangulationUpToDate() const;
 
         MD5_HASH GetHash() const;
 
+        ///> Returns true if the edge index has been built (see the class description)
+        bool HasEdgeIndex() const
+        {
+            return m_edgeIndex.load( std::memory_order_acquire ) != nullptr;
+        }
+
+        /**
+         * Builds the edge index right away instead of waiting for enough queries to be made.
+         * Useful before handing a large, otherwise unmodified set to several threads.
+         */
+        void BuildEdgeIndex();
+
     private:
 
         MD5_HASH checksum() const;
 
+        class EDGE_INDEX;
+
+        ///> Returns the edge index, building it if the set is large and queried often enough
+        EDGE_INDEX* edgeIndex() const;
+
+        ///> Drops the edge index and the Clipper paths; called by every operation that may
+        ///> modify the polygons
+        void invalidateCaches()
+        {
+            if( m_edgeIndex.load( std::memory_order_relaxed )
+                    || m_edgeIndexQueries.load( std::memory_order_relaxed ) )
+                freeEdgeIndex();
+
+            if( m_clipperPathsValid )
+            {
+                m_clipperPaths.clear();
+                m_clipperPathsValid = false;
+            }
+        }
+
+        void freeEdgeIndex();
+
+        /**
+         * Returns the outlines and holes in Clipper form, in m_polys order and with the
+         * orientation Clipper expects.  The cached paths are returned when valid; otherwise
+         * the polygons are converted into aStorage.
+         */
+        const ClipperLib::Paths& clipperPaths( ClipperLib::Paths& aStorage ) const;
+
         std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> m_triangulatedPolys;
         bool m_triangulationValid = false;
         MD5_HASH m_hash;
 
+        ///> Paths of the last Clipper operation, kept until the set is modified so that chained
+        ///> boolean operations don't convert the polygons back to Clipper.  Only filled by
+        ///> importTree(), never by const methods, and not shared with copies.
+        ClipperLib::Paths m_clipperPaths;
+        bool              m_clipperPathsValid = false;
+
+        mutable std::atomic<EDGE_INDEX*> m_edgeIndex;
+        mutable std::atomic<int>         m_edgeIndexQueries;
 };
 
 #endif
@@ -28,13 +28,17 @@
 
 #include <algorithm>
 #include <assert.h>                          // for assert
+#include <climits>                           // for INT_MAX, needed by rtree.h
 #include <cmath>                             // for sqrt, cos, hypot, isinf
+#include <cstdint>
 #include <cstdio>
+#include <functional>
 #include <istream>                           // for operator<<, operator>>
 #include <limits>                            // for numeric_limits
 #include <memory>
 #include <set>
 #include <string>                            // for char_traits, operator!=
+#include <thread>
 #include <type_traits>                       // for swap, move
 #include <unordered_set>
 #include <vector>
@@ -42,6 +46,7 @@
 #include <clipper.hpp>                       // for Clipper, PolyNode, Clipp...
 #include <geometry/geometry_utils.h>
 #include <geometry/polygon_triangulation.h>
+#include <geometry/rtree.h>
 #include <geometry/seg.h>                    // for SEG, OPT_VECTOR2I
 #include <geometry/shape.h>
 #include <geometry/shape_line_chain.h>
@@ -54,21 +59,389 @@
 
 using namespace ClipperLib;
 
+/**
+ * EDGE_INDEX
+ *
+ * An R-tree of the edges of every polygon in the set.  Queries return exactly what the linear
+ * scans over SHAPE_LINE_CHAIN edges return, but only visit the edges near the query.
+ */
+class SHAPE_POLY_SET::EDGE_INDEX
+{
+public:
+    EDGE_INDEX( const POLYSET& aPolys )
+    {
+        for( const POLYGON& poly : aPolys )
+        {
+            m_polys.push_back( std::make_unique<POLY_EDGES>() );
+            POLY_EDGES& polyEdges = *m_polys.back();
+
+            for( int contour = 0; contour < (int) poly.size(); contour++ )
+            {
+                const SHAPE_LINE_CHAIN& chain = poly[contour];
+
+                // Same conditions as SHAPE_LINE_CHAIN::PointInside()
+                polyEdges.m_solidContours.push_back( chain.IsClosed() && chain.PointCount() >= 3 );
+
+                if( contour == 0 )
+                    polyEdges.m_bbox.Compute( chain.CPoints() );
+
+                for( int i = 0; i < chain.SegmentCount(); i++ )
+                {
+                    const SEG seg = chain.CSegment( i );
+                    const int mmin[2] = { std::min( seg.A.x, seg.B.x ), std::min( seg.A.y, seg.B.y ) };
+                    const int mmax[2] = { std::max( seg.A.x, seg.B.x ), std::max( seg.A.y, seg.B.y ) };
+
+                    polyEdges.m_tree.Insert( mmin, mmax, (intptr_t) polyEdges.m_edges.size() );
+                    polyEdges.m_edges.push_back( { seg, contour } );
+                }
+            }
+        }
+    }
+
+    /**
+     * Equivalent of SHAPE_POLY_SET::containsSingle() for the aPoly-th polygon.
+     */
+    bool Contains( int aPoly, const VECTOR2I& aP, int aAccuracy )
+    {
+        POLY_EDGES& polyEdges = *m_polys[aPoly];
+
+        if( !polyEdges.m_solidContours[0] )
+            return false;
+
+        // A point farther than the edge tolerance from the outline bbox can't be inside
+        BOX2I bbox = polyEdges.m_bbox;
+        bbox.Inflate( aAccuracy + 1 );
+
+        if( !bbox.Contains( aP ) )
+            return false;
+
+        // Cast a ray in the positive x direction (as in SHAPE_LINE_CHAIN::PointInside()) and
+        // collect the contours of the edges it crosses.  Only edges whose bbox reaches the ray
+        // can be crossed.
+        std::vector<int> crossings;
+
+        auto visitor =
+                [&]( const intptr_t& aEdge ) -> bool
+                {
+                    const EDGE&     edge = polyEdges.m_edges[aEdge];
+                    const VECTOR2I& p1 = edge.m_seg.A;
+                    const VECTOR2I& p2 = edge.m_seg.B;
+                    const VECTOR2I  diff = p2 - p1;
+
+                    if( diff.y != 0 )
+                    {
+                        const int d = rescale( diff.x, ( aP.y - p1.y ), diff.y );
+
+                        if( ( ( p1.y > aP.y ) != ( p2.y > aP.y ) ) && ( aP.x - p1.x < d ) )
+                            crossings.push_back( edge.m_contour );
+                    }
+
+                    return true;
+                };
+
+        const int rayMin[2] = { aP.x, aP.y };
+        const int rayMax[2] = { std::numeric_limits<int>::max(), aP.y };
+
+        polyEdges.m_tree.Search( rayMin, rayMax, visitor );
+
+        std::sort( crossings.begin(), crossings.end() );
+
+        auto isInside =
+                [&]( int aContour ) -> bool
+                {
+                    auto range = std::equal_range( crossings.begin(), crossings.end(), aContour );
+                    return polyEdges.m_solidContours[aContour]
+                           && ( std::distance( range.first, range.second ) % 2 ) != 0;
+                };
+
+        bool inside = isInside( 0 );
+
+        // Same accuracy rules as SHAPE_LINE_CHAIN::PointInside()
+        if( aAccuracy == 0 )
+            inside = inside && !onEdge( polyEdges, 0, aP, 0 );
+        else if( aAccuracy > 1 )
+            inside = inside || onEdge( polyEdges, 0, aP, aAccuracy - 1 );
+
+        if( !inside )
+            return false;
+
+        // Holes are tested with an accuracy of 1, see containsSingle()
+        for( auto it = crossings.begin(); it != crossings.end(); )
+        {
+            if( *it != 0 && isInside( *it ) )
+                return false;
+
+            it = std::upper_bound( it, crossings.end(), *it );
+        }
+
+        return true;
+    }
+
+    /**
+     * Returns the minimum distance between any edge of the aPoly-th polygon and aSeg, or
+     * between the edges and aSeg.A if aPointOnly is set.  Returns -1 if there are no edges.
+     */
+    int Distance( int aPoly, const SEG& aSeg, bool aPointOnly )
+    {
+        POLY_EDGES& polyEdges = *m_polys[aPoly];
+
+        if( polyEdges.m_edges.empty() )
+            return -1;
+
+        BOX2I queryBox;
+        queryBox.SetOrigin( aSeg.A );
+        queryBox.SetEnd( aSeg.B );
+        queryBox.Normalize();
+
+        int minDistance = std::numeric_limits<int>::max();
+
+        auto visitor =
+                [&]( const intptr_t& aEdge ) -> bool
+                {
+                    const SEG& edge = polyEdges.m_edges[aEdge].m_seg;
+                    int dist = aPointOnly ? edge.Distance( aSeg.A ) : edge.Distance( aSeg );
+
+                    minDistance = std::min( minDistance, dist );
+
+                    // Nothing can be closer than touching
+                    return minDistance > 0;
+                };
+
+        // Grow the search area until some edge is found, starting from roughly the size of a
+        // cell of a uniform grid holding one edge per cell
+        const BOX2I& bbox = polyEdges.m_bbox;
+        double cellSize = std::max( bbox.GetWidth(), bbox.GetHeight() )
+                                / std::sqrt( (double) polyEdges.m_edges.size() );
+        int64_t radius = std::max( 1, KiROUND( cellSize ) );
+
+        while( true )
+        {
+            if( search( polyEdges, queryBox, radius, visitor ) )
+                break;
+
+            if( radius > std::numeric_limits<int>::max() / 2 )
+                break;
+
+            radius *= 2;
+        }
+
+        if( minDistance == 0 || minDistance == std::numeric_limits<int>::max() )
+            return minDistance;
+
+        // Any edge closer than the best candidate must intersect the query box inflated by
+        // the candidate distance
+        search( polyEdges, queryBox, minDistance, visitor );
+
+        return minDistance;
+    }
+
+    /**
+     * Returns true if aSeg intersects any edge of any polygon (see SEG::Intersect()).
+     */
+    bool Intersects( const SEG& aSeg, bool aIgnoreEndpoints )
+    {
+        BOX2I queryBox;
+        queryBox.SetOrigin( aSeg.A );
+        queryBox.SetEnd( aSeg.B );
+        queryBox.Normalize();
+
+        for( std::unique_ptr<POLY_EDGES>& polyEdges : m_polys )
+        {
+            bool found = false;
+
+            auto visitor =
+                    [&]( const intptr_t& aEdge ) -> bool
+                    {
+                        found = (bool) polyEdges->m_edges[aEdge].m_seg.Intersect( aSeg,
+                                                                                aIgnoreEndpoints );
+                        return !found;
+                    };
+
+            search( *polyEdges, queryBox, 0, visitor );
+
+            if( found )
+                return true;
+        }
+
+        return false;
+    }
+
+private:
+    struct EDGE
+    {
+        SEG m_seg;
+        int m_contour;
+    };
+
+    struct POLY_EDGES
+    {
+        // The edge indices are stored in the R-tree child pointers: they must be pointer-sized
+        RTree<intptr_t, int, 2, double> m_tree;
+        std::vector<EDGE>               m_edges;
+        std::vector<bool>               m_solidContours;
+        BOX2I                           m_bbox;
+    };
+
+    ///> Visits the edges whose bbox overlaps aBox inflated by aMargin; returns the count found
+    template <class VISITOR>
+    int search( POLY_EDGES& aPolyEdges, const BOX2I& aBox, int64_t aMargin, VISITOR& aVisitor )
+    {
+        auto clamp =
+                []( int64_t aValue ) -> int
+                {
+                    return (int) std::max<int64_t>( std::numeric_limits<int>::min(),
+                                                    std::min<int64_t>( std::numeric_limits<int>::max(),
+                                                                       aValue ) );
+                };
+
+        const int mmin[2] = { clamp( (int64_t) aBox.GetLeft() - aMargin ),
+                              clamp( (int64_t) aBox.GetTop() - aMargin ) };
+        const int mmax[2] = { clamp( (int64_t) aBox.GetRight() + aMargin ),
+                              clamp( (int64_t) aBox.GetBottom() + aMargin ) };
+
+        return aPolyEdges.m_tree.Search( mmin, mmax, aVisitor );
+    }
+
+    ///> Equivalent of SHAPE_LINE_CHAIN::PointOnEdge() for a single contour
+    bool onEdge( POLY_EDGES& aPolyEdges, int aContour, const VECTOR2I& aP, int aAccuracy )
+    {
+        bool found = false;
+
+        auto visitor =
+                [&]( const intptr_t& aEdge ) -> bool
+                {
+                    const EDGE& edge = aPolyEdges.m_edges[aEdge];
+
+                    if( edge.m_contour != aContour )
+                        return true;
+
+                    if( edge.m_seg.A == aP || edge.m_seg.B == aP
+                            || edge.m_seg.Distance( aP ) <= aAccuracy + 1 )
+                    {
+                        found = true;
+                    }
+
+                    return !found;
+                };
+
+        search( aPolyEdges, BOX2I( aP, VECTOR2I( 0, 0 ) ), aAccuracy + 1, visitor );
+
+        return found;
+    }
+
+    std::vector<std::unique_ptr<POLY_EDGES>> m_polys;
+};
+
+
+// Building the edge index costs about as much as a few linear scans of the edges, so it is
+// only worth it for large sets that are queried repeatedly without being modified.
+static const int EDGE_INDEX_MIN_VERTICES = 256;
+static const int EDGE_INDEX_MIN_QUERIES = 4;
+
+
+SHAPE_POLY_SET::EDGE_INDEX* SHAPE_POLY_SET::edgeIndex() const
+{
+    EDGE_INDEX* index = m_edgeIndex.load( std::memory_order_acquire );
+
+    if( index )
+        return index;
+
+    // Exactly one caller sees the threshold being reached, so only one thread builds the index
+    if( ++m_edgeIndexQueries != EDGE_INDEX_MIN_QUERIES )
+        return nullptr;
+
+    if( TotalVertices() < EDGE_INDEX_MIN_VERTICES )
+        return nullptr;
+
+    index = new EDGE_INDEX( m_polys );
+    m_edgeIndex.store( index, std::memory_order_release );
+
+    return index;
+}
+
+
+void SHAPE_POLY_SET::BuildEdgeIndex()
+{
+    if( !m_edgeIndex.load() )
+        m_edgeIndex.store( new EDGE_INDEX( m_polys ) );
+}
+
+
+void SHAPE_POLY_SET::freeEdgeIndex()
+{
+    delete m_edgeIndex.exchange( nullptr );
+    m_edgeIndexQueries.store( 0 );
+}
+
+
+/// Number of helper threads currently running in runParallel(), shared by all the sets so
+/// that sets processed from several threads at once (e.g. at board load) don't oversubscribe
+/// the CPU
+static std::atomic<int> s_parallelHelpers( 0 );
+
+
+/**
+ * Calls aFunc for each index in [0, aCount), on the calling thread and on as many helper
+ * threads as are useful and available.
+ */
+static void runParallel( size_t aCount, const std::function<void( size_t )>& aFunc )
+{
+    std::atomic<size_t> next( 0 );
+
+    auto worker = [&]()
+    {
+        for( size_t ii = next.fetch_add( 1 ); ii < aCount; ii = next.fetch_add( 1 ) )
+            aFunc( ii );
+    };
+
+    int helpers = 0;
+
+    if( aCount > 1 )
+    {
+        int budget = std::max<int>( std::thread::hardware_concurrency(), 1 ) - 1;
+        int wanted = std::min<int>( budget, aCount - 1 );
+        int busy = s_parallelHelpers.fetch_add( wanted );
+
+        helpers = std::max( 0, std::min( wanted, budget - busy ) );
+        s_parallelHelpers.fetch_sub( wanted - helpers );
+    }
+
+    std::vector<std::thread> threads;
+
+    for( int ii = 0; ii < helpers; ii++ )
+        threads.emplace_back( worker );
+
+    worker();
+
+    for( std::thread& t : threads )
+        t.join();
+
+    s_parallelHelpers.fetch_sub( helpers );
+}
+
+
 SHAPE_POLY_SET::SHAPE_POLY_SET() :
-    SHAPE( SH_POLY_SET )
+    SHAPE( SH_POLY_SET ),
+    m_edgeIndex( nullptr ),
+    m_edgeIndexQueries( 0 )
 {
 }
 
 
 SHAPE_POLY_SET::SHAPE_POLY_SET( const SHAPE_LINE_CHAIN& aOutline ) :
-    SHAPE( SH_POLY_SET )
+    SHAPE( SH_POLY_SET ),
+    m_edgeIndex( nullptr ),
+    m_edgeIndexQueries( 0 )
 {
     AddOutline( aOutline );
 }
 
 
 SHAPE_POLY_SET::SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther, bool aDeepCopy ) :
-    SHAPE( SH_POLY_SET ), m_polys( aOther.m_polys )
+    SHAPE( SH_POLY_SET ),
+    m_polys( aOther.m_polys ),
+    m_edgeIndex( nullptr ),
+    m_edgeIndexQueries( 0 )
 {
     if( aOther.IsTriangulationUpToDate() )
     {
@@ -84,6 +457,7 @@ SHAPE_POLY_SET::SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther, bool aDeepCopy ) :
 
 SHAPE_POLY_SET::~SHAPE_POLY_SET()
 {
+    delete m_edgeIndex.load();
 }
 
 
@@ -178,6 +552,8 @@ bool SHAPE_POLY_SET::GetGlobalIndex( SHAPE_POLY_SET::VERTEX_INDEX aRelativeIndic
 
 int SHAPE_POLY_SET::NewOutline()
 {
+    invalidateCaches();
+
     SHAPE_LINE_CHAIN empty_path;
     POLYGON poly;
 
@@ -190,6 +566,8 @@ int SHAPE_POLY_SET::NewOutline()
 
 int SHAPE_POLY_SET::NewHole( int aOutline )
 {
+    invalidateCaches();
+
     SHAPE_LINE_CHAIN empty_path;
 
     empty_path.SetClosed( true );
@@ -207,6 +585,8 @@ int SHAPE_POLY_SET::NewHole( int aOutline )
 
 int SHAPE_POLY_SET::Append( int x, int y, int aOutline, int aHole, bool aAllowDuplication )
 {
+    invalidateCaches();
+
     assert( m_polys.size() );
 
     if( aOutline < 0 )
@@ -230,6 +610,8 @@ int SHAPE_POLY_SET::Append( int x, int y, int aOutline, int aHole, bool aAllowDu
 
 void SHAPE_POLY_SET::InsertVertex( int aGlobalIndex, VECTOR2I aNewVertex )
 {
+    invalidateCaches();
+
     VERTEX_INDEX index;
 
     if( aGlobalIndex < 0 )
@@ -283,7 +665,7 @@ SHAPE_POLY_SET SHAPE_POLY_SET::Subset( int aFirstPolygon, int aLastPolygon )
 
     for( int index = aFirstPolygon; index < aLastPolygon; index++ )
     {
-        newPolySet.m_polys.push_back( Polygon( index ) );
+        newPolySet.m_polys.push_back( m_polys[index] );
     }
 
     return newPolySet;
@@ -415,6 +797,8 @@ bool SHAPE_POLY_SET::IsSelfIntersecting() const
 
 int SHAPE_POLY_SET::AddOutline( const SHAPE_LINE_CHAIN& aOutline )
 {
+    invalidateCaches();
+
     assert( aOutline.IsClosed() );
 
     POLYGON poly;
@@ -429,6 +813,8 @@ int SHAPE_POLY_SET::AddOutline( const SHAPE_LINE_CHAIN& aOutline )
 
 int SHAPE_POLY_SET::AddHole( const SHAPE_LINE_CHAIN& aHole, int aOutline )
 {
+    invalidateCaches();
+
     assert( m_polys.size() );
 
     if( aOutline < 0 )
@@ -459,20 +845,12 @@ void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType,
         POLYGON_MODE aFastMode )
 {
     Clipper c;
+    Paths   storage;
 
     c.StrictlySimple( aFastMode == PM_STRICTLY_SIMPLE );
 
-    for( auto poly : aShape.m_polys )
-    {
-        for( size_t i = 0 ; i < poly.size(); i++ )
-            c.AddPath( poly[i].convertToClipper( i == 0 ), ptSubject, true );
-    }
-
-    for( auto poly : aOtherShape.m_polys )
-    {
-        for( size_t i = 0; i < poly.size(); i++ )
-            c.AddPath( poly[i].convertToClipper( i == 0 ), ptClip, true );
-    }
+    c.AddPaths( aShape.clipperPaths( storage ), ptSubject, true );
+    c.AddPaths( aOtherShape.clipperPaths( storage ), ptClip, true );
 
     PolyTree solution;
 
@@ -482,6 +860,23 @@ void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType,
 }
 
 
+const Paths& SHAPE_POLY_SET::clipperPaths( Paths& aStorage ) const
+{
+    if( m_clipperPathsValid )
+        return m_clipperPaths;
+
+    aStorage.clear();
+
+    for( const POLYGON& poly : m_polys )
+    {
+        for( size_t i = 0; i < poly.size(); i++ )
+            aStorage.push_back( poly[i].convertToClipper( i == 0 ) );
+    }
+
+    return aStorage;
+}
+
+
 void SHAPE_POLY_SET::BooleanAdd( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode )
 {
     booleanOp( ctUnion, b, aFastMode );
@@ -580,11 +975,9 @@ void SHAPE_POLY_SET::Inflate( int aAmount, int aCircleSegmentsCount,
         break;
     }
 
-    for( const POLYGON& poly : m_polys )
-    {
-        for( size_t i = 0; i < poly.size(); i++ )
-            c.AddPath( poly[i].convertToClipper( i == 0 ), joinType, etClosedPolygon );
-    }
+    Paths storage;
+
+    c.AddPaths( clipperPaths( storage ), joinType, etClosedPolygon );
 
     PolyTree solution;
 
@@ -618,6 +1011,8 @@ void SHAPE_POLY_SET::Inflate( int aAmount, int aCircleSegmentsCount,
 
 void SHAPE_POLY_SET::importTree( PolyTree* tree )
 {
+    invalidateCaches();
+
     m_polys.clear();
 
     for( PolyNode* n = tree->GetFirst(); n; n = n->GetNext() )
@@ -626,14 +1021,22 @@ void SHAPE_POLY_SET::importTree( PolyTree* tree )
         {
             POLYGON paths;
             paths.reserve( n->Childs.size() + 1 );
-            paths.push_back( n->Contour );
+            paths.emplace_back( n->Contour );
+            m_clipperPaths.push_back( std::move( n->Contour ) );
 
             for( unsigned int i = 0; i < n->Childs.size(); i++ )
-                paths.push_back( n->Childs[i]->Contour );
+            {
+                paths.emplace_back( n->Childs[i]->Contour );
+                m_clipperPaths.push_back( std::move( n->Childs[i]->Contour ) );
+            }
 
-            m_polys.push_back( paths );
+            m_polys.push_back( std::move( paths ) );
         }
     }
+
+    // Clipper returns the outlines and the holes with the orientations it expects as input,
+    // so the solution paths can be used as they are by the next operation
+    m_clipperPathsValid = true;
 }
 
 
@@ -849,6 +1252,8 @@ void SHAPE_POLY_SET::Fracture( POLYGON_MODE aFastMode )
 {
     Simplify( aFastMode );    // remove overlapping holes/degeneracy
 
+    invalidateCaches();
+
     for( POLYGON& paths : m_polys )
     {
         fractureSingle( paths );
@@ -1034,6 +1439,8 @@ bool SHAPE_POLY_SET::HasHoles() const
 
 void SHAPE_POLY_SET::Unfracture( POLYGON_MODE aFastMode )
 {
+    invalidateCaches();
+
     for( POLYGON& path : m_polys )
     {
         unfractureSingle( path );
@@ -1051,6 +1458,211 @@ void SHAPE_POLY_SET::Simplify( POLYGON_MODE aFastMode )
 }
 
 
+void SHAPE_POLY_SET::SimplifyClustered( POLYGON_MODE aFastMode )
+{
+    const int count = (int) m_polys.size();
+
+    if( count < 2 )
+    {
+        Simplify( aFastMode );
+        return;
+    }
+
+    invalidateCaches();
+
+    // Group the polygons whose bounding boxes overlap or touch, transitively (union-find over
+    // an R-tree of the bounding boxes).  Polygons of different clusters can't overlap, so each
+    // cluster can be merged on its own.
+    std::vector<int>   parent( count );
+    std::vector<BOX2I> bboxes( count );
+    RTree<intptr_t, int, 2, double> tree;     // payloads are stored as pointers
+
+    auto root =
+            [&]( int aIdx ) -> int
+            {
+                while( parent[aIdx] != aIdx )
+                    aIdx = parent[aIdx] = parent[parent[aIdx]];
+
+                return aIdx;
+            };
+
+    for( int ii = 0; ii < count; ii++ )
+    {
+        parent[ii] = ii;
+        bboxes[ii] = m_polys[ii][0].BBox();
+
+        const int mmin[2] = { bboxes[ii].GetLeft(), bboxes[ii].GetTop() };
+        const int mmax[2] = { bboxes[ii].GetRight(), bboxes[ii].GetBottom() };
+
+        auto visitor =
+                [&]( intptr_t aOther ) -> bool
+                {
+                    int a = root( ii );
+                    int b = root( (int) aOther );
+
+                    if( a != b )
+                        parent[std::max( a, b )] = std::min( a, b );
+
+                    return true;
+                };
+
+        tree.Search( mmin, mmax, visitor );
+        tree.Insert( mmin, mmax, ii );
+    }
+
+    std::vector<int>            clusterOf( count, -1 );
+    std::vector<SHAPE_POLY_SET> clusters;
+
+    for( int ii = 0; ii < count; ii++ )
+    {
+        int& cluster = clusterOf[root( ii )];
+
+        if( cluster < 0 )
+        {
+            cluster = (int) clusters.size();
+            clusters.emplace_back();
+        }
+
+        clusters[cluster].m_polys.push_back( std::move( m_polys[ii] ) );
+    }
+
+    runParallel( clusters.size(),
+            [&]( size_t aIndex )
+            {
+                // Lone polygons are still simplified, to remove their self-intersections
+                clusters[aIndex].Simplify( aFastMode );
+            } );
+
+    m_polys.clear();
+
+    for( SHAPE_POLY_SET& cluster : clusters )
+    {
+        for( POLYGON& poly : cluster.m_polys )
+            m_polys.push_back( std::move( poly ) );
+    }
+}
+
+
+void SHAPE_POLY_SET::SimplifyTiled( POLYGON_MODE aFastMode, int aTileSize, bool aFracture )
+{
+    // Keeps the bookkeeping of the tiles cheap whatever the tile size is
+    const int maxTilesPerSide = 256;
+
+    const int   count = (int) m_polys.size();
+    const BOX2I bbox = BBox();
+
+    aTileSize = std::max( aTileSize, 1 );
+    aTileSize = std::max( aTileSize,
+                          std::max( bbox.GetWidth(), bbox.GetHeight() ) / maxTilesPerSide + 1 );
+
+    const int columns = bbox.GetWidth() / aTileSize + 1;
+    const int rows = bbox.GetHeight() / aTileSize + 1;
+
+    if( count < 2 || columns * rows < 2 )
+    {
+        if( aFracture )
+            Fracture( aFastMode );
+        else
+            Simplify( aFastMode );
+
+        return;
+    }
+
+    invalidateCaches();
+
+    auto column = [&]( int aX )
+    {
+        return std::min<int>( columns - 1, ( (int64_t) aX - bbox.GetX() ) / aTileSize );
+    };
+
+    auto row = [&]( int aY )
+    {
+        return std::min<int>( rows - 1, ( (int64_t) aY - bbox.GetY() ) / aTileSize );
+    };
+
+    // A polygon inside a single tile is moved to this tile, a polygon overlapping several
+    // tiles is copied to each of them and clipped by the tile edges
+    std::vector<std::vector<int>> tiles( columns * rows );
+    std::vector<bool>             clipped( count, false );
+
+    for( int ii = 0; ii < count; ii++ )
+    {
+        const BOX2I polyBox = m_polys[ii][0].BBox();
+        const int   firstColumn = column( polyBox.GetLeft() );
+        const int   lastColumn = column( polyBox.GetRight() );
+        const int   firstRow = row( polyBox.GetTop() );
+        const int   lastRow = row( polyBox.GetBottom() );
+
+        clipped[ii] = firstColumn != lastColumn || firstRow != lastRow;
+
+        for( int y = firstRow; y <= lastRow; y++ )
+        {
+            for( int x = firstColumn; x <= lastColumn; x++ )
+                tiles[y * columns + x].push_back( ii );
+        }
+    }
+
+    std::vector<SHAPE_POLY_SET> results( tiles.size() );
+
+    runParallel( tiles.size(),
+            [&]( size_t aIndex )
+            {
+                SHAPE_POLY_SET& tile = results[aIndex];
+                bool            needClip = false;
+
+                for( int ii : tiles[aIndex] )
+                {
+                    if( clipped[ii] )
+                    {
+                        tile.m_polys.push_back( m_polys[ii] );
+                        needClip = true;
+                    }
+                    else
+                    {
+                        tile.m_polys.push_back( std::move( m_polys[ii] ) );
+                    }
+                }
+
+                if( tile.m_polys.empty() )
+                    return;
+
+                if( needClip )
+                {
+                    // The intersection also merges the polygons of the tile
+                    const int      left = bbox.GetX() + (int) ( aIndex % columns ) * aTileSize;
+                    const int      top = bbox.GetY() + (int) ( aIndex / columns ) * aTileSize;
+                    SHAPE_POLY_SET tileArea;
+
+                    tileArea.NewOutline();
+                    tileArea.Append( left, top );
+                    tileArea.Append( left + aTileSize, top );
+                    tileArea.Append( left + aTileSize, top + aTileSize );
+                    tileArea.Append( left, top + aTileSize );
+
+                    tile.BooleanIntersection( tileArea, aFastMode );
+                }
+                else
+                {
+                    tile.Simplify( aFastMode );
+                }
+
+                if( aFracture )
+                {
+                    for( POLYGON& poly : tile.m_polys )
+                        tile.fractureSingle( poly );
+                }
+            } );
+
+    m_polys.clear();
+
+    for( SHAPE_POLY_SET& tile : results )
+    {
+        for( POLYGON& poly : tile.m_polys )
+            m_polys.push_back( std::move( poly ) );
+    }
+}
+
+
 int SHAPE_POLY_SET::NormalizeAreaOutlines()
 {
     // We are expecting only one main outline, but this main outline can have holes
@@ -1111,6 +1723,8 @@ const std::string SHAPE_POLY_SET::Format() const
 
 bool SHAPE_POLY_SET::Parse( std::stringstream& aStream )
 {
+    invalidateCaches();
+
     std::string tmp;
 
     aStream >> tmp;
@@ -1204,6 +1818,23 @@ bool SHAPE_POLY_SET::PointOnEdge( const VECTOR2I& aP ) const
 
 bool SHAPE_POLY_SET::Collide( const SEG& aSeg, int aClearance ) const
 {
+    // Without clearance there is no need to copy (and lose the edge index of) the set
+    if( aClearance <= 0 )
+    {
+        if( Contains( aSeg.A ) )
+            return true;
+
+        if( EDGE_INDEX* index = edgeIndex() )
+            return index->Intersects( aSeg, true );
+
+        for( CONST_SEGMENT_ITERATOR it = CIterateSegments( 0, OutlineCount() - 1, true ); it; it++ )
+        {
+            if( ( *it ).Intersect( aSeg, true ) )
+                return true;
+        }
+
+        return false;
+    }
 
     SHAPE_POLY_SET polySet = SHAPE_POLY_SET( *this );
 
@@ -1235,6 +1866,10 @@ bool SHAPE_POLY_SET::Collide( const SEG& aSeg, int aClearance ) const
 
 bool SHAPE_POLY_SET::Collide( const VECTOR2I& aP, int aClearance ) const
 {
+    // There is a collision if and only if the point is inside of the polygon.
+    if( aClearance <= 0 )
+        return Contains( aP );
+
     SHAPE_POLY_SET polySet = SHAPE_POLY_SET( *this );
 
     // Inflate the polygon if necessary.
@@ -1251,12 +1886,16 @@ bool SHAPE_POLY_SET::Collide( const VECTOR2I& aP, int aClearance ) const
 
 void SHAPE_POLY_SET::RemoveAllContours()
 {
+    invalidateCaches();
+
     m_polys.clear();
 }
 
 
 void SHAPE_POLY_SET::RemoveContour( int aContourIdx, int aPolygonIdx )
 {
+    invalidateCaches();
+
     // Default polygon is the last one
     if( aPolygonIdx < 0 )
         aPolygonIdx += m_polys.size();
@@ -1267,6 +1906,8 @@ void SHAPE_POLY_SET::RemoveContour( int aContourIdx, int aPolygonIdx )
 
 int SHAPE_POLY_SET::RemoveNullSegments()
 {
+    invalidateCaches();
+
     int removed = 0;
 
     ITERATOR iterator = IterateWithHoles();
@@ -1320,12 +1961,16 @@ int SHAPE_POLY_SET::RemoveNullSegments()
 
 void SHAPE_POLY_SET::DeletePolygon( int aIdx )
 {
+    invalidateCaches();
+
     m_polys.erase( m_polys.begin() + aIdx );
 }
 
 
 void SHAPE_POLY_SET::Append( const SHAPE_POLY_SET& aSet )
 {
+    invalidateCaches();
+
     m_polys.insert( m_polys.end(), aSet.m_polys.begin(), aSet.m_polys.end() );
 }
 
@@ -1408,10 +2053,8 @@ void SHAPE_POLY_SET::BuildBBoxCaches()
 {
     for( int polygonIdx = 0; polygonIdx < OutlineCount(); polygonIdx++ )
     {
-        Outline( polygonIdx ).GenerateBBoxCache();
-
-        for( int holeIdx = 0; holeIdx < HoleCount( polygonIdx ); holeIdx++ )
-            Hole( polygonIdx, holeIdx ).GenerateBBoxCache();
+        for( SHAPE_LINE_CHAIN& contour : m_polys[polygonIdx] )
+            contour.GenerateBBoxCache();
     }
 }
 
@@ -1451,6 +2094,8 @@ void SHAPE_POLY_SET::RemoveVertex( int aGlobalIndex )
 
 void SHAPE_POLY_SET::RemoveVertex( VERTEX_INDEX aIndex )
 {
+    invalidateCaches();
+
     m_polys[aIndex.m_polygon][aIndex.m_contour].Remove( aIndex.m_vertex );
 }
 
@@ -1468,6 +2113,8 @@ void SHAPE_POLY_SET::SetVertex( int aGlobalIndex, const VECTOR2I& aPos )
 
 void SHAPE_POLY_SET::SetVertex( const VERTEX_INDEX& aIndex, const VECTOR2I& aPos )
 {
+    invalidateCaches();
+
     m_polys[aIndex.m_polygon][aIndex.m_contour].SetPoint( aIndex.m_vertex, aPos );
 }
 
@@ -1475,6 +2122,9 @@ void SHAPE_POLY_SET::SetVertex( const VERTEX_INDEX& aIndex, const VECTOR2I& aPos
 bool SHAPE_POLY_SET::containsSingle( const VECTOR2I& aP, int aSubpolyIndex, int aAccuracy,
                                      bool aUseBBoxCaches ) const
 {
+    if( EDGE_INDEX* index = edgeIndex() )
+        return index->Contains( aSubpolyIndex, aP, aAccuracy );
+
     // Check that the point is inside the outline
     if( m_polys[aSubpolyIndex][0].PointInside( aP, aAccuracy ) )
     {
@@ -1498,6 +2148,8 @@ bool SHAPE_POLY_SET::containsSingle( const VECTOR2I& aP, int aSubpolyIndex, int
 
 void SHAPE_POLY_SET::Move( const VECTOR2I& aVector )
 {
+    invalidateCaches();
+
     for( POLYGON& poly : m_polys )
     {
         for( SHAPE_LINE_CHAIN& path : poly )
@@ -1508,6 +2160,8 @@ void SHAPE_POLY_SET::Move( const VECTOR2I& aVector )
 
 void SHAPE_POLY_SET::Mirror( bool aX, bool aY, const VECTOR2I& aRef )
 {
+    invalidateCaches();
+
     for( POLYGON& poly : m_polys )
     {
         for( SHAPE_LINE_CHAIN& path : poly )
@@ -1520,6 +2174,8 @@ void SHAPE_POLY_SET::Mirror( bool aX, bool aY, const VECTOR2I& aRef )
 
 void SHAPE_POLY_SET::Rotate( double aAngle, const VECTOR2I& aCenter )
 {
+    invalidateCaches();
+
     for( POLYGON& poly : m_polys )
     {
         for( SHAPE_LINE_CHAIN& path : poly )
@@ -1566,6 +2222,14 @@ int SHAPE_POLY_SET::DistanceToPolygon( VECTOR2I aPoint, int aPolygonIndex )
     if( containsSingle( aPoint, aPolygonIndex, 1 ) )
         return 0;
 
+    if( EDGE_INDEX* index = edgeIndex() )
+    {
+        int minDistance = index->Distance( aPolygonIndex, SEG( aPoint, aPoint ), true );
+
+        if( minDistance >= 0 )
+            return minDistance;
+    }
+
     SEGMENT_ITERATOR iterator = IterateSegmentsWithHoles( aPolygonIndex );
 
     SEG polygonEdge = *iterator;
@@ -1594,19 +2258,25 @@ int SHAPE_POLY_SET::DistanceToPolygon( const SEG& aSegment, int aPolygonIndex, i
     if( containsSingle( aSegment.A, aPolygonIndex, 1 ) )
         return 0;
 
-    SEGMENT_ITERATOR iterator = IterateSegmentsWithHoles( aPolygonIndex );
-
-    SEG polygonEdge = *iterator;
-    int minDistance = polygonEdge.Distance( aSegment );
+    EDGE_INDEX* index = edgeIndex();
+    int minDistance = index ? index->Distance( aPolygonIndex, aSegment, false ) : -1;
 
-    for( iterator++; iterator && minDistance > 0; iterator++ )
+    if( minDistance < 0 )
     {
-        polygonEdge = *iterator;
+        SEGMENT_ITERATOR iterator = IterateSegmentsWithHoles( aPolygonIndex );
 
-        int currentDistance = polygonEdge.Distance( aSegment );
+        SEG polygonEdge = *iterator;
+        minDistance = polygonEdge.Distance( aSegment );
 
-        if( currentDistance < minDistance )
-            minDistance = currentDistance;
+        for( iterator++; iterator && minDistance > 0; iterator++ )
+        {
+            polygonEdge = *iterator;
+
+            int currentDistance = polygonEdge.Distance( aSegment );
+
+            if( currentDistance < minDistance )
+                minDistance = currentDistance;
+        }
     }
 
     // Take into account the width of the segment
@@ -1860,6 +2530,8 @@ SHAPE_POLY_SET::POLYGON SHAPE_POLY_SET::chamferFilletPolygon( CORNER_MODE aMode,
 
 SHAPE_POLY_SET &SHAPE_POLY_SET::operator=( const SHAPE_POLY_SET& aOther )
 {
+    invalidateCaches();
+
     static_cast<SHAPE&>(*this) = aOther;
     m_polys = aOther.m_polys;
 
@@ -1920,26 +2592,50 @@ void SHAPE_POLY_SET::CacheTriangulation()
     if( tmpSet.HasHoles() )
         tmpSet.Fracture( PM_FAST );
 
+    // Each outline of the fractured set is triangulated independently
+    const size_t count = tmpSet.OutlineCount();
+    std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> results( count );
+    std::vector<char> succeeded( count, 0 );
+
+    runParallel( count,
+            [&]( size_t aIndex )
+            {
+                results[aIndex] = std::make_unique<TRIANGULATED_POLYGON>();
+                PolygonTriangulation tess( *results[aIndex] );
+                succeeded[aIndex] = tess.TesselatePolygon( tmpSet.CPolygon( aIndex ).front() );
+            } );
+
     m_triangulatedPolys.clear();
     m_triangulationValid = true;
 
-    while( tmpSet.OutlineCount() > 0 )
+    // If the tesselation fails, we re-fracture the polygon, which will first simplify the
+    // system before fracturing and removing the holes.  This may result in multiple, disjoint
+    // polygons.
+    SHAPE_POLY_SET failed;
+
+    for( size_t ii = 0; ii < count; ii++ )
     {
-        m_triangulatedPolys.push_back( std::make_unique<TRIANGULATED_POLYGON>() );
-        PolygonTriangulation tess( *m_triangulatedPolys.back() );
+        if( succeeded[ii] )
+            m_triangulatedPolys.push_back( std::move( results[ii] ) );
+        else
+            failed.AddOutline( tmpSet.CPolygon( ii ).front() );
+    }
 
-        // If the tesselation fails, we re-fracture the polygon, which will
-        // first simplify the system before fracturing and removing the holes
-        // This may result in multiple, disjoint polygons.
-        if( !tess.TesselatePolygon( tmpSet.Polygon( 0 ).front() ) )
+    if( failed.OutlineCount() > 0 )
+    {
+        failed.Fracture( PM_FAST );
+
+        for( int ii = 0; ii < failed.OutlineCount(); ii++ )
         {
-            tmpSet.Fracture( PM_FAST );
-            m_triangulationValid = false;
-            continue;
-        }
+            m_triangulatedPolys.push_back( std::make_unique<TRIANGULATED_POLYGON>() );
+            PolygonTriangulation tess( *m_triangulatedPolys.back() );
 
-        tmpSet.DeletePolygon( 0 );
-        m_triangulationValid = true;
+            if( !tess.TesselatePolygon( failed.CPolygon( ii ).front() ) )
+            {
+                m_triangulatedPolys.pop_back();
+                m_triangulationValid = false;
+            }
+        }
     }
 
     if( m_triangulationValid )
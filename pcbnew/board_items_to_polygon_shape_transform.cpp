@@ -113,6 +113,10 @@ void BOARD::ConvertBrdLayerToPolygonalContours( PCB_LAYER_ID aLayer, SHAPE_POLY_
             break;
         }
     }
+
+    // Most items are small and far apart: merging them cluster by cluster is much faster
+    // than a single union of the whole layer
+    aOutlines.SimplifyClustered( SHAPE_POLY_SET::PM_FAST );
 }
 
 
@@ -594,7 +594,7 @@ public:
      * Holes in vias or pads are ignored
      * Usefull to export the shape of copper layers to dxf polygons
      * or 3D viewer
-     * the polygons are not merged.
+     * the polygons are merged (see SHAPE_POLY_SET::SimplifyClustered()).
      * @param aLayer = A copper layer, like B_Cu, etc.
      * @param aOutlines The SHAPE_POLY_SET to fill in with items outline.
      */
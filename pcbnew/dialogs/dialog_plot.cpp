@@ -28,6 +28,7 @@
 #include <pcb_edit_frame.h>
 #include <pcbnew_settings.h>
 #include <pcbplot.h>
+#include <plot_job_runner.h>
 #include <gerber_jobfile_writer.h>
 #include <reporter.h>
 #include <wildcards_and_files_ext.h>
@@ -40,6 +41,7 @@
 #include <drc/drc.h>
 #include <tool/tool_manager.h>
 #include <tools/zone_filler_tool.h>
+#include <widgets/progress_reporter.h>
 #include <math/util.h>      // for KiROUND
 #include <macros.h>
 
@@ -156,6 +158,9 @@ void DIALOG_PLOT::init_Dialog()
     // Gerber precision for coordinates
     m_coordFormatCtrl->SetSelection( m_plotOpts.GetGerberPrecision() == 5 ? 0 : 1 );
 
+    // Option to plot the copper layers as merged regions
+    m_mergeCopperRegions->SetValue( m_plotOpts.GetGerberMergeCopper() );
+
     // SVG precision and units for coordinates
     m_svgPrecsision->SetValue( m_plotOpts.GetSvgPrecision() );
     m_svgUnits->SetSelection( m_plotOpts.GetSvgUseInch() );
@@ -705,6 +710,7 @@ void DIALOG_PLOT::applyPlotSettings()
     tempOptions.SetCreateGerberJobFile( m_generateGerberJobFile->GetValue() );
 
     tempOptions.SetGerberPrecision( m_coordFormatCtrl->GetSelection() == 0 ? 5 : 6 );
+    tempOptions.SetGerberMergeCopper( m_mergeCopperRegions->GetValue() );
     tempOptions.SetSvgPrecision( m_svgPrecsision->GetValue(), m_svgUnits->GetSelection() );
 
     LSET selectedLayers;
@@ -826,6 +832,9 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
 
     wxBusyCursor dummy;
 
+    // The layers are plotted in parallel, each one in its own file
+    PLOT_JOB_RUNNER jobRunner( board );
+
     for( LSEQ seq = m_plotOpts.GetLayerSelection().UIOrder();  seq;  ++seq )
     {
         PCB_LAYER_ID layer = *seq;
@@ -851,29 +860,15 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
         wxString fullname = fn.GetFullName();
         jobfile_writer.AddGbrFile( layer, fullname );
 
-        LOCALE_IO toggle;
+        jobRunner.AddLayerJob( layer, fn.GetFullPath(), m_plotOpts );
+    }
 
-        PLOTTER*    plotter = StartPlotBoard( board, &m_plotOpts, layer, fn.GetFullPath(), wxEmptyString );
+    if( jobRunner.GetJobCount() )
+    {
+        WX_PROGRESS_REPORTER progressReporter( this, _( "Plotting" ), 1, false );
 
         // Print diags in messages box:
-        wxString msg;
-
-        if( plotter )
-        {
-            PlotOneBoardLayer( board, plotter, layer, m_plotOpts );
-            plotter->EndPlot();
-            delete plotter;
-
-            msg.Printf( _( "Plot file \"%s\" created." ), fn.GetFullPath() );
-            reporter.Report( msg, RPT_SEVERITY_ACTION );
-        }
-        else
-        {
-            msg.Printf( _( "Unable to create file \"%s\"." ), fn.GetFullPath() );
-            reporter.Report( msg, RPT_SEVERITY_ERROR );
-        }
-
-        wxSafeYield();      // displays report message.
+        jobRunner.Run( &reporter, &progressReporter );
     }
 
     if( m_plotOpts.GetFormat() == PLOT_FORMAT::GERBER && m_plotOpts.GetCreateGerberJobFile() )
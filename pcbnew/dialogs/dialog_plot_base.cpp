@@ -199,6 +199,11 @@ DIALOG_PLOT_BASE::DIALOG_PLOT_BASE( wxWindow* parent, wxWindowID id, const wxStr
 
 	gbSizer2->Add( m_subtractMaskFromSilk, wxGBPosition( 2, 0 ), wxGBSpan( 1, 1 ), wxALIGN_CENTER_VERTICAL, 5 );
 
+	m_mergeCopperRegions = new wxCheckBox( m_GerberOptionsSizer->GetStaticBox(), wxID_ANY, _("Merge copper into regions"), wxDefaultPosition, wxDefaultSize, 0 );
+	m_mergeCopperRegions->SetToolTip( _("Plot each copper layer as the union of its items, drawn as regions.\nGives much smaller files for boards having planes, but pads and tracks\nlose their aperture and net attributes.") );
+
+	gbSizer2->Add( m_mergeCopperRegions, wxGBPosition( 3, 0 ), wxGBSpan( 1, 1 ), wxALIGN_CENTER_VERTICAL, 5 );
+
 	coordFormatLabel = new wxStaticText( m_GerberOptionsSizer->GetStaticBox(), wxID_ANY, _("Coordinate format:"), wxDefaultPosition, wxDefaultSize, 0 );
 	coordFormatLabel->Wrap( -1 );
 	gbSizer2->Add( coordFormatLabel, wxGBPosition( 0, 1 ), wxGBSpan( 1, 1 ), wxALIGN_CENTER_VERTICAL|wxLEFT, 30 );
@@ -91,6 +91,7 @@ class DIALOG_PLOT_BASE : public DIALOG_SHIM
 		wxCheckBox* m_useGerberExtensions;
 		wxCheckBox* m_generateGerberJobFile;
 		wxCheckBox* m_subtractMaskFromSilk;
+		wxCheckBox* m_mergeCopperRegions;
 		wxStaticText* coordFormatLabel;
 		wxChoice* m_coordFormatCtrl;
 		wxCheckBox* m_useGerberX2Format;
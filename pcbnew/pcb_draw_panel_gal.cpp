@@ -106,6 +106,13 @@ const LAYER_NUM GAL_LAYER_ORDER[] =
 };
 
 
+///> Scale below which copper is drawn as merged outlines (about 5 pixels per millimeter)
+static const double LOD_PROXY_MAX_SCALE = 1.5;
+
+///> Size of the cells copper outlines are merged and rebuilt by
+static const int LOD_PROXY_CELL_SIZE = Millimeter2iu( 10 );
+
+
 PCB_DRAW_PANEL_GAL::PCB_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWindowId,
                                         const wxPoint& aPosition, const wxSize& aSize,
                                         KIGFX::GAL_DISPLAY_OPTIONS& aOptions, GAL_TYPE aGalType ) :
@@ -117,6 +124,17 @@ PCB_DRAW_PANEL_GAL::PCB_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWin
     m_painter = std::make_unique<KIGFX::PCB_PAINTER>( m_gal );
     m_view->SetPainter( m_painter.get() );
 
+    // Boards have many items, whose geometry (texts, zones, pads) is expensive to build
+    m_view->SetParallelCaching( true );
+
+    // When zoomed out, tracks, pads and zone fillings are drawn as merged outlines instead of
+    // hundreds of thousands of items
+    for( int layer = F_Cu; layer <= B_Cu; ++layer )
+        m_view->SetLayerLODProxy( layer, LOD_PROXY_MAX_SCALE, LOD_PROXY_CELL_SIZE );
+
+    for( int layer : { LAYER_PAD_FR, LAYER_PAD_BK, LAYER_PADS_TH } )
+        m_view->SetLayerLODProxy( layer, LOD_PROXY_MAX_SCALE, LOD_PROXY_CELL_SIZE );
+
     setDefaultLayerOrder();
     setDefaultLayerDeps();
 
@@ -405,6 +405,68 @@ bool PCB_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
 }
 
 
+bool PCB_PAINTER::GetLODProxy( const VIEW_ITEM* aItem, int aLayer,
+                               SHAPE_POLY_SET& aOutlines ) const
+{
+    const EDA_ITEM* item = dynamic_cast<const EDA_ITEM*>( aItem );
+
+    if( !item )
+        return false;
+
+    // Proxies are filled with the layer color, so selected, brightened or highlighted items
+    // have to be drawn by themselves
+    if( m_pcbSettings.GetColor( aItem, aLayer ) != m_pcbSettings.GetColor( nullptr, aLayer ) )
+        return false;
+
+    switch( item->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    {
+        constexpr int clearanceFlags = PCB_RENDER_SETTINGS::CL_EXISTING
+                                       | PCB_RENDER_SETTINGS::CL_TRACKS;
+
+        if( !IsCopperLayer( aLayer ) || m_pcbSettings.m_sketchMode[LAYER_TRACKS]
+                || ( m_pcbSettings.m_clearance & clearanceFlags ) == clearanceFlags )
+            return false;
+
+        static_cast<const TRACK*>( item )->TransformShapeWithClearanceToPolygon( aOutlines, 0 );
+        return true;
+    }
+
+    case PCB_PAD_T:
+    {
+        const D_PAD* pad = static_cast<const D_PAD*>( item );
+
+        if( ( aLayer != LAYER_PAD_FR && aLayer != LAYER_PAD_BK && aLayer != LAYER_PADS_TH )
+                || m_pcbSettings.m_sketchMode[LAYER_PADS_TH]
+                || ( m_pcbSettings.m_clearance & PCB_RENDER_SETTINGS::CL_PADS ) )
+            return false;
+
+        pad->TransformShapeWithClearanceToPolygon( aOutlines, 0 );
+        return true;
+    }
+
+    case PCB_ZONE_AREA_T:
+    {
+        const ZONE_CONTAINER* zone = static_cast<const ZONE_CONTAINER*>( item );
+
+        // Only the filling is kept, the zone outline and hatching are not drawn when zoomed out
+        if( !IsCopperLayer( aLayer ) || !zone->IsOnLayer( (PCB_LAYER_ID) aLayer )
+                || zone->GetIsKeepout()
+                || m_pcbSettings.m_displayZone != PCB_RENDER_SETTINGS::DZ_SHOW_FILLED )
+            return false;
+
+        aOutlines.Append( zone->GetFilledPolysList() );
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+
 void PCB_PAINTER::draw( const TRACK* aTrack, int aLayer )
 {
     VECTOR2D start( aTrack->GetStart() );
@@ -860,11 +922,11 @@ void PCB_PAINTER::draw( const D_PAD* aPad, int aLayer )
         case F_Paste:
         case B_Paste:
             {
-            wxSize pad_size = aPad->GetSize();
+            // Resize a copy: the pad may be drawn by other threads at the same time
+            D_PAD  pastePad( *aPad );
             wxSize margin = aPad->GetSolderPasteMargin();
-            const_cast<D_PAD*>(aPad)->SetSize( pad_size + margin + margin );
-            aPad->TransformShapeWithClearanceToPolygon( polySet, 0 );
-            const_cast<D_PAD*>(aPad)->SetSize( pad_size );
+            pastePad.SetSize( aPad->GetSize() + margin + margin );
+            pastePad.TransformShapeWithClearanceToPolygon( polySet, 0 );
             }
             break;
 
@@ -240,6 +240,18 @@ public:
     /// @copydoc PAINTER::Draw()
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) override;
 
+    /// @copydoc PAINTER::GetLODProxy()
+    virtual bool GetLODProxy( const VIEW_ITEM* aItem, int aLayer,
+                              SHAPE_POLY_SET& aOutlines ) const override;
+
+    /// @copydoc PAINTER::Clone()
+    virtual PAINTER* Clone( GAL* aGal ) override
+    {
+        PCB_PAINTER* painter = new PCB_PAINTER( aGal );
+        painter->ApplySettings( &m_pcbSettings );
+        return painter;
+    }
+
 protected:
     PCB_RENDER_SETTINGS m_pcbSettings;
 
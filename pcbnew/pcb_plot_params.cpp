@@ -107,6 +107,7 @@ PCB_PLOT_PARAMS::PCB_PLOT_PARAMS()
     m_includeGerberNetlistInfo   = true;
     m_createGerberJobFile        = true;
     m_gerberPrecision            = gbrDefaultPrecision;
+    m_gerberMergeCopper          = false;
     // we used 0.1mils for SVG step before, but nm precision is more accurate, so we use nm
     m_svgPrecision               = SVG_PRECISION_DEFAULT;
     m_svgUseInch                 = false;
@@ -208,6 +209,10 @@ void PCB_PLOT_PARAMS::Format( OUTPUTFORMATTER* aFormatter,
         aFormatter->Print( aNestLevel+1, "(%s %d)\n",
                            getTokenName( T_gerberprecision ), m_gerberPrecision );
 
+    if( m_gerberMergeCopper )   // save this option only if set, for the same reason
+        aFormatter->Print( aNestLevel+1, "(%s %s)\n",
+                           getTokenName( T_gerbermergecopper ), trueStr );
+
     // Svg options
     aFormatter->Print( aNestLevel+1, "(%s %s)\n", getTokenName( T_svguseinch ),
                        m_svgUseInch ? trueStr : falseStr );
@@ -287,6 +292,8 @@ bool PCB_PLOT_PARAMS::IsSameAs( const PCB_PLOT_PARAMS &aPcbPlotParams, bool aCom
         return false;
     if( m_gerberPrecision != aPcbPlotParams.m_gerberPrecision )
         return false;
+    if( m_gerberMergeCopper != aPcbPlotParams.m_gerberMergeCopper )
+        return false;
     if( m_excludeEdgeLayer != aPcbPlotParams.m_excludeEdgeLayer )
         return false;
     if( m_lineWidth != aPcbPlotParams.m_lineWidth )
@@ -464,6 +471,10 @@ void PCB_PLOT_PARAMS_PARSER::Parse( PCB_PLOT_PARAMS* aPcbPlotParams )
                 parseInt( gbrDefaultPrecision-1, gbrDefaultPrecision);
             break;
 
+        case T_gerbermergecopper:
+            aPcbPlotParams->m_gerberMergeCopper = parseBool();
+            break;
+
         case T_svgprecision:
             aPcbPlotParams->m_svgPrecision = parseInt( SVG_PRECISION_MIN, SVG_PRECISION_MAX );
             break;
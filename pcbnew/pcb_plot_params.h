@@ -123,6 +123,12 @@ private:
     /// 5 is the minimal value for professional boards.
     int         m_gerberPrecision;
 
+    /** Gerber format: plot the copper layers as regions, the union of all the items of the
+     * layer, instead of flashing pads and drawing tracks.  Gives much smaller files for boards
+     * having planes, but pads and tracks lose their aperture and net attributes.
+     */
+    bool        m_gerberMergeCopper;
+
     /// precision of coordinates in SVG files: accepted 3 - 6
     /// 6 is the internal resolution of Pcbnew
     unsigned    m_svgPrecision;
@@ -306,6 +312,9 @@ public:
     void        SetGerberPrecision( int aPrecision );
     int         GetGerberPrecision() const { return m_gerberPrecision; }
 
+    void        SetGerberMergeCopper( bool aMerge ) { m_gerberMergeCopper = aMerge; }
+    bool        GetGerberMergeCopper() const { return m_gerberMergeCopper; }
+
     void        SetSvgPrecision( unsigned aPrecision, bool aUseInch );
     unsigned    GetSvgPrecision() const { return m_svgPrecision; }
     bool        GetSvgUseInch() const { return m_svgUseInch; }
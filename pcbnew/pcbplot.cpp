@@ -37,6 +37,7 @@
 #include <class_board.h>
 #include <pcbnew.h>
 #include <plotcontroller.h>
+#include <plot_job_runner.h>
 #include <pcb_plot_params.h>
 #include <wx/ffile.h>
 #include <dialog_plot.h>
@@ -416,6 +417,34 @@ PLOT_CONTROLLER::~PLOT_CONTROLLER()
 }
 
 
+bool PLOT_CONTROLLER::buildPlotFileName( LAYER_NUM aLayer, const wxString& aSuffix,
+                                         PLOT_FORMAT aFormat, wxFileName& aPlotFile )
+{
+    // Compute the full filename for the output (after ensuring the output directory is OK)
+    wxString outputDirName = GetPlotOptions().GetOutputDirectory() ;
+    wxFileName outputDir = wxFileName::DirName( outputDirName );
+    wxString boardFilename = m_board->GetFileName();
+
+    if( !EnsureFileDirectoryExists( &outputDir, boardFilename ) )
+        return false;
+
+    // outputDir contains now the full path of plot files
+    aPlotFile = boardFilename;
+    aPlotFile.SetPath( outputDir.GetPath() );
+    wxString fileExt = GetDefaultPlotExtension( aFormat );
+
+    // Gerber format can use specific file ext, depending on layers
+    // (now not a good practice, because the official file ext is .gbr)
+    if( aFormat == PLOT_FORMAT::GERBER && GetPlotOptions().GetUseGerberProtelExtensions() )
+        fileExt = GetGerberProtelExtension( aLayer );
+
+    // Build plot filenames from the board name and layer names:
+    BuildPlotFileName( &aPlotFile, outputDir.GetPath(), aSuffix, fileExt );
+
+    return true;
+}
+
+
 /* IMPORTANT THING TO KNOW: the locale during plots *MUST* be kept as
  * C/POSIX using a LOCALE_IO object on the stack. This even when
  * opening/closing the plotfile, since some drivers do I/O even then */
@@ -450,27 +479,8 @@ bool PLOT_CONTROLLER::OpenPlotfile(
     ClosePlot();
 
     // Now compute the full filename for the output and start the plot
-    // (after ensuring the output directory is OK)
-    wxString outputDirName = GetPlotOptions().GetOutputDirectory() ;
-    wxFileName outputDir = wxFileName::DirName( outputDirName );
-    wxString boardFilename = m_board->GetFileName();
-
-    if( EnsureFileDirectoryExists( &outputDir, boardFilename ) )
+    if( buildPlotFileName( GetLayer(), aSuffix, aFormat, m_plotFile ) )
     {
-        // outputDir contains now the full path of plot files
-        m_plotFile = boardFilename;
-        m_plotFile.SetPath( outputDir.GetPath() );
-        wxString fileExt = GetDefaultPlotExtension( aFormat );
-
-        // Gerber format can use specific file ext, depending on layers
-        // (now not a good practice, because the official file ext is .gbr)
-        if( GetPlotOptions().GetFormat() == PLOT_FORMAT::GERBER
-                && GetPlotOptions().GetUseGerberProtelExtensions() )
-            fileExt = GetGerberProtelExtension( GetLayer() );
-
-        // Build plot filenames from the board name and layer names:
-        BuildPlotFileName( &m_plotFile, outputDir.GetPath(), aSuffix, fileExt );
-
         m_plotter = StartPlotBoard( m_board, &GetPlotOptions(), ToLAYER_ID( GetLayer() ),
                                     m_plotFile.GetFullPath(), aSheetDesc );
     }
@@ -510,3 +520,47 @@ bool PLOT_CONTROLLER::GetColorMode()
 
     return m_plotter->GetColorMode();
 }
+
+
+bool PLOT_CONTROLLER::QueueLayer( LAYER_NUM aLayer, const wxString& aSuffix, PLOT_FORMAT aFormat,
+                                  const wxString& aSheetDesc )
+{
+    // Same as OpenPlotfile(): the format is saved in the plot options
+    GetPlotOptions().SetFormat( aFormat );
+
+    wxFileName plotFile;
+
+    if( !buildPlotFileName( aLayer, aSuffix, aFormat, plotFile ) )
+        return false;
+
+    if( !m_jobRunner )
+        m_jobRunner = std::make_unique<PLOT_JOB_RUNNER>( m_board );
+
+    m_jobRunner->AddLayerJob( ToLAYER_ID( aLayer ), plotFile.GetFullPath(), GetPlotOptions(),
+                              aSheetDesc );
+    return true;
+}
+
+
+bool PLOT_CONTROLLER::QueueDrillFiles( EXCELLON_WRITER* aWriter, bool aGenDrill, bool aGenMap )
+{
+    wxFileName outputDir = wxFileName::DirName( GetPlotOptions().GetOutputDirectory() );
+
+    if( !EnsureFileDirectoryExists( &outputDir, m_board->GetFileName() ) )
+        return false;
+
+    if( !m_jobRunner )
+        m_jobRunner = std::make_unique<PLOT_JOB_RUNNER>( m_board );
+
+    m_jobRunner->AddDrillJob( aWriter, outputDir.GetPathWithSep(), aGenDrill, aGenMap );
+    return true;
+}
+
+
+bool PLOT_CONTROLLER::PlotQueuedJobs( REPORTER* aReporter )
+{
+    if( !m_jobRunner )
+        return true;
+
+    return m_jobRunner->Run( aReporter ) == 0;
+}
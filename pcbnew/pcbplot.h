@@ -171,6 +171,14 @@ PLOTTER* StartPlotBoard( BOARD* aBoard,
 void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, PCB_LAYER_ID aLayer,
                         const PCB_PLOT_PARAMS& aPlotOpt );
 
+/**
+ * Function PlotLayerChangesBoardSettings
+ * @return true if PlotOneBoardLayer() temporarily changes board wide settings to plot aLayer
+ * (solder mask layers with a minimum width), so the layer cannot be plotted while other
+ * layers of the board are plotted.
+ */
+bool PlotLayerChangesBoardSettings( BOARD* aBoard, PCB_LAYER_ID aLayer );
+
 /**
  * Function PlotStandardLayer
  * plot copper or technical layers.
@@ -195,6 +203,20 @@ void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, PCB_LAYER_ID aLayer,
 void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                         const PCB_PLOT_PARAMS& aPlotOpt );
 
+/**
+ * Function PlotMergedCopperLayer
+ * plot copper layers as regions, the union of their pads, vias, tracks and filled zones,
+ * instead of flashing pads and drawing tracks (graphic items are plotted like in
+ * PlotStandardLayer()).  Used for Gerber files, when PCB_PLOT_PARAMS::GetGerberMergeCopper()
+ * is set.  Pads and tracks lose their aperture and net attributes.
+ * @param aBoard = the board to plot
+ * @param aPlotter = the plotter to use
+ * @param aLayerMask = the mask to define the layers to plot
+ * @param aPlotOpt = the plot options (files options, drill marks)
+ */
+void PlotMergedCopperLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
+                            const PCB_PLOT_PARAMS& aPlotOpt );
+
 /**
  * Function PlotLayerOutlines
  * plot copper outline of a copper layer.
@@ -55,6 +55,8 @@
 #include <pcb_painter.h>
 #include <gbr_metadata.h>
 
+#include <memory>
+
 /*
  * Plot a solder mask layer.  Solder mask layers have a minimum thickness value and cannot be
  * drawn like standard layers, unless the minimum thickness is 0.
@@ -179,7 +181,12 @@ void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, PCB_LAYER_ID aLayer,
         else
         {
             plotOpt.SetSkipPlotNPTH_Pads( true );
-            PlotStandardLayer( aBoard, aPlotter, layer_mask, plotOpt );
+
+            if( plotOpt.GetFormat() == PLOT_FORMAT::GERBER && plotOpt.GetGerberMergeCopper()
+                    && plotOpt.GetPlotMode() == FILLED )
+                PlotMergedCopperLayer( aBoard, aPlotter, layer_mask, plotOpt );
+            else
+                PlotStandardLayer( aBoard, aPlotter, layer_mask, plotOpt );
         }
     }
     else
@@ -289,6 +296,14 @@ void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, PCB_LAYER_ID aLayer,
 }
 
 
+bool PlotLayerChangesBoardSettings( BOARD* aBoard, PCB_LAYER_ID aLayer )
+{
+    // PlotSolderMaskLayer() changes the board max error and the arc radius correction
+    return ( aLayer == B_Mask || aLayer == F_Mask )
+            && aBoard->GetDesignSettings().m_SolderMaskMinWidth != 0;
+}
+
+
 /* Plot a copper layer or mask.
  * Silk screen layers are not plotted here.
  */
@@ -360,10 +375,8 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             extraSize.x += width_adj;
             extraSize.y += width_adj;
 
-            // Store these parameters that can be modified to plot inflated/deflated pads shape
-            wxSize deltaSize = pad->GetDelta(); // has meaning only for trapezoidal pads
-            PAD_SHAPE_T padShape = pad->GetShape();
-            double padCornerRadius = pad->GetRoundRectCornerRadius();
+            // Trapezoidal pads are also inflated/deflated by changing their delta
+            wxSize padPlotsDelta = pad->GetDelta();
 
             if( pad->GetShape() == PAD_SHAPE_TRAPEZOID )
             {   // The easy way is to use BuildPadPolygon to calculate
@@ -396,7 +409,7 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
                 else
                     delta.y = coord[1].x - coord[0].x;
 
-                pad->SetDelta( delta );
+                padPlotsDelta = delta;
             }
             else
                 padPlotsSize = pad->GetSize() + extraSize;
@@ -413,38 +426,46 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             if( pad->GetLayerSet()[F_Cu] )
                 color = color.LegacyMix( aPlotOpt.ColorSettings()->GetColor( LAYER_PAD_FR ) );
 
-            // Temporary set the pad size to the required plot size:
-            wxSize tmppadsize = pad->GetSize();
+            // The board pads are not modified, because layers can be plotted by several threads
+            // at once: a copy of the pad is plotted when its plot size or shape is not its own.
+            D_PAD*                 plotPad = pad;
+            std::unique_ptr<D_PAD> padCopy;
+
+            if( pad->GetShape() != PAD_SHAPE_CUSTOM
+                    && ( padPlotsSize != pad->GetSize() || padPlotsDelta != pad->GetDelta()
+                         || ( pad->GetShape() == PAD_SHAPE_RECT && margin.x > 0 ) ) )
+            {
+                padCopy = std::make_unique<D_PAD>( *pad );
+                padCopy->SetSize( padPlotsSize );
+                padCopy->SetDelta( padPlotsDelta );
+                plotPad = padCopy.get();
+            }
 
             switch( pad->GetShape() )
             {
             case PAD_SHAPE_CIRCLE:
             case PAD_SHAPE_OVAL:
-                pad->SetSize( padPlotsSize );
-
                 if( aPlotOpt.GetSkipPlotNPTH_Pads() &&
                     ( aPlotOpt.GetDrillMarksType() == PCB_PLOT_PARAMS::NO_DRILL_SHAPE ) &&
-                    ( pad->GetSize() == pad->GetDrillSize() ) &&
-                    ( pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED ) )
+                    ( plotPad->GetSize() == plotPad->GetDrillSize() ) &&
+                    ( plotPad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED ) )
                     break;
 
-                itemplotter.PlotPad( pad, color, plotMode );
+                itemplotter.PlotPad( plotPad, color, plotMode );
                 break;
 
             case PAD_SHAPE_RECT:
                 if( margin.x > 0 )
                 {
-                    pad->SetShape( PAD_SHAPE_ROUNDRECT );
-                    pad->SetSize( padPlotsSize );
-                    pad->SetRoundRectCornerRadius( margin.x );
+                    plotPad->SetShape( PAD_SHAPE_ROUNDRECT );
+                    plotPad->SetRoundRectCornerRadius( margin.x );
                 }
                 KI_FALLTHROUGH;
 
             case PAD_SHAPE_TRAPEZOID:
             case PAD_SHAPE_ROUNDRECT:
             case PAD_SHAPE_CHAMFERED_RECT:
-                pad->SetSize( padPlotsSize );
-                itemplotter.PlotPad( pad, color, plotMode );
+                itemplotter.PlotPad( plotPad, color, plotMode );
                 break;
 
             case PAD_SHAPE_CUSTOM:
@@ -473,12 +494,6 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             }
                 break;
             }
-
-            // Restore the pad parameters modified by the plot code
-            pad->SetSize( tmppadsize );
-            pad->SetDelta( deltaSize );
-            pad->SetShape( padShape );
-            pad->SetRoundRectCornerRadius( padCornerRadius );
         }
 
         aPlotter->EndBlock( NULL );
@@ -652,6 +667,105 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
 }
 
 
+/* Plot a copper layer as regions: the union of its pads, vias, tracks and filled zones.
+ * The union is built tile by tile, in parallel, so the regions are cut at the tile edges.
+ * Graphic items are plotted like in PlotStandardLayer().
+ */
+void PlotMergedCopperLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
+                            const PCB_PLOT_PARAMS& aPlotOpt )
+{
+    // Large enough to keep the count of regions low, small enough to use all the cores
+    const int tileSize = Millimeter2iu( 25 );
+
+    BRDITEMS_PLOTTER itemplotter( aPlotter, aBoard, aPlotOpt );
+
+    itemplotter.SetLayerSet( aLayerMask );
+
+    // Plot edge layer and graphic items
+    itemplotter.PlotBoardGraphicItems();
+
+    for( MODULE* module : aBoard->Modules() )
+    {
+        if( ! itemplotter.PlotAllTextsModule( module ) )
+        {
+            wxLogMessage( _( "Your BOARD has a bad layer number for footprint %s" ),
+                          module->GetReference() );
+        }
+
+        for( BOARD_ITEM* item : module->GraphicalItems() )
+        {
+            if( item->Type() == PCB_MODULE_EDGE_T && aLayerMask[ item->GetLayer() ] )
+                itemplotter.Plot_1_EdgeModule( (EDGE_MODULE*) item );
+        }
+    }
+
+    // Same rule as PlotStandardLayer() to skip NPTH pads having no copper
+    bool skipNPTH = aPlotOpt.GetSkipPlotNPTH_Pads()
+                    && aPlotOpt.GetDrillMarksType() == PCB_PLOT_PARAMS::NO_DRILL_SHAPE;
+    int  maxError = aBoard->GetDesignSettings().m_MaxError;
+
+    GBR_METADATA gbr_metadata;
+    gbr_metadata.SetApertureAttrib( GBR_APERTURE_METADATA::GBR_APERTURE_ATTRIB_CONDUCTOR );
+    gbr_metadata.SetCopper( true );
+
+    for( LSEQ seq = ( aLayerMask & LSET::AllCuMask() ).Seq(); seq; ++seq )
+    {
+        PCB_LAYER_ID   layer = *seq;
+        SHAPE_POLY_SET copper;
+
+        for( MODULE* module : aBoard->Modules() )
+            module->TransformPadsShapesWithClearanceToPolygon( layer, copper, 0, maxError,
+                                                               skipNPTH );
+
+        for( TRACK* track : aBoard->Tracks() )
+        {
+            if( track->IsOnLayer( layer ) )
+                track->TransformShapeWithClearanceToPolygon( copper, 0, maxError );
+        }
+
+        for( ZONE_CONTAINER* zone : aBoard->Zones() )
+        {
+            if( zone->GetLayer() != layer )
+                continue;
+
+            if( zone->GetFilledPolysUseThickness() )
+                zone->TransformSolidAreasShapesToPolygonSet( copper, maxError );
+            else
+                copper.Append( zone->GetFilledPolysList() );
+        }
+
+        copper.SimplifyTiled( SHAPE_POLY_SET::PM_FAST, tileSize, true );
+
+        aPlotter->StartBlock( NULL );
+        aPlotter->SetColor( itemplotter.getColor( layer ) );
+
+        std::vector<wxPoint> cornerList;
+
+        for( int ii = 0; ii < copper.OutlineCount(); ii++ )
+        {
+            const SHAPE_LINE_CHAIN& path = copper.COutline( ii );
+
+            cornerList.clear();
+
+            for( int jj = 0; jj < path.PointCount(); jj++ )
+                cornerList.emplace_back( (wxPoint) path.CPoint( jj ) );
+
+            // Ensure the polygon is closed
+            if( cornerList[0] != cornerList[cornerList.size() - 1] )
+                cornerList.push_back( cornerList[0] );
+
+            aPlotter->PlotPoly( cornerList, FILLED_SHAPE, 0, &gbr_metadata );
+        }
+
+        aPlotter->EndBlock( NULL );
+    }
+
+    // Adding drill marks, if required and if the plotter is able to plot them:
+    if( aPlotOpt.GetDrillMarksType() != PCB_PLOT_PARAMS::NO_DRILL_SHAPE )
+        itemplotter.PlotDrillMarks();
+}
+
+
 // Seems like we want to plot from back to front?
 static const PCB_LAYER_ID plot_seq[] = {
 
@@ -730,8 +844,6 @@ void PlotLayerOutlines( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
         outlines.RemoveAllContours();
         aBoard->ConvertBrdLayerToPolygonalContours( layer, outlines );
 
-        outlines.Simplify( SHAPE_POLY_SET::PM_FAST );
-
         // Plot outlines
         std::vector< wxPoint > cornerList;
 
@@ -0,0 +1,262 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include <common.h>
+#include <plotter.h>
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <pcbplot.h>
+#include <widgets/progress_reporter.h>
+#include <gendrill_Excellon_writer.h>
+
+#include "plot_job_runner.h"
+
+
+/**
+ * A REPORTER keeping the messages of a job, to report them once all the jobs are done
+ */
+class PLOT_JOB_MESSAGES : public REPORTER
+{
+public:
+    PLOT_JOB_MESSAGES( std::vector<std::pair<wxString, SEVERITY>>& aMessages ) :
+        m_messages( aMessages )
+    {
+    }
+
+    REPORTER& Report( const wxString& aText, SEVERITY aSeverity = RPT_SEVERITY_UNDEFINED ) override
+    {
+        m_messages.emplace_back( aText, aSeverity );
+        return *this;
+    }
+
+    bool HasMessage() const override
+    {
+        return !m_messages.empty();
+    }
+
+private:
+    std::vector<std::pair<wxString, SEVERITY>>& m_messages;
+};
+
+
+PLOT_JOB_RUNNER::PLOT_JOB_RUNNER( BOARD* aBoard ) :
+    m_board( aBoard )
+{
+}
+
+
+void PLOT_JOB_RUNNER::AddLayerJob( PCB_LAYER_ID aLayer, const wxString& aFullFileName,
+                                   const PCB_PLOT_PARAMS& aPlotOpts, const wxString& aSheetDesc )
+{
+    PLOT_JOB job;
+
+    job.m_layer = aLayer;
+    job.m_fileName = aFullFileName;
+    job.m_sheetDesc = aSheetDesc;
+    job.m_plotOpts = aPlotOpts;
+    job.m_drillWriter = nullptr;
+    job.m_genDrill = false;
+    job.m_genMap = false;
+    job.m_success = false;
+
+    m_jobs.push_back( job );
+}
+
+
+void PLOT_JOB_RUNNER::AddDrillJob( EXCELLON_WRITER* aWriter, const wxString& aPlotDirectory,
+                                   bool aGenDrill, bool aGenMap )
+{
+    PLOT_JOB job;
+
+    job.m_layer = UNDEFINED_LAYER;
+    job.m_fileName = aPlotDirectory;
+    job.m_drillWriter = aWriter;
+    job.m_genDrill = aGenDrill;
+    job.m_genMap = aGenMap;
+    job.m_success = false;
+
+    m_jobs.push_back( job );
+}
+
+
+void PLOT_JOB_RUNNER::runJob( PLOT_JOB& aJob )
+{
+    if( aJob.m_drillWriter )
+    {
+        PLOT_JOB_MESSAGES reporter( aJob.m_messages );
+
+        aJob.m_drillWriter->CreateDrillandMapFilesSet( aJob.m_fileName, aJob.m_genDrill,
+                                                       aJob.m_genMap, &reporter );
+
+        aJob.m_success = std::none_of( aJob.m_messages.begin(), aJob.m_messages.end(),
+                []( const std::pair<wxString, SEVERITY>& aMsg )
+                {
+                    return aMsg.second == RPT_SEVERITY_ERROR;
+                } );
+        return;
+    }
+
+    PLOTTER* plotter = StartPlotBoard( m_board, &aJob.m_plotOpts, aJob.m_layer, aJob.m_fileName,
+                                       aJob.m_sheetDesc );
+
+    if( plotter )
+    {
+        PlotOneBoardLayer( m_board, plotter, aJob.m_layer, aJob.m_plotOpts );
+        plotter->EndPlot();
+
+        delete plotter->RenderSettings();
+        delete plotter;
+
+        aJob.m_success = true;
+    }
+}
+
+
+int PLOT_JOB_RUNNER::Run( REPORTER* aReporter, PROGRESS_REPORTER* aProgressReporter )
+{
+    // Plot files must be written with the C locale.  Switching it here, once, also keeps the
+    // LOCALE_IO objects of the jobs from switching it back and forth.
+    LOCALE_IO toggle;
+
+    std::vector<PLOT_JOB*> parallelJobs;
+    std::vector<PLOT_JOB*> serialJobs;
+
+    for( PLOT_JOB& job : m_jobs )
+    {
+        if( job.m_layer != UNDEFINED_LAYER
+                && PlotLayerChangesBoardSettings( m_board, job.m_layer ) )
+            serialJobs.push_back( &job );
+        else
+            parallelJobs.push_back( &job );
+    }
+
+    // The pads cache their bounding radius when it is first needed: compute it now, so the
+    // jobs don't write it
+    for( MODULE* module : m_board->Modules() )
+    {
+        for( D_PAD* pad : module->Pads() )
+            pad->GetBoundingRadius();
+    }
+
+    if( aProgressReporter )
+    {
+        aProgressReporter->Report( _( "Plotting..." ) );
+        aProgressReporter->SetMaxProgress( m_jobs.size() );
+    }
+
+    size_t parallelThreadCount =
+            std::min<size_t>( std::thread::hardware_concurrency(), parallelJobs.size() );
+    parallelThreadCount = std::max<size_t>( parallelThreadCount, 1 );
+
+    std::atomic<size_t>              nextJob( 0 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto plot_lambda = [&]( PROGRESS_REPORTER* aReporter ) -> size_t
+    {
+        size_t num = 0;
+
+        for( size_t i = nextJob++; i < parallelJobs.size(); i = nextJob++ )
+        {
+            runJob( *parallelJobs[i] );
+
+            if( aReporter )
+                aReporter->AdvanceProgress();
+
+            num++;
+        }
+
+        return num;
+    };
+
+    if( parallelThreadCount <= 1 )
+        plot_lambda( aProgressReporter );
+    else
+    {
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, plot_lambda, aProgressReporter );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        {
+            // Here we balance returns with a 100ms timeout to allow UI updating
+            std::future_status status;
+            do
+            {
+                if( aProgressReporter )
+                    aProgressReporter->KeepRefreshing();
+
+                status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+            } while( status != std::future_status::ready );
+        }
+    }
+
+    for( PLOT_JOB* job : serialJobs )
+    {
+        runJob( *job );
+
+        if( aProgressReporter )
+        {
+            aProgressReporter->AdvanceProgress();
+            aProgressReporter->KeepRefreshing();
+        }
+    }
+
+    int failures = 0;
+
+    for( const PLOT_JOB& job : m_jobs )
+    {
+        if( !job.m_success )
+            failures++;
+
+        if( !aReporter )
+            continue;
+
+        wxString msg;
+
+        if( job.m_drillWriter )
+        {
+            for( const std::pair<wxString, SEVERITY>& jobMsg : job.m_messages )
+                aReporter->Report( jobMsg.first, jobMsg.second );
+        }
+        else if( job.m_success )
+        {
+            msg.Printf( _( "Plot file \"%s\" created." ), job.m_fileName );
+            aReporter->Report( msg, RPT_SEVERITY_ACTION );
+        }
+        else
+        {
+            msg.Printf( _( "Unable to create file \"%s\"." ), job.m_fileName );
+            aReporter->Report( msg, RPT_SEVERITY_ERROR );
+        }
+    }
+
+    m_jobs.clear();
+
+    return failures;
+}
@@ -0,0 +1,111 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file pcbnew/plot_job_runner.h
+ */
+
+#ifndef PLOT_JOB_RUNNER_H_
+#define PLOT_JOB_RUNNER_H_
+
+#include <utility>
+#include <vector>
+
+#include <layers_id_colors_and_visibility.h>
+#include <pcb_plot_params.h>
+#include <reporter.h>
+
+class BOARD;
+class EXCELLON_WRITER;
+class PROGRESS_REPORTER;
+
+
+/**
+ * Class PLOT_JOB_RUNNER
+ * plots board layers, each one in its own file, and creates drill files using several threads.
+ *
+ * The jobs only read the board.  The layers whose plot temporarily changes board wide settings
+ * (see PlotLayerChangesBoardSettings()) are plotted one at a time, once the other jobs are done.
+ * The messages of the jobs are reported in the order the jobs were added, so the files and the
+ * report are the same as when the jobs are run one after another.
+ */
+class PLOT_JOB_RUNNER
+{
+public:
+    PLOT_JOB_RUNNER( BOARD* aBoard );
+
+    /**
+     * Function AddLayerJob
+     * adds a job plotting a board layer in a file.
+     * @param aLayer is the layer to plot.
+     * @param aFullFileName is the plot file.
+     * @param aPlotOpts are the plot options, copied by the job.
+     * @param aSheetDesc is the sheet description of the page frame, if plotted.
+     */
+    void AddLayerJob( PCB_LAYER_ID aLayer, const wxString& aFullFileName,
+                      const PCB_PLOT_PARAMS& aPlotOpts,
+                      const wxString& aSheetDesc = wxEmptyString );
+
+    /**
+     * Function AddDrillJob
+     * adds a job creating the drill and/or drill map files of the board, see
+     * EXCELLON_WRITER::CreateDrillandMapFilesSet().
+     * The writer is not owned by the runner: it must stay alive until Run() returns.
+     */
+    void AddDrillJob( EXCELLON_WRITER* aWriter, const wxString& aPlotDirectory, bool aGenDrill,
+                      bool aGenMap );
+
+    size_t GetJobCount() const { return m_jobs.size(); }
+
+    /**
+     * Function Run
+     * runs all the jobs added, and removes them from the runner.
+     * @param aReporter receives the messages of the jobs (can be NULL).
+     * @param aProgressReporter shows the progress of the jobs (can be NULL).
+     * @return the count of jobs which failed.
+     */
+    int Run( REPORTER* aReporter = NULL, PROGRESS_REPORTER* aProgressReporter = NULL );
+
+private:
+    struct PLOT_JOB
+    {
+        PCB_LAYER_ID     m_layer;           ///< UNDEFINED_LAYER for a drill job
+        wxString         m_fileName;        ///< plot file, or directory of the drill files
+        wxString         m_sheetDesc;
+        PCB_PLOT_PARAMS  m_plotOpts;
+        EXCELLON_WRITER* m_drillWriter;
+        bool             m_genDrill;
+        bool             m_genMap;
+        bool             m_success;
+
+        /// Messages reported by the drill writer, reported by Run() once all the jobs are done
+        std::vector<std::pair<wxString, SEVERITY>> m_messages;
+    };
+
+    void runJob( PLOT_JOB& aJob );
+
+    BOARD*                m_board;
+    std::vector<PLOT_JOB> m_jobs;
+};
+
+#endif  // PLOT_JOB_RUNNER_H_
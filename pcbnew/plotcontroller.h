@@ -30,11 +30,16 @@
 #ifndef PLOTCONTROLLER_H_
 #define PLOTCONTROLLER_H_
 
+#include <memory>
+
 #include <pcb_plot_params.h>
 #include <layers_id_colors_and_visibility.h>
 
 class PLOTTER;
 class BOARD;
+class EXCELLON_WRITER;
+class PLOT_JOB_RUNNER;
+class REPORTER;
 
 
 /**
@@ -106,7 +111,43 @@ public:
      */
     bool GetColorMode();
 
+    /**
+     * Queue a layer to be plotted by PlotQueuedJobs(), with the current plot options, in its
+     * own file named like OpenPlotfile() names it
+     * @param aLayer is the layer to plot
+     * @param aSuffix is a string added to the base filename to identify the plot file
+     * @param aFormat is the plot file format identifier
+     * @param aSheetDesc
+     * @return false if the plot directory cannot be created
+     */
+    bool QueueLayer( LAYER_NUM aLayer, const wxString& aSuffix, PLOT_FORMAT aFormat,
+                     const wxString& aSheetDesc );
+
+    /**
+     * Queue the creation of the drill and/or map files of an EXCELLON_WRITER in the plot
+     * directory, run by PlotQueuedJobs() along with the queued layers
+     * The writer must stay alive until PlotQueuedJobs() returns.
+     * @return false if the plot directory cannot be created
+     */
+    bool QueueDrillFiles( EXCELLON_WRITER* aWriter, bool aGenDrill, bool aGenMap );
+
+    /**
+     * Plot the queued layers and drill files using several threads.  The files are the same
+     * as when plotting the layers one after another with OpenPlotfile() and PlotLayer()
+     * @param aReporter receives the messages of the jobs (can be NULL)
+     * @return true if all the files were created
+     */
+    bool PlotQueuedJobs( REPORTER* aReporter = NULL );
+
 private:
+    /**
+     * Compute the full filename of a plot file from the board filename, and ensure the output
+     * directory exists
+     * @return false if the output directory cannot be created
+     */
+    bool buildPlotFileName( LAYER_NUM aLayer, const wxString& aSuffix, PLOT_FORMAT aFormat,
+                            wxFileName& aPlotFile );
+
     /// the layer to plot
     LAYER_NUM m_plotLayer;
 
@@ -122,6 +163,9 @@ private:
 
     /// The current plot filename, set by OpenPlotfile
     wxFileName m_plotFile;
+
+    /// The jobs queued by QueueLayer() and QueueDrillFiles()
+    std::unique_ptr<PLOT_JOB_RUNNER> m_jobRunner;
 };
 
 #endif
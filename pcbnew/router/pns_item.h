@@ -78,6 +78,7 @@ public:
         m_marker = 0;
         m_rank = -1;
         m_routable = true;
+        m_clearanceClass = -1;
     }
 
     ITEM( const ITEM& aOther )
@@ -91,6 +92,7 @@ public:
         m_marker = aOther.m_marker;
         m_rank = aOther.m_rank;
         m_routable = aOther.m_routable;
+        m_clearanceClass = aOther.m_clearanceClass;
     }
 
     virtual ~ITEM();
@@ -241,6 +243,13 @@ public:
     void SetRoutable( bool aRoutable ) { m_routable = aRoutable; }
     bool IsRoutable() const { return m_routable; }
 
+    /**
+     * Clearance class pre-resolved by the RULE_RESOLVER when the world was synced
+     * (-1 means the clearance is derived from the item's net).
+     */
+    void SetClearanceClass( int aClass ) { m_clearanceClass = aClass; }
+    int ClearanceClass() const { return m_clearanceClass; }
+
 private:
     bool collideSimple( const ITEM* aOther, int aClearance, bool aNeedMTV, VECTOR2I* aMTV,
                         const NODE* aParentNode, bool aDifferentNetsOnly ) const;
@@ -257,6 +266,7 @@ protected:
     int                     m_marker;
     int                     m_rank;
     bool                    m_routable;
+    int                     m_clearanceClass;
 };
 
 template< typename T, typename S >
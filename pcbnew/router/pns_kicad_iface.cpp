@@ -50,6 +50,10 @@
 
 #include <memory>
 
+#ifdef PROFILE
+#include <profile.h>
+#endif
+
 #include "tools/pcb_tool_base.h"
 
 #include "pns_kicad_iface.h"
@@ -84,6 +88,20 @@ public:
 
     virtual wxString NetName( int aNet ) override;
 
+    /**
+     * Returns the clearance class of a pad with a local (pad or footprint) clearance
+     * override, or -1 if the pad simply inherits the clearance of its net.
+     */
+    int ClearanceClass( const D_PAD* aPad ) const;
+
+#ifdef PROFILE
+    /**
+     * Times the clearance of every pair of \a aItems resolved through the class matrix and
+     * through the net and pad lookups it replaced, and traces the results.
+     */
+    void BenchmarkClearance( const std::vector<const PNS::ITEM*>& aItems ) const;
+#endif
+
 private:
     struct CLEARANCE_ENT
     {
@@ -93,15 +111,35 @@ private:
     };
 
     int holeRadius( const PNS::ITEM* aItem ) const;
-    int localPadClearance( const PNS::ITEM* aItem ) const;
+    int clearanceClass( const PNS::ITEM* aItem ) const;
+    int addClearanceClass( int aClearance );
     int matchDpSuffix( const wxString& aNetName, wxString& aComplementNet, wxString& aBaseDpName );
 
     PNS::ROUTER* m_router;
     BOARD*       m_board;
 
     std::vector<CLEARANCE_ENT> m_netClearanceCache;
-    std::unordered_map<const D_PAD*, int> m_localClearanceCache;
     int m_defaultClearance;
+
+    ///> Clearance class id of pads with a local clearance override
+    std::unordered_map<const D_PAD*, int> m_localClearanceCache;
+
+    ///> Clearance class id of each net, indexed by net code
+    std::vector<int> m_netClearanceClass;
+    int m_defaultClearanceClass;
+
+    ///> Clearance value of each class
+    std::vector<int> m_classClearance;
+
+    ///> Clearance between two classes, row-major, m_classCount squared entries
+    std::vector<int> m_clearanceMatrix;
+    int m_classCount;
+
+#ifdef PROFILE
+    ///> Hot path statistics, reported when the resolver is destroyed
+    mutable long long m_clearanceQueries;
+    mutable long long m_taggedClassHits;
+#endif
 };
 
 
@@ -109,11 +147,30 @@ PNS_PCBNEW_RULE_RESOLVER::PNS_PCBNEW_RULE_RESOLVER( BOARD* aBoard, PNS::ROUTER*
     m_router( aRouter ),
     m_board( aBoard )
 {
+#ifdef PROFILE
+    m_clearanceQueries = 0;
+    m_taggedClassHits = 0;
+#endif
+
     PNS::NODE* world = m_router->GetWorld();
 
     PNS::TOPOLOGY topo( world );
     m_netClearanceCache.resize( m_board->GetNetCount() );
 
+    auto defaultRule = m_board->GetDesignSettings().m_NetClasses.Find ("Default");
+
+    if( defaultRule )
+    {
+        m_defaultClearance = defaultRule->GetClearance();
+    }
+    else
+    {
+        m_defaultClearance = Millimeter2iu(0.254);
+    }
+
+    m_defaultClearanceClass = addClearanceClass( m_defaultClearance );
+    m_netClearanceClass.resize( m_board->GetNetCount(), m_defaultClearanceClass );
+
     // Build clearance cache for net classes
     for( unsigned int i = 0; i < m_board->GetNetCount(); i++ )
     {
@@ -132,6 +189,7 @@ PNS_PCBNEW_RULE_RESOLVER::PNS_PCBNEW_RULE_RESOLVER( BOARD* aBoard, PNS::ROUTER*
         ent.clearance = clearance;
         ent.dpClearance = nc->GetDiffPairGap();
         m_netClearanceCache[i] = ent;
+        m_netClearanceClass[i] = addClearanceClass( clearance );
 
         wxLogTrace( "PNS", "Add net %u netclass %s clearance %d Diff Pair clearance %d",
                 i, netClassName.mb_str(), clearance, ent.dpClearance );
@@ -147,28 +205,142 @@ PNS_PCBNEW_RULE_RESOLVER::PNS_PCBNEW_RULE_RESOLVER( BOARD* aBoard, PNS::ROUTER*
             int padClearance = pad->GetLocalClearance();
 
             if( padClearance > 0 )
-                m_localClearanceCache[ pad ] = padClearance;
+                m_localClearanceCache[ pad ] = addClearanceClass( padClearance );
 
             else if( moduleClearance > 0 )
-                m_localClearanceCache[ pad ] = moduleClearance;
+                m_localClearanceCache[ pad ] = addClearanceClass( moduleClearance );
         }
     }
 
-    auto defaultRule = m_board->GetDesignSettings().m_NetClasses.Find ("Default");
+    // Precompute the clearance between every pair of classes, so that resolving the
+    // clearance of two items in the router's inner loops costs only a few array loads
+    m_classCount = m_classClearance.size();
+    m_clearanceMatrix.resize( m_classCount * m_classCount );
 
-    if( defaultRule )
+    for( int a = 0; a < m_classCount; a++ )
     {
-        m_defaultClearance = defaultRule->GetClearance();
+        for( int b = 0; b < m_classCount; b++ )
+        {
+            m_clearanceMatrix[a * m_classCount + b] = std::max( m_classClearance[a],
+                                                              m_classClearance[b] );
+        }
     }
-    else
+
+    wxLogTrace( "PNS", "Clearance resolver: %d nets, %d clearance classes, %d local overrides",
+                (int) m_netClearanceClass.size(), m_classCount, (int) m_localClearanceCache.size() );
+}
+
+
+PNS_PCBNEW_RULE_RESOLVER::~PNS_PCBNEW_RULE_RESOLVER()
+{
+#ifdef PROFILE
+    wxLogTrace( "PNS", "Clearance resolver: %lld queries, %lld item classes from pad tags",
+                m_clearanceQueries, m_taggedClassHits );
+#endif
+}
+
+
+#ifdef PROFILE
+void PNS_PCBNEW_RULE_RESOLVER::BenchmarkClearance(
+        const std::vector<const PNS::ITEM*>& aItems ) const
+{
+    // The clearance of an item as Clearance() looked it up before the class matrix: the
+    // clearance of its net, overridden by the local clearance of pads
+    auto itemClearance =
+            [&]( const PNS::ITEM* aItem ) -> int
+            {
+                int net = aItem->Net();
+                int clearance = m_defaultClearance;
+
+                if( net >= 0 && net < (int) m_netClearanceCache.size() )
+                    clearance = m_netClearanceCache[net].clearance;
+
+                if( aItem->Parent() && aItem->Parent()->Type() == PCB_PAD_T )
+                {
+                    auto i = m_localClearanceCache.find(
+                            static_cast<const D_PAD*>( aItem->Parent() ) );
+
+                    if( i != m_localClearanceCache.end() )
+                        clearance = m_classClearance[i->second];
+                }
+
+                return clearance;
+            };
+
+    // Keep the statistics of the routing queries only
+    long long queries = m_clearanceQueries;
+    long long taggedHits = m_taggedClassHits;
+
+    size_t    count = std::min<size_t>( aItems.size(), 2000 );
+    long long lookupSum = 0;
+    long long matrixSum = 0;
+    size_t    different = 0;
+
+    PROF_COUNTER lookupTimer;
+
+    for( size_t a = 0; a < count; a++ )
     {
-        m_defaultClearance = Millimeter2iu(0.254);
+        for( size_t b = 0; b < count; b++ )
+            lookupSum += std::max( itemClearance( aItems[a] ), itemClearance( aItems[b] ) );
     }
+
+    lookupTimer.Stop();
+
+    PROF_COUNTER matrixTimer;
+
+    for( size_t a = 0; a < count; a++ )
+    {
+        for( size_t b = 0; b < count; b++ )
+            matrixSum += Clearance( aItems[a], aItems[b] );
+    }
+
+    matrixTimer.Stop();
+
+    for( size_t a = 0; a < count; a++ )
+    {
+        for( size_t b = 0; b < count; b++ )
+        {
+            if( Clearance( aItems[a], aItems[b] )
+                    != std::max( itemClearance( aItems[a] ), itemClearance( aItems[b] ) ) )
+            {
+                different++;
+            }
+        }
+    }
+
+    m_clearanceQueries = queries;
+    m_taggedClassHits = taggedHits;
+
+    wxLogTrace( "PNS", "Clearance of %zu item pairs: %0.3f ms through net and pad lookups "
+                       "(sum %lld), %0.3f ms through the class matrix (sum %lld), %zu differ",
+                count * count, lookupTimer.msecs(), lookupSum, matrixTimer.msecs(), matrixSum,
+                different );
 }
+#endif
 
 
-PNS_PCBNEW_RULE_RESOLVER::~PNS_PCBNEW_RULE_RESOLVER()
+int PNS_PCBNEW_RULE_RESOLVER::addClearanceClass( int aClearance )
 {
+    // Classes are identified by their clearance value; there are only a handful of them
+    for( int i = 0; i < (int) m_classClearance.size(); i++ )
+    {
+        if( m_classClearance[i] == aClearance )
+            return i;
+    }
+
+    m_classClearance.push_back( aClearance );
+    return m_classClearance.size() - 1;
+}
+
+
+int PNS_PCBNEW_RULE_RESOLVER::ClearanceClass( const D_PAD* aPad ) const
+{
+    auto i = m_localClearanceCache.find( aPad );
+
+    if( i == m_localClearanceCache.end() )
+        return -1;
+
+    return i->second;
 }
 
 
@@ -231,40 +403,38 @@ bool PNS_PCBNEW_RULE_RESOLVER::CollideHoles( const PNS::ITEM* aA, const PNS::ITE
 }
 
 
-int PNS_PCBNEW_RULE_RESOLVER::localPadClearance( const PNS::ITEM* aItem ) const
+int PNS_PCBNEW_RULE_RESOLVER::clearanceClass( const PNS::ITEM* aItem ) const
 {
-    if( !aItem->Parent() || aItem->Parent()->Type() != PCB_PAD_T )
-        return 0;
+    // Pads with a local clearance override were tagged in SyncWorld()
+    int cls = aItem->ClearanceClass();
 
-    const D_PAD* pad = static_cast<D_PAD*>( aItem->Parent() );
+    if( cls >= 0 )
+    {
+#ifdef PROFILE
+        m_taggedClassHits++;
+#endif
+        return cls;
+    }
 
-    auto i = m_localClearanceCache.find( pad );
+    int net = aItem->Net();
 
-    if( i == m_localClearanceCache.end() )
-        return 0;
+    if( net >= 0 && net < (int) m_netClearanceClass.size() )
+        return m_netClearanceClass[net];
 
-    return i->second;
+    return m_defaultClearanceClass;
 }
 
 
 int PNS_PCBNEW_RULE_RESOLVER::Clearance( const PNS::ITEM* aA, const PNS::ITEM* aB ) const
 {
-    int net_a = aA->Net();
-    int cl_a = ( net_a >= 0 ? m_netClearanceCache[net_a].clearance : m_defaultClearance );
-    int net_b = aB->Net();
-    int cl_b = ( net_b >= 0 ? m_netClearanceCache[net_b].clearance : m_defaultClearance );
+#ifdef PROFILE
+    m_clearanceQueries++;
+#endif
 
-    // Pad clearance is 0 if the ITEM* is not a pad
-    int pad_a = localPadClearance( aA );
-    int pad_b = localPadClearance( aB );
+    int cls_a = clearanceClass( aA );
+    int cls_b = clearanceClass( aB );
 
-    if( pad_a > 0 )
-        cl_a = pad_a;
-
-    if( pad_b > 0 )
-        cl_b = pad_b;
-
-    return std::max( cl_a, cl_b );
+    return m_clearanceMatrix[cls_a * m_classCount + cls_b];
 }
 
 
@@ -1155,6 +1325,10 @@ void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
         return;
     }
 
+    // The rule resolver is built first so that items can be tagged with their clearance class
+    delete m_ruleResolver;
+    m_ruleResolver = new PNS_PCBNEW_RULE_RESOLVER( m_board, m_router );
+
     for( auto gitem : m_board->Drawings() )
     {
         if ( gitem->Type() == PCB_LINE_T )
@@ -1177,7 +1351,10 @@ void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
         for( auto pad : module->Pads() )
         {
             if( auto solid = syncPad( pad ) )
+            {
+                solid->SetClearanceClass( m_ruleResolver->ClearanceClass( pad ) );
                 aWorld->Add( std::move( solid ) );
+            }
 
             worstPadClearance = std::max( worstPadClearance, pad->GetLocalClearance() );
         }
@@ -1227,11 +1404,21 @@ void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
 
     int worstRuleClearance = m_board->GetDesignSettings().GetBiggestClearanceValue();
 
-    delete m_ruleResolver;
-    m_ruleResolver = new PNS_PCBNEW_RULE_RESOLVER( m_board, m_router );
-
     aWorld->SetRuleResolver( m_ruleResolver );
     aWorld->SetMaxClearance( 4 * std::max(worstPadClearance, worstRuleClearance ) );
+
+#ifdef PROFILE
+    std::vector<const PNS::ITEM*> items;
+
+    for( int net = 0; net < (int) m_board->GetNetCount(); net++ )
+    {
+        std::set<PNS::ITEM*> netItems;
+        aWorld->AllItemsInNet( net, netItems );
+        items.insert( items.end(), netItems.begin(), netItems.end() );
+    }
+
+    m_ruleResolver->BenchmarkClearance( items );
+#endif
 }
 
 
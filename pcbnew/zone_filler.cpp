@@ -505,7 +505,8 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE_CONTAINER* aZone, SHAPE_POL
         }
     }
 
-    holes.Simplify( SHAPE_POLY_SET::PM_FAST );
+    // No need to simplify the holes first: overlapping clip polygons are merged by the
+    // non-zero fill rule of the subtraction itself.
     aFill.BooleanSubtract( holes, SHAPE_POLY_SET::PM_FAST );
 }
 
@@ -676,7 +677,9 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE_CONTAINER* aZone, SHAPE_
         zone->TransformOutlinesShapeWithClearanceToPolygon( aHoles, minClearance, useNetClearance );
     }
 
-    aHoles.Simplify( SHAPE_POLY_SET::PM_FAST );
+    // The knockouts are mostly small and disjoint, so merge them cluster by cluster rather
+    // than in a single union
+    aHoles.SimplifyClustered( SHAPE_POLY_SET::PM_FAST );
 }
 
 
@@ -747,8 +750,10 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone,
     // Create a temporary zone that we can hit-test spoke-ends against.  It's only temporary
     // because the "real" subtract-clearance-holes has to be done after the spokes are added.
     static const bool USE_BBOX_CACHES = true;
-    SHAPE_POLY_SET testAreas = aRawPolys;
-    testAreas.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
+    // (Subtracting into the temporary instead of copying aRawPolys first lets the boolean
+    // use the Clipper paths cached by the previous operation on aRawPolys.)
+    SHAPE_POLY_SET testAreas;
+    testAreas.BooleanSubtract( aRawPolys, clearanceHoles, SHAPE_POLY_SET::PM_FAST );
 
     // Prune features that don't meet minimum-width criteria
     if( half_min_width - epsilon > epsilon )
@@ -785,8 +790,8 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone,
 
     // Ensure previous changes (adding thermal stubs) do not add
     // filled areas outside the zone boundary
+    // (The result of a boolean is already simple, so it doesn't need a Simplify() pass.)
     aRawPolys.BooleanIntersection( aSmoothedOutline, SHAPE_POLY_SET::PM_FAST );
-    aRawPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
 
     if( s_DumpZonesWhenFilling )
         dumper->Write( &aRawPolys, "solid-areas-with-thermal-spokes" );
@@ -0,0 +1,328 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for CAIRO_TILE_GAL: rendering the screen as tiles composited by CAIRO_COMPOSITOR
+ * must give the same image as rendering it on a single surface.  Image surfaces are used, so
+ * the test runs without a window.
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <gal/cairo/cairo_tile_gal.h>
+#include <gal/cairo/cairo_compositor.h>
+
+#include <profile.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+
+using namespace KIGFX;
+
+
+/**
+ * Draws a board-like scene on the whole screen of a GAL: tracks, vias, pads and texts
+ */
+static void drawScene( GAL& aGal )
+{
+    // The scene does not depend on the tile it is drawn on
+    unsigned int seed = 1;
+
+    auto random = [&seed]( double aMax )
+    {
+        seed = seed * 1103515245 + 12345;
+        return aMax * ( ( seed >> 16 ) & 0x7fff ) / 32767.0;
+    };
+
+    VECTOR2D origin = aGal.GetScreenWorldMatrix() * VECTOR2D( 0.0, 0.0 );
+    VECTOR2D size = aGal.GetScreenWorldMatrix() * VECTOR2D( aGal.GetScreenPixelSize() ) - origin;
+
+    auto randomPoint = [&]()
+    {
+        return origin + VECTOR2D( random( size.x ), random( size.y ) );
+    };
+
+    double scale = size.x / 1000.0;
+
+    aGal.SetIsFill( true );
+    aGal.SetIsStroke( false );
+
+    for( int ii = 0; ii < 20000; ii++ )
+    {
+        VECTOR2D start = randomPoint();
+        VECTOR2D end = start + VECTOR2D( random( 40.0 ) - 20.0, random( 40.0 ) - 20.0 ) * scale;
+
+        aGal.SetFillColor( COLOR4D( 0.8, 0.2, 0.2, 0.8 ) );
+        aGal.DrawSegment( start, end, ( 0.5 + random( 2.0 ) ) * scale );
+    }
+
+    for( int ii = 0; ii < 5000; ii++ )
+    {
+        aGal.SetFillColor( COLOR4D( 0.8, 0.8, 0.0, 0.8 ) );
+        aGal.DrawCircle( randomPoint(), ( 1.0 + random( 2.0 ) ) * scale );
+    }
+
+    for( int ii = 0; ii < 2000; ii++ )
+    {
+        VECTOR2D             center = randomPoint();
+        VECTOR2D             half = VECTOR2D( 1.0 + random( 3.0 ), 1.0 + random( 3.0 ) ) * scale;
+        std::deque<VECTOR2D> corners = { center - half, center + VECTOR2D( half.x, -half.y ),
+                                         center + half, center + VECTOR2D( -half.x, half.y ) };
+
+        aGal.SetFillColor( COLOR4D( 0.5, 0.5, 0.5, 0.8 ) );
+        aGal.DrawPolygon( corners );
+    }
+
+    aGal.SetIsFill( false );
+    aGal.SetIsStroke( true );
+    aGal.SetStrokeColor( COLOR4D( 0.0, 0.8, 0.8, 1.0 ) );
+    aGal.SetLineWidth( 0.3 * scale );
+    aGal.SetGlyphSize( VECTOR2D( 3.0, 3.0 ) * scale );
+
+    for( int ii = 0; ii < 1000; ii++ )
+        aGal.StrokeText( wxString::Format( "U%d", ii ), randomPoint(), 0.0 );
+}
+
+
+class TEST_CAIRO_TILE_GAL_FIXTURE
+{
+public:
+    static const int SCREEN_WIDTH = 1600;
+    static const int SCREEN_HEIGHT = 1000;
+
+    TEST_CAIRO_TILE_GAL_FIXTURE() :
+        m_single( m_options )
+    {
+        m_single.ResizeScreen( SCREEN_WIDTH, SCREEN_HEIGHT );
+        m_single.SetScreenDPI( 100.0 );
+        m_single.SetWorldUnitLength( 0.01 );
+        m_single.SetLookAtPoint( VECTOR2D( 0.0, 0.0 ) );
+
+        // Compute the view matrices the tiles copy
+        m_single.BeginTile( BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( SCREEN_WIDTH, SCREEN_HEIGHT ) ),
+                            CAIRO_ANTIALIAS_DEFAULT );
+
+        m_screen = cairo_image_surface_create( CAIRO_FORMAT_ARGB32, SCREEN_WIDTH, SCREEN_HEIGHT );
+        m_screenContext = cairo_create( m_screen );
+        m_currentContext = m_screenContext;
+
+        m_compositor = std::make_unique<CAIRO_COMPOSITOR>( &m_currentContext );
+        m_compositor->Resize( SCREEN_WIDTH, SCREEN_HEIGHT );
+        m_singleBuffer = m_compositor->CreateBuffer();
+        m_tiledBuffer = m_compositor->CreateBuffer();
+    }
+
+    ~TEST_CAIRO_TILE_GAL_FIXTURE()
+    {
+        m_compositor.reset();
+        cairo_destroy( m_screenContext );
+        cairo_surface_destroy( m_screen );
+    }
+
+    /// Renders the scene on a single surface and composites it on m_singleBuffer
+    void renderSingle()
+    {
+        m_single.BeginTile( BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( SCREEN_WIDTH, SCREEN_HEIGHT ) ),
+                            CAIRO_ANTIALIAS_DEFAULT );
+        drawScene( m_single );
+        m_single.EndTile();
+
+        m_compositor->SetBuffer( m_singleBuffer );
+        m_compositor->ClearBuffer( COLOR4D::BLACK );
+        m_compositor->DrawTile( m_single.GetSurface(), 0, 0 );
+    }
+
+    /**
+     * Renders the scene as aColumns x aRows tiles drawn by aThreadCount threads, and
+     * composites them on m_tiledBuffer
+     */
+    void renderTiles( int aColumns, int aRows, size_t aThreadCount )
+    {
+        int tileWidth = ( SCREEN_WIDTH + aColumns - 1 ) / aColumns;
+        int tileHeight = ( SCREEN_HEIGHT + aRows - 1 ) / aRows;
+
+        while( m_tiles.size() < size_t( aColumns * aRows ) )
+            m_tiles.push_back( std::make_unique<CAIRO_TILE_GAL>( m_options, &m_single ) );
+
+        for( int row = 0; row < aRows; row++ )
+        {
+            for( int col = 0; col < aColumns; col++ )
+            {
+                VECTOR2I origin( col * tileWidth, row * tileHeight );
+                VECTOR2I size( std::min( tileWidth, SCREEN_WIDTH - origin.x ),
+                               std::min( tileHeight, SCREEN_HEIGHT - origin.y ) );
+
+                m_tiles[row * aColumns + col]->BeginTile( BOX2I( origin, size ),
+                                                          CAIRO_ANTIALIAS_DEFAULT );
+            }
+        }
+
+        std::atomic<size_t>              nextTile( 0 );
+        std::vector<std::future<size_t>> returns( aThreadCount );
+        size_t                           tileCount = aColumns * aRows;
+
+        auto draw_lambda = [&]() -> size_t
+        {
+            size_t count = 0;
+
+            for( size_t i = nextTile++; i < tileCount; i = nextTile++ )
+            {
+                drawScene( *m_tiles[i] );
+                m_tiles[i]->EndTile();
+                count++;
+            }
+
+            return count;
+        };
+
+        for( size_t ii = 0; ii < aThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, draw_lambda );
+
+        for( size_t ii = 0; ii < aThreadCount; ++ii )
+            returns[ii].wait();
+
+        m_compositor->SetBuffer( m_tiledBuffer );
+        m_compositor->ClearBuffer( COLOR4D::BLACK );
+
+        for( size_t i = 0; i < tileCount; i++ )
+        {
+            const BOX2I& rect = m_tiles[i]->GetRect();
+            m_compositor->DrawTile( m_tiles[i]->GetSurface(), rect.GetX(), rect.GetY() );
+        }
+    }
+
+    /// Returns the pixels of a compositor buffer, composited on the screen surface
+    std::vector<uint32_t> pixels( unsigned int aBuffer )
+    {
+        cairo_set_operator( m_screenContext, CAIRO_OPERATOR_CLEAR );
+        cairo_paint( m_screenContext );
+        cairo_set_operator( m_screenContext, CAIRO_OPERATOR_OVER );
+
+        m_compositor->DrawBuffer( aBuffer );
+        cairo_surface_flush( m_screen );
+
+        int                   stride = cairo_image_surface_get_stride( m_screen );
+        unsigned char*        data = cairo_image_surface_get_data( m_screen );
+        std::vector<uint32_t> result;
+
+        for( int y = 0; y < SCREEN_HEIGHT; y++ )
+        {
+            const uint32_t* row = reinterpret_cast<const uint32_t*>( data + y * stride );
+            result.insert( result.end(), row, row + SCREEN_WIDTH );
+        }
+
+        return result;
+    }
+
+    GAL_DISPLAY_OPTIONS                          m_options;
+    CAIRO_TILE_GAL                               m_single;
+    std::vector<std::unique_ptr<CAIRO_TILE_GAL>> m_tiles;
+
+    cairo_surface_t*                  m_screen;
+    cairo_t*                          m_screenContext;
+    cairo_t*                          m_currentContext;
+    std::unique_ptr<CAIRO_COMPOSITOR> m_compositor;
+    unsigned int                      m_singleBuffer;
+    unsigned int                      m_tiledBuffer;
+};
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_FIXTURE_TEST_SUITE( CairoTileGal, TEST_CAIRO_TILE_GAL_FIXTURE )
+
+
+/**
+ * The composited tiles give the same image as a single surface
+ */
+BOOST_AUTO_TEST_CASE( TilesMatchSingleSurface )
+{
+    renderSingle();
+    renderTiles( 4, 3, 2 );
+
+    std::vector<uint32_t> single = pixels( m_singleBuffer );
+    std::vector<uint32_t> tiled = pixels( m_tiledBuffer );
+
+    BOOST_REQUIRE_EQUAL( single.size(), tiled.size() );
+
+    size_t drawn = 0;
+    size_t different = 0;
+
+    for( size_t i = 0; i < single.size(); i++ )
+    {
+        if( single[i] )
+            drawn++;
+
+        if( single[i] != tiled[i] )
+            different++;
+    }
+
+    BOOST_TEST_MESSAGE( different << " different pixels out of " << single.size() );
+
+    BOOST_CHECK( drawn > single.size() / 10 );
+
+    // Antialiasing may round a few pixels differently along the tile borders
+    BOOST_CHECK( different <= single.size() / 1000 );
+}
+
+
+/**
+ * Times headless frames rendered on a single surface, and rendered as tiles on one thread and
+ * on every hardware thread.  The timings are only reported (run with --log_level=message).
+ */
+BOOST_AUTO_TEST_CASE( FrameTime )
+{
+    const int frameCount = 5;
+    size_t    threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+
+    auto timeFrames =
+            [&]( std::function<void()> aRender ) -> double
+            {
+                PROF_COUNTER timer;
+
+                for( int ii = 0; ii < frameCount; ii++ )
+                    aRender();
+
+                timer.Stop();
+                return timer.msecs() / frameCount;
+            };
+
+    double single = timeFrames( [&]() { renderSingle(); } );
+    double serialTiles = timeFrames( [&]() { renderTiles( 4, 4, 1 ); } );
+    double parallelTiles = timeFrames( [&]() { renderTiles( 4, 4, threadCount ); } );
+
+    BOOST_TEST_MESSAGE( SCREEN_WIDTH << "x" << SCREEN_HEIGHT << " frame: single surface "
+                        << single << " ms, 16 tiles on 1 thread " << serialTiles
+                        << " ms, on " << threadCount << " threads " << parallelTiles << " ms" );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
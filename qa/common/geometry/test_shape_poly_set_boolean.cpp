@@ -0,0 +1,253 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <cmath>
+#include <set>
+#include <string>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+/**
+ * Fixture for the boolean tests: a square "zone" and a grid of round clearance holes
+ */
+struct BooleanFixture
+{
+    SHAPE_POLY_SET m_zone;
+    SHAPE_POLY_SET m_holes;
+
+    BooleanFixture()
+    {
+        m_zone.NewOutline();
+        m_zone.Append( 0, 0 );
+        m_zone.Append( 1000000, 0 );
+        m_zone.Append( 1000000, 1000000 );
+        m_zone.Append( 0, 1000000 );
+
+        for( int x = 50000; x < 1000000; x += 100000 )
+        {
+            for( int y = 50000; y < 1000000; y += 100000 )
+            {
+                SHAPE_LINE_CHAIN hole;
+
+                for( int i = 0; i < 16; i++ )
+                {
+                    double angle = 2.0 * M_PI * i / 16;
+                    hole.Append( x + KiROUND( 40000 * cos( angle ) ),
+                                 y + KiROUND( 40000 * sin( angle ) ) );
+                }
+
+                hole.SetClosed( true );
+                m_holes.AddOutline( hole );
+            }
+        }
+    }
+
+    /**
+     * Runs a chain of operations similar to a zone fill.  With aDropCaches, every
+     * intermediate result is copied, which drops the Clipper paths kept by the set.
+     */
+    SHAPE_POLY_SET fillChain( bool aDropCaches ) const
+    {
+        auto step = [&]( SHAPE_POLY_SET& aSet )
+        {
+            if( aDropCaches )
+                aSet = SHAPE_POLY_SET( aSet );
+        };
+
+        SHAPE_POLY_SET holes( m_holes );
+        holes.Simplify( SHAPE_POLY_SET::PM_FAST );
+        step( holes );
+
+        SHAPE_POLY_SET fill( m_zone );
+        fill.BooleanSubtract( holes, SHAPE_POLY_SET::PM_FAST );
+        step( fill );
+        fill.Deflate( 15000, 16, SHAPE_POLY_SET::CHAMFER_ALL_CORNERS );
+        step( fill );
+        fill.Inflate( 15000, 16, SHAPE_POLY_SET::ROUND_ALL_CORNERS );
+        step( fill );
+        fill.BooleanIntersection( m_zone, SHAPE_POLY_SET::PM_FAST );
+        step( fill );
+        fill.Simplify( SHAPE_POLY_SET::PM_FAST );
+        step( fill );
+        fill.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+        return fill;
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( SPSBoolean, BooleanFixture )
+
+
+/**
+ * Chained operations give the same result whether or not they reuse the Clipper paths
+ * of the previous operation
+ */
+BOOST_AUTO_TEST_CASE( ChainedOperationsMatchUncached )
+{
+    SHAPE_POLY_SET cached = fillChain( false );
+    SHAPE_POLY_SET uncached = fillChain( true );
+
+    BOOST_CHECK_GT( cached.TotalVertices(), 0 );
+    BOOST_CHECK_EQUAL( cached.Format(), uncached.Format() );
+}
+
+
+/**
+ * Modifying the result of a boolean drops the Clipper paths it was built from
+ */
+BOOST_AUTO_TEST_CASE( ModifiedResultIsReconverted )
+{
+    SHAPE_POLY_SET fill( m_zone );
+    fill.BooleanSubtract( m_holes, SHAPE_POLY_SET::PM_FAST );
+
+    fill.Move( VECTOR2I( 500000, 0 ) );
+    fill.BooleanIntersection( m_zone, SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET expected( m_zone );
+    expected.BooleanSubtract( m_holes, SHAPE_POLY_SET::PM_FAST );
+    expected = SHAPE_POLY_SET( expected );
+    expected.Move( VECTOR2I( 500000, 0 ) );
+    expected = SHAPE_POLY_SET( expected );
+    expected.BooleanIntersection( m_zone, SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( fill.Format(), expected.Format() );
+
+    const BOX2I bbox = fill.BBox();
+    BOOST_CHECK_EQUAL( bbox.GetX(), 500000 );
+    BOOST_CHECK_EQUAL( bbox.GetRight(), 1000000 );
+}
+
+/**
+ * The clustered union gives the same polygons as a single union, possibly in another order
+ */
+BOOST_AUTO_TEST_CASE( ClusteredSimplifyMatchesSimplify )
+{
+    SHAPE_POLY_SET knockouts( m_holes );
+
+    // Overlapping chains of polygons, so that some clusters hold many of them
+    for( int x = 0; x < 1000000; x += 30000 )
+    {
+        SHAPE_LINE_CHAIN track;
+        track.Append( x, 480000 );
+        track.Append( x + 40000, 480000 );
+        track.Append( x + 40000, 520000 );
+        track.Append( x, 520000 );
+        track.SetClosed( true );
+        knockouts.AddOutline( track );
+    }
+
+    SHAPE_POLY_SET expected( knockouts );
+    expected.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+    knockouts.SimplifyClustered( SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_REQUIRE_EQUAL( knockouts.OutlineCount(), expected.OutlineCount() );
+
+    auto format =
+            []( const SHAPE_POLY_SET::POLYGON& aPoly ) -> std::string
+            {
+                SHAPE_POLY_SET poly( aPoly[0] );
+
+                for( size_t ii = 1; ii < aPoly.size(); ii++ )
+                    poly.AddHole( aPoly[ii] );
+
+                return poly.Format();
+            };
+
+    std::multiset<std::string> expectedPolys, clusteredPolys;
+
+    for( int ii = 0; ii < expected.OutlineCount(); ii++ )
+    {
+        expectedPolys.insert( format( expected.CPolygon( ii ) ) );
+        clusteredPolys.insert( format( knockouts.CPolygon( ii ) ) );
+    }
+
+    BOOST_CHECK( expectedPolys == clusteredPolys );
+}
+
+/**
+ * The tiled union covers the same area as a single union, with polygons cut at the tile edges
+ */
+BOOST_AUTO_TEST_CASE( TiledSimplifyMatchesSimplify )
+{
+    const int tileSize = 150000;
+
+    // The zone with its knockouts removed, overlapped by chains of tracks
+    SHAPE_POLY_SET copper( m_zone );
+    copper.BooleanSubtract( m_holes, SHAPE_POLY_SET::PM_FAST );
+
+    for( int x = 0; x < 1000000; x += 30000 )
+    {
+        SHAPE_LINE_CHAIN track;
+        track.Append( x, 480000 );
+        track.Append( x + 40000, 480000 );
+        track.Append( x + 40000, 520000 );
+        track.Append( x, 520000 );
+        track.SetClosed( true );
+        copper.AddOutline( track );
+    }
+
+    SHAPE_POLY_SET expected( copper );
+    expected.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+    const BOX2I bbox = copper.BBox();
+
+    copper.SimplifyTiled( SHAPE_POLY_SET::PM_FAST, tileSize, true );
+
+    BOOST_CHECK_GT( copper.OutlineCount(), expected.OutlineCount() );
+
+    auto area =
+            []( const SHAPE_POLY_SET& aSet ) -> double
+            {
+                double total = 0.0;
+
+                for( int ii = 0; ii < aSet.OutlineCount(); ii++ )
+                {
+                    total += std::fabs( aSet.COutline( ii ).Area() );
+
+                    for( int jj = 0; jj < aSet.HoleCount( ii ); jj++ )
+                        total -= std::fabs( aSet.CHole( ii, jj ).Area() );
+                }
+
+                return total;
+            };
+
+    BOOST_CHECK_CLOSE( area( copper ), area( expected ), 0.001 );
+
+    for( int ii = 0; ii < copper.OutlineCount(); ii++ )
+    {
+        BOOST_CHECK_EQUAL( copper.HoleCount( ii ), 0 );
+
+        const BOX2I polyBox = copper.COutline( ii ).BBox();
+        const int   column = ( polyBox.GetLeft() - bbox.GetLeft() ) / tileSize;
+        const int   row = ( polyBox.GetTop() - bbox.GetTop() ) / tileSize;
+
+        BOOST_CHECK_LE( polyBox.GetRight(), bbox.GetLeft() + ( column + 1 ) * tileSize );
+        BOOST_CHECK_LE( polyBox.GetBottom(), bbox.GetTop() + ( row + 1 ) * tileSize );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,216 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <cmath>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+/**
+ * Fixture for the edge index tests: a large, jagged polygon with holes (similar to a filled
+ * zone with thermal reliefs) and a second, disjoint polygon.
+ */
+struct EdgeIndexFixture
+{
+    SHAPE_POLY_SET m_polySet;
+
+    EdgeIndexFixture()
+    {
+        SHAPE_LINE_CHAIN outline;
+
+        // A star-like outline with many vertices
+        for( int i = 0; i < 2000; i++ )
+        {
+            double angle = 2.0 * M_PI * i / 2000;
+            double radius = ( i % 2 ) ? 100000 : 90000;
+            outline.Append( KiROUND( radius * cos( angle ) ), KiROUND( radius * sin( angle ) ) );
+        }
+
+        outline.SetClosed( true );
+        m_polySet.AddOutline( outline );
+
+        for( int x = -40000; x <= 40000; x += 20000 )
+        {
+            for( int y = -40000; y <= 40000; y += 20000 )
+            {
+                SHAPE_LINE_CHAIN hole;
+                hole.Append( x - 5000, y - 5000 );
+                hole.Append( x + 5000, y - 5000 );
+                hole.Append( x + 5000, y + 5000 );
+                hole.Append( x - 5000, y + 5000 );
+                hole.SetClosed( true );
+                m_polySet.AddHole( hole );
+            }
+        }
+
+        SHAPE_LINE_CHAIN island;
+        island.Append( 200000, 0 );
+        island.Append( 250000, 0 );
+        island.Append( 250000, 50000 );
+        island.Append( 200000, 50000 );
+        island.SetClosed( true );
+        m_polySet.AddOutline( island );
+    }
+
+    ///> Reference implementation of SHAPE_POLY_SET::Contains() using the line chains directly
+    bool refContains( const VECTOR2I& aP, int aAccuracy ) const
+    {
+        for( int i = 0; i < m_polySet.OutlineCount(); i++ )
+        {
+            if( !m_polySet.COutline( i ).PointInside( aP, aAccuracy ) )
+                continue;
+
+            bool inHole = false;
+
+            for( int j = 0; j < m_polySet.HoleCount( i ); j++ )
+                inHole |= m_polySet.CHole( i, j ).PointInside( aP, 1 );
+
+            if( !inHole )
+                return true;
+        }
+
+        return false;
+    }
+
+    ///> Reference distance between aP and the edges of the aIndex-th polygon
+    int refEdgeDistance( const SEG& aSeg, int aIndex, bool aPointOnly ) const
+    {
+        int dist = std::numeric_limits<int>::max();
+
+        for( auto it = m_polySet.CIterateSegmentsWithHoles( aIndex ); it; it++ )
+            dist = std::min( dist, aPointOnly ? ( *it ).Distance( aSeg.A ) : ( *it ).Distance( aSeg ) );
+
+        return dist;
+    }
+
+    ///> Query points: a coarse grid plus every vertex and edge midpoint
+    std::vector<VECTOR2I> queryPoints() const
+    {
+        std::vector<VECTOR2I> points;
+
+        for( int x = -110000; x <= 260000; x += 3700 )
+        {
+            for( int y = -110000; y <= 110000; y += 3700 )
+                points.emplace_back( x, y );
+        }
+
+        for( auto it = m_polySet.CIterateSegments( 0, m_polySet.OutlineCount() - 1, true ); it; it++ )
+        {
+            points.push_back( ( *it ).A );
+            points.push_back( ( ( *it ).A + ( *it ).B ) / 2 );
+        }
+
+        return points;
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( SPSEdgeIndex, EdgeIndexFixture )
+
+
+/**
+ * The index is built lazily after repeated queries and dropped by non-const accesses
+ */
+BOOST_AUTO_TEST_CASE( LazyBuildAndInvalidation )
+{
+    BOOST_CHECK( !m_polySet.HasEdgeIndex() );
+
+    for( int i = 0; i < 10; i++ )
+        m_polySet.Contains( VECTOR2I( i, i ) );
+
+    BOOST_CHECK( m_polySet.HasEdgeIndex() );
+
+    // Copies never share the index
+    SHAPE_POLY_SET copy( m_polySet );
+    BOOST_CHECK( !copy.HasEdgeIndex() );
+
+    m_polySet.Outline( 1 ).Move( VECTOR2I( 1000, 0 ) );
+    BOOST_CHECK( !m_polySet.HasEdgeIndex() );
+
+    m_polySet.BuildEdgeIndex();
+    BOOST_CHECK( m_polySet.HasEdgeIndex() );
+
+    m_polySet.Move( VECTOR2I( 0, 1000 ) );
+    BOOST_CHECK( !m_polySet.HasEdgeIndex() );
+
+    // Small sets are never indexed
+    SHAPE_POLY_SET small;
+    small.AddOutline( m_polySet.COutline( 1 ) );
+
+    for( int i = 0; i < 10; i++ )
+        small.Contains( VECTOR2I( i, i ) );
+
+    BOOST_CHECK( !small.HasEdgeIndex() );
+}
+
+
+/**
+ * Indexed point containment matches the linear scan for all accuracy modes
+ */
+BOOST_AUTO_TEST_CASE( ContainsMatchesLinearScan )
+{
+    m_polySet.BuildEdgeIndex();
+
+    for( const VECTOR2I& p : queryPoints() )
+    {
+        for( int accuracy : { 0, 1, 5 } )
+        {
+            BOOST_TEST_CONTEXT( "Point " << p.x << ", " << p.y << " accuracy " << accuracy )
+            {
+                BOOST_CHECK_EQUAL( m_polySet.Contains( p, -1, accuracy ),
+                                   refContains( p, accuracy ) );
+            }
+        }
+    }
+
+    BOOST_CHECK( m_polySet.HasEdgeIndex() );
+}
+
+
+/**
+ * Indexed distance and collision queries match the linear scan
+ */
+BOOST_AUTO_TEST_CASE( DistanceMatchesLinearScan )
+{
+    m_polySet.BuildEdgeIndex();
+
+    for( const VECTOR2I& p : queryPoints() )
+    {
+        for( int i = 0; i < m_polySet.OutlineCount(); i++ )
+        {
+            int expected = m_polySet.Contains( p, i, 1 ) ? 0 : refEdgeDistance( SEG( p, p ), i, true );
+            BOOST_CHECK_EQUAL( m_polySet.DistanceToPolygon( p, i ), expected );
+
+            SEG seg( p, p + VECTOR2I( 3000, 1700 ) );
+            expected = m_polySet.Contains( seg.A, i, 1 ) ? 0 : refEdgeDistance( seg, i, false );
+            BOOST_CHECK_EQUAL( m_polySet.DistanceToPolygon( seg, i ), expected );
+        }
+
+        BOOST_CHECK_EQUAL( m_polySet.Collide( p ), refContains( p, 0 ) );
+    }
+
+    BOOST_CHECK( m_polySet.HasEdgeIndex() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,148 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <cmath>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+/**
+ * Fixture for the triangulation tests: a large, jagged polygon with holes and a few
+ * small disjoint squares.
+ */
+struct TriangulationFixture
+{
+    SHAPE_POLY_SET m_polySet;
+
+    TriangulationFixture()
+    {
+        SHAPE_LINE_CHAIN outline;
+
+        for( int i = 0; i < 6000; i++ )
+        {
+            double angle = 2.0 * M_PI * i / 6000;
+            double radius = ( i % 2 ) ? 1000000 : 950000;
+            outline.Append( KiROUND( radius * cos( angle ) ), KiROUND( radius * sin( angle ) ) );
+        }
+
+        outline.SetClosed( true );
+        m_polySet.AddOutline( outline );
+
+        for( int x = -500000; x <= 500000; x += 100000 )
+        {
+            for( int y = -500000; y <= 500000; y += 100000 )
+            {
+                SHAPE_LINE_CHAIN hole;
+                hole.Append( x - 20000, y - 20000 );
+                hole.Append( x + 20000, y - 20000 );
+                hole.Append( x + 20000, y + 20000 );
+                hole.Append( x - 20000, y + 20000 );
+                hole.SetClosed( true );
+                m_polySet.AddHole( hole );
+            }
+        }
+
+        for( int i = 0; i < 5; i++ )
+        {
+            SHAPE_LINE_CHAIN island;
+            island.Append( 2000000 + i * 100000, 0 );
+            island.Append( 2050000 + i * 100000, 0 );
+            island.Append( 2050000 + i * 100000, 50000 );
+            island.Append( 2000000 + i * 100000, 50000 );
+            island.SetClosed( true );
+            m_polySet.AddOutline( island );
+        }
+    }
+
+    ///> Area of the set, outlines minus holes
+    double polySetArea() const
+    {
+        double area = 0.0;
+
+        for( int i = 0; i < m_polySet.OutlineCount(); i++ )
+        {
+            area += std::abs( m_polySet.COutline( i ).Area() );
+
+            for( int j = 0; j < m_polySet.HoleCount( i ); j++ )
+                area -= std::abs( m_polySet.CHole( i, j ).Area() );
+        }
+
+        return area;
+    }
+
+    ///> Sum of the areas of the cached triangles of aPolySet
+    static double triangulatedArea( const SHAPE_POLY_SET& aPolySet )
+    {
+        double area = 0.0;
+
+        for( unsigned int i = 0; i < aPolySet.TriangulatedPolyCount(); i++ )
+        {
+            const auto* triPoly = aPolySet.TriangulatedPolygon( i );
+
+            for( size_t j = 0; j < triPoly->GetTriangleCount(); j++ )
+            {
+                VECTOR2I a, b, c;
+                triPoly->GetTriangle( j, a, b, c );
+                area += std::abs( (double) ( b - a ).Cross( c - a ) ) / 2.0;
+            }
+        }
+
+        return area;
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( SPSTriangulation, TriangulationFixture )
+
+
+/**
+ * The triangles of all the (parallel triangulated) outlines cover the polygon area
+ */
+BOOST_AUTO_TEST_CASE( TrianglesCoverArea )
+{
+    m_polySet.CacheTriangulation();
+
+    BOOST_CHECK( m_polySet.IsTriangulationUpToDate() );
+    BOOST_CHECK_EQUAL( m_polySet.TriangulatedPolyCount(), m_polySet.OutlineCount() );
+    BOOST_CHECK_CLOSE( triangulatedArea( m_polySet ), polySetArea(), 1e-6 );
+}
+
+
+/**
+ * The triangulation is cached until the set is modified
+ */
+BOOST_AUTO_TEST_CASE( CachedUntilModified )
+{
+    m_polySet.CacheTriangulation();
+    BOOST_CHECK( m_polySet.IsTriangulationUpToDate() );
+
+    m_polySet.Move( VECTOR2I( 1000, 1000 ) );
+    BOOST_CHECK( !m_polySet.IsTriangulationUpToDate() );
+
+    m_polySet.CacheTriangulation();
+    BOOST_CHECK( m_polySet.IsTriangulationUpToDate() );
+    BOOST_CHECK_CLOSE( triangulatedArea( m_polySet ), polySetArea(), 1e-6 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
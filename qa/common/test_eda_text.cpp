@@ -0,0 +1,91 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the text size computations of EDA_TEXT
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <eda_text.h>
+
+#include <basic_gal.h>
+#include <math/util.h>
+
+
+/**
+ * Measures a line as EDA_TEXT::LenSize() used to, through the settings of basic_gal
+ */
+static int galLenSize( const EDA_TEXT& aText, const wxString& aLine, int aThickness )
+{
+    basic_gal.SetFontItalic( aText.IsItalic() );
+    basic_gal.SetFontBold( aText.IsBold() );
+    basic_gal.SetLineWidth( (float) aThickness );
+    basic_gal.SetGlyphSize( VECTOR2D( aText.GetTextSize() ) );
+
+    return KiROUND( basic_gal.GetTextLineSize( aLine ).x );
+}
+
+
+BOOST_AUTO_TEST_SUITE( EdaText )
+
+
+/**
+ * Italic and upright texts have the widths computed through the GAL settings, whatever
+ * the italic setting left in basic_gal
+ */
+BOOST_AUTO_TEST_CASE( LenSizeItalic )
+{
+    const wxString line = wxT( "Text_{sub} ~over~ 123" );
+
+    EDA_TEXT upright( line );
+    upright.SetTextSize( wxSize( 1000000, 1200000 ) );
+    upright.SetTextThickness( 150000 );
+
+    EDA_TEXT italic( upright );
+    italic.SetItalic( true );
+
+    const int thickness = upright.GetEffectiveTextPenWidth();
+
+    const int uprightWidth = galLenSize( upright, line, thickness );
+    const int italicWidth = galLenSize( italic, line, thickness );
+
+    BOOST_CHECK_GT( italicWidth, uprightWidth );
+
+    // basic_gal is left italic by the last measure
+    BOOST_CHECK_EQUAL( upright.LenSize( line, thickness ), uprightWidth );
+    BOOST_CHECK_EQUAL( italic.LenSize( line, thickness ), italicWidth );
+
+    basic_gal.SetFontItalic( false );
+
+    BOOST_CHECK_EQUAL( upright.LenSize( line, thickness ), uprightWidth );
+    BOOST_CHECK_EQUAL( italic.LenSize( line, thickness ), italicWidth );
+
+    // The text box has the same width as the line
+    BOOST_CHECK_EQUAL( upright.GetTextBox().GetWidth(), uprightWidth );
+    BOOST_CHECK_EQUAL( italic.GetTextBox().GetWidth(), italicWidth );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,125 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for PLOT_OUTPUT_BUFFER: the numbers must be formatted like printf() formats them
+ * in the C locale.
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <plot_output_buffer.h>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+
+
+/// Formats a number with a PLOT_OUTPUT_BUFFER function
+template <typename FUNC>
+static std::string format( FUNC aFunc )
+{
+    char buffer[PLOT_OUTPUT_BUFFER::MAX_NUMBER_LEN];
+    return std::string( buffer, aFunc( buffer ) );
+}
+
+
+/// Formats a number with snprintf()
+template <typename T>
+static std::string printfFormat( const char* aFormat, T aValue )
+{
+    char buffer[64];
+    snprintf( buffer, sizeof( buffer ), aFormat, aValue );
+    return buffer;
+}
+
+
+BOOST_AUTO_TEST_SUITE( PlotOutputBuffer )
+
+
+BOOST_AUTO_TEST_CASE( Integers )
+{
+    for( long long value : { 0LL, 7LL, -7LL, 10LL, 123456789LL, -2147483648LL, 2147483647LL } )
+    {
+        BOOST_CHECK_EQUAL( format( [&]( char* aBuf )
+                                   {
+                                       return PLOT_OUTPUT_BUFFER::FormatInt( aBuf, value );
+                                   } ),
+                           printfFormat( "%lld", value ) );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( FixedAndSignificant )
+{
+    std::mt19937                           rng( 1 );
+    std::uniform_real_distribution<double> dist( -1.0, 1.0 );
+
+    for( int ii = 0; ii < 100000; ii++ )
+    {
+        double value = dist( rng ) * std::pow( 10.0, ii % 10 - 3 );
+
+        BOOST_CHECK_EQUAL( format( [&]( char* aBuf )
+                                   {
+                                       return PLOT_OUTPUT_BUFFER::FormatFixed( aBuf, value, 6,
+                                                                               false );
+                                   } ),
+                           printfFormat( "%f", value ) );
+
+        // "%g" uses an exponent below 1e-4
+        if( std::fabs( value ) >= 1e-4 )
+        {
+            BOOST_CHECK_EQUAL( format( [&]( char* aBuf )
+                                       {
+                                           return PLOT_OUTPUT_BUFFER::FormatSignificant( aBuf,
+                                                                                         value, 6 );
+                                       } ),
+                               printfFormat( "%g", value ) );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( NoExponent )
+{
+    auto significant = []( double aValue )
+    {
+        return format( [&]( char* aBuf )
+                       {
+                           return PLOT_OUTPUT_BUFFER::FormatSignificant( aBuf, aValue, 6 );
+                       } );
+    };
+
+    BOOST_CHECK_EQUAL( significant( 0.0 ), "0" );
+    BOOST_CHECK_EQUAL( significant( -0.0 ), "0" );
+    BOOST_CHECK_EQUAL( significant( 1.5e-5 ), "0.000015" );
+    BOOST_CHECK_EQUAL( significant( -1e-12 ), "0" );
+    BOOST_CHECK_EQUAL( significant( 999999.7 ), "1000000" );
+    BOOST_CHECK_EQUAL( significant( 12345678.0 ), "12345678" );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
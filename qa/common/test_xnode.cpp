@@ -0,0 +1,260 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for XNODE_BUILDER and XNODE_STREAM: streaming a document must give the same
+ * output as building it as an XNODE tree and formatting the tree.
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <xnode.h>
+
+#include <profile.h>
+
+#include <wx/mstream.h>
+
+#include <memory>
+
+
+/**
+ * Produces a document shaped like a generic netlist, with aCompCount components and nets
+ */
+static void writeNetlistLike( XNODE_SINK& aSink, int aCompCount )
+{
+    aSink.StartElement( "export" );
+    aSink.AddAttribute( "version", "D" );
+
+    aSink.StartElement( "design" );
+    aSink.AddElement( "source", "/home/user/a \"quoted\" <path> & more.sch" );
+    aSink.AddElement( "date", "" );
+    aSink.StartElement( "sheet" );
+    aSink.AddAttribute( "number", "1" );
+    aSink.AddAttribute( "name", "/" );
+    aSink.StartElement( "title_block" );
+    aSink.AddElement( "title", wxString::FromUTF8( "Tit\xC3\xA9 \xE2\x82\xAC" ) );
+    aSink.AddElement( "company" );
+
+    for( int ii = 0; ii < 3; ii++ )
+    {
+        aSink.StartElement( "comment" );
+        aSink.AddAttribute( "number", wxString::Format( "%d", ii + 1 ) );
+        aSink.AddAttribute( "value", ii == 1 ? "multi\nline\twith \"quotes\"\r" : "" );
+        aSink.EndElement();
+    }
+
+    aSink.EndElement();
+    aSink.EndElement();
+    aSink.EndElement();
+
+    aSink.StartElement( "components" );
+
+    for( int ii = 0; ii < aCompCount; ii++ )
+    {
+        aSink.StartElement( "comp" );
+        aSink.AddAttribute( "ref", wxString::Format( "R%d", ii + 1 ) );
+        aSink.AddElement( "value", ii % 7 ? wxString::Format( "%dk", ii % 100 ) : "~" );
+        aSink.AddElement( "footprint", "Resistor_SMD:R_0603_1608Metric" );
+
+        aSink.StartElement( "fields" );
+        aSink.StartElement( "field" );
+        aSink.AddAttribute( "name", "MPN" );
+        aSink.AddText( "RC0603FR-0710KL" );
+        aSink.EndElement();
+        aSink.EndElement();
+
+        aSink.StartElement( "libsource" );
+        aSink.AddAttribute( "lib", "Device" );
+        aSink.AddAttribute( "part", "R" );
+        aSink.AddAttribute( "description", "Resistor" );
+        aSink.EndElement();
+
+        aSink.AddElement( "tstamp", wxString::Format( "%08X", ii ) );
+        aSink.EndElement();
+    }
+
+    aSink.EndElement();
+
+    aSink.StartElement( "nets" );
+
+    for( int ii = 0; ii < aCompCount; ii++ )
+    {
+        aSink.StartElement( "net" );
+        aSink.AddAttribute( "code", wxString::Format( "%d", ii + 1 ) );
+        aSink.AddAttribute( "name", wxString::Format( "Net-(R%d-Pad2)", ii + 1 ) );
+
+        for( int jj = 0; jj < 2; jj++ )
+        {
+            aSink.StartElement( "node" );
+            aSink.AddAttribute( "ref", wxString::Format( "R%d", ( ii + jj ) % aCompCount + 1 ) );
+            aSink.AddAttribute( "pin", jj ? "1" : "2" );
+            aSink.EndElement();
+        }
+
+        aSink.EndElement();
+    }
+
+    aSink.EndElement();
+
+    // Mixed content: an element following a textual child, and a textual child following
+    // an element
+    aSink.StartElement( "mixed" );
+    aSink.AddText( "text" );
+    aSink.AddElement( "a" );
+    aSink.AddElement( "b", "x" );
+    aSink.AddText( "tail" );
+    aSink.EndElement();
+
+    aSink.EndElement();
+}
+
+
+/// Formats an XNODE tree as an S-expression
+static std::string formatTreeSexpr( XNODE* aRoot )
+{
+    STRING_FORMATTER formatter;
+    aRoot->Format( &formatter, 0 );
+    return formatter.GetString();
+}
+
+
+/// Saves an XNODE tree as XML, the way the generic netlist used to be written
+static std::string formatTreeXml( XNODE* aRoot )
+{
+    wxXmlDocument        xdoc;
+    wxMemoryOutputStream stream;
+
+    xdoc.SetRoot( aRoot );
+    xdoc.Save( stream, 2 );
+    xdoc.DetachRoot();
+
+    std::string result( stream.GetLength(), '\0' );
+    stream.CopyTo( &result[0], result.size() );
+    return result;
+}
+
+
+static std::string formatStream( XNODE_STREAM::FORMAT aFormat, int aCompCount )
+{
+    STRING_FORMATTER formatter;
+    XNODE_STREAM     stream( &formatter, aFormat );
+
+    writeNetlistLike( stream, aCompCount );
+    return formatter.GetString();
+}
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_AUTO_TEST_SUITE( XNode )
+
+
+/**
+ * The builder gives the same tree as building it by hand
+ */
+BOOST_AUTO_TEST_CASE( Builder )
+{
+    XNODE_BUILDER builder;
+
+    builder.StartElement( "root" );
+    builder.AddAttribute( "version", "D" );
+    builder.AddElement( "empty" );
+    builder.AddElement( "value", "10k" );
+    builder.EndElement();
+
+    std::unique_ptr<XNODE> root( builder.ReleaseRoot() );
+
+    BOOST_REQUIRE( root );
+    BOOST_CHECK( root->GetName() == "root" );
+    BOOST_CHECK( root->GetAttribute( "version" ) == "D" );
+
+    XNODE* empty = root->GetChildren();
+    BOOST_REQUIRE( empty );
+    BOOST_CHECK( empty->GetName() == "empty" );
+    BOOST_CHECK( !empty->GetChildren() );
+
+    XNODE* value = empty->GetNext();
+    BOOST_REQUIRE( value );
+    BOOST_CHECK( value->GetNodeContent() == "10k" );
+    BOOST_CHECK( !value->GetNext() );
+
+    BOOST_CHECK( !builder.ReleaseRoot() );
+}
+
+
+/**
+ * Streaming gives the same S-expression and XML output as formatting the tree
+ */
+BOOST_AUTO_TEST_CASE( StreamMatchesTree )
+{
+    XNODE_BUILDER builder;
+    writeNetlistLike( builder, 20 );
+    XNODE* root = builder.ReleaseRoot();
+
+    BOOST_CHECK_EQUAL( formatStream( XNODE_STREAM::SEXPR, 20 ), formatTreeSexpr( root ) );
+    BOOST_CHECK_EQUAL( formatStream( XNODE_STREAM::XML, 20 ), formatTreeXml( root ) );
+
+    delete root;
+}
+
+
+/**
+ * Time building and formatting the tree against streaming, for a large netlist
+ */
+BOOST_AUTO_TEST_CASE( LargeNetlist )
+{
+    const int compCount = 30000;
+
+    for( XNODE_STREAM::FORMAT format : { XNODE_STREAM::SEXPR, XNODE_STREAM::XML } )
+    {
+        const char* name = format == XNODE_STREAM::XML ? "XML" : "S-expression";
+
+        PROF_COUNTER treeTimer;
+
+        XNODE_BUILDER builder;
+        writeNetlistLike( builder, compCount );
+        XNODE* root = builder.ReleaseRoot();
+
+        std::string fromTree = format == XNODE_STREAM::XML ? formatTreeXml( root )
+                                                           : formatTreeSexpr( root );
+        delete root;
+
+        treeTimer.Stop();
+
+        PROF_COUNTER streamTimer;
+
+        std::string fromStream = formatStream( format, compCount );
+
+        streamTimer.Stop();
+
+        BOOST_TEST_MESSAGE( name << " netlist of " << compCount << " components: tree "
+                            << treeTimer.msecs() << " ms, stream " << streamTimer.msecs()
+                            << " ms" );
+
+        BOOST_CHECK( fromStream == fromTree );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
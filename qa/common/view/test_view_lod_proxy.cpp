@@ -0,0 +1,329 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for VIEW_LOD_PROXY: merging of the item outlines per cell and incremental
+ * rebuilding of the cells.
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <view/view_lod_proxy.h>
+#include <view/view_item.h>
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+
+using namespace KIGFX;
+
+
+/**
+ * An item whose outline is a regular polygon inscribed in its bounding box
+ */
+class TEST_LOD_ITEM : public VIEW_ITEM
+{
+public:
+    TEST_LOD_ITEM( const VECTOR2I& aCenter, int aRadius, int aVertexCount = 4 ) :
+        m_center( aCenter ),
+        m_radius( aRadius ),
+        m_vertexCount( aVertexCount ),
+        m_proxied( true ),
+        m_lod( 0.0 )
+    {
+    }
+
+    const BOX2I ViewBBox() const override
+    {
+        return BOX2I( m_center - VECTOR2I( m_radius, m_radius ),
+                      VECTOR2I( 2 * m_radius, 2 * m_radius ) );
+    }
+
+    void ViewGetLayers( int aLayers[], int& aCount ) const override
+    {
+        aLayers[0] = 0;
+        aCount = 1;
+    }
+
+    void Outline( SHAPE_POLY_SET& aOutlines ) const
+    {
+        SHAPE_LINE_CHAIN chain;
+
+        for( int i = 0; i < m_vertexCount; ++i )
+        {
+            double angle = 2.0 * M_PI * i / m_vertexCount;
+            chain.Append( m_center.x + KiROUND( m_radius * cos( angle ) ),
+                          m_center.y + KiROUND( m_radius * sin( angle ) ) );
+        }
+
+        chain.SetClosed( true );
+        aOutlines.AddOutline( chain );
+    }
+
+    VECTOR2I m_center;
+    int      m_radius;
+    int      m_vertexCount;
+    bool     m_proxied;     ///< Is the item merged in the outlines?
+    double   m_lod;         ///< Scale the item is drawn from
+};
+
+
+class TEST_VIEW_LOD_PROXY_FIXTURE
+{
+public:
+    static constexpr int CELL_SIZE = 10000;
+
+    TEST_VIEW_LOD_PROXY_FIXTURE() :
+        m_proxy( 1.0, CELL_SIZE ),
+        m_outlineCount( 0 )
+    {
+    }
+
+    /// Rebuilds the cells of the whole layer, and returns the outlines
+    std::vector<const SHAPE_POLY_SET*> rebuild( double aTolerance = 0.0, double aScale = 0.5 )
+    {
+        BOX2I all;
+        all.SetMaximum();
+
+        m_proxy.Rebuild( all, aScale, aTolerance,
+                []( const VIEW_ITEM* aItem ) -> double
+                {
+                    return static_cast<const TEST_LOD_ITEM*>( aItem )->m_lod;
+                },
+                [this]( const VIEW_ITEM* aItem, SHAPE_POLY_SET& aOutlines ) -> bool
+                {
+                    const TEST_LOD_ITEM* item = static_cast<const TEST_LOD_ITEM*>( aItem );
+
+                    m_outlineCount++;
+
+                    if( !item->m_proxied )
+                        return false;
+
+                    item->Outline( aOutlines );
+                    return true;
+                } );
+
+        std::vector<const SHAPE_POLY_SET*> outlines;
+        m_proxy.Query( all, outlines );
+        return outlines;
+    }
+
+    VIEW_LOD_PROXY   m_proxy;
+    std::atomic<int> m_outlineCount;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( ViewLodProxy, TEST_VIEW_LOD_PROXY_FIXTURE )
+
+
+/**
+ * Overlapping items of a cell are merged in a single outline
+ */
+BOOST_AUTO_TEST_CASE( MergeCellItems )
+{
+    TEST_LOD_ITEM a( VECTOR2I( 1000, 1000 ), 500 );
+    TEST_LOD_ITEM b( VECTOR2I( 1400, 1000 ), 500 );
+
+    m_proxy.Add( &a );
+    m_proxy.Add( &b );
+
+    BOOST_CHECK( !m_proxy.Contains( &a ) );
+
+    std::vector<const SHAPE_POLY_SET*> outlines = rebuild();
+
+    BOOST_REQUIRE_EQUAL( outlines.size(), 1 );
+    BOOST_CHECK_EQUAL( outlines[0]->OutlineCount(), 1 );
+    BOOST_CHECK( m_proxy.Contains( &a ) );
+    BOOST_CHECK( m_proxy.Contains( &b ) );
+}
+
+
+/**
+ * Items without an outline are left out of the proxy
+ */
+BOOST_AUTO_TEST_CASE( ItemsDrawnByThemselves )
+{
+    TEST_LOD_ITEM a( VECTOR2I( 1000, 1000 ), 500 );
+    TEST_LOD_ITEM b( VECTOR2I( 5000, 5000 ), 500 );
+
+    b.m_proxied = false;
+
+    m_proxy.Add( &a );
+    m_proxy.Add( &b );
+
+    std::vector<const SHAPE_POLY_SET*> outlines = rebuild();
+
+    BOOST_REQUIRE_EQUAL( outlines.size(), 1 );
+    BOOST_CHECK_EQUAL( outlines[0]->OutlineCount(), 1 );
+    BOOST_CHECK( m_proxy.Contains( &a ) );
+    BOOST_CHECK( !m_proxy.Contains( &b ) );
+}
+
+
+/**
+ * Only the cells whose items changed are rebuilt
+ */
+BOOST_AUTO_TEST_CASE( IncrementalRebuild )
+{
+    std::vector<std::unique_ptr<TEST_LOD_ITEM>> items;
+
+    for( int x = 0; x < 4; ++x )
+    {
+        for( int y = 0; y < 4; ++y )
+        {
+            VECTOR2I center( x * CELL_SIZE + CELL_SIZE / 2, y * CELL_SIZE + CELL_SIZE / 2 );
+            items.push_back( std::make_unique<TEST_LOD_ITEM>( center, 1000 ) );
+            m_proxy.Add( items.back().get() );
+        }
+    }
+
+    BOOST_CHECK_EQUAL( rebuild().size(), 16 );
+    BOOST_CHECK_EQUAL( m_outlineCount, 16 );
+
+    // Nothing changed
+    m_outlineCount = 0;
+    rebuild();
+    BOOST_CHECK_EQUAL( m_outlineCount, 0 );
+
+    // Move an item to another cell, both cells are rebuilt
+    items[0]->m_center.x += 2 * CELL_SIZE;
+    m_proxy.Update( items[0].get() );
+    BOOST_CHECK( !m_proxy.Contains( items[0].get() ) );
+
+    std::vector<const SHAPE_POLY_SET*> outlines = rebuild();
+
+    BOOST_CHECK_EQUAL( outlines.size(), 15 );
+    BOOST_CHECK_EQUAL( m_outlineCount, 2 );
+    BOOST_CHECK( m_proxy.Contains( items[0].get() ) );
+
+    // Remove an item
+    m_outlineCount = 0;
+    m_proxy.Remove( items[1].get() );
+    BOOST_CHECK( !m_proxy.Contains( items[1].get() ) );
+    BOOST_CHECK_EQUAL( rebuild().size(), 14 );
+    BOOST_CHECK_EQUAL( m_outlineCount, 0 );
+
+    // Invalidate rebuilds all of them
+    m_proxy.Invalidate();
+    rebuild();
+    BOOST_CHECK_EQUAL( m_outlineCount, 15 );
+}
+
+
+/**
+ * The cells whose items are shown or hidden at the new scale are rebuilt, and only them
+ */
+BOOST_AUTO_TEST_CASE( ScaleCrossingLOD )
+{
+    TEST_LOD_ITEM a( VECTOR2I( 1000, 1000 ), 500 );
+    TEST_LOD_ITEM b( VECTOR2I( 3000, 1000 ), 500 );
+    TEST_LOD_ITEM c( VECTOR2I( 5 * CELL_SIZE, 1000 ), 500 );
+
+    b.m_lod = 0.3;
+
+    m_proxy.Add( &a );
+    m_proxy.Add( &b );
+    m_proxy.Add( &c );
+
+    BOOST_CHECK_EQUAL( rebuild( 0.0, 0.5 ).size(), 2 );
+    BOOST_CHECK_EQUAL( m_outlineCount, 3 );
+    BOOST_CHECK( m_proxy.Contains( &b ) );
+
+    // b is still drawn
+    m_outlineCount = 0;
+    rebuild( 0.0, 0.35 );
+    BOOST_CHECK_EQUAL( m_outlineCount, 0 );
+
+    // b is hidden: the cell is rebuilt without it
+    rebuild( 0.0, 0.3 );
+    BOOST_CHECK_EQUAL( m_outlineCount, 1 );
+    BOOST_CHECK( m_proxy.Contains( &a ) );
+    BOOST_CHECK( !m_proxy.Contains( &b ) );
+    BOOST_CHECK( m_proxy.Contains( &c ) );
+
+    // b is shown again
+    m_outlineCount = 0;
+    rebuild( 0.0, 0.5 );
+    BOOST_CHECK_EQUAL( m_outlineCount, 2 );
+    BOOST_CHECK( m_proxy.Contains( &b ) );
+}
+
+
+/**
+ * The cells are rebuilt once the scale changed enough for the tolerance to be out of date
+ */
+BOOST_AUTO_TEST_CASE( ScaleChangingTolerance )
+{
+    TEST_LOD_ITEM a( VECTOR2I( 1000, 1000 ), 500 );
+
+    m_proxy.Add( &a );
+
+    rebuild( 0.0, 0.5 );
+    BOOST_CHECK_EQUAL( m_outlineCount, 1 );
+
+    // Within the range of the tolerance
+    m_outlineCount = 0;
+    rebuild( 0.0, 0.3 );
+    rebuild( 0.0, 0.9 );
+    BOOST_CHECK_EQUAL( m_outlineCount, 0 );
+
+    // Zoomed out
+    rebuild( 0.0, 0.2 );
+    BOOST_CHECK_EQUAL( m_outlineCount, 1 );
+
+    // Zoomed in
+    m_outlineCount = 0;
+    rebuild( 0.0, 0.5 );
+    BOOST_CHECK_EQUAL( m_outlineCount, 1 );
+}
+
+
+/**
+ * Vertices closer than the tolerance are merged
+ */
+BOOST_AUTO_TEST_CASE( Decimation )
+{
+    TEST_LOD_ITEM circle( VECTOR2I( 1000, 1000 ), 1000, 360 );
+
+    m_proxy.Add( &circle );
+
+    std::vector<const SHAPE_POLY_SET*> outlines = rebuild( 0.0 );
+
+    // Merging the outlines drops the collinear vertices only
+    BOOST_REQUIRE_EQUAL( outlines.size(), 1 );
+    BOOST_CHECK_GT( outlines[0]->COutline( 0 ).PointCount(), 200 );
+
+    // 17.5 units between the vertices, about 1/4 of them are kept
+    m_proxy.Invalidate();
+    outlines = rebuild( 60.0 );
+
+    BOOST_REQUIRE_EQUAL( outlines.size(), 1 );
+    BOOST_CHECK_LT( outlines[0]->COutline( 0 ).PointCount(), 100 );
+    BOOST_CHECK_GT( outlines[0]->COutline( 0 ).PointCount(), 50 );
+    BOOST_CHECK( outlines[0]->IsTriangulationUpToDate() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
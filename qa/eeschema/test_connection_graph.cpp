@@ -0,0 +1,323 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the incremental updates of CONNECTION_GRAPH
+ */
+
+#include <class_libentry.h>
+#include <convert_to_biu.h>
+#include <lib_pin.h>
+#include <sch_component.h>
+#include <sch_connection.h>
+#include <sch_line.h>
+#include <sch_pin.h>
+#include <sch_screen.h>
+#include <sch_sheet.h>
+#include <sch_sheet_path.h>
+#include <sch_text.h>
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <connection_graph.h>
+
+#include <map>
+
+
+/// A point in mils
+static wxPoint mils( int aX, int aY )
+{
+    return wxPoint( Mils2iu( aX ), Mils2iu( aY ) );
+}
+
+
+/**
+ * A hierarchy of three sheets:
+ *  - the root sheet has R1, with its first pin wired to the "IN" pin of the Child sheet and
+ *    labelled "A", and its second pin unconnected
+ *  - the Child sheet has R3, with its first pin on the "IN" hierarchical label and its second
+ *    pin unconnected, and R4, with its first pin labelled "L"
+ *  - the Bulk sheet has unconnected resistors, so that edits to the other sheets affect few
+ *    enough subgraphs to be updated incrementally
+ */
+class TEST_CONNECTION_GRAPH_FIXTURE
+{
+public:
+    TEST_CONNECTION_GRAPH_FIXTURE() :
+            m_part( "R", nullptr ),
+            m_graph( nullptr )
+    {
+        m_part.GetReferenceField().SetText( "R" );
+
+        for( int ii = 0; ii < 2; ii++ )
+        {
+            LIB_PIN* pin = new LIB_PIN( &m_part );
+            pin->SetNumber( wxString::Format( "%d", ii + 1 ) );
+            pin->SetPosition( mils( 0, ii ? -200 : 200 ) );
+            m_part.AddDrawItem( pin );
+        }
+
+        m_previousRoot = g_RootSheet;
+        g_RootSheet = &m_root;
+
+        m_root.SetScreen( new SCH_SCREEN( nullptr ) );
+        m_root.SetFileName( "root.sch" );
+
+        m_child = addSheet( "Child", mils( 2000, 0 ) );
+        m_bulk = addSheet( "Bulk", mils( 2000, 3000 ) );
+
+        SCH_SHEET_PATH rootPath;
+        rootPath.push_back( &m_root );
+
+        SCH_SHEET_PATH childPath = rootPath;
+        childPath.push_back( m_child );
+
+        SCH_SHEET_PATH bulkPath = rootPath;
+        bulkPath.push_back( m_bulk );
+
+        // Root sheet
+        m_r1 = addComponent( rootPath, "R1", mils( 0, 0 ) );
+        wxPoint r1Pin1 = m_r1->GetSchPins( &rootPath )[0]->GetPosition();
+
+        SCH_SHEET_PIN* sheetPin = new SCH_SHEET_PIN( m_child, m_child->GetPosition(), "IN" );
+        m_child->AddPin( sheetPin );
+
+        addWire( rootPath, r1Pin1, sheetPin->GetPosition() );
+
+        m_label = new SCH_LABEL( r1Pin1, "A" );
+        m_root.GetScreen()->Append( m_label );
+
+        // Child sheet
+        m_r3 = addComponent( childPath, "R3", mils( 0, 0 ) );
+        wxPoint r3Pin1 = m_r3->GetSchPins( &childPath )[0]->GetPosition();
+
+        m_child->GetScreen()->Append( new SCH_HIERLABEL( r3Pin1, "IN" ) );
+
+        m_r4 = addComponent( childPath, "R4", mils( 1000, 0 ) );
+        wxPoint r4Pin1 = m_r4->GetSchPins( &childPath )[0]->GetPosition();
+
+        m_child->GetScreen()->Append( new SCH_LABEL( r4Pin1, "L" ) );
+
+        // Bulk sheet
+        for( int ii = 0; ii < 12; ii++ )
+            addComponent( bulkPath, wxString::Format( "R%d", 101 + ii ), mils( ii * 500, 0 ) );
+    }
+
+    ~TEST_CONNECTION_GRAPH_FIXTURE()
+    {
+        g_RootSheet = m_previousRoot;
+    }
+
+    /// Adds a sheet with its own screen to the root sheet
+    SCH_SHEET* addSheet( const wxString& aName, const wxPoint& aPos )
+    {
+        SCH_SHEET* sheet = new SCH_SHEET( aPos );
+        sheet->SetSize( wxSize( Mils2iu( 1000 ), Mils2iu( 1000 ) ) );
+        sheet->GetFields()[SHEETNAME].SetText( aName );
+        sheet->SetFileName( aName.Lower() + ".sch" );
+        sheet->SetScreen( new SCH_SCREEN( nullptr ) );
+        m_root.GetScreen()->Append( sheet );
+        return sheet;
+    }
+
+    /// Adds an annotated resistor to the screen of \a aSheet
+    SCH_COMPONENT* addComponent( SCH_SHEET_PATH& aSheet, const wxString& aRef,
+                                 const wxPoint& aPos )
+    {
+        SCH_COMPONENT* component = new SCH_COMPONENT( m_part, LIB_ID( "Device", "R" ), &aSheet,
+                                                      1, 0, aPos );
+        component->SetRef( &aSheet, aRef );
+        aSheet.LastScreen()->Append( component );
+        return component;
+    }
+
+    /// Adds a wire to the screen of \a aSheet
+    SCH_LINE* addWire( const SCH_SHEET_PATH& aSheet, const wxPoint& aStart, const wxPoint& aEnd )
+    {
+        SCH_LINE* wire = new SCH_LINE( aStart, LAYER_WIRE );
+        wire->SetEndPoint( aEnd );
+        aSheet.LastScreen()->Append( wire );
+        return wire;
+    }
+
+    /// The connection name and net code of every item on every sheet
+    struct NETS
+    {
+        std::map<std::pair<SCH_ITEM*, wxString>, wxString> m_names;
+        std::map<std::pair<SCH_ITEM*, wxString>, int>      m_codes;
+    };
+
+    NETS getNets()
+    {
+        NETS nets;
+
+        auto record =
+                [&]( SCH_ITEM* aItem, const SCH_SHEET_PATH& aSheet )
+                {
+                    SCH_CONNECTION* connection = aItem->Connection( aSheet );
+                    auto            key = std::make_pair( aItem, aSheet.PathAsString() );
+
+                    BOOST_REQUIRE( connection );
+                    nets.m_names[key] = connection->Name();
+                    nets.m_codes[key] = connection->NetCode();
+                };
+
+        for( const SCH_SHEET_PATH& sheet : SCH_SHEET_LIST( &m_root ) )
+        {
+            for( SCH_ITEM* item : sheet.LastScreen()->Items() )
+            {
+                if( item->Type() == SCH_COMPONENT_T )
+                {
+                    for( SCH_PIN* pin : static_cast<SCH_COMPONENT*>( item )->GetSchPins( &sheet ) )
+                        record( pin, sheet );
+                }
+                else if( item->Type() == SCH_SHEET_T )
+                {
+                    for( SCH_SHEET_PIN* pin : static_cast<SCH_SHEET*>( item )->GetPins() )
+                        record( pin, sheet );
+                }
+                else if( item->IsConnectable() )
+                {
+                    record( item, sheet );
+                }
+            }
+        }
+
+        return nets;
+    }
+
+    /**
+     * Updates the graph without flagging any item, and checks that it has the nets of a
+     * graph built from scratch.  The net codes may differ, but must group the same items.
+     */
+    void checkIncrementalUpdate()
+    {
+        SCH_SHEET_LIST sheets( &m_root );
+
+        m_graph.Recalculate( sheets );
+        BOOST_CHECK( m_graph.GetLastTimings().m_incremental );
+
+        NETS incremental = getNets();
+
+        m_graph.Recalculate( sheets, true );
+        BOOST_CHECK( !m_graph.GetLastTimings().m_incremental );
+
+        NETS full = getNets();
+
+        BOOST_CHECK( incremental.m_names == full.m_names );
+
+        std::map<int, int> codes;
+        std::map<int, int> reverseCodes;
+
+        for( const auto& it : incremental.m_codes )
+        {
+            int fullCode = full.m_codes.at( it.first );
+
+            BOOST_CHECK_EQUAL( codes.emplace( it.second, fullCode ).first->second, fullCode );
+            BOOST_CHECK_EQUAL( reverseCodes.emplace( fullCode, it.second ).first->second,
+                               it.second );
+        }
+    }
+
+    LIB_PART         m_part;
+    SCH_SHEET        m_root;
+    SCH_SHEET*       m_previousRoot;
+    SCH_SHEET*       m_child;
+    SCH_SHEET*       m_bulk;
+    SCH_COMPONENT*   m_r1;
+    SCH_COMPONENT*   m_r3;
+    SCH_COMPONENT*   m_r4;
+    SCH_LABEL*       m_label;
+    CONNECTION_GRAPH m_graph;
+};
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_FIXTURE_TEST_SUITE( ConnectionGraph, TEST_CONNECTION_GRAPH_FIXTURE )
+
+
+/**
+ * Edits which change the driver names without flagging the items as connectivity dirty
+ * update the nets as a full recalculation does
+ */
+BOOST_AUTO_TEST_CASE( IncrementalDriverNameChanges )
+{
+    SCH_SHEET_PATH rootPath;
+    rootPath.push_back( &m_root );
+
+    SCH_SHEET_PATH childPath = rootPath;
+    childPath.push_back( m_child );
+
+    m_graph.Recalculate( SCH_SHEET_LIST( &m_root ), true );
+
+    wxString r3Net = m_r3->GetSchPins( &childPath )[1]->Connection( childPath )->Name();
+    BOOST_CHECK( r3Net.Contains( "R3-Pad2" ) );
+
+    // Annotation
+    BOOST_TEST_CONTEXT( "Annotation" )
+    {
+        m_r3->SetRef( &childPath, "R30" );
+        checkIncrementalUpdate();
+
+        r3Net = m_r3->GetSchPins( &childPath )[1]->Connection( childPath )->Name();
+        BOOST_CHECK( r3Net.Contains( "R30-Pad2" ) );
+    }
+
+    // Annotation cleared, then set back
+    BOOST_TEST_CONTEXT( "Clear annotation" )
+    {
+        m_r1->ClearAnnotation( &rootPath );
+        checkIncrementalUpdate();
+
+        m_r1->SetRef( &rootPath, "R1" );
+        checkIncrementalUpdate();
+    }
+
+    // Label text, which names the net of the Child sheet
+    BOOST_TEST_CONTEXT( "Label text" )
+    {
+        m_label->SetText( "B" );
+        checkIncrementalUpdate();
+
+        wxString inNet = m_r3->GetSchPins( &childPath )[0]->Connection( childPath )->Name();
+        BOOST_CHECK_EQUAL( inNet, "/B" );
+    }
+
+    // Sheet name, which prefixes the local labels of the Child sheet
+    BOOST_TEST_CONTEXT( "Sheet name" )
+    {
+        wxString labelNet = m_r4->GetSchPins( &childPath )[0]->Connection( childPath )->Name();
+        BOOST_CHECK_EQUAL( labelNet, "/Child/L" );
+
+        m_child->GetFields()[SHEETNAME].SetText( "Renamed" );
+        checkIncrementalUpdate();
+
+        labelNet = m_r4->GetSchPins( &childPath )[0]->Connection( childPath )->Name();
+        BOOST_CHECK_EQUAL( labelNet, "/Renamed/L" );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,195 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the similar labels ERC test (NETLIST_OBJECT_LIST::TestforSimilarLabels)
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <netlist_object.h>
+
+#include <profile.h>
+#include <sch_screen.h>
+#include <sch_sheet.h>
+#include <sch_text.h>
+
+#include <memory>
+
+
+class TEST_ERC_SIMILAR_LABELS_FIXTURE
+{
+public:
+    TEST_ERC_SIMILAR_LABELS_FIXTURE()
+    {
+        m_root.SetScreen( new SCH_SCREEN( nullptr ) );
+    }
+
+    /// Adds a sheet below the root sheet, with its own screen, and returns its path
+    SCH_SHEET_PATH addSheet()
+    {
+        m_sheets.push_back( std::make_unique<SCH_SHEET>() );
+        m_sheets.back()->SetScreen( new SCH_SCREEN( nullptr ) );
+
+        SCH_SHEET_PATH path;
+        path.push_back( &m_root );
+        path.push_back( m_sheets.back().get() );
+        return path;
+    }
+
+    /// Adds a label to the netlist object list
+    void addLabel( const SCH_SHEET_PATH& aPath, NETLIST_ITEM aType, const wxString& aText )
+    {
+        m_labels.push_back( std::make_unique<SCH_LABEL>( wxPoint( 0, 0 ), aText ) );
+
+        NETLIST_OBJECT* item = new NETLIST_OBJECT();
+        item->m_Type = aType;
+        item->m_Comp = m_labels.back().get();
+        item->m_SheetPath = aPath;
+        item->m_Label = aText;
+        m_list.push_back( item );
+    }
+
+    /// Returns the number of markers created on the screen of aPath
+    int markerCount( const SCH_SHEET_PATH& aPath ) const
+    {
+        int count = 0;
+
+        for( SCH_ITEM* item : aPath.LastScreen()->Items().OfType( SCH_MARKER_T ) )
+        {
+            static_cast<void>( item );
+            count++;
+        }
+
+        return count;
+    }
+
+    SCH_SHEET                               m_root;
+    std::vector<std::unique_ptr<SCH_SHEET>> m_sheets;
+    std::vector<std::unique_ptr<SCH_LABEL>> m_labels;
+    NETLIST_OBJECT_LIST                     m_list;
+};
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_FIXTURE_TEST_SUITE( ErcSimilarLabels, TEST_ERC_SIMILAR_LABELS_FIXTURE )
+
+
+/**
+ * Check which pairs of labels are reported, and on which sheet
+ */
+BOOST_AUTO_TEST_CASE( Markers )
+{
+    SCH_SHEET_PATH root;
+    root.push_back( &m_root );
+
+    SCH_SHEET_PATH sheet1 = addSheet();
+    SCH_SHEET_PATH sheet2 = addSheet();
+    SCH_SHEET_PATH sheet3 = addSheet();
+
+    // Local labels differing by case on the same sheet
+    addLabel( sheet1, NETLIST_ITEM::LABEL, "clk" );
+    addLabel( sheet1, NETLIST_ITEM::LABEL, "CLK" );
+
+    // Identical labels, and labels differing by case on different sheets
+    addLabel( sheet1, NETLIST_ITEM::LABEL, "data" );
+    addLabel( sheet1, NETLIST_ITEM::LABEL, "data" );
+    addLabel( sheet1, NETLIST_ITEM::LABEL, "sda" );
+    addLabel( sheet2, NETLIST_ITEM::LABEL, "SDA" );
+
+    // Global labels differing by case: reported on the sheet of the less used one
+    addLabel( sheet1, NETLIST_ITEM::GLOBLABEL, "VCC" );
+    addLabel( sheet2, NETLIST_ITEM::GLOBLABEL, "VCC" );
+    addLabel( sheet2, NETLIST_ITEM::GLOBLABEL, "VCC" );
+    addLabel( sheet3, NETLIST_ITEM::GLOBLABEL, "Vcc" );
+
+    // A local label differing by case from a global one
+    addLabel( sheet2, NETLIST_ITEM::LABEL, "vcc" );
+
+    // Three different spellings on the same sheet
+    addLabel( sheet3, NETLIST_ITEM::LABEL, "Reset" );
+    addLabel( sheet3, NETLIST_ITEM::HIERLABEL, "RESET" );
+    addLabel( sheet3, NETLIST_ITEM::LABEL, "reset" );
+
+    // Sheet labels are not tested
+    addLabel( root, NETLIST_ITEM::SHEETLABEL, "RESET" );
+    addLabel( root, NETLIST_ITEM::SHEETLABEL, "reset" );
+
+    m_list.TestforSimilarLabels();
+
+    BOOST_CHECK_EQUAL( markerCount( root ), 0 );
+    BOOST_CHECK_EQUAL( markerCount( sheet1 ), 1 );
+    BOOST_CHECK_EQUAL( markerCount( sheet2 ), 1 );
+    BOOST_CHECK_EQUAL( markerCount( sheet3 ), 4 );
+}
+
+
+/**
+ * Time the test on a large hierarchy: many sheets with many labels each, and a set of
+ * global labels used on every sheet
+ */
+BOOST_AUTO_TEST_CASE( LargeHierarchy )
+{
+    const int sheetCount = 200;
+    const int labelCount = 250;
+    const int globalCount = 50;
+
+    std::vector<SCH_SHEET_PATH> paths;
+
+    for( int ii = 0; ii < sheetCount; ii++ )
+    {
+        paths.push_back( addSheet() );
+
+        for( int jj = 0; jj < labelCount; jj++ )
+            addLabel( paths.back(), NETLIST_ITEM::LABEL, wxString::Format( "NET_%d", jj ) );
+
+        for( int jj = 0; jj < globalCount; jj++ )
+            addLabel( paths.back(), NETLIST_ITEM::GLOBLABEL, wxString::Format( "GLOBAL_%d", jj ) );
+
+        // One local label differing by case from another one on each sheet
+        addLabel( paths.back(), NETLIST_ITEM::LABEL, "net_0" );
+    }
+
+    // And a global label differing by case from the others
+    addLabel( paths.front(), NETLIST_ITEM::GLOBLABEL, "global_0" );
+
+    PROF_COUNTER timer;
+
+    m_list.TestforSimilarLabels();
+
+    timer.Stop();
+
+    BOOST_TEST_MESSAGE( "TestforSimilarLabels() on " << m_list.size() << " labels: "
+                        << timer.msecs() << " ms" );
+
+    BOOST_CHECK_EQUAL( markerCount( paths.front() ), 2 );
+
+    for( int ii = 1; ii < sheetCount; ii++ )
+        BOOST_CHECK_EQUAL( markerCount( paths[ii] ), 1 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
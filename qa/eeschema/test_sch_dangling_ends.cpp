@@ -0,0 +1,262 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the dangling end tests of labels, wires and bus entries, and for
+ * DANGLING_END_ITEM_INDEX
+ */
+
+#include <convert_to_biu.h>
+#include <sch_bus_entry.h>
+#include <sch_line.h>
+#include <sch_sheet_path.h>
+#include <sch_text.h>
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <sch_item.h>
+
+#include <memory>
+
+
+/// A point in mils
+static wxPoint mils( int aX, int aY )
+{
+    return wxPoint( Mils2iu( aX ), Mils2iu( aY ) );
+}
+
+
+class TEST_SCH_DANGLING_ENDS_FIXTURE
+{
+public:
+    /// Adds a wire or a bus segment
+    SCH_LINE* addLine( const wxPoint& aStart, const wxPoint& aEnd, int aLayer )
+    {
+        SCH_LINE* line = new SCH_LINE( aStart, aLayer );
+        line->SetEndPoint( aEnd );
+        m_items.emplace_back( line );
+        return line;
+    }
+
+    /// Adds an item
+    template <typename T>
+    T* add( T* aItem )
+    {
+        m_items.emplace_back( aItem );
+        return aItem;
+    }
+
+    /// Updates the dangling state of all the items, as SCH_EDIT_FRAME::TestDanglingEnds() does
+    void testDanglingEnds()
+    {
+        std::vector<DANGLING_END_ITEM> endPoints;
+
+        for( const std::unique_ptr<SCH_ITEM>& item : m_items )
+            item->GetEndPoints( endPoints );
+
+        DANGLING_END_ITEM_INDEX index( std::move( endPoints ) );
+
+        for( const std::unique_ptr<SCH_ITEM>& item : m_items )
+            item->UpdateDanglingState( index, &m_path );
+    }
+
+    std::vector<std::unique_ptr<SCH_ITEM>> m_items;
+    SCH_SHEET_PATH                         m_path;
+};
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_FIXTURE_TEST_SUITE( SchDanglingEnds, TEST_SCH_DANGLING_ENDS_FIXTURE )
+
+
+/**
+ * The index visits the end points at a position in the order of the list, and lists the
+ * wire and bus segments
+ */
+BOOST_AUTO_TEST_CASE( IndexLookup )
+{
+    SCH_LINE*  wire = addLine( mils( 0, 0 ), mils( 1000, 0 ), LAYER_WIRE );
+    SCH_LABEL* label = add( new SCH_LABEL( mils( 1000, 0 ), "A" ) );
+    SCH_LINE*  bus = addLine( mils( 1000, 0 ), mils( 1000, 1000 ), LAYER_BUS );
+
+    std::vector<DANGLING_END_ITEM> endPoints;
+
+    for( const std::unique_ptr<SCH_ITEM>& item : m_items )
+        item->GetEndPoints( endPoints );
+
+    DANGLING_END_ITEM_INDEX index( std::move( endPoints ) );
+
+    BOOST_CHECK_EQUAL( index.Items().size(), 5 );
+    BOOST_CHECK( index.WireStarts() == std::vector<size_t>{ 0 } );
+    BOOST_CHECK( index.BusStarts() == std::vector<size_t>{ 3 } );
+
+    std::vector<size_t> found;
+
+    index.ForEachAt( mils( 1000, 0 ),
+            [&]( size_t aIdx, const DANGLING_END_ITEM& aItem ) -> bool
+            {
+                found.push_back( aIdx );
+                return true;
+            } );
+
+    BOOST_CHECK( found == ( std::vector<size_t>{ 1, 2, 3 } ) );
+    BOOST_CHECK( index.Items()[1].GetItem() == wire );
+    BOOST_CHECK( index.Items()[2].GetItem() == label );
+    BOOST_CHECK( index.Items()[3].GetItem() == bus );
+
+    // The visit stops when the function returns false
+    found.clear();
+
+    index.ForEachAt( mils( 1000, 0 ),
+            [&]( size_t aIdx, const DANGLING_END_ITEM& aItem ) -> bool
+            {
+                found.push_back( aIdx );
+                return aItem.GetType() != LABEL_END;
+            } );
+
+    BOOST_CHECK( found == ( std::vector<size_t>{ 1, 2 } ) );
+
+    // Points along a segment are not end points
+    found.clear();
+
+    index.ForEachAt( mils( 500, 0 ),
+            [&]( size_t aIdx, const DANGLING_END_ITEM& aItem ) -> bool
+            {
+                found.push_back( aIdx );
+                return true;
+            } );
+
+    BOOST_CHECK( found.empty() );
+
+    // But they are on the segments found by their bounding box
+    BOOST_CHECK( index.SegmentsAt( mils( 500, 0 ), false ) == std::vector<size_t>{ 0 } );
+    BOOST_CHECK( index.SegmentsAt( mils( 500, 0 ), true ).empty() );
+    BOOST_CHECK( index.SegmentsAt( mils( 1000, 500 ), true ) == std::vector<size_t>{ 3 } );
+    BOOST_CHECK( index.SegmentsAt( mils( 1000, 0 ), false ) == std::vector<size_t>{ 0 } );
+    BOOST_CHECK( index.SegmentsAt( mils( 1000, 0 ), true ) == std::vector<size_t>{ 3 } );
+    BOOST_CHECK( index.SegmentsAt( mils( 500, 500 ), false ).empty() );
+    BOOST_CHECK( index.SegmentsAt( wxPoint( Mils2iu( 500 ), 1 ), false, 1 )
+                 == std::vector<size_t>{ 0 } );
+}
+
+
+/**
+ * The segments around a point are found in the order of the list
+ */
+BOOST_AUTO_TEST_CASE( SegmentsInListOrder )
+{
+    std::vector<DANGLING_END_ITEM> endPoints;
+
+    for( int ii = 0; ii < 40; ii++ )
+    {
+        // Diagonals through ( 1000, 1000 ), and short wires away from it
+        int       len = ( ii % 2 ) ? 100 : 1000;
+        SCH_LINE* line = addLine( mils( 1000 - len, 1000 - ( ii % 5 ) * len / 5 ),
+                                  mils( 1000 + len, 1000 + ( ii % 5 ) * len / 5 ),
+                                  LAYER_WIRE );
+
+        if( ii % 2 )
+            line->Move( mils( 5000, 0 ) );
+    }
+
+    for( const std::unique_ptr<SCH_ITEM>& item : m_items )
+        item->GetEndPoints( endPoints );
+
+    DANGLING_END_ITEM_INDEX index( std::move( endPoints ) );
+    std::vector<size_t>     expected;
+
+    for( size_t ii = 0; ii < 40; ii += 2 )
+        expected.push_back( ii * 2 );
+
+    BOOST_CHECK( index.SegmentsAt( mils( 1000, 1000 ), false ) == expected );
+}
+
+
+/**
+ * A label takes the type of the segment it sits on, whatever segments come before it in
+ * the list
+ */
+BOOST_AUTO_TEST_CASE( LabelsOnSegments )
+{
+    SCH_LINE* bus = addLine( mils( 0, 1000 ), mils( 2000, 1000 ), LAYER_BUS );
+    SCH_LINE* wire = addLine( mils( 0, 0 ), mils( 2000, 0 ), LAYER_WIRE );
+
+    SCH_LABEL* wireLabel = add( new SCH_LABEL( mils( 1000, 0 ), "NET" ) );
+    SCH_LABEL* busLabel = add( new SCH_LABEL( mils( 1000, 1000 ), "BUS[0..3]" ) );
+    SCH_LABEL* floating = add( new SCH_LABEL( mils( 1000, 500 ), "FLOATING" ) );
+
+    testDanglingEnds();
+
+    BOOST_CHECK( !wireLabel->IsDangling() );
+    BOOST_CHECK( wireLabel->GetConnectionType() == CONNECTION_TYPE::NET );
+    BOOST_CHECK_EQUAL( wireLabel->ConnectedItems( m_path ).count( wire ), 1 );
+    BOOST_CHECK_EQUAL( wireLabel->ConnectedItems( m_path ).count( bus ), 0 );
+
+    BOOST_CHECK( !busLabel->IsDangling() );
+    BOOST_CHECK( busLabel->GetConnectionType() == CONNECTION_TYPE::BUS );
+    BOOST_CHECK_EQUAL( busLabel->ConnectedItems( m_path ).count( bus ), 1 );
+
+    BOOST_CHECK( floating->IsDangling() );
+    BOOST_CHECK( floating->GetConnectionType() == CONNECTION_TYPE::NONE );
+
+    // The wire ends are not connected to anything
+    BOOST_CHECK( wire->IsStartDangling() );
+    BOOST_CHECK( wire->IsEndDangling() );
+}
+
+
+/**
+ * Bus entries are connected anywhere along a bus segment
+ */
+BOOST_AUTO_TEST_CASE( BusEntriesAlongSegments )
+{
+    addLine( mils( 0, 0 ), mils( 0, 2000 ), LAYER_BUS );
+    addLine( mils( 50, 600 ), mils( 1000, 600 ), LAYER_BUS );
+
+    // From the middle of the vertical bus to a wire
+    SCH_BUS_WIRE_ENTRY* wireEntry = add( new SCH_BUS_WIRE_ENTRY( mils( 0, 1000 ) ) );
+    SCH_LINE*           wire = addLine( wireEntry->m_End(), mils( 1000, 1100 ), LAYER_WIRE );
+
+    // From the middle of the vertical bus to the middle of the horizontal one
+    SCH_BUS_BUS_ENTRY* busEntry = add( new SCH_BUS_BUS_ENTRY( mils( 0, 500 ) ) );
+    BOOST_REQUIRE( busEntry->m_End() == mils( 100, 600 ) );
+
+    SCH_BUS_BUS_ENTRY* farEntry = add( new SCH_BUS_BUS_ENTRY( mils( 2000, 2000 ) ) );
+
+    testDanglingEnds();
+
+    BOOST_CHECK( !wireEntry->IsDanglingStart() );
+    BOOST_CHECK( !wireEntry->IsDanglingEnd() );
+    BOOST_CHECK( !wire->IsStartDangling() );
+
+    BOOST_CHECK( !busEntry->IsDanglingStart() );
+    BOOST_CHECK( !busEntry->IsDanglingEnd() );
+
+    BOOST_CHECK( farEntry->IsDanglingStart() );
+    BOOST_CHECK( farEntry->IsDanglingEnd() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,294 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the symbol library index and the deferred symbol drawings of the legacy
+ * schematic plugin
+ */
+
+#include <class_libentry.h>
+#include <convert_to_biu.h>
+#include <lib_pin.h>
+#include <settings/settings_manager.h>
+#include <symbol_lib_table.h>
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <sch_io_mgr.h>
+
+#include <wx/ffile.h>
+
+
+/// A capacitor, with 110 mils long pins
+static const char* symbolC =
+        "#\n"
+        "# C\n"
+        "#\n"
+        "DEF C C 0 10 N Y 1 F N\n"
+        "F0 \"C\" 25 100 50 H V L CNN\n"
+        "F1 \"C\" 25 -100 50 H V L CNN\n"
+        "F2 \"\" 38 -150 50 H I C CNN\n"
+        "F3 \"\" 0 0 50 H I C CNN\n"
+        "DRAW\n"
+        "P 2 0 1 20 -80 -30 80 -30 N\n"
+        "P 2 0 1 20 -80 30 80 30 N\n"
+        "X ~ 1 0 150 110 D 50 50 1 1 P\n"
+        "X ~ 2 0 -150 110 U 50 50 1 1 P\n"
+        "ENDDRAW\n"
+        "ENDDEF\n";
+
+/// A resistor, with 50 mils long pins
+static const char* symbolR =
+        "#\n"
+        "# R\n"
+        "#\n"
+        "DEF R R 0 0 N Y 1 F N\n"
+        "F0 \"R\" 80 0 50 V V C CNN\n"
+        "F1 \"R\" 0 0 50 V V C CNN\n"
+        "F2 \"\" -70 0 50 V I C CNN\n"
+        "F3 \"\" 0 0 50 H I C CNN\n"
+        "DRAW\n"
+        "S -40 -100 40 100 0 1 10 N\n"
+        "X ~ 1 0 150 50 D 50 50 1 1 P\n"
+        "X ~ 2 0 -150 50 U 50 50 1 1 P\n"
+        "ENDDRAW\n"
+        "ENDDEF\n";
+
+
+class TEST_SCH_LEGACY_PLUGIN_FIXTURE
+{
+public:
+    TEST_SCH_LEGACY_PLUGIN_FIXTURE() :
+            m_modTime( 1, wxDateTime::Jan, 2020, 12, 0, 0 )
+    {
+        m_libFn = wxFileName::CreateTempFileName( "qa_symbols" );
+        wxRemoveFile( m_libFn.GetFullPath() );
+        m_libFn.SetExt( "lib" );
+
+        m_indexOnly[ SYMBOL_LIB_TABLE::PropIndexOnly ] = "";
+    }
+
+    ~TEST_SCH_LEGACY_PLUGIN_FIXTURE()
+    {
+        wxRemoveFile( m_libFn.GetFullPath() );
+        wxRemoveFile( indexFileName().GetFullPath() );
+    }
+
+    /**
+     * Writes the library file with \a aFirst and \a aSecond symbols.  The library always
+     * has the same modification time, so that only its contents can tell it changed.
+     */
+    void writeLibrary( const char* aFirst, const char* aSecond )
+    {
+        wxFFile file( m_libFn.GetFullPath(), "wb" );
+
+        BOOST_REQUIRE( file.IsOpened() );
+        file.Write( wxString( "EESchema-LIBRARY Version 2.4\n#encoding utf-8\n" ) );
+        file.Write( wxString( aFirst ) );
+        file.Write( wxString( aSecond ) );
+        file.Write( wxString( "#\n#End Library\n" ) );
+        file.Close();
+
+        BOOST_REQUIRE( m_libFn.SetTimes( nullptr, &m_modTime, nullptr ) );
+    }
+
+    /// The index file of the library, named as SCH_LEGACY_PLUGIN_CACHE names them
+    wxFileName indexFileName() const
+    {
+        std::string path( TO_UTF8( m_libFn.GetFullPath() ) );
+        wxFileName  fn;
+
+        fn.AssignDir( SETTINGS_MANAGER::GetUserSettingsPath() );
+        fn.AppendDir( "symbol_index" );
+        fn.SetName( wxString::Format( "%016llx",
+                                      (unsigned long long) std::hash<std::string>()( path ) ) );
+        fn.SetExt( "idx" );
+
+        return fn;
+    }
+
+    /// The contents of the index file
+    wxString readIndex() const
+    {
+        wxString contents;
+        wxFFile  file( indexFileName().GetFullPath(), "rb" );
+
+        if( file.IsOpened() )
+            file.ReadAll( &contents );
+
+        return contents;
+    }
+
+    /// The lengths of the pins of \a aPart, which tell the loaded drawing
+    static std::vector<int> pinLengths( LIB_PART* aPart )
+    {
+        LIB_PINS         pins;
+        std::vector<int> lengths;
+
+        aPart->GetPins( pins );
+
+        for( LIB_PIN* pin : pins )
+            lengths.push_back( pin->GetLength() );
+
+        return lengths;
+    }
+
+    /// Lists the symbols of the library, without their drawing
+    std::map<wxString, LIB_PART*> listSymbols( SCH_PLUGIN* aPlugin )
+    {
+        std::vector<LIB_PART*>        parts;
+        std::map<wxString, LIB_PART*> symbols;
+
+        aPlugin->EnumerateSymbolLib( parts, m_libFn.GetFullPath(), &m_indexOnly );
+
+        for( LIB_PART* part : parts )
+            symbols[ part->GetName() ] = part;
+
+        return symbols;
+    }
+
+    wxFileName m_libFn;
+    wxDateTime m_modTime;
+    PROPERTIES m_indexOnly;
+};
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_FIXTURE_TEST_SUITE( SchLegacyPlugin, TEST_SCH_LEGACY_PLUGIN_FIXTURE )
+
+
+/**
+ * The index written when loading a library gives the same symbol definitions when the
+ * library is loaded again
+ */
+BOOST_AUTO_TEST_CASE( IndexRoundTrip )
+{
+    writeLibrary( symbolC, symbolR );
+    wxRemoveFile( indexFileName().GetFullPath() );
+
+    SCH_PLUGIN::SCH_PLUGIN_RELEASER pi( SCH_IO_MGR::FindPlugin( SCH_IO_MGR::SCH_LEGACY ) );
+    std::map<wxString, LIB_PART*>   symbols = listSymbols( pi );
+
+    wxString index = readIndex();
+
+    BOOST_CHECK( index.StartsWith( "EESchema-LIBINDEX Version 1\n" ) );
+    BOOST_CHECK( index.Contains( "\nDEF C C " ) );
+    BOOST_CHECK( index.Contains( "\nDEF R R " ) );
+
+    SCH_PLUGIN::SCH_PLUGIN_RELEASER indexed( SCH_IO_MGR::FindPlugin( SCH_IO_MGR::SCH_LEGACY ) );
+    std::map<wxString, LIB_PART*>   indexedSymbols = listSymbols( indexed );
+
+    // The index was used as is
+    BOOST_CHECK_EQUAL( readIndex(), index );
+    BOOST_REQUIRE_EQUAL( indexedSymbols.size(), 2 );
+
+    for( const auto& it : symbols )
+    {
+        BOOST_TEST_CONTEXT( it.first )
+        {
+            LIB_PART* part = it.second;
+            LIB_PART* indexedPart = indexedSymbols.at( it.first );
+
+            BOOST_CHECK_EQUAL( indexedPart->GetReferenceField().GetText(),
+                               part->GetReferenceField().GetText() );
+            BOOST_CHECK_EQUAL( indexedPart->GetValueField().GetText(),
+                               part->GetValueField().GetText() );
+            BOOST_CHECK_EQUAL( indexedPart->GetPinNameOffset(), part->GetPinNameOffset() );
+            BOOST_CHECK_EQUAL( indexedPart->ShowPinNumbers(), part->ShowPinNumbers() );
+            BOOST_CHECK_EQUAL( indexedPart->GetUnitCount(), part->GetUnitCount() );
+        }
+    }
+}
+
+
+/**
+ * Listed symbols have no drawing until they are loaded
+ */
+BOOST_AUTO_TEST_CASE( DeferredDrawing )
+{
+    writeLibrary( symbolC, symbolR );
+
+    SCH_PLUGIN::SCH_PLUGIN_RELEASER pi( SCH_IO_MGR::FindPlugin( SCH_IO_MGR::SCH_LEGACY ) );
+    std::map<wxString, LIB_PART*>   symbols = listSymbols( pi );
+
+    BOOST_REQUIRE_EQUAL( symbols.size(), 2 );
+    BOOST_CHECK( pinLengths( symbols.at( "C" ) ).empty() );
+    BOOST_CHECK( pinLengths( symbols.at( "R" ) ).empty() );
+
+    LIB_PART* r = pi->LoadSymbol( m_libFn.GetFullPath(), "R" );
+
+    BOOST_CHECK_EQUAL( r, symbols.at( "R" ) );
+    BOOST_CHECK( pinLengths( r ) == std::vector<int>( 2, Mils2iu( 50 ) ) );
+    BOOST_CHECK( pinLengths( symbols.at( "C" ) ).empty() );
+
+    // Listing the symbols with their drawing loads the others
+    std::vector<LIB_PART*> parts;
+    pi->EnumerateSymbolLib( parts, m_libFn.GetFullPath() );
+
+    BOOST_CHECK( pinLengths( symbols.at( "C" ) ) == std::vector<int>( 2, Mils2iu( 110 ) ) );
+    BOOST_CHECK( pinLengths( r ) == std::vector<int>( 2, Mils2iu( 50 ) ) );
+}
+
+
+/**
+ * An index out of date with its library, which has the same size and modification time,
+ * is rebuilt instead of loading the drawing of another symbol
+ */
+BOOST_AUTO_TEST_CASE( StaleIndex )
+{
+    writeLibrary( symbolC, symbolR );
+
+    {
+        SCH_PLUGIN::SCH_PLUGIN_RELEASER pi( SCH_IO_MGR::FindPlugin( SCH_IO_MGR::SCH_LEGACY ) );
+        listSymbols( pi );
+    }
+
+    wxString staleIndex = readIndex();
+    BOOST_REQUIRE( !staleIndex.IsEmpty() );
+
+    // The symbols swap places, so the offset of each one is that of the other
+    writeLibrary( symbolR, symbolC );
+
+    SCH_PLUGIN::SCH_PLUGIN_RELEASER pi( SCH_IO_MGR::FindPlugin( SCH_IO_MGR::SCH_LEGACY ) );
+    std::map<wxString, LIB_PART*>   symbols = listSymbols( pi );
+
+    // The index cannot tell it is stale yet
+    BOOST_CHECK_EQUAL( readIndex(), staleIndex );
+    BOOST_REQUIRE_EQUAL( symbols.size(), 2 );
+
+    LIB_PART* r = pi->LoadSymbol( m_libFn.GetFullPath(), "R" );
+
+    BOOST_CHECK_EQUAL( r, symbols.at( "R" ) );
+    BOOST_CHECK( pinLengths( r ) == std::vector<int>( 2, Mils2iu( 50 ) ) );
+    BOOST_CHECK( readIndex() != staleIndex );
+
+    LIB_PART* c = pi->LoadSymbol( m_libFn.GetFullPath(), "C" );
+
+    BOOST_CHECK_EQUAL( c, symbols.at( "C" ) );
+    BOOST_CHECK( pinLengths( c ) == std::vector<int>( 2, Mils2iu( 110 ) ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -271,4 +271,56 @@ BOOST_AUTO_TEST_CASE( SingleElementTree )
     BOOST_CHECK_EQUAL( count, 1 );
 }
 
+/**
+ * Check the pin index: one entry per pin, queries returning each owner once, and removal
+ * of an owner after it was moved
+ */
+BOOST_AUTO_TEST_CASE( PinIndex )
+{
+    EE_PIN_RTREE pinTree;
+
+    SCH_JUNCTION   junction( wxPoint( 0, 0 ) );
+    SCH_NO_CONNECT nc( wxPoint( Mils2iu( 1000 ), 0 ) );
+
+    // Two "pins" on the left and right of each item, overlapping at their inner ends
+    auto pinRects = []( const wxPoint& aPos ) {
+        return std::vector<EDA_RECT>{
+            EDA_RECT( aPos - wxPoint( Mils2iu( 100 ), 0 ), wxSize( Mils2iu( 100 ), 0 ) ),
+            EDA_RECT( aPos, wxSize( Mils2iu( 100 ), 0 ) )
+        };
+    };
+
+    pinTree.insert( &junction, pinRects( junction.GetPosition() ) );
+    pinTree.insert( &nc, pinRects( nc.GetPosition() ) );
+
+    BOOST_CHECK_EQUAL( pinTree.size(), 2 );
+    BOOST_CHECK( pinTree.contains( &junction ) );
+
+    // Both pins of the junction are at its position, but it is reported once
+    std::vector<SCH_ITEM*> owners = pinTree.Owners( SCH_LOCATE_ANY_T, wxPoint( 0, 0 ) );
+    BOOST_CHECK_EQUAL( owners.size(), 1 );
+    BOOST_CHECK( owners[0] == &junction );
+
+    BOOST_CHECK( pinTree.Owners( SCH_NO_CONNECT_T, wxPoint( 0, 0 ) ).empty() );
+    BOOST_CHECK( pinTree.Owners( SCH_LOCATE_ANY_T, wxPoint( Mils2iu( 500 ), 0 ) ).empty() );
+    BOOST_CHECK_EQUAL( pinTree.Owners( SCH_LOCATE_ANY_T, wxPoint( Mils2iu( 500 ), 0 ),
+                                       Mils2iu( 400 ) ).size(), 2 );
+
+    // Moving an item does not prevent removing its pins
+    junction.Move( wxPoint( Mils2iu( 5000 ), Mils2iu( 5000 ) ) );
+    BOOST_CHECK( pinTree.remove( &junction ) );
+    BOOST_CHECK( !pinTree.remove( &junction ) );
+    BOOST_CHECK( pinTree.Owners( SCH_LOCATE_ANY_T, wxPoint( 0, 0 ) ).empty() );
+
+    // Inserting an item again replaces its pins
+    pinTree.insert( &nc, pinRects( wxPoint( 0, Mils2iu( 1000 ) ) ) );
+    BOOST_CHECK_EQUAL( pinTree.size(), 1 );
+    BOOST_CHECK( pinTree.Owners( SCH_LOCATE_ANY_T, nc.GetPosition() ).empty() );
+    BOOST_CHECK_EQUAL( pinTree.Owners( SCH_NO_CONNECT_T, wxPoint( 0, Mils2iu( 1000 ) ) ).size(),
+                       1 );
+
+    pinTree.clear();
+    BOOST_CHECK( pinTree.empty() );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,122 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the point queries of SCH_SCREEN
+ */
+
+#include <convert_to_biu.h>
+#include <sch_line.h>
+#include <sch_sheet.h>
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <sch_screen.h>
+
+
+class TEST_SCH_SCREEN_FIXTURE
+{
+public:
+    TEST_SCH_SCREEN_FIXTURE() : m_screen( nullptr )
+    {
+    }
+
+    /// Adds a wire to the screen
+    SCH_LINE* addWire( const wxPoint& aStart, const wxPoint& aEnd )
+    {
+        SCH_LINE* wire = new SCH_LINE( aStart, LAYER_WIRE );
+        wire->SetEndPoint( aEnd );
+        m_screen.Append( wire );
+        return wire;
+    }
+
+    SCH_SCREEN m_screen;
+};
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_FIXTURE_TEST_SUITE( SchScreen, TEST_SCH_SCREEN_FIXTURE )
+
+
+/**
+ * Sheet pins moved, rotated or mirrored in place are found at their new position once their
+ * sheet is updated, as the move and edit tools do
+ */
+BOOST_AUTO_TEST_CASE( SheetPinChangedInPlace )
+{
+    SCH_SHEET* sheet = new SCH_SHEET( wxPoint( 0, 0 ) );
+    sheet->SetSize( wxSize( Mils2iu( 2000 ), Mils2iu( 1000 ) ) );
+
+    const wxPoint  center( Mils2iu( 1000 ), Mils2iu( 500 ) );
+    const wxPoint  pinPos( 0, Mils2iu( 500 ) );
+    SCH_SHEET_PIN* pin = new SCH_SHEET_PIN( sheet, pinPos, "IN" );
+    sheet->AddPin( pin );
+    m_screen.Append( sheet );
+
+    // Two wires ending on the pin need a junction
+    addWire( wxPoint( -Mils2iu( 1000 ), pinPos.y ), pinPos );
+    addWire( pinPos, wxPoint( -Mils2iu( 1000 ), Mils2iu( 1500 ) ) );
+
+    BOOST_CHECK( m_screen.GetSheetLabel( pinPos ) == pin );
+    BOOST_CHECK( m_screen.IsJunctionNeeded( pinPos ) );
+
+    // Moved along the sheet edge
+    const wxPoint movedPos( 0, Mils2iu( 200 ) );
+    pin->ConstrainOnEdge( movedPos );
+    m_screen.Update( sheet );
+
+    BOOST_CHECK_EQUAL( pin->GetPosition(), movedPos );
+    BOOST_CHECK( m_screen.GetSheetLabel( movedPos ) == pin );
+    BOOST_CHECK( m_screen.GetSheetLabel( pinPos ) == nullptr );
+    BOOST_CHECK( !m_screen.IsJunctionNeeded( pinPos ) );
+
+    // Mirrored to the right side of the sheet
+    pin->MirrorY( center.x );
+    m_screen.Update( sheet );
+
+    const wxPoint mirroredPos( Mils2iu( 2000 ), movedPos.y );
+    BOOST_CHECK_EQUAL( pin->GetPosition(), mirroredPos );
+    BOOST_CHECK( m_screen.GetSheetLabel( mirroredPos ) == pin );
+    BOOST_CHECK( m_screen.GetSheetLabel( movedPos ) == nullptr );
+
+    // Rotated to the top or bottom side of the sheet
+    pin->Rotate( center );
+    m_screen.Update( sheet );
+
+    const wxPoint rotatedPos = pin->GetPosition();
+    BOOST_CHECK( rotatedPos.y == 0 || rotatedPos.y == Mils2iu( 1000 ) );
+    BOOST_CHECK( m_screen.GetSheetLabel( rotatedPos ) == pin );
+    BOOST_CHECK( m_screen.GetSheetLabel( mirroredPos ) == nullptr );
+
+    // Back on the wires, the junction is needed again
+    pin->ConstrainOnEdge( pinPos );
+    m_screen.Update( sheet );
+
+    BOOST_CHECK( m_screen.GetSheetLabel( pinPos ) == pin );
+    BOOST_CHECK( m_screen.IsJunctionNeeded( pinPos ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,145 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/utility_registry.h>
+
+#include <iostream>
+#include <memory>
+
+#include <common.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+#include <wx/dir.h>
+#include <wx/filename.h>
+
+#include <gerber_file_image.h>
+
+
+/**
+ * Load a Gerber file several times, and print the load time
+ *
+ * @param aFileName the file to load
+ * @param aReps the count of loads
+ * @param aTotalMs the load time, in ms, is added to this total
+ * @return true if the file was loaded
+ */
+static bool loadGerber( const wxString& aFileName, int aReps, double& aTotalMs )
+{
+    int          itemCount = 0;
+    PROF_COUNTER timer;
+
+    for( int i = 0; i < aReps; i++ )
+    {
+        std::unique_ptr<GERBER_FILE_IMAGE> image = std::make_unique<GERBER_FILE_IMAGE>( 0 );
+
+        if( !image->LoadGerberFile( aFileName ) )
+        {
+            std::cerr << "Cannot load " << aFileName.ToStdString() << std::endl;
+            return false;
+        }
+
+        itemCount = image->GetItemsCount();
+    }
+
+    timer.Stop();
+
+    double loadMs = timer.msecs() / aReps;
+    aTotalMs += loadMs;
+
+    std::cout << wxFileName( aFileName ).GetFullName().ToStdString() << ": " << itemCount
+              << " items, " << loadMs << " ms" << std::endl;
+
+    return true;
+}
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "r", "reps", _( "number of loads of each file" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "Gerber files or directories" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum GERBER_LOAD_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+int gerber_load_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText(
+            _( "This program loads Gerber files, given by name or as all the files of the "
+               "given directories (eg. gerbview/gerber_test_files), and prints the time "
+               "taken to load each of them." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long reps = 1;
+    cl_parser.Found( "reps", &reps );
+    reps = std::max( reps, 1L );
+
+    wxArrayString files;
+
+    for( unsigned i = 0; i < cl_parser.GetParamCount(); i++ )
+    {
+        const wxString& param = cl_parser.GetParam( i );
+
+        if( wxDirExists( param ) )
+            wxDir::GetAllFiles( param, &files, wxEmptyString, wxDIR_FILES );
+        else
+            files.Add( param );
+    }
+
+    files.Sort();
+
+    bool   ok = true;
+    double totalMs = 0.0;
+
+    for( const wxString& file : files )
+        ok = loadGerber( file, reps, totalMs ) && ok;
+
+    std::cout << files.size() << " files loaded in " << totalMs << " ms" << std::endl;
+
+    if( !ok )
+        return GERBER_LOAD_RET_CODES::LOAD_FAILED;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register(
+        { "gerber_load", "Time loading Gerber files", gerber_load_main_func } );
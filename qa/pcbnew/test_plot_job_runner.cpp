@@ -0,0 +1,256 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for PLOT_JOB_RUNNER, which must write the same plot files as plotting the
+ * layers one after another
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <pcbnew_utils/board_construction_utils.h>
+
+#include <class_board.h>
+#include <class_drawsegment.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <common.h>
+#include <pcbplot.h>
+#include <plotter.h>
+
+// Code under test
+#include <plot_job_runner.h>
+
+#include <wx/filename.h>
+
+#include <fstream>
+#include <set>
+
+
+/**
+ * A board with a track and a filled zone on each outer copper layer, a via, a board outline
+ * and a footprint with a through hole and a SMD pad
+ */
+class TEST_PLOT_JOB_RUNNER_FIXTURE
+{
+public:
+    TEST_PLOT_JOB_RUNNER_FIXTURE()
+    {
+        m_baseFn = wxFileName::CreateTempFileName( "qa_plot" );
+        wxRemoveFile( m_baseFn.GetFullPath() );
+
+        for( PCB_LAYER_ID layer : { F_Cu, B_Cu } )
+        {
+            const int endY = layer == F_Cu ? 5 : 10;
+
+            TRACK* track = new TRACK( &m_board );
+            track->SetLayer( layer );
+            track->SetStart( wxPoint( Millimeter2iu( 5 ), Millimeter2iu( 5 ) ) );
+            track->SetEnd( wxPoint( Millimeter2iu( 25 ), Millimeter2iu( endY ) ) );
+            track->SetWidth( Millimeter2iu( 0.25 ) );
+            m_board.Add( track );
+
+            ZONE_CONTAINER* zone = new ZONE_CONTAINER( &m_board );
+
+            zone->SetLayer( layer );
+            zone->SetMinThickness( Millimeter2iu( 0.2 ) );
+            zone->Outline()->NewOutline();
+            zone->Outline()->Append( Millimeter2iu( 30 ), Millimeter2iu( 2 ) );
+            zone->Outline()->Append( Millimeter2iu( 38 ), Millimeter2iu( 2 ) );
+            zone->Outline()->Append( Millimeter2iu( 38 ), Millimeter2iu( 18 ) );
+            zone->Outline()->Append( Millimeter2iu( 30 ), Millimeter2iu( 18 ) );
+
+            SHAPE_POLY_SET fill = *zone->Outline();
+            zone->SetFilledPolysList( fill );
+            zone->SetIsFilled( true );
+            m_board.Add( zone );
+        }
+
+        VIA* via = new VIA( &m_board );
+        via->SetViaType( VIATYPE::THROUGH );
+        via->SetLayerPair( F_Cu, B_Cu );
+        via->SetPosition( wxPoint( Millimeter2iu( 25 ), Millimeter2iu( 10 ) ) );
+        via->SetWidth( Millimeter2iu( 0.8 ) );
+        via->SetDrill( Millimeter2iu( 0.4 ) );
+        m_board.Add( via );
+
+        const wxPoint corners[] = { wxPoint( 0, 0 ), wxPoint( Millimeter2iu( 40 ), 0 ),
+                                    wxPoint( Millimeter2iu( 40 ), Millimeter2iu( 20 ) ),
+                                    wxPoint( 0, Millimeter2iu( 20 ) ) };
+
+        for( int ii = 0; ii < 4; ii++ )
+        {
+            DRAWSEGMENT* edge = new DRAWSEGMENT( &m_board );
+            edge->SetLayer( Edge_Cuts );
+            edge->SetStart( corners[ii] );
+            edge->SetEnd( corners[( ii + 1 ) % 4] );
+            edge->SetWidth( Millimeter2iu( 0.1 ) );
+            m_board.Add( edge );
+        }
+
+        MODULE* module = new MODULE( &m_board );
+        module->SetReference( "U1" );
+
+        D_PAD* thtPad = new D_PAD( module );
+        thtPad->SetName( "1" );
+        thtPad->SetPosition( wxPoint( Millimeter2iu( 10 ), Millimeter2iu( 12 ) ) );
+        thtPad->SetPos0( thtPad->GetPosition() );
+        module->Add( thtPad );
+
+        D_PAD* smdPad = new D_PAD( module );
+        smdPad->SetName( "2" );
+        smdPad->SetShape( PAD_SHAPE_RECT );
+        smdPad->SetAttribute( PAD_ATTRIB_SMD );
+        smdPad->SetLayerSet( D_PAD::SMDMask() );
+        smdPad->SetSize( wxSize( Millimeter2iu( 1.5 ), Millimeter2iu( 1 ) ) );
+        smdPad->SetPosition( wxPoint( Millimeter2iu( 14 ), Millimeter2iu( 12 ) ) );
+        smdPad->SetPos0( smdPad->GetPosition() );
+        module->Add( smdPad );
+
+        KI_TEST::DrawRect( *module, VECTOR2I( Millimeter2iu( 12 ), Millimeter2iu( 12 ) ),
+                           VECTOR2I( Millimeter2iu( 8 ), Millimeter2iu( 4 ) ), 0,
+                           Millimeter2iu( 0.12 ), F_SilkS );
+
+        m_board.Add( module );
+
+        // The solder mask layers change the board settings while they are plotted, so the
+        // runner plots them after the other layers
+        m_board.GetDesignSettings().m_SolderMaskMinWidth = Millimeter2iu( 0.1 );
+    }
+
+    ~TEST_PLOT_JOB_RUNNER_FIXTURE()
+    {
+        for( const wxString& file : m_files )
+            wxRemoveFile( file );
+    }
+
+    /// The plot file of \a aLayer, for the serial plot or the runner plot
+    wxString plotFileName( PCB_LAYER_ID aLayer, const wxString& aSuffix )
+    {
+        wxFileName fn( m_baseFn );
+        wxString   layerName = LSET::Name( aLayer );
+
+        layerName.Replace( ".", "_" );
+        fn.SetName( fn.GetName() + "-" + layerName + "-" + aSuffix );
+        fn.SetExt( "gbr" );
+
+        m_files.insert( fn.GetFullPath() );
+        return fn.GetFullPath();
+    }
+
+    /**
+     * The lines of a plot file, without the lines giving the plot date (the "G04 Created by"
+     * comment and the TF.CreationDate attribute), which differ between two plots
+     */
+    static std::vector<std::string> readPlot( const wxString& aFileName )
+    {
+        std::ifstream            file( aFileName.fn_str() );
+        std::vector<std::string> lines;
+        std::string              line;
+
+        BOOST_REQUIRE( file.is_open() );
+
+        while( std::getline( file, line ) )
+        {
+            if( line.compare( 0, 14, "G04 Created by" ) == 0
+                    || line.find( "TF.CreationDate" ) != std::string::npos )
+                continue;
+
+            lines.push_back( line );
+        }
+
+        return lines;
+    }
+
+    BOARD              m_board;
+    wxFileName         m_baseFn;
+    std::set<wxString> m_files;
+};
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_FIXTURE_TEST_SUITE( PlotJobRunner, TEST_PLOT_JOB_RUNNER_FIXTURE )
+
+
+/**
+ * The layers plotted by the runner give the same Gerber files as the layers plotted one
+ * after another, with the X2 attributes and the netlist attributes
+ */
+BOOST_AUTO_TEST_CASE( SameFilesAsSerialPlot )
+{
+    const PCB_LAYER_ID layers[] = { F_Cu, B_Cu, F_SilkS, F_Mask, B_Mask, F_Paste, Edge_Cuts };
+
+    PCB_PLOT_PARAMS plotOpts;
+    plotOpts.SetFormat( PLOT_FORMAT::GERBER );
+    plotOpts.SetUseGerberX2format( true );
+    plotOpts.SetIncludeGerberNetlistInfo( true );
+
+    BOOST_REQUIRE( PlotLayerChangesBoardSettings( &m_board, F_Mask ) );
+
+    // Serial plot, as done before the runner
+    {
+        LOCALE_IO toggle;
+
+        for( PCB_LAYER_ID layer : layers )
+        {
+            PLOTTER* plotter = StartPlotBoard( &m_board, &plotOpts, layer,
+                                               plotFileName( layer, "serial" ), wxEmptyString );
+
+            BOOST_REQUIRE( plotter );
+
+            PlotOneBoardLayer( &m_board, plotter, layer, plotOpts );
+            plotter->EndPlot();
+
+            delete plotter->RenderSettings();
+            delete plotter;
+        }
+    }
+
+    PLOT_JOB_RUNNER runner( &m_board );
+
+    for( PCB_LAYER_ID layer : layers )
+        runner.AddLayerJob( layer, plotFileName( layer, "runner" ), plotOpts );
+
+    BOOST_CHECK_EQUAL( runner.GetJobCount(), 7 );
+    BOOST_CHECK_EQUAL( runner.Run(), 0 );
+    BOOST_CHECK_EQUAL( runner.GetJobCount(), 0 );
+
+    for( PCB_LAYER_ID layer : layers )
+    {
+        BOOST_TEST_CONTEXT( wxString( LSET::Name( layer ) ) )
+        {
+            std::vector<std::string> serial = readPlot( plotFileName( layer, "serial" ) );
+            std::vector<std::string> parallel = readPlot( plotFileName( layer, "runner" ) );
+
+            BOOST_CHECK( !serial.empty() );
+            BOOST_CHECK_EQUAL_COLLECTIONS( serial.begin(), serial.end(), parallel.begin(),
+                                           parallel.end() );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
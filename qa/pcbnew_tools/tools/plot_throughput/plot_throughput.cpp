@@ -0,0 +1,229 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <common.h>
+#include <class_board.h>
+#include <class_zone.h>
+#include <pcbplot.h>
+#include <plotter.h>
+#include <profile.h>
+
+#include <wx/filename.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+
+
+/**
+ * Builds a board with a zone on each outer copper layer, filled with a grid of round
+ * polygons (like the copper left around a grid of vias by a plane)
+ */
+static std::unique_ptr<BOARD> buildZoneBoard()
+{
+    const int gridSize = 200;
+    const int pitch = Millimeter2iu( 1.0 );
+    const int radius = Millimeter2iu( 0.4 );
+    const int vertexCount = 32;
+
+    std::unique_ptr<BOARD> board = std::make_unique<BOARD>();
+
+    for( PCB_LAYER_ID layer : { F_Cu, B_Cu } )
+    {
+        ZONE_CONTAINER* zone = new ZONE_CONTAINER( board.get() );
+        SHAPE_POLY_SET  fill;
+
+        zone->SetLayer( layer );
+        zone->SetMinThickness( Millimeter2iu( 0.2 ) );
+
+        zone->Outline()->NewOutline();
+        zone->Outline()->Append( 0, 0 );
+        zone->Outline()->Append( gridSize * pitch, 0 );
+        zone->Outline()->Append( gridSize * pitch, gridSize * pitch );
+        zone->Outline()->Append( 0, gridSize * pitch );
+
+        for( int x = 0; x < gridSize; x++ )
+        {
+            for( int y = 0; y < gridSize; y++ )
+            {
+                SHAPE_LINE_CHAIN circle;
+
+                for( int ii = 0; ii < vertexCount; ii++ )
+                {
+                    double angle = 2.0 * M_PI * ii / vertexCount;
+                    circle.Append( x * pitch + pitch / 2 + KiROUND( radius * cos( angle ) ),
+                                   y * pitch + pitch / 2 + KiROUND( radius * sin( angle ) ) );
+                }
+
+                circle.SetClosed( true );
+                fill.AddOutline( circle );
+            }
+        }
+
+        zone->SetFilledPolysList( fill );
+        zone->SetIsFilled( true );
+        board->Add( zone );
+    }
+
+    return board;
+}
+
+
+enum PLOT_THROUGHPUT_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    PLOT_FAILED,
+};
+
+
+/**
+ * Times plotting the copper layers of a board having zones, in each plot format whose
+ * content is dominated by the zone vertices, and in Gerber format with merged copper.
+ *
+ * Usage: plot_throughput [board file] [repeat count]
+ *
+ * Without a board file, a board with about 1.3 million zone vertices per outer copper layer
+ * is built.  Each layer is plotted "repeat count" times and the best time is kept.
+ */
+int plot_throughput_main( int argc, char *argv[] )
+{
+    int repeat = 3;
+
+    if( argc > 2 )
+        repeat = std::max( 1, atoi( argv[2] ) );
+
+    std::unique_ptr<BOARD> brd;
+
+    if( argc > 1 )
+        brd = KI_TEST::ReadBoardFromFileOrStream( argv[1] );
+    else
+        brd = buildZoneBoard();
+
+    if( !brd )
+        return PLOT_THROUGHPUT_RET_CODES::LOAD_FAILED;
+
+    LSET   layers;
+    size_t vertices = 0;
+
+    for( ZONE_CONTAINER* zone : brd->Zones() )
+    {
+        if( zone->IsOnCopperLayer() )
+        {
+            layers.set( zone->GetLayer() );
+            vertices += zone->GetFilledPolysList().TotalVertices();
+        }
+    }
+
+    printf( "%zu copper layers with zones, %zu zone vertices\n", layers.count(), vertices );
+
+    // Plot files are always written with the C locale
+    LOCALE_IO  toggle;
+    wxFileName plotFile( wxFileName::CreateTempFileName( "plot_throughput" ) );
+
+    struct PLOT_RUN
+    {
+        PLOT_FORMAT m_format;
+        bool        m_mergeCopper;
+        const char* m_name;
+    };
+
+    const PLOT_RUN runs[] = {
+        { PLOT_FORMAT::GERBER, false, "gbr" },
+        { PLOT_FORMAT::GERBER, true, "gbr (merged copper)" },
+        { PLOT_FORMAT::PDF, false, "pdf" },
+        { PLOT_FORMAT::SVG, false, "svg" },
+    };
+
+    for( const PLOT_RUN& run : runs )
+    {
+        PCB_PLOT_PARAMS plotOpts;
+        plotOpts.SetFormat( run.m_format );
+        plotOpts.SetGerberMergeCopper( run.m_mergeCopper );
+
+        double   totalTime = 0.0;
+        wxULongLong totalSize = 0;
+
+        for( PCB_LAYER_ID layer : layers.Seq() )
+        {
+            double best = std::numeric_limits<double>::max();
+
+            // Keep the best run of each layer, to lower the noise of the measurement
+            for( int ii = 0; ii < repeat; ii++ )
+            {
+                PROF_COUNTER counter;
+                PLOTTER* plotter = StartPlotBoard( brd.get(), &plotOpts, layer,
+                                                   plotFile.GetFullPath(), wxEmptyString );
+
+                if( !plotter )
+                {
+                    wxRemoveFile( plotFile.GetFullPath() );
+                    return PLOT_THROUGHPUT_RET_CODES::PLOT_FAILED;
+                }
+
+                PlotOneBoardLayer( brd.get(), plotter, layer, plotOpts );
+                plotter->EndPlot();
+                counter.Stop();
+
+                delete plotter->RenderSettings();
+                delete plotter;
+
+                best = std::min( best, counter.msecs() );
+            }
+
+            totalTime += best;
+            totalSize += plotFile.GetSize();
+        }
+
+        double megabytes = totalSize.ToDouble() / ( 1024.0 * 1024.0 );
+
+        printf( "%s: %.3f ms, %.1f MB", run.m_name, totalTime, megabytes );
+
+        if( totalTime > 0.0 )
+        {
+            printf( ", %.0f vertices/s, %.1f MB/s", vertices * 1000.0 / totalTime,
+                    megabytes * 1000.0 / totalTime );
+        }
+
+        printf( "\n" );
+    }
+
+    wxRemoveFile( plotFile.GetFullPath() );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "plot_throughput",
+        "Benchmark plotting the filled zones of a PCB in Gerber, PDF and SVG formats",
+        plot_throughput_main,
+} );
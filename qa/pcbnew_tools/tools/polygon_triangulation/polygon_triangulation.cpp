@@ -33,8 +33,9 @@
 #include <class_zone.h>
 #include <profile.h>
 
-#include <atomic>
-#include <thread>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
 #include <unordered_set>
 #include <utility>
 
@@ -208,65 +209,72 @@ enum POLY_TRI_RET_CODES
 };
 
 
+/**
+ * Times the triangulation of each filled zone of a board.
+ *
+ * Usage: polygon_triangulation [board file] [repeat count]
+ *
+ * Each zone is triangulated "repeat count" times and the best time is kept.
+ */
 int polygon_triangulation_main( int argc, char *argv[] )
 {
     std::string filename;
+    int         repeat = 1;
 
     if( argc > 1 )
         filename = argv[1];
 
+    if( argc > 2 )
+        repeat = std::max( 1, atoi( argv[2] ) );
+
     auto brd = KI_TEST::ReadBoardFromFileOrStream( filename );
 
     if( !brd )
         return POLY_TRI_RET_CODES::LOAD_FAILED;
 
+    size_t totalVertices = 0;
+    size_t totalTriangles = 0;
+    double totalTime = 0.0;
 
-    PROF_COUNTER cnt( "allBoard" );
+    for( int areaId = 0; areaId < brd->GetAreaCount(); areaId++ )
+    {
+        ZONE_CONTAINER* zone = brd->GetArea( areaId );
+        size_t          triangles = 0;
+        double          best = std::numeric_limits<double>::max();
 
+        // Keep the best run of each zone, to lower the noise of the measurement
+        for( int ii = 0; ii < repeat; ii++ )
+        {
+            SHAPE_POLY_SET poly = zone->GetFilledPolysList();
 
-    std::atomic<size_t> zonesToTriangulate( 0 );
-    std::atomic<size_t> threadsFinished( 0 );
+            PROF_COUNTER counter;
+            poly.CacheTriangulation();
+            counter.Stop();
 
-    size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-    {
-        std::thread t = std::thread( [&brd, &zonesToTriangulate, &threadsFinished]() {
-            for( size_t areaId = zonesToTriangulate.fetch_add( 1 );
-                        areaId < static_cast<size_t>( brd->GetAreaCount() );
-                        areaId = zonesToTriangulate.fetch_add( 1 ) )
-            {
-                auto zone = brd->GetArea( areaId );
-                SHAPE_POLY_SET poly = zone->GetFilledPolysList();
-
-                poly.CacheTriangulation();
-
-                (void) poly;
-                printf("zone %zu/%d\n", ( areaId + 1 ), brd->GetAreaCount() );
-#if 0
-                PROF_COUNTER unfrac("unfrac");
-                poly.Unfracture( SHAPE_POLY_SET::PM_FAST );
-                unfrac.Show();
-
-                PROF_COUNTER triangulate("triangulate");
-
-                for(int i =0; i< poly.OutlineCount(); i++)
-                {
-                    poly.triangulatePoly( &poly.Polygon(i) );
-                }
-                triangulate.Show();
-#endif
-            }
+            best = std::min( best, counter.msecs() );
+            triangles = 0;
+
+            for( unsigned int jj = 0; jj < poly.TriangulatedPolyCount(); jj++ )
+                triangles += poly.TriangulatedPolygon( jj )->GetTriangleCount();
+        }
+
+        const size_t vertices = zone->GetFilledPolysList().TotalVertices();
 
-            threadsFinished++;
-        } );
+        printf( "zone %d/%d: %zu vertices, %zu triangles, %.3f ms\n", areaId + 1,
+                brd->GetAreaCount(), vertices, triangles, best );
 
-        t.detach();
+        totalVertices += vertices;
+        totalTriangles += triangles;
+        totalTime += best;
     }
 
-    while( threadsFinished < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    printf( "total: %zu vertices, %zu triangles, %.3f ms", totalVertices, totalTriangles,
+            totalTime );
+
+    if( totalTime > 0.0 )
+        printf( ", %.0f vertices/s", totalVertices * 1000.0 / totalTime );
 
-    cnt.Show();
+    printf( "\n" );
 
     return KI_TEST::RET_CODES::OK;
 }
@@ -274,6 +282,6 @@ int polygon_triangulation_main( int argc, char *argv[] )
 
 static bool registered = UTILITY_REGISTRY::Register( {
         "polygon_triangulation",
-        "Process polygon triangulation on a PCB",
+        "Benchmark polygon triangulation of the filled zones of a PCB",
         polygon_triangulation_main,
 } );